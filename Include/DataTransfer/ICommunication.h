@@ -81,6 +81,7 @@
  * ### 注意事项
  * - **纯虚函数**: `create`, `send`, `receive`, `close` 是纯虚函数，派生类必须提供具体实现。
  * - **超时函数**: `setSendTimeout` 和 `setReceiveTimeout` 提供了默认实现（返回 false），具体通信类型如果支持超时设置，应覆盖这些方法。
+ * - **描述符**: `nativeHandle` 提供了默认实现（返回 -1），基于 socket 或串口的通信类型应覆盖它，以便注册到事件循环中。
  * - **返回值**: `receive` 方法的返回值约定用于指示接收状态（成功字节数、超时/关闭、错误）。
  * - **线程安全**: `ICommunication` 接口本身不保证线程安全。具体的派生类实现需要考虑其方法的线程安全性。通常，同一个通信对象的发送和接收操作可能需要在外部进行同步。
  */
@@ -180,6 +181,14 @@ namespace LSX_LIB
              */
             virtual bool setReceiveTimeout(int timeout_ms) { return false; }
 
+            /**
+             * @brief 获取用于 receive 的底层描述符，以便放入 epoll/poll/select（如 Thread::EventLoop）等待可读。
+             * 此方法是可选的，并非所有通信类型都支持。描述符仍归通信对象所有，调用者不能关闭它。
+             *
+             * @return POSIX 上返回 socket 或串口的文件描述符；未打开、平台（如 Windows）或通信类型不支持时返回 -1。
+             */
+            virtual int nativeHandle() { return -1; }
+
             /**
              * @brief 虚析构函数。
              * 确保通过基类指针删除派生类对象时，能够正确调用派生类的析构函数，释放所有资源。
@@ -0,0 +1,279 @@
+/**
+ * @file RpcChannel.h
+ * @brief 数据传输工具库 - 基于 TCP 分帧传输的多路复用 RPC
+ * @details 定义了 LSX_LIB::DataTransfer 命名空间下的 RpcChannel 类。
+ * 直接在 TcpClient/TcpServer 上做请求/应答时，应答没有标记，一个连接同一时刻只能有一个未完成的请求，
+ * 高延迟链路上只能靠增加连接数来提高吞吐。RpcChannel 在已连接的 ICommunication 上加一层长度前缀分帧，
+ * 每个请求携带请求 ID，同一连接上可以同时有任意多个未完成的请求，应答可以乱序返回，
+ * 每个调用有独立的截止时间，并通过 std::future 或回调（可投递到线程池）完成。
+ * @author 连思鑫（liansixin）
+ * @date 2025-4-8
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **分帧传输**: 每帧为 12 字节头部（长度、类型、方法名长度、请求 ID，网络字节序）加方法名和负载。
+ * - **请求流水线**: 调用方无需等待上一个应答即可继续发送请求，应答按请求 ID 匹配，可以乱序到达。
+ * - **截止时间**: 每个调用可指定超时，到期未收到应答时以 RpcStatus::Timeout 完成，之后到达的应答被丢弃。
+ * - **完成方式**: 支持返回 std::future<RpcResult>，或注册回调；构造时传入线程池则回调在线程池中执行。
+ * - **双向对称**: 连接两端都可以注册方法并发起调用；请求处理函数在线程池中并发执行，先完成的先应答。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "RpcChannel.h"
+ * #include "TcpServer.h"
+ * #include "TcpClient.h"
+ * #include "ThreadPool.h"
+ *
+ * LSX_LIB::Thread::ThreadPool pool(4);
+ *
+ * // 服务端：接受连接后交给 RpcChannel
+ * auto server = std::make_unique<LSX_LIB::DataTransfer::TcpServer>(9000);
+ * server->create();
+ * server->acceptConnection();
+ * LSX_LIB::DataTransfer::RpcChannel serverChannel(std::move(server), &pool);
+ * serverChannel.registerMethod("echo", [](const std::vector<uint8_t>& request) {
+ * return request; // 在线程池中执行，抛出的异常会作为 RpcStatus::HandlerError 返回给调用方
+ * });
+ * serverChannel.start();
+ *
+ * // 客户端：同一连接上同时发出多个请求
+ * auto client = std::make_unique<LSX_LIB::DataTransfer::TcpClient>("127.0.0.1", 9000);
+ * client->create();
+ * LSX_LIB::DataTransfer::RpcChannel channel(std::move(client), &pool);
+ * channel.start();
+ *
+ * std::vector<std::future<LSX_LIB::DataTransfer::RpcResult>> replies;
+ * for (int i = 0; i < 16; ++i) {
+ * replies.push_back(channel.call("echo", {uint8_t(i)}, 500)); // 每个请求 500ms 截止
+ * }
+ * for (auto& reply : replies) {
+ * LSX_LIB::DataTransfer::RpcResult result = reply.get();
+ * if (result.status != LSX_LIB::DataTransfer::RpcStatus::Ok) {
+ * std::cerr << "call failed: " << result.error << std::endl;
+ * }
+ * }
+ *
+ * // 回调方式
+ * channel.call("echo", {1, 2, 3}, 1000, [](LSX_LIB::DataTransfer::RpcResult result) {
+ * std::cout << "reply " << result.payload.size() << " bytes" << std::endl;
+ * });
+ * @endcode
+ *
+ * ### 注意事项
+ * - **传输对象**: 传入的 ICommunication 必须已经连接（TcpClient::create 成功或 TcpServer::acceptConnection 成功），
+ *   RpcChannel 接管其所有权，析构时关闭连接。start 之后不要再直接调用它的 send/receive。
+ * - **读线程**: start 启动一个读线程，通过 poll 等待 nativeHandle() 可读后直接 read 该描述符，不经过传输对象的 receive，
+ *   因此读取不会等待正在阻塞的 send，两端同时发送大块数据也不会互相卡死。nativeHandle() 不可用的平台（Windows）
+ *   改为设置 50ms 接收超时轮询 receive，此时只能通过发送失败发现对端关闭。
+ * - **无线程池时**: 回调和请求处理函数直接在读线程中执行，期间不会读取新的帧，应避免耗时操作；回调抛出的异常会被捕获并记录。
+ * - **截止时间精度**: 超时由读线程检查，精度约为几毫秒；timeoutMs <= 0 表示不设截止时间。
+ * - **断开连接**: 对端关闭、读错误或收到非法帧时，所有未完成的调用以 RpcStatus::Disconnected 完成，之后的调用立即失败。
+ */
+
+// LSXTransportLib: 数据传输工具库（跨平台）
+// 命名空间：LSX_LIB
+
+#ifndef LSX_RPC_CHANNEL_H
+#define LSX_RPC_CHANNEL_H
+#pragma once
+#include "ICommunication.h" // 包含通信接口基类
+#include "IThreadPool.h" // 包含线程池接口 (用于执行回调和请求处理函数)
+#include <string> // 包含 std::string
+#include <vector> // 包含 std::vector
+#include <map> // 包含 std::map, std::multimap
+#include <memory> // 包含 std::unique_ptr, std::shared_ptr
+#include <functional> // 包含 std::function
+#include <future> // 包含 std::future, std::promise
+#include <mutex> // 包含 std::mutex
+#include <condition_variable> // 包含 std::condition_variable
+#include <thread> // 包含 std::thread
+#include <atomic> // 包含 std::atomic
+#include <chrono> // 包含 std::chrono::steady_clock
+#include <cstdint> // 包含 uint8_t, uint32_t
+
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB
+{
+    /**
+     * @brief 数据传输相关的命名空间。
+     * 包含各种通信类和工具。
+     */
+    namespace DataTransfer
+    {
+        /**
+         * @brief RPC 调用的完成状态。
+         */
+        enum class RpcStatus : uint8_t
+        {
+            Ok = 0,             // 调用成功，payload 为应答数据
+            Timeout = 1,        // 截止时间前未收到应答
+            Disconnected = 2,   // 连接已断开或通道未启动
+            SendFailed = 3,     // 请求发送失败
+            MethodNotFound = 4, // 对端未注册该方法
+            HandlerError = 5    // 对端处理函数抛出异常，error 为异常信息
+        };
+
+        /**
+         * @brief RPC 调用结果。
+         */
+        struct RpcResult
+        {
+            RpcStatus status = RpcStatus::Ok; // 完成状态
+            std::vector<uint8_t> payload;     // 应答数据 (仅 Ok 时有效)
+            std::string error;                // 错误描述 (非 Ok 时有效)
+        };
+
+        /**
+         * @brief 多路复用 RPC 通道。
+         * 在一个已连接的 ICommunication 上同时承载多个带请求 ID 的调用。此类是线程安全的，
+         * call 和 registerMethod 可以在任意线程调用。
+         */
+        class RpcChannel
+        {
+        public:
+            /**
+             * @brief 请求处理函数，参数为请求负载，返回值为应答负载。抛出异常时向调用方返回 HandlerError。
+             */
+            using Handler = std::function<std::vector<uint8_t>(const std::vector<uint8_t>& request)>;
+
+            /**
+             * @brief 调用完成回调。
+             */
+            using Callback = std::function<void(RpcResult result)>;
+
+            /**
+             * @brief 构造函数。
+             *
+             * @param transport 已连接的通信对象，RpcChannel 接管其所有权。
+             * @param pool 用于执行回调和请求处理函数的线程池，为 nullptr 时在读线程中执行。线程池须比 RpcChannel 存活更久。
+             * @param maxFrameBytes 单帧最大字节数，收到更大的帧视为协议错误并断开，默认 16MB。
+             */
+            explicit RpcChannel(std::unique_ptr<ICommunication> transport,
+                                Thread::IThreadPool* pool = nullptr,
+                                size_t maxFrameBytes = 16 * 1024 * 1024);
+
+            /**
+             * @brief 析构函数。停止读线程，等待正在执行的请求处理函数结束，并关闭连接。
+             */
+            ~RpcChannel();
+
+            RpcChannel(const RpcChannel&) = delete;
+            RpcChannel& operator=(const RpcChannel&) = delete;
+
+            /**
+             * @brief 注册（或替换）一个方法的处理函数。可以在 start 之前或之后调用。
+             *
+             * @param method 方法名，最长 65535 字节。
+             * @param handler 处理函数。
+             */
+            void registerMethod(const std::string& method, Handler handler);
+
+            /**
+             * @brief 启动读线程。
+             *
+             * @return 启动成功返回 true；已启动、已断开或没有传输对象时返回 false。
+             */
+            bool start();
+
+            /**
+             * @brief 停止读线程，所有未完成的调用以 Disconnected 完成，并等待正在执行的请求处理函数结束。
+             * 不关闭连接。多次调用是安全的。
+             */
+            void stop();
+
+            /**
+             * @brief 判断通道是否处于可用状态（已启动且连接未断开）。
+             *
+             * @return 可用返回 true。
+             */
+            bool isRunning() const;
+
+            /**
+             * @brief 发起调用，通过回调完成。
+             * 请求发出后立即返回，不等待应答；回调恰好执行一次。
+             *
+             * @param method 方法名。
+             * @param payload 请求负载。
+             * @param timeoutMs 截止时间（毫秒），<= 0 表示不设截止时间。
+             * @param callback 完成回调，有线程池时在线程池中执行。
+             */
+            void call(const std::string& method, const std::vector<uint8_t>& payload, int timeoutMs, Callback callback);
+
+            /**
+             * @brief 发起调用，通过 std::future 完成。
+             * future 在收到应答、超时或断开时就绪，不经过线程池，可以在线程池任务中等待。
+             *
+             * @param method 方法名。
+             * @param payload 请求负载。
+             * @param timeoutMs 截止时间（毫秒），<= 0 表示不设截止时间。
+             * @return 调用结果的 future。
+             */
+            std::future<RpcResult> call(const std::string& method, const std::vector<uint8_t>& payload, int timeoutMs);
+
+            /**
+             * @brief 获取当前未完成的调用数。
+             *
+             * @return 未完成的调用数。
+             */
+            size_t inFlight() const;
+
+        private:
+            using Clock = std::chrono::steady_clock;
+            using DeadlineMap = std::multimap<Clock::time_point, uint32_t>;
+
+            /**
+             * @brief 一个未完成的调用。回调和 promise 二选一。
+             */
+            struct Pending
+            {
+                Callback callback;
+                std::shared_ptr<std::promise<RpcResult>> promise;
+                bool hasDeadline = false;
+                DeadlineMap::iterator deadline;   // hasDeadline 为 true 时指向 deadlines_ 中的条目
+            };
+
+            void startCall(const std::string& method, const std::vector<uint8_t>& payload, int timeoutMs, Pending pending);
+            void complete(Pending pending, RpcResult result);
+            bool takePending(uint32_t id, Pending& pending);         // 取出并移除未完成的调用，不存在时返回 false
+            void readLoop();
+            bool readSome(std::vector<uint8_t>& buffer, int waitMs); // 连接断开或出错时返回 false
+            bool parseFrames(std::vector<uint8_t>& buffer);          // 收到非法帧时返回 false
+            void dispatchRequest(uint32_t id, std::string method, std::vector<uint8_t> payload);
+            void expireCalls();
+            void failAll(const std::string& reason);
+            int nextWaitMs();
+            bool sendFrame(uint8_t type, uint32_t id, const std::string& method,
+                           const uint8_t* payload, size_t size);
+            void sendError(uint32_t id, RpcStatus status, const std::string& message);
+
+            std::unique_ptr<ICommunication> transport_;  // 已连接的通信对象
+            Thread::IThreadPool* pool_;                  // 执行回调和处理函数的线程池，可以为空
+            const size_t maxFrameBytes_;                 // 单帧最大字节数
+            int handle_ = -1;                            // 用于 poll 的描述符，-1 表示轮询 receive
+
+            std::mutex sendMutex_;                       // 保证每帧被完整、连续地发送
+
+            mutable std::mutex pendingMutex_;            // 保护 pending_、deadlines_、nextId_
+            std::map<uint32_t, Pending> pending_;        // 请求 ID -> 未完成的调用
+            DeadlineMap deadlines_;                      // 截止时间 -> 请求 ID
+            uint32_t nextId_ = 1;                        // 下一个请求 ID
+
+            std::mutex handlersMutex_;                   // 保护 handlers_
+            std::map<std::string, std::shared_ptr<Handler>> handlers_; // 方法名 -> 处理函数
+
+            std::mutex activeMutex_;                     // 配合 activeCv_ 等待处理函数结束
+            std::condition_variable activeCv_;
+            int activeHandlers_ = 0;                     // 正在线程池中执行的请求处理函数数
+
+            std::atomic<bool> running_{false};           // 读线程是否应继续运行
+            std::atomic<bool> connected_{true};          // 连接是否可用
+            std::thread reader_;                         // 读线程
+        };
+    } // namespace DataTransfer
+} // namespace LSX_LIB
+
+#endif // LSX_RPC_CHANNEL_H
@@ -0,0 +1,300 @@
+/**
+ * @file SerialMux.h
+ * @brief 数据传输工具库 - 单串口上带优先级的逻辑通道复用
+ * @details 定义了 LSX_LIB::DataTransfer 命名空间下的 SerialMux 类。
+ * 一条串口链路往往同时承载控制指令、遥测数据和固件升级数据，直接调用 SerialPort::send 发送一大块固件数据时，
+ * 紧急的控制帧只能排在后面，在常见波特率下会被延迟数百毫秒。SerialMux 把链路划分为最多 256 个逻辑通道，
+ * 消息被切成小块（默认 64 字节）发送，每发一块都重新按优先级选择通道，控制通道严格优先；
+ * 每个通道有独立的发送队列和基于信用的接收窗口，接收方来不及处理时发送方自动停止发送。
+ * @author 连思鑫（liansixin）
+ * @date 2025-4-8
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **逻辑通道**: 通道号 0-255，两端以相同的通道号和配置调用 openChannel。
+ * - **严格优先级**: priority 数值越小优先级越高；每个数据块发送前重新选择最高优先级且有信用的通道，同优先级通道轮转。
+ * - **小块分帧**: 帧格式为 `A5 通道 类型 长度 偏移(2) 数据 CRC16(2)`，CRC 错误或丢字节时自动重新同步。
+ * - **流量控制**: 每个通道的发送队列有字节上限，队列满时 send 阻塞（可设超时），向生产者施加背压。
+ * - **信用机制**: 接收方按接收窗口向发送方通告可发送的字节上限，应用取走消息后才归还信用，信用通告定期重发，丢失也能恢复。
+ *   信用耗尽的发送方定期发送空的偏移探测帧，消息最后一块丢失时接收方也能发现缺口并归还信用。
+ * - **内核队列限制**: POSIX 上通过 TIOCOUTQ 限制驱动输出队列中积压的字节数，避免大块数据在内核中排在控制帧之前。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "SerialMux.h"
+ * #include "SerialPort.h"
+ *
+ * auto port = std::make_unique<LSX_LIB::DataTransfer::SerialPort>("/dev/ttyS1", 115200);
+ * port->create();
+ * LSX_LIB::DataTransfer::SerialMux mux(std::move(port));
+ *
+ * LSX_LIB::DataTransfer::MuxChannelConfig control;
+ * control.priority = 0; // 控制通道，最高优先级
+ * LSX_LIB::DataTransfer::MuxChannelConfig firmware;
+ * firmware.priority = 7;
+ * firmware.receiveWindow = 8192;
+ * mux.openChannel(0, control);
+ * mux.openChannel(2, firmware);
+ * mux.setHandler(0, [](std::vector<uint8_t> message) {
+ * // 在读线程中执行，应尽快返回
+ * });
+ * mux.start();
+ *
+ * mux.send(2, image.data() + offset, 1024);   // 固件数据，发送队列满时阻塞
+ * mux.send(0, stopCmd, sizeof(stopCmd), 0);   // 控制指令，几毫秒内即可插队发出
+ *
+ * std::vector<uint8_t> message;
+ * if (mux.receive(2, message, 1000) > 0) {    // 没有 handler 的通道通过 receive 取消息
+ * // 处理 message
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **两端配置一致**: 两端需要以相同的通道号打开通道，且单条消息不能超过 receiveWindow（receiveWindow 最大 32768）。
+ * - **所有权**: SerialMux 接管传输对象的所有权，start 之后不要再直接调用它的 send/receive。传输对象不限于 SerialPort，任何 ICommunication 都可以。
+ * - **线程**: start 启动一个读线程和一个写线程；handler 在读线程中执行，handler 返回后才归还信用。
+ * - **延迟**: 控制帧的最坏等待时间约为一个数据块加 maxOutQueueBytes 字节的传输时间，115200 波特率、默认配置下约 10ms。
+ * - **平台**: Windows 上没有 poll 和 TIOCOUTQ，读线程依赖 SerialPort 的读超时，内核队列不受限制，延迟会变大。
+ */
+
+// LSXTransportLib: 数据传输工具库（跨平台）
+// 命名空间：LSX_LIB
+
+#ifndef LSX_SERIAL_MUX_H
+#define LSX_SERIAL_MUX_H
+#pragma once
+#include "ICommunication.h" // 包含通信接口基类
+#include <string> // 包含 std::string
+#include <vector> // 包含 std::vector
+#include <deque> // 包含 std::deque
+#include <memory> // 包含 std::unique_ptr
+#include <functional> // 包含 std::function
+#include <mutex> // 包含 std::mutex
+#include <condition_variable> // 包含 std::condition_variable
+#include <thread> // 包含 std::thread
+#include <atomic> // 包含 std::atomic
+#include <chrono> // 包含 std::chrono::steady_clock
+#include <cstdint> // 包含 uint8_t, uint32_t, uint64_t
+
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB
+{
+    /**
+     * @brief 数据传输相关的命名空间。
+     * 包含各种通信类和工具。
+     */
+    namespace DataTransfer
+    {
+        /**
+         * @brief SerialMux 的链路级配置。
+         */
+        struct SerialMuxConfig
+        {
+            size_t chunkBytes = 64;        // 单个数据块的最大负载字节数 (16-255)，越小控制帧等待越短，帧头开销越大
+            int maxOutQueueBytes = 64;     // 驱动输出队列中允许积压的最大字节数 (POSIX)，<= 0 表示不限制
+            int creditRefreshMs = 500;     // 信用通告的重发周期 (毫秒)
+        };
+
+        /**
+         * @brief 逻辑通道配置。
+         */
+        struct MuxChannelConfig
+        {
+            int priority = 4;              // 优先级，数值越小越优先，严格优先
+            size_t receiveWindow = 4096;   // 接收窗口 (字节)，即对端在本端取走消息前最多可发送的字节数，最大 32768
+            size_t sendQueueBytes = 16384; // 发送队列上限 (字节)，队列满时 send 阻塞
+        };
+
+        /**
+         * @brief 逻辑通道统计信息。
+         */
+        struct MuxChannelStats
+        {
+            uint64_t txBytes = 0;          // 已发出的负载字节数
+            uint64_t rxBytes = 0;          // 已收到的负载字节数
+            uint64_t txMessages = 0;       // 已完整发出的消息数
+            uint64_t rxMessages = 0;       // 已完整收到的消息数
+            uint64_t rxDropped = 0;        // 因丢帧而丢弃的不完整消息数
+            size_t txQueuedBytes = 0;      // 发送队列中等待发送的字节数
+            size_t rxQueuedBytes = 0;      // 接收队列中尚未取走的字节数
+            size_t peerCredit = 0;         // 当前还可以向对端发送的字节数
+        };
+
+        /**
+         * @brief 单串口逻辑通道复用器。
+         * 此类是线程安全的，send/receive 可以在任意线程调用。
+         */
+        class SerialMux
+        {
+        public:
+            /**
+             * @brief 消息处理函数，在读线程中执行。
+             */
+            using Handler = std::function<void(std::vector<uint8_t> message)>;
+
+            /**
+             * @brief 构造函数。
+             *
+             * @param link 已打开的链路（通常为 create 成功的 SerialPort），SerialMux 接管其所有权。
+             * @param config 链路级配置。
+             */
+            explicit SerialMux(std::unique_ptr<ICommunication> link, const SerialMuxConfig& config = SerialMuxConfig());
+
+            /**
+             * @brief 析构函数。停止读写线程并关闭链路。
+             */
+            ~SerialMux();
+
+            SerialMux(const SerialMux&) = delete;
+            SerialMux& operator=(const SerialMux&) = delete;
+
+            /**
+             * @brief 打开一个逻辑通道。可以在 start 之前或之后调用。
+             *
+             * @param channel 通道号。
+             * @param config 通道配置。
+             * @return 成功返回 true；通道已打开时返回 false。
+             */
+            bool openChannel(uint8_t channel, const MuxChannelConfig& config = MuxChannelConfig());
+
+            /**
+             * @brief 设置通道的消息处理函数。设置后该通道收到的消息不再进入接收队列。
+             * handler 在读线程中执行，返回后归还该消息占用的信用；handler 抛出的异常会被捕获并记录，信用照常归还。
+             *
+             * @param channel 已打开的通道号。
+             * @param handler 处理函数，传入空函数则恢复使用接收队列。
+             */
+            void setHandler(uint8_t channel, Handler handler);
+
+            /**
+             * @brief 启动读线程和写线程，并向对端通告所有已打开通道的信用。
+             *
+             * @return 启动成功返回 true；已启动或链路不可用时返回 false。
+             */
+            bool start();
+
+            /**
+             * @brief 停止读写线程，唤醒所有阻塞的 send/receive。不关闭链路。多次调用是安全的。
+             */
+            void stop();
+
+            /**
+             * @brief 将一条消息放入通道的发送队列。
+             * 消息会被切成小块，在有信用时按优先级发出。
+             *
+             * @param channel 已打开的通道号。
+             * @param data 消息数据。
+             * @param size 消息长度，不能超过通道的 receiveWindow。
+             * @param timeoutMs 发送队列满时的最长等待时间（毫秒），-1 表示一直等待，0 表示不等待。
+             * @return 消息已入队返回 true；通道未打开、消息过长、超时或已停止时返回 false。
+             */
+            bool send(uint8_t channel, const uint8_t* data, size_t size, int timeoutMs = -1);
+
+            /**
+             * @brief 从通道的接收队列取出一条完整消息，并归还对应的信用。
+             *
+             * @param channel 已打开的通道号。
+             * @param message 输出参数，收到的消息。
+             * @param timeoutMs 最长等待时间（毫秒），-1 表示一直等待，0 表示不等待。
+             * @return 1 表示取到消息；0 表示超时；-1 表示通道未打开或已停止。
+             */
+            int receive(uint8_t channel, std::vector<uint8_t>& message, int timeoutMs);
+
+            /**
+             * @brief 获取通道统计信息。
+             *
+             * @param channel 通道号。
+             * @return 统计信息快照，通道未打开时各项为 0。
+             */
+            MuxChannelStats getStats(uint8_t channel) const;
+
+            /**
+             * @brief 获取 CRC 校验失败（含重新同步丢弃）的帧数。
+             *
+             * @return 校验失败次数。
+             */
+            uint64_t crcErrors() const { return crcErrors_.load(std::memory_order_relaxed); }
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            /**
+             * @brief 通道状态，全部受 mutex_ 保护。
+             */
+            struct Channel
+            {
+                bool open = false;
+                MuxChannelConfig config;
+                Handler handler;
+
+                // 发送方向
+                std::deque<std::vector<uint8_t>> txQueue; // 待发送的消息
+                size_t txOffset = 0;                      // 队首消息已发送的字节数
+                size_t txQueuedBytes = 0;                 // 队列中未发送的字节数
+                uint32_t txSent = 0;                      // 累计发出的字节数 (与对端 rxReceived 对应)
+                uint32_t peerLimit = 0;                   // 对端通告的累计可发送上限
+                bool probeDue = false;                    // 信用耗尽，需要发送偏移探测帧
+                std::condition_variable txSpace;          // 发送队列有空间
+
+                // 接收方向
+                std::vector<uint8_t> rxPartial;           // 正在重组的消息
+                bool rxSkipping = false;                  // 丢帧后丢弃数据直到下一条消息开始
+                uint32_t rxReceived = 0;                  // 累计收到 (含丢失) 的字节数，按对端的发送偏移计算
+                uint32_t rxConsumed = 0;                  // 累计已归还信用的字节数
+                uint32_t advertised = 0;                  // 上次通告的信用上限
+                bool creditDue = false;                   // 需要尽快通告信用
+                std::deque<std::vector<uint8_t>> rxQueue; // 完整但尚未取走的消息
+                size_t rxQueuedBytes = 0;
+                std::condition_variable rxReady;          // 接收队列非空
+
+                MuxChannelStats stats;
+            };
+
+            /**
+             * @brief 读线程解析出、需要在锁外交给 handler 的消息。
+             */
+            struct Delivery
+            {
+                uint8_t channel;
+                Handler handler;
+                std::vector<uint8_t> message;
+            };
+
+            void readLoop();
+            void writeLoop();
+            bool readSome(std::vector<uint8_t>& buffer);              // 链路出错时返回 false
+            void parseFrames(std::vector<uint8_t>& buffer);
+            void handleFrame(uint8_t channel, uint8_t type, uint16_t offset, const uint8_t* data, size_t size,
+                             std::vector<Delivery>& deliveries);     // 调用方持有 mutex_
+            bool nextFrame(std::vector<uint8_t>& frame);              // 调用方持有 mutex_，没有可发送的帧时返回 false
+            void consumeLocked(Channel& channel, size_t bytes);       // 归还信用
+            void waitOutQueue();
+            void wakeAll();                                           // 唤醒写线程和所有阻塞的 send/receive
+            static void buildFrame(std::vector<uint8_t>& frame, uint8_t channel, uint8_t type, uint16_t offset,
+                                   const uint8_t* data, size_t size);
+            static uint16_t Crc16(const uint8_t* data, size_t size);
+
+            std::unique_ptr<ICommunication> link_;     // 链路
+            const SerialMuxConfig config_;             // 链路级配置
+            int handle_ = -1;                          // 用于 poll/TIOCOUTQ 的描述符
+
+            mutable std::mutex mutex_;                 // 保护 channels_ 及所有通道状态
+            std::condition_variable writerCv_;         // 唤醒写线程
+            Channel channels_[256];                    // 通道表
+            uint8_t rrCursor_ = 0;                     // 同优先级轮转的位置
+            bool stopping_ = false;                    // 已调用 stop 或链路出错，阻塞的 send/receive 应返回
+            Clock::time_point nextRefresh_;            // 下一次定期通告信用的时间
+
+            std::atomic<bool> running_{false};         // 读写线程是否应继续运行
+            std::atomic<uint64_t> crcErrors_{0};       // CRC 校验失败次数
+            std::thread reader_;                       // 读线程
+            std::thread writer_;                       // 写线程
+        };
+    } // namespace DataTransfer
+} // namespace LSX_LIB
+
+#endif // LSX_SERIAL_MUX_H
@@ -228,6 +228,13 @@ namespace LSX_LIB
              */
             bool setReceiveTimeout(int timeout_ms) override;
 
+            /**
+             * @brief 获取串口设备的文件描述符，用于注册到事件循环等待可读。
+             *
+             * @return POSIX 上返回描述符，串口未打开时返回 -1；Windows 上返回 -1。
+             */
+            int nativeHandle() override;
+
         private: // SerialPort 没有被其他类继承，所以保持 private 即可
             /**
              * @brief 串口名称。
@@ -310,7 +310,27 @@ namespace LSX_LIB
              */
             bool setReceiveTimeout(int timeout_ms) override;
 
+            /**
+             * @brief 获取已接受的客户端连接 (`connFd`) 的文件描述符，即 receive 使用的描述符，用于注册到事件循环等待可读。
+             *
+             * @return POSIX 上返回描述符，尚未接受连接时返回 -1；Windows 上返回 -1。
+             */
+            int nativeHandle() override;
+
+            /**
+             * @brief 获取监听 socket (`listenFd`) 的文件描述符。注册到事件循环后，可读表示有新连接，可调用 acceptConnection。
+             *
+             * @return POSIX 上返回描述符，未创建时返回 -1；Windows 上返回 -1。
+             */
+            int listenHandle();
+
         private: // TcpServer 没有被其他类继承，所以保持 private 即可
+            /**
+             * @brief 关闭当前已接受的客户端连接，调用方已持有 mtx。
+             * std::mutex 不可重入，acceptConnection 和 close 持锁时必须调用此方法而不是 closeClientConnection。
+             */
+            void closeClientConnectionLocked();
+
 #ifdef _WIN32
             /**
              * @brief Windows 监听 socket 句柄。
@@ -228,6 +228,13 @@ namespace LSX_LIB
              */
             bool setReceiveTimeout(int timeout_ms) override;
 
+            /**
+             * @brief 获取 UDP socket 的文件描述符，用于注册到事件循环等待可读。
+             *
+             * @return POSIX 上返回描述符，未创建时返回 -1；Windows 上返回 -1。
+             */
+            int nativeHandle() override;
+
         protected: // 更改为 protected 以便派生类 (如 UdpBroadcast) 访问
 #ifdef _WIN32
             /**
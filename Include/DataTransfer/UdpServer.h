@@ -266,6 +266,13 @@ namespace LSX_LIB
              */
             bool setReceiveTimeout(int timeout_ms) override;
 
+            /**
+             * @brief 获取 UDP socket 的文件描述符，用于注册到事件循环等待可读。
+             *
+             * @return POSIX 上返回描述符，未创建时返回 -1；Windows 上返回 -1。
+             */
+            int nativeHandle() override;
+
         private: // UdpServer 没有被其他类继承，所以保持 private 即可
 #ifdef _WIN32
             /**
@@ -0,0 +1,295 @@
+/**
+ * @file LogCategory.h
+ * @brief 数据传输工具库 - 日志分类（按模块的日志级别）
+ * @details 定义了 LSX_LIB::Logger 命名空间下的 LogCategory 类和 LogCategoryRegistry 类。
+ * Logger 自身只有一个全局日志级别，为某个模块（例如串口驱动）打开 DEBUG 会同时打开所有模块的 DEBUG 输出。
+ * 日志分类为每个模块提供独立的原子日志级别，配合 `LSX_LOG_CAT_*` 宏在调用点缓存分类引用，
+ * 被禁用的分类只需一次 relaxed 原子读取即可跳过，消息表达式本身也不会被求值。
+ * 分类级别可以在运行时通过 API、规格字符串或注册到 ConfigServer 的 HTTP 接口调整。
+ * @author 连思鑫（liansixin）
+ * @date 2025年5月13日
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **命名分类**: 按名称获取分类，首次使用时自动创建，分类对象在进程内永不销毁，引用可长期缓存。
+ * - **独立级别**: 每个分类拥有独立的原子日志级别，不受 Logger 全局级别影响。
+ * - **默认级别**: 未显式设置过级别的分类跟随注册表的默认级别。
+ * - **调用点缓存**: `LSX_LOG_CAT_*` 宏在每个调用点以函数内静态变量缓存分类引用，只在首次执行时查表。
+ * - **运行时控制**: 支持 `SetLevel`、`Apply("serial=DEBUG,net=WARNING")` 以及 `RegisterLogCategoryRoutes` 注册的 HTTP 接口。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "Logger.h"
+ * #include "LogCategory.h"
+ * #include "ConfigServer.h"
+ *
+ * LSX_LIB::Logger::Logger logger(LSX_LIB::Logger::LoggerConfig());
+ *
+ * void serial_rx(const std::vector<uint8_t>& frame) {
+ * // 分类 "serial" 默认为 INFO，下面这行只有一次原子读取，字符串拼接不会执行
+ * LSX_LOG_CAT_DEBUG(logger, "serial", "rx " + std::to_string(frame.size()) + " bytes");
+ * }
+ *
+ * int main() {
+ * auto& registry = LSX_LIB::Logger::LogCategoryRegistry::Instance();
+ * registry.SetLevel("serial", LSX_LIB::Logger::LogLevel::DEBUG); // 只打开串口模块的 DEBUG
+ * registry.Apply("net=WARNING,db=ERROR"); // 也可以使用规格字符串批量设置
+ *
+ * LSX_LIB::Config::ConfigServer server("data.db");
+ * server.initialize();
+ * // GET /api/log/categories                        列出所有分类及级别
+ * // PUT /api/log/categories?name=serial&level=INFO 修改单个分类
+ * // PUT /api/log/categories?spec=serial=DEBUG,net=INFO 批量修改
+ * LSX_LIB::Logger::RegisterLogCategoryRoutes(server);
+ * server.run();
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **与全局级别的关系**: 通过分类记录的日志只受分类级别过滤，不再检查 Logger 的全局级别；不带分类的旧宏行为不变。
+ * - **分类名称**: 宏中的分类名只在调用点首次执行时读取一次，应使用字符串常量。
+ * - **生命周期**: 注册表和分类对象有意不析构，保证静态对象析构阶段的日志调用仍然安全。
+ * - **HTTP 接口**: `RegisterLogCategoryRoutes` 是模板函数，不引入 httplib 依赖；任何提供
+ *   `addCustomRoute(method, pattern, handler)` 且请求对象支持 `has_param`/`get_param_value` 的服务器都可以使用。
+ */
+
+#ifndef LSX_LIB_LOGGER_LOG_CATEGORY_H
+#define LSX_LIB_LOGGER_LOG_CATEGORY_H
+#pragma once
+#include "LogCommon.h" // 包含日志通用定义 (LogLevel)
+#include <string> // 包含 std::string
+#include <vector> // 包含 std::vector
+#include <map> // 包含 std::map
+#include <memory> // 包含 std::unique_ptr
+#include <mutex> // 包含 std::mutex
+#include <atomic> // 包含 std::atomic
+#include <utility> // 包含 std::pair
+
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB {
+    /**
+     * @brief 日志相关的命名空间。
+     * 包含日志系统相关的类和工具。
+     */
+    namespace Logger {
+
+        class LogCategoryRegistry;
+
+        /**
+         * @brief 日志分类。
+         * 一个命名的日志来源（通常对应一个模块），拥有独立的原子日志级别。
+         * 只能通过 LogCategoryRegistry 创建。
+         */
+        class LogCategory {
+        public:
+            LogCategory(const LogCategory&) = delete;
+            LogCategory& operator=(const LogCategory&) = delete;
+
+            /**
+             * @brief 获取分类名称。
+             *
+             * @return 分类名称。
+             */
+            const std::string& GetName() const { return name_; }
+
+            /**
+             * @brief 判断指定级别的消息是否需要输出。
+             * 只有一次 relaxed 原子读取，适合放在日志调用点的热路径上。
+             *
+             * @param level 消息的日志级别。
+             * @return 消息级别不低于分类级别时返回 true。
+             */
+            bool IsEnabled(LogLevel level) const
+            {
+                return static_cast<int>(level) >= level_.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief 获取分类当前的日志级别。
+             *
+             * @return 当前日志级别。
+             */
+            LogLevel GetLevel() const
+            {
+                return static_cast<LogLevel>(level_.load(std::memory_order_acquire));
+            }
+
+            /**
+             * @brief 判断分类是否为低优先级。
+             * 日志后端过载时，Logger 会优先丢弃低优先级分类中未受保护级别的日志。
+             *
+             * @return 低优先级返回 true。
+             */
+            bool IsLowPriority() const
+            {
+                return low_priority_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            friend class LogCategoryRegistry;
+
+            LogCategory(std::string name, LogLevel level)
+                : name_(std::move(name)), level_(static_cast<int>(level)) {}
+
+            std::string name_;            // 分类名称
+            std::atomic<int> level_;      // 当前日志级别 (LogLevel 的整数值)
+            bool explicit_level_ = false; // 是否被显式设置过级别 (受注册表互斥锁保护)
+            std::atomic<bool> low_priority_{false}; // 是否为低优先级分类
+        };
+
+        /**
+         * @brief 日志分类注册表。
+         * 进程内唯一，负责创建、查找分类以及运行时修改分类级别。此类是线程安全的。
+         */
+        class LogCategoryRegistry {
+        public:
+            /**
+             * @brief 获取全局注册表实例。
+             *
+             * @return 注册表引用。
+             */
+            static LogCategoryRegistry& Instance();
+
+            LogCategoryRegistry(const LogCategoryRegistry&) = delete;
+            LogCategoryRegistry& operator=(const LogCategoryRegistry&) = delete;
+
+            /**
+             * @brief 获取指定名称的分类，不存在时以默认级别创建。
+             * 返回的引用在进程生命周期内一直有效。
+             *
+             * @param name 分类名称。
+             * @return 分类引用。
+             */
+            LogCategory& Get(const std::string& name);
+
+            /**
+             * @brief 设置指定分类的日志级别，分类不存在时先创建。
+             * 显式设置过级别的分类不再跟随默认级别变化。
+             *
+             * @param name 分类名称。
+             * @param level 新的日志级别。
+             */
+            void SetLevel(const std::string& name, LogLevel level);
+
+            /**
+             * @brief 设置默认日志级别。
+             * 影响之后新建的分类以及所有未显式设置过级别的分类。
+             *
+             * @param level 新的默认日志级别。
+             */
+            void SetDefaultLevel(LogLevel level);
+
+            /**
+             * @brief 标记指定分类是否为低优先级，分类不存在时先创建。
+             * 日志后端过载时，低优先级分类中低于 SheddingConfig::protectLevel 的日志会被全部丢弃。
+             *
+             * @param name 分类名称。
+             * @param low_priority 是否为低优先级。
+             */
+            void SetLowPriority(const std::string& name, bool low_priority);
+
+            /**
+             * @brief 获取默认日志级别。
+             *
+             * @return 默认日志级别。
+             */
+            LogLevel GetDefaultLevel() const;
+
+            /**
+             * @brief 按规格字符串批量设置级别。
+             * 格式为逗号分隔的 `名称=级别` 列表，名称为 `*` 时设置默认级别，例如 `*=WARNING,serial=DEBUG`。
+             * 级别名称不区分大小写，支持 DEBUG、INFO、WARNING（或 WARN）、ERROR。
+             * 规格中任意一项无效时不做任何修改。
+             *
+             * @param spec 规格字符串。
+             * @return 全部解析成功并已应用返回 true。
+             */
+            bool Apply(const std::string& spec);
+
+            /**
+             * @brief 列出所有分类及其当前级别（按名称排序）。
+             *
+             * @return 分类名称与级别的列表。
+             */
+            std::vector<std::pair<std::string, LogLevel>> List() const;
+
+            /**
+             * @brief 将级别名称解析为 LogLevel。
+             *
+             * @param text 级别名称（不区分大小写）。
+             * @param level 解析结果。
+             * @return 解析成功返回 true。
+             */
+            static bool ParseLevel(const std::string& text, LogLevel& level);
+
+            /**
+             * @brief 获取级别的名称字符串。
+             *
+             * @param level 日志级别。
+             * @return 级别名称，例如 "DEBUG"。
+             */
+            static const char* LevelName(LogLevel level);
+
+            /**
+             * @brief 以 JSON 文本导出默认级别和所有分类的级别。
+             * 格式为 `{"default":"INFO","categories":{"serial":"DEBUG"}}`。
+             *
+             * @return JSON 字符串。
+             */
+            std::string ToJson() const;
+
+        private:
+            LogCategoryRegistry() = default;
+
+            LogCategory& GetLocked(const std::string& name);
+
+            mutable std::mutex mutex_;                                    // 保护 categories_ 和 default_level_
+            std::map<std::string, std::unique_ptr<LogCategory>> categories_; // 分类表，unique_ptr 保证地址稳定
+            LogLevel default_level_ = LogLevel::INFO;                     // 默认日志级别
+        };
+
+        /**
+         * @brief 在 HTTP 服务器上注册日志分类的查询与修改接口。
+         * 通常传入 LSX_LIB::Config::ConfigServer，由其 addCustomRoute 注册路由：
+         * - `GET  path`：返回 LogCategoryRegistry::ToJson() 的结果。
+         * - `PUT  path?name=<分类>&level=<级别>`：修改单个分类的级别（name 为 `*` 时修改默认级别）。
+         * - `PUT  path?spec=<规格>`：按 LogCategoryRegistry::Apply 的格式批量修改。
+         * 修改成功返回最新的 JSON，参数无效返回 400。
+         *
+         * @tparam Server 提供 addCustomRoute(method, pattern, handler) 的服务器类型。
+         * @param server 服务器实例。
+         * @param path 路由路径，默认为 "/api/log/categories"。
+         */
+        template <typename Server>
+        void RegisterLogCategoryRoutes(Server& server, const std::string& path = "/api/log/categories")
+        {
+            server.addCustomRoute("GET", path, [](const auto& req, auto& res) {
+                (void)req;
+                res.set_content(LogCategoryRegistry::Instance().ToJson(), "application/json; charset=utf-8");
+            });
+            server.addCustomRoute("PUT", path, [](const auto& req, auto& res) {
+                auto& registry = LogCategoryRegistry::Instance();
+                bool ok = false;
+                if (req.has_param("spec")) {
+                    ok = registry.Apply(req.get_param_value("spec"));
+                } else if (req.has_param("name") && req.has_param("level")) {
+                    ok = registry.Apply(req.get_param_value("name") + "=" + req.get_param_value("level"));
+                }
+                if (!ok) {
+                    res.status = 400;
+                    res.set_content("{\"message\":\"need 'spec' or 'name' and 'level' (DEBUG/INFO/WARNING/ERROR)\"}",
+                                    "application/json; charset=utf-8");
+                    return;
+                }
+                res.set_content(registry.ToJson(), "application/json; charset=utf-8");
+            });
+        }
+
+    } // namespace Logger
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_LOGGER_LOG_CATEGORY_H
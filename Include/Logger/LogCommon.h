@@ -64,6 +64,7 @@
 #pragma once
 #include <string> // 包含 std::string
 #include <utility> // 包含 std::move
+#include <cstdint> // 包含 uint64_t
 
 /**
  * @brief LSX 库的根命名空间。
@@ -119,6 +120,59 @@ namespace LSX_LIB {
             File
         };
 
+        /**
+         * @brief 结构化键值日志的输出格式枚举。
+         * 用于 `LSX_LOG_KV` 宏输出的日志行。
+         */
+        enum class KvFormat {
+            /**
+             * @brief JSON Lines。
+             * 每行一个 JSON 对象，例如 `{"ts":"...","level":"INFO","msg":"sent","bytes":12}`。
+             */
+            Json,
+            /**
+             * @brief logfmt。
+             * 空格分隔的 `key=value`，例如 `ts="..." level=INFO msg=sent bytes=12`。
+             */
+            Logfmt
+        };
+
+        /**
+         * @brief 日志自适应降载配置。
+         * 日志后端跟不上时（等待输出的线程过多或单次写入耗时过长），Logger 自动丢弃或采样低重要性的日志。
+         */
+        struct SheddingConfig {
+            /**
+             * @brief 是否启用自适应降载。
+             */
+            bool enabled = false;                  // 是否启用
+            /**
+             * @brief 等待输出锁的线程数阈值。
+             * 正在等待或正在写入的线程数达到此值时视为过载。
+             */
+            int maxPendingWriters = 4;             // 排队线程数阈值
+            /**
+             * @brief 单次写入耗时阈值（微秒）。
+             * LogWriter::Write 耗时的指数滑动平均超过此值时视为过载。
+             */
+            int maxWriteLatencyUs = 2000;          // 写入耗时阈值 (微秒)
+            /**
+             * @brief 受保护的最低级别。
+             * 不低于此级别的日志永不丢弃。
+             */
+            LogLevel protectLevel = LogLevel::WARNING; // 永不丢弃的最低级别
+            /**
+             * @brief 过载时的采样间隔。
+             * 过载期间未受保护的日志每 N 条保留 1 条，0 表示全部丢弃；低优先级分类的日志始终全部丢弃。
+             */
+            int sampleEvery = 10;                  // 过载时每 N 条保留 1 条
+            /**
+             * @brief 恢复等待时间（毫秒）。
+             * 连续这么长时间未检测到过载才结束降载，并输出一条降载汇总。
+             */
+            int recoverMs = 1000;                  // 恢复等待时间 (毫秒)
+        };
+
         /**
          * @brief 日志配置结构体。
          * 存储日志系统的配置参数。
@@ -144,6 +198,32 @@ namespace LSX_LIB {
              * 当 OutputMode 为 File 时，指定单个日志文件的最大行数，用于文件滚动或截断。
              */
             int maxLines = 1000;                   // 默认文件最大行数 (对于文件输出)
+            /**
+             * @brief 是否启用分段轮转。
+             * 为 true 时文件输出使用 RotatingFileWriter：maxLines 表示单个分段的行数，写满后切分为新分段；
+             * 为 false 时使用 FileWriter，文件只保留最新的 maxLines 行。
+             */
+            bool rotate = false;                   // 是否启用分段轮转 (对于文件输出)
+            /**
+             * @brief 是否在后台压缩已轮转的分段。
+             * 仅在 rotate 为 true 时生效，分段由低优先级后台线程压缩为 .gz 文件。
+             */
+            bool compressRotated = true;           // 是否后台压缩已轮转的分段
+            /**
+             * @brief 已轮转分段的总大小上限（字节）。
+             * 仅在 rotate 为 true 时生效，超过上限时从最旧的分段开始删除，0 表示不限制。
+             */
+            uint64_t maxTotalBytes = 0;            // 已轮转分段的总大小上限，0 表示不限制
+            /**
+             * @brief 结构化键值日志的输出格式。
+             * `LSX_LOG_KV` 宏输出的日志行使用此格式，可通过 Logger::SetKvFormat 在运行时修改。
+             */
+            KvFormat kvFormat = KvFormat::Json;    // 键值日志的输出格式
+            /**
+             * @brief 自适应降载配置。
+             * 默认不启用，可通过 Logger::SetShedding 在运行时修改。
+             */
+            SheddingConfig shedding;               // 自适应降载配置
 
             /**
              * @brief 默认构造函数。
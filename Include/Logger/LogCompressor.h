@@ -0,0 +1,131 @@
+/**
+ * @file LogCompressor.h
+ * @brief 数据传输工具库 - 已轮转日志文件的后台压缩与清理
+ * @details 定义了 LSX_LIB::Logger 命名空间下的 LogCompressor 类。
+ * RotatingFileWriter 每写满一个分段就把关闭的分段文件交给 LogCompressor，
+ * 由其后台线程压缩为 gzip 格式（内置编码器，不依赖 zlib），再按总大小上限从最旧的分段开始删除。
+ * 后台线程以 SCHED_IDLE 调度策略和 idle I/O 优先级运行，只使用系统空闲的 CPU 和磁盘带宽，不影响记录日志的线程。
+ * @author 连思鑫（liansixin）
+ * @date 2025年5月13日
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **后台压缩**: 分段文件压缩为 `<分段>.gz`，可直接用 `zcat`/`gzip -d` 查看。
+ * - **低优先级**: Linux 下压缩线程使用 SCHED_IDLE 和 IOPRIO_CLASS_IDLE，其他平台以普通优先级运行。
+ * - **磁盘配额**: 所有已轮转分段（含压缩后的文件）总大小超过上限时，按时间从旧到新删除。
+ * - **断点恢复**: 启动时会重新提交上次退出前尚未压缩的分段，并清理压缩中断留下的临时文件。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "LogCompressor.h"
+ *
+ * // 通常不直接使用，由 RotatingFileWriter 创建和管理
+ * LSX_LIB::Logger::LogCompressor compressor("logs/app.log", true, 16 * 1024 * 1024);
+ * compressor.Submit("logs/app.log.20250513-120000.000");
+ *
+ * // 也可以单独压缩任意文件
+ * LSX_LIB::Logger::LogCompressor::GzipFile("big.txt", "big.txt.gz");
+ * @endcode
+ *
+ * ### 注意事项
+ * - **内存占用**: 压缩时整个分段会读入内存，分段大小由 maxLines 决定，嵌入式设备上应保持适中。
+ * - **压缩率**: 内置编码器使用 LZ77 + 固定 Huffman 表，速度优先，文本日志通常可压缩到原大小的 1/3 以下。
+ * - **析构**: 析构时等待正在压缩的分段完成，队列中剩余的分段保持未压缩状态，下次启动时补压。
+ * - **分段命名**: 分段文件名为 `<日志路径>.<YYYYmmdd-HHMMSS>.<序号>`（可带 `.gz` / `.gz.tmp`），只有严格符合该格式的文件才参与补压和配额计算，
+ *   同目录下的 `<日志文件名>.log`、`<日志文件名>.bak` 等其他文件不会被压缩或删除。
+ */
+
+#ifndef LSX_LIB_LOGGER_LOG_COMPRESSOR_H
+#define LSX_LIB_LOGGER_LOG_COMPRESSOR_H
+#pragma once
+#include <string> // 包含 std::string
+#include <deque> // 包含 std::deque
+#include <thread> // 包含 std::thread
+#include <mutex> // 包含 std::mutex
+#include <condition_variable> // 包含 std::condition_variable
+#include <cstdint> // 包含 uint64_t
+
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB {
+    /**
+     * @brief 日志相关的命名空间。
+     * 包含日志系统相关的类和工具。
+     */
+    namespace Logger {
+
+        /**
+         * @brief 已轮转日志分段的后台压缩器。
+         * 拥有一个低优先级后台线程，依次压缩提交的分段并执行磁盘配额。
+         * Submit 是线程安全的。
+         */
+        class LogCompressor {
+        public:
+            /**
+             * @brief 构造函数。
+             * 启动后台线程，并重新提交 basePath 对应的未压缩分段。
+             *
+             * @param basePath 活动日志文件路径，分段文件以 `<basePath>.` 为前缀。
+             * @param compress 是否压缩分段；为 false 时只执行磁盘配额。
+             * @param maxTotalBytes 所有分段的总大小上限（字节），0 表示不限制。
+             */
+            LogCompressor(std::string basePath, bool compress, uint64_t maxTotalBytes);
+
+            /**
+             * @brief 析构函数。
+             * 等待当前正在处理的分段完成后停止后台线程。
+             */
+            ~LogCompressor();
+
+            LogCompressor(const LogCompressor&) = delete;
+            LogCompressor& operator=(const LogCompressor&) = delete;
+
+            /**
+             * @brief 提交一个已关闭的分段文件。
+             * 只入队并唤醒后台线程，不做任何文件 I/O。
+             *
+             * @param segmentPath 分段文件路径。
+             */
+            void Submit(const std::string& segmentPath);
+
+            /**
+             * @brief 阻塞等待队列中所有分段处理完成。
+             */
+            void WaitIdle();
+
+            /**
+             * @brief 将文件压缩为 gzip 格式。
+             * 先写入 `<dst>.tmp`，成功后再重命名为 dst，中途失败不会留下不完整的 dst。
+             *
+             * @param src 源文件路径。
+             * @param dst 目标文件路径。
+             * @return 成功返回 true。
+             */
+            static bool GzipFile(const std::string& src, const std::string& dst);
+
+        private:
+            void Run();                  // 后台线程主循环
+            void Process(const std::string& segmentPath); // 压缩单个分段
+            void EnforceQuota();         // 按总大小上限删除最旧的分段
+            void RecoverPending();       // 重新提交上次遗留的未压缩分段
+
+            std::string base_path_;      // 活动日志文件路径
+            bool compress_;              // 是否压缩分段
+            uint64_t max_total_bytes_;   // 分段总大小上限，0 表示不限制
+
+            std::mutex mutex_;                 // 保护 queue_、busy_ 和 stop_
+            std::condition_variable cv_;       // 新任务/停止通知
+            std::condition_variable idle_cv_;  // 队列清空通知
+            std::deque<std::string> queue_;    // 待处理的分段
+            bool busy_ = false;                // 后台线程是否正在处理分段
+            bool stop_ = false;                // 停止标志
+            std::thread worker_;               // 后台线程
+        };
+
+    } // namespace Logger
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_LOGGER_LOG_COMPRESSOR_H
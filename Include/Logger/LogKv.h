@@ -0,0 +1,166 @@
+/**
+ * @file LogKv.h
+ * @brief 数据传输工具库 - 结构化键值日志编码器
+ * @details 定义了 LSX_LIB::Logger 命名空间下的 KvEncoder 类。
+ * `LSX_LOG_*` 宏只接收拼接好的字符串，字段被混入文本后，日志采集端只能用正则重新解析。
+ * KvEncoder 将带类型的键值字段直接编码进每个线程复用的缓冲区，输出为 JSON Lines 或 logfmt，
+ * 编码过程不为每个字段构造临时 std::string，也不构造 nlohmann::json 对象。
+ * 通常通过 Logger.h 中的 `LSX_LOG_KV` 宏使用。
+ * @author 连思鑫（liansixin）
+ * @date 2025年5月13日
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **两种格式**: `KvFormat::Json` 每行一个 JSON 对象；`KvFormat::Logfmt` 为 `key=value` 空格分隔。
+ * - **类型化字段**: 支持整数、bool、浮点数、枚举、字符（串）、std::string 和 std::string_view。
+ * - **零临时分配**: 数字直接格式化到栈上缓冲区后追加，字符串边转义边追加；线程本地缓冲区复用容量。
+ * - **固定字段**: 每行包含 ts、level、thread、src（文件:行号）、func、msg，之后是调用者的字段。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "Logger.h"
+ *
+ * LSX_LIB::Logger::Logger logger(LSX_LIB::Logger::LoggerConfig());
+ * logger.SetKvFormat(LSX_LIB::Logger::KvFormat::Json);
+ *
+ * LSX_LOG_KV(logger, INFO, "frame sent", "fd", fd, "bytes", n, "peer", peer_name);
+ * // {"ts":"2025-05-13 12:00:00.123","level":"INFO","thread":"1401...","src":"net.cpp:42","func":"send",
+ * //  "msg":"frame sent","fd":7,"bytes":128,"peer":"10.0.0.2"}
+ *
+ * logger.SetKvFormat(LSX_LIB::Logger::KvFormat::Logfmt);
+ * LSX_LOG_KV(logger, WARNING, "retry", "attempt", 3, "delay_ms", 12.5);
+ * // ts="2025-05-13 12:00:00.124" level=WARNING thread=1401... src=net.cpp:57 func=send msg=retry attempt=3 delay_ms=12.5
+ * @endcode
+ *
+ * ### 注意事项
+ * - **键**: 键必须是 `const char*`（通常为字符串常量），键与值成对出现，数量为奇数时编译失败。
+ * - **不支持的类型**: 其他类型会触发 static_assert，请先转换为上述类型之一。
+ * - **浮点数**: JSON 中 NaN/Inf 输出为 null，logfmt 中输出为 NaN/+Inf/-Inf。
+ * - **与文本日志混用**: 同一 Logger 的文本日志和键值日志写入同一输出器，采集端需要按行区分格式。
+ */
+
+#ifndef LSX_LIB_LOGGER_LOG_KV_H
+#define LSX_LIB_LOGGER_LOG_KV_H
+#pragma once
+#include "LogCommon.h" // 包含日志通用定义 (LogLevel, KvFormat)
+#include <string> // 包含 std::string
+#include <string_view> // 包含 std::string_view
+#include <type_traits> // 包含 std::is_integral 等类型萃取
+#include <cstdint> // 包含 int64_t, uint64_t
+
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB {
+    /**
+     * @brief 日志相关的命名空间。
+     * 包含日志系统相关的类和工具。
+     */
+    namespace Logger {
+
+        /**
+         * @brief 结构化键值日志编码器。
+         * 所有方法均为静态方法，向调用者提供的 std::string 追加内容。
+         */
+        class KvEncoder {
+        public:
+            /**
+             * @brief 获取当前线程复用的编码缓冲区（已清空，保留容量）。
+             *
+             * @return 线程本地缓冲区引用。
+             */
+            static std::string& ThreadBuffer();
+
+            /**
+             * @brief 编码一行完整的键值日志。
+             * 先写入固定字段，再依次写入调用者提供的键值对。
+             *
+             * @param out 输出缓冲区（追加）。
+             * @param format 输出格式。
+             * @param level 日志级别。
+             * @param file 源代码文件名。
+             * @param line 源代码行号。
+             * @param func 源代码函数名。
+             * @param msg 日志消息。
+             * @param fields 键值对，形如 "key1", value1, "key2", value2。
+             */
+            template <typename Msg, typename... Fields>
+            static void EncodeLine(std::string& out, KvFormat format, LogLevel level,
+                                   const char* file, int line, const char* func,
+                                   const Msg& msg, const Fields&... fields)
+            {
+                static_assert(sizeof...(Fields) % 2 == 0, "LSX_LOG_KV: keys and values must come in pairs");
+                BeginLine(out, format, level, file, line, func);
+                AppendField(out, format, "msg", msg);
+                AppendFields(out, format, fields...);
+                EndLine(out, format);
+            }
+
+            /**
+             * @brief 追加一个键值对。
+             *
+             * @param out 输出缓冲区（追加）。
+             * @param format 输出格式。
+             * @param key 键。
+             * @param value 值。
+             */
+            template <typename T>
+            static void AppendField(std::string& out, KvFormat format, const char* key, const T& value)
+            {
+                AppendKey(out, format, key);
+                AppendValue(out, format, value);
+            }
+
+        private:
+            static void AppendFields(std::string&, KvFormat) {}
+
+            template <typename V, typename... Rest>
+            static void AppendFields(std::string& out, KvFormat format, const char* key, const V& value,
+                                     const Rest&... rest)
+            {
+                AppendField(out, format, key, value);
+                AppendFields(out, format, rest...);
+            }
+
+            template <typename T>
+            static void AppendValue(std::string& out, KvFormat format, const T& value)
+            {
+                using D = typename std::decay<T>::type;
+                if constexpr (std::is_same<D, bool>::value) {
+                    AppendBool(out, value);
+                } else if constexpr (std::is_same<D, char>::value) {
+                    AppendString(out, format, std::string_view(&value, 1));
+                } else if constexpr (std::is_integral<D>::value && std::is_signed<D>::value) {
+                    AppendInt(out, static_cast<int64_t>(value));
+                } else if constexpr (std::is_integral<D>::value) {
+                    AppendUint(out, static_cast<uint64_t>(value));
+                } else if constexpr (std::is_enum<D>::value) {
+                    AppendValue(out, format, static_cast<typename std::underlying_type<D>::type>(value));
+                } else if constexpr (std::is_floating_point<D>::value) {
+                    AppendDouble(out, format, static_cast<double>(value));
+                } else if constexpr (std::is_same<D, const char*>::value || std::is_same<D, char*>::value) {
+                    AppendString(out, format, value != nullptr ? std::string_view(value) : std::string_view());
+                } else if constexpr (std::is_convertible<const T&, std::string_view>::value) {
+                    AppendString(out, format, std::string_view(value));
+                } else {
+                    static_assert(sizeof(T) == 0, "LSX_LOG_KV: unsupported field type");
+                }
+            }
+
+            static void BeginLine(std::string& out, KvFormat format, LogLevel level,
+                                  const char* file, int line, const char* func);
+            static void EndLine(std::string& out, KvFormat format);
+            static void AppendKey(std::string& out, KvFormat format, const char* key);
+            static void AppendBool(std::string& out, bool value);
+            static void AppendInt(std::string& out, int64_t value);
+            static void AppendUint(std::string& out, uint64_t value);
+            static void AppendDouble(std::string& out, KvFormat format, double value);
+            static void AppendString(std::string& out, KvFormat format, std::string_view value);
+        };
+
+    } // namespace Logger
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_LOGGER_LOG_KV_H
@@ -0,0 +1,228 @@
+/**
+ * @file LogMemoryStore.h
+ * @brief 数据传输工具库 - 内存中的近期日志存储与查询
+ * @details 定义了 LSX_LIB::Logger 命名空间下的 LogMemoryStore 类。
+ * 现场排查问题时在 flash 上 grep 日志文件既慢又会和应用抢占 I/O。
+ * LogMemoryStore 作为 Logger 的附加输出，在内存中以固定大小的块组成环形存储，保留最近 N 字节的日志记录；
+ * 每个块记录时间范围以及级别、分类位图，查询时可整块跳过不相关的数据。
+ * 查询通过原子发布的记录计数读取块内容，不会阻塞记录日志的线程；
+ * 查询接口可以通过 `RegisterLogStoreRoutes` 注册到 ConfigServer 的 HTTP 服务器。
+ * @author 连思鑫（liansixin）
+ * @date 2025年5月13日
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **环形存储**: 总内存固定为构造时指定的字节数，写满后整块淘汰最旧的记录。
+ * - **块索引**: 每个块维护最早/最晚时间戳、级别位图和分类位图，按时间、级别、分类过滤时直接跳过不匹配的块。
+ * - **多条件查询**: 支持时间范围、最低级别、分类、子串过滤，返回最新的若干条匹配记录。
+ * - **无阻塞查询**: 写入方只在封存块时短暂持有块列表锁；查询方只在复制块指针列表时持有该锁，扫描过程不加锁。
+ * - **HTTP 接口**: `RegisterLogStoreRoutes` 以 JSON 返回查询结果。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "Logger.h"
+ * #include "ConfigServer.h"
+ *
+ * LSX_LIB::Logger::Logger logger(LSX_LIB::Logger::LoggerConfig());
+ * auto store = std::make_shared<LSX_LIB::Logger::LogMemoryStore>(4 * 1024 * 1024); // 保留最近 4MB
+ * logger.SetMemoryStore(store);
+ *
+ * LSX_LIB::Logger::LogQuery query;
+ * query.minLevel = LSX_LIB::Logger::LogLevel::WARNING;
+ * query.contains = "timeout";
+ * for (const auto& record : store->Query(query)) {
+ * std::cout << record.text << std::endl;
+ * }
+ *
+ * LSX_LIB::Config::ConfigServer server("data.db");
+ * server.initialize();
+ * // GET /api/log/recent?level=WARNING&category=serial&q=timeout&since=1715570000000&limit=100
+ * LSX_LIB::Logger::RegisterLogStoreRoutes(server, store);
+ * server.run();
+ * @endcode
+ *
+ * ### 注意事项
+ * - **记录内容**: 存储的是写入 LogWriter 的完整格式化文本，子串匹配区分大小写。
+ * - **超长记录**: 单条记录超过块大小时会被截断为块大小。
+ * - **时间戳**: 使用写入存储时的系统时间（自 1970-01-01 起的毫秒数）。
+ * - **分类位图**: 前 63 个分类各占一位，之后的分类共用最后一位，只影响块级跳过的效率，不影响结果正确性。
+ */
+
+#ifndef LSX_LIB_LOGGER_LOG_MEMORY_STORE_H
+#define LSX_LIB_LOGGER_LOG_MEMORY_STORE_H
+#pragma once
+#include "LogCommon.h" // 包含日志通用定义 (LogLevel)
+#include "LogCategory.h" // 包含 LogCategoryRegistry::ParseLevel
+#include <string> // 包含 std::string
+#include <string_view> // 包含 std::string_view
+#include <vector> // 包含 std::vector
+#include <deque> // 包含 std::deque
+#include <map> // 包含 std::map
+#include <memory> // 包含 std::shared_ptr, std::unique_ptr
+#include <mutex> // 包含 std::mutex
+#include <atomic> // 包含 std::atomic
+#include <cstdint> // 包含 int64_t, uint64_t
+#include <cstdlib> // 包含 std::strtoll
+
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB {
+    /**
+     * @brief 日志相关的命名空间。
+     * 包含日志系统相关的类和工具。
+     */
+    namespace Logger {
+
+        /**
+         * @brief 日志查询条件。
+         */
+        struct LogQuery {
+            int64_t sinceMs = 0;                  // 起始时间（含），自 1970-01-01 起的毫秒数
+            int64_t untilMs = INT64_MAX;          // 结束时间（含）
+            LogLevel minLevel = LogLevel::DEBUG;  // 最低日志级别
+            std::string category;                 // 分类名称，为空表示不限；"-" 表示只查不带分类的记录
+            std::string contains;                 // 子串过滤，为空表示不限
+            size_t limit = 1000;                  // 最多返回的记录数（取最新的匹配记录）
+        };
+
+        /**
+         * @brief 查询返回的日志记录。
+         */
+        struct LogRecordView {
+            uint64_t seq;          // 记录序号，从 0 开始单调递增
+            int64_t timeMs;        // 写入时间，自 1970-01-01 起的毫秒数
+            LogLevel level;        // 日志级别
+            std::string category;  // 分类名称，无分类时为空
+            std::string text;      // 格式化后的日志文本
+        };
+
+        /**
+         * @brief 内存中的近期日志存储。
+         * Append 由 Logger 在输出锁内调用（多个线程直接调用时内部也会串行化）；Query 可在任意线程并发调用。
+         */
+        class LogMemoryStore {
+        public:
+            /**
+             * @brief 构造函数。
+             *
+             * @param capacityBytes 用于保存日志文本的总内存（字节），最少为一个块。
+             * @param blockBytes 单个块的文本容量（字节），默认 64KB。
+             */
+            explicit LogMemoryStore(size_t capacityBytes, size_t blockBytes = 64 * 1024);
+
+            LogMemoryStore(const LogMemoryStore&) = delete;
+            LogMemoryStore& operator=(const LogMemoryStore&) = delete;
+
+            /**
+             * @brief 追加一条日志记录。
+             *
+             * @param level 日志级别。
+             * @param category 分类名称，无分类时为空。
+             * @param text 格式化后的日志文本。
+             */
+            void Append(LogLevel level, std::string_view category, std::string_view text);
+
+            /**
+             * @brief 查询日志记录。
+             * 不阻塞 Append。
+             *
+             * @param query 查询条件。
+             * @return 按时间从旧到新排列的匹配记录，最多 query.limit 条（取最新的）。
+             */
+            std::vector<LogRecordView> Query(const LogQuery& query) const;
+
+            /**
+             * @brief 获取已写入的记录总数（含已淘汰的）。
+             *
+             * @return 记录总数。
+             */
+            uint64_t TotalRecords() const { return next_seq_.load(std::memory_order_acquire); }
+
+            /**
+             * @brief 将查询结果编码为 JSON。
+             * 格式为 `{"count":N,"records":[{"seq":..,"ts":..,"level":"INFO","category":"..","text":".."}]}`。
+             *
+             * @param records 查询结果。
+             * @return JSON 字符串。
+             */
+            static std::string ToJson(const std::vector<LogRecordView>& records);
+
+        private:
+            struct Entry {
+                uint64_t seq;
+                int64_t timeMs;
+                uint32_t offset;
+                uint32_t length;
+                uint16_t categoryId;
+                uint8_t level;
+            };
+
+            struct Block;
+
+            uint16_t CategoryId(std::string_view category);      // 调用方持有 append_mutex_
+            std::shared_ptr<Block> NewBlock() const;
+            void SealCurrent();                                   // 调用方持有 append_mutex_
+
+            const size_t block_bytes_;                            // 单块文本容量
+            const size_t block_entries_;                          // 单块记录容量
+            const size_t max_blocks_;                             // 最多保留的块数
+
+            std::mutex append_mutex_;                             // 串行化 Append
+            std::shared_ptr<Block> current_;                      // 当前写入的块 (受 blocks_mutex_ 保护发布)
+            mutable std::mutex blocks_mutex_;                     // 保护 sealed_ 和 current_ 指针
+            std::deque<std::shared_ptr<Block>> sealed_;           // 已封存的块，从旧到新
+            std::atomic<uint64_t> next_seq_{0};                   // 下一条记录的序号
+
+            mutable std::mutex category_mutex_;                   // 保护分类表
+            std::map<std::string, uint16_t, std::less<>> category_ids_; // 分类名称 -> 编号 (0 表示无分类)
+            std::vector<std::string> category_names_;             // 编号 -> 分类名称
+        };
+
+        /**
+         * @brief 在 HTTP 服务器上注册近期日志查询接口。
+         * `GET path` 支持的查询参数：since、until（毫秒时间戳）、level（最低级别名称）、
+         * category（分类，"-" 表示无分类）、q（子串）、limit（最多返回条数），返回 LogMemoryStore::ToJson 的结果。
+         *
+         * @tparam Server 提供 addCustomRoute(method, pattern, handler) 的服务器类型，通常为 ConfigServer。
+         * @param server 服务器实例。
+         * @param store 日志存储。
+         * @param path 路由路径，默认为 "/api/log/recent"。
+         */
+        template <typename Server>
+        void RegisterLogStoreRoutes(Server& server, std::shared_ptr<LogMemoryStore> store,
+                                    const std::string& path = "/api/log/recent")
+        {
+            server.addCustomRoute("GET", path, [store](const auto& req, auto& res) {
+                LogQuery query;
+                if (req.has_param("since")) {
+                    query.sinceMs = std::strtoll(req.get_param_value("since").c_str(), nullptr, 10);
+                }
+                if (req.has_param("until")) {
+                    query.untilMs = std::strtoll(req.get_param_value("until").c_str(), nullptr, 10);
+                }
+                if (req.has_param("limit")) {
+                    query.limit = static_cast<size_t>(std::strtoull(req.get_param_value("limit").c_str(), nullptr, 10));
+                }
+                if (req.has_param("level") && !LogCategoryRegistry::ParseLevel(req.get_param_value("level"), query.minLevel)) {
+                    res.status = 400;
+                    res.set_content("{\"message\":\"invalid level (DEBUG/INFO/WARNING/ERROR)\"}",
+                                    "application/json; charset=utf-8");
+                    return;
+                }
+                if (req.has_param("category")) {
+                    query.category = req.get_param_value("category");
+                }
+                if (req.has_param("q")) {
+                    query.contains = req.get_param_value("q");
+                }
+                res.set_content(LogMemoryStore::ToJson(store->Query(query)), "application/json; charset=utf-8");
+            });
+        }
+
+    } // namespace Logger
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_LOGGER_LOG_MEMORY_STORE_H
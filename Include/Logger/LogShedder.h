@@ -0,0 +1,175 @@
+/**
+ * @file LogShedder.h
+ * @brief 数据传输工具库 - 日志后端过载时的自适应降载
+ * @details 定义了 LSX_LIB::Logger 命名空间下的 LogShedder 类。
+ * 故障风暴期间日志量往往在系统最繁忙时激增，同步写入的 Logger 会因输出锁竞争和慢速 I/O 拖慢整个应用。
+ * LogShedder 由 Logger 内部使用：统计正在等待输出锁的线程数和 LogWriter::Write 耗时的滑动平均，
+ * 判定过载后丢弃低优先级分类的日志并对其他低级别日志采样，恢复正常后输出一条降载汇总。
+ * @author 连思鑫（liansixin）
+ * @date 2025年5月13日
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **过载检测**: 排队线程数达到 SheddingConfig::maxPendingWriters，或写入耗时滑动平均超过 maxWriteLatencyUs 即进入降载。
+ * - **分级处理**: 不低于 protectLevel 的日志始终保留；低优先级分类（LogCategoryRegistry::SetLowPriority）的其余日志全部丢弃；其他日志按 sampleEvery 采样。
+ * - **自动恢复**: 连续 recoverMs 毫秒未检测到过载后结束降载，并返回一条汇总文本供 Logger 输出。
+ * - **无锁判定**: 丢弃判定只读取原子变量，在格式化日志之前完成，被丢弃的日志几乎没有开销。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "Logger.h"
+ *
+ * LSX_LIB::Logger::LoggerConfig config;
+ * config.shedding.enabled = true;
+ * config.shedding.maxWriteLatencyUs = 1000; // 单次写入平均超过 1ms 视为过载
+ * LSX_LIB::Logger::Logger logger(config);
+ *
+ * LSX_LIB::Logger::LogCategoryRegistry::Instance().SetLowPriority("net", true); // 过载时优先丢弃网络模块日志
+ *
+ * auto stats = logger.GetSheddingStats();
+ * std::cout << "shedding=" << stats.shedding << " dropped=" << stats.droppedTotal << std::endl;
+ * @endcode
+ *
+ * ### 注意事项
+ * - **汇总输出**: 汇总在降载结束后的下一次日志写入或 Flush 时输出，级别为 WARNING，格式为
+ *   `Log shedding ended: dropped N records in T ms (DEBUG a, INFO b, WARNING c, ERROR d; low-priority categories e)`。
+ * - **采样计数**: 采样按线程计数，每个线程每 sampleEvery 条保留 1 条。
+ * - **运行时修改**: Configure 可随时调用，修改阈值不会清除已有的统计。
+ */
+
+#ifndef LSX_LIB_LOGGER_LOG_SHEDDER_H
+#define LSX_LIB_LOGGER_LOG_SHEDDER_H
+#pragma once
+#include "LogCommon.h" // 包含日志通用定义 (LogLevel, SheddingConfig)
+#include "LogCategory.h" // 包含 LogCategory 定义
+#include <string> // 包含 std::string
+#include <atomic> // 包含 std::atomic
+#include <chrono> // 包含 std::chrono::steady_clock
+#include <cstdint> // 包含 uint64_t, int64_t
+
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB {
+    /**
+     * @brief 日志相关的命名空间。
+     * 包含日志系统相关的类和工具。
+     */
+    namespace Logger {
+
+        /**
+         * @brief 降载统计信息。
+         */
+        struct SheddingStats {
+            bool shedding = false;           // 当前是否处于降载状态
+            uint64_t episodes = 0;           // 累计进入降载的次数
+            uint64_t droppedTotal = 0;       // 累计丢弃的日志条数
+            uint64_t droppedByLevel[4] = {}; // 按级别统计的累计丢弃条数 (下标为 LogLevel 的整数值)
+            uint64_t droppedLowPriority = 0; // 其中因属于低优先级分类而丢弃的条数
+            double avgWriteUs = 0.0;         // LogWriter::Write 耗时的滑动平均 (微秒)
+        };
+
+        /**
+         * @brief 日志自适应降载器。
+         * ShouldDrop 可在任意线程无锁调用；BeginWrite/EndWrite 由 Logger 在输出锁前后调用。
+         */
+        class LogShedder {
+        public:
+            LogShedder() = default;
+            LogShedder(const LogShedder&) = delete;
+            LogShedder& operator=(const LogShedder&) = delete;
+
+            /**
+             * @brief 修改降载配置。线程安全。
+             *
+             * @param config 新的配置。
+             */
+            void Configure(const SheddingConfig& config);
+
+            /**
+             * @brief 获取当前的降载配置。
+             *
+             * @return 当前配置。
+             */
+            SheddingConfig GetConfig() const;
+
+            /**
+             * @brief 判断一条日志是否应被丢弃。
+             * 未处于降载状态时只有一次原子读取。距最近一次过载已超过 recoverMs 时不再丢弃，
+             * 放行的日志经 EndWrite 结束降载并输出汇总，即使 sampleEvery 为 0 也能恢复。
+             *
+             * @param level 日志级别。
+             * @param category 日志分类，无分类时为 nullptr。
+             * @return 应丢弃返回 true（已计入统计）。
+             */
+            bool ShouldDrop(LogLevel level, const LogCategory* category)
+            {
+                if (!shedding_.load(std::memory_order_relaxed)) {
+                    return false;
+                }
+                return ShouldDropSlow(level, category);
+            }
+
+            /**
+             * @brief 在等待输出锁之前调用，登记一个排队的写入者。
+             *
+             * @return 本次是否被登记（降载未启用时返回 false），需原样传给 EndWrite。
+             */
+            bool BeginWrite();
+
+            /**
+             * @brief 在持有输出锁、完成写入后调用，更新过载状态。
+             *
+             * @param registered BeginWrite 的返回值。
+             * @param write_ns 本次 LogWriter::Write 的耗时（纳秒）。
+             * @return 降载刚刚结束时返回汇总文本，否则返回空字符串。
+             */
+            std::string EndWrite(bool registered, int64_t write_ns);
+
+            /**
+             * @brief 在持有输出锁时检查降载是否可以结束（用于 Flush 等不写日志的路径）。
+             *
+             * @return 降载刚刚结束时返回汇总文本，否则返回空字符串。
+             */
+            std::string Poll();
+
+            /**
+             * @brief 获取降载统计信息。
+             *
+             * @return 统计信息快照。
+             */
+            SheddingStats GetStats() const;
+
+        private:
+            bool ShouldDropSlow(LogLevel level, const LogCategory* category);
+            std::string UpdateState(bool overloaded);  // 调用方持有 Logger 输出锁
+            static int64_t NowMs();
+
+            // 配置 (原子变量，供 ShouldDrop 无锁读取)
+            std::atomic<bool> enabled_{false};
+            std::atomic<int> max_pending_{4};
+            std::atomic<int> max_latency_us_{2000};
+            std::atomic<int> protect_level_{static_cast<int>(LogLevel::WARNING)};
+            std::atomic<int> sample_every_{10};
+            std::atomic<int> recover_ms_{1000};
+
+            // 运行状态
+            std::atomic<bool> shedding_{false};         // 是否处于降载状态
+            std::atomic<int> pending_{0};               // 正在等待或持有输出锁的写入者数
+            std::atomic<double> avg_write_us_{0.0};     // 写入耗时滑动平均 (仅在输出锁内写入)
+            int64_t episode_start_ms_ = 0;              // 本次降载开始时间 (输出锁保护)
+            std::atomic<int64_t> last_overload_ms_{0};  // 最近一次检测到过载的时间 (输出锁内写入，ShouldDrop 读取)
+            uint64_t episode_base_[5] = {};             // 本次降载开始时的丢弃计数快照 (输出锁保护)
+
+            // 统计
+            std::atomic<uint64_t> episodes_{0};
+            std::atomic<uint64_t> dropped_[4] = {};     // 按级别的丢弃条数
+            std::atomic<uint64_t> dropped_low_priority_{0};
+        };
+
+    } // namespace Logger
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_LOGGER_LOG_SHEDDER_H
@@ -6,6 +6,7 @@
  * LogWriter 接口定义了日志输出的基本行为 (`Write`, 可选 `Flush`)。
  * ConsoleWriter 将格式化后的日志直接输出到标准输出。
  * FileWriter 将格式化后的日志写入指定文件，并支持基于行数的文件大小限制和轮转。
+ * RotatingFileWriter 追加写入活动文件，写满后切分为分段文件并交给 LogCompressor 在后台压缩和清理。
  * 这些输出器通常由 Logger 类内部使用，负责将最终的日志字符串发送到目标。
  * @author 连思鑫（liansixin）
  * @date 2025年5月13日
@@ -17,6 +18,7 @@
  * - **文件输出**: FileWriter 实现将日志写入文件，支持文件路径和最大行数配置。
  * - **文件轮转**: FileWriter 在达到最大行数时，会将当前文件内容清空（或进行更复杂的轮转逻辑，此处实现为清空）并重新开始写入。
  * - **刷新**: FileWriter 提供 Flush 方法，强制将缓冲区内容写入文件。
+ * - **分段轮转**: RotatingFileWriter 每写满 max_lines 行就关闭活动文件并重命名为分段，分段由后台线程压缩为 .gz，并受总大小上限约束。
  *
  * ### 使用示例
  *
@@ -69,6 +71,7 @@
  * - **线程安全**: LogWriter 接口本身不保证线程安全。具体的实现类（ConsoleWriter, FileWriter）需要在其 Write 方法内部处理线程安全问题。在 FileWriter 中，对文件流和行缓冲区的并发访问需要保护（虽然 Logger 类通常会提供外部锁）。
  * - **文件轮转实现**: 示例代码中的 FileWriter 使用 std::deque 作为行缓冲区，并在达到最大行数时调用 `RotateLogs`。`RotateLogs` 的具体实现（如清空文件、重命名旧文件等）决定了日志轮转的行为。当前示例注释中描述的是清空文件。
  * - **Flush**: Flush 方法对于文件输出很重要，确保缓冲的数据被写入磁盘。在程序正常退出前或重要事件后应考虑调用。
+ * - **FileWriter 与 RotatingFileWriter**: FileWriter 每次写入都会重写整个文件，只适合很小的 max_lines；需要保留较多历史日志时应使用 RotatingFileWriter（LoggerConfig::rotate = true）。
  */
 
 #ifndef LSX_LIB_LOGGER_LOG_WRITER_H
@@ -81,6 +84,9 @@
 #include <deque>
 #include <mutex>
 #include <utility>
+#include <memory>
+#include <cstdint>
+#include "LogCompressor.h"
 
 
 /**
@@ -214,6 +220,62 @@ namespace LSX_LIB {
             void RotateLogs(); // 将缓冲区内容写入文件
         };
 
+        /**
+         * @brief 分段轮转文件日志输出器。
+         * 日志追加写入活动文件，活动文件写满 max_lines 行后关闭并重命名为
+         * `<filepath>.<YYYYmmdd-HHMMSS>.<序号>` 分段，交给 LogCompressor 在后台压缩和执行磁盘配额。
+         * 记录日志的线程只做追加写入和一次重命名，不参与压缩。
+         */
+        class RotatingFileWriter : public LogWriter {
+        public:
+            /**
+             * @brief 构造函数。
+             * 以追加模式打开活动文件（已有内容计入当前分段行数），并启动后台压缩器。
+             *
+             * @param filepath 活动日志文件的路径。
+             * @param max_lines 每个分段的最大行数。
+             * @param compress 是否在后台将分段压缩为 .gz。
+             * @param max_total_bytes 所有分段的总大小上限（字节），0 表示不限制。
+             */
+            RotatingFileWriter(const std::string& filepath, int max_lines, bool compress, uint64_t max_total_bytes);
+            /**
+             * @brief 析构函数。
+             * 刷新并关闭活动文件，停止后台压缩器（未压缩的分段下次启动时补压）。
+             */
+            ~RotatingFileWriter() override;
+            /**
+             * @brief 追加写入一行日志，写满时切分分段。
+             *
+             * @param text 格式化后的日志文本字符串。
+             */
+            void Write(const std::string& text) override;
+            /**
+             * @brief 刷新活动文件。
+             */
+            void Flush() override;
+        private:
+            /**
+             * @brief 打开活动文件并统计已有行数。
+             */
+            void OpenFile();
+            /**
+             * @brief 关闭活动文件，重命名为分段并提交给压缩器，然后重新打开新的活动文件。
+             */
+            void Rotate();
+            /**
+             * @brief 生成新的分段文件路径。
+             */
+            std::string NextSegmentPath();
+
+            std::string filepath_;                      // 活动日志文件路径
+            int max_lines_;                             // 每个分段的最大行数
+            int line_count_ = 0;                        // 当前活动文件中的行数
+            std::ofstream file_stream_;                 // 活动文件输出流
+            std::string last_stamp_;                    // 上一个分段的时间戳
+            int stamp_seq_ = 0;                         // 同一秒内的分段序号
+            std::unique_ptr<LogCompressor> compressor_; // 后台压缩器
+        };
+
     } // namespace Logger
 } // namespace LSX_LIB
 
@@ -19,6 +19,10 @@
  * - **动态配置**: 支持在运行时更改日志级别和输出模式。
  * - **线程安全**: 使用互斥锁和原子变量保护内部状态和输出操作。
  * - **日志宏**: 提供方便的宏简化日志记录调用。
+ * - **日志分类**: `LSX_LOG_CAT_*` 宏按模块分类记录日志，每个分类拥有独立的运行时级别（见 LogCategory.h）。
+ * - **结构化日志**: `LSX_LOG_KV` 宏将类型化的键值字段编码为 JSON Lines 或 logfmt（见 LogKv.h）。
+ * - **近期日志存储**: 可附加 LogMemoryStore，在内存中保留最近的日志并支持查询（见 LogMemoryStore.h）。
+ * - **自适应降载**: 启用 SheddingConfig 后，输出跟不上时丢弃低优先级日志并在恢复后输出汇总（见 LogShedder.h）。
  *
  * ### 使用示例
  *
@@ -112,6 +116,11 @@
 #include "LogCommon.h" // 包含日志通用定义 (LogLevel, OutputMode, LoggerConfig)
 #include "LogFormatter.h" // 包含 LogFormatter 类定义
 #include "LogWriter.h" // 包含 LogWriter 类定义
+#include "LogCategory.h" // 包含 LogCategory 日志分类定义
+#include "LogKv.h" // 包含 KvEncoder 键值日志编码器
+#include "LogMemoryStore.h" // 包含 LogMemoryStore 近期日志存储
+#include "LogShedder.h" // 包含 LogShedder 自适应降载
+#include <string_view> // 包含 std::string_view
 #include <string> // 包含 std::string
 #include <memory> // 包含 std::unique_ptr
 #include <mutex> // 包含 std::mutex, std::lock_guard
@@ -191,6 +200,80 @@ namespace LSX_LIB {
                      int line,
                      const char* func);
 
+            /**
+             * @brief 按分类记录日志。
+             * 只根据分类的级别过滤，不检查 Logger 的全局级别；分类名称会加在消息前面，格式为 `[分类] 消息`。
+             * 通常通过 `LSX_LOG_CAT_*` 宏调用，宏已在调用点完成级别检查。
+             * 此方法是线程安全的。
+             *
+             * @param category 日志分类。
+             * @param msg_level 此条消息的日志级别。
+             * @param msg 日志消息体字符串。
+             * @param file 源代码文件名 (通常使用 __FILE__ 宏)。
+             * @param line 源代码行号 (通常使用 __LINE__ 宏)。
+             * @param func 源代码函数名 (通常使用 __func__ 或 __FUNCTION__ 宏)。
+             */
+            void Log(const LogCategory& category,
+                     LogLevel msg_level,
+                     const std::string& msg,
+                     const char* file,
+                     int line,
+                     const char* func);
+
+            /**
+             * @brief 记录结构化键值日志。
+             * 在当前线程复用的缓冲区中按 GetKvFormat() 的格式编码整行，不为每个字段构造临时字符串。
+             * 通常通过 `LSX_LOG_KV` 宏调用。此方法是线程安全的。
+             *
+             * @param msg_level 此条消息的日志级别。
+             * @param file 源代码文件名 (通常使用 __FILE__ 宏)。
+             * @param line 源代码行号 (通常使用 __LINE__ 宏)。
+             * @param func 源代码函数名 (通常使用 __func__ 宏)。
+             * @param msg 日志消息。
+             * @param fields 键值对，形如 "key1", value1, "key2", value2。
+             */
+            template <typename Msg, typename... Fields>
+            void LogKv(LogLevel msg_level,
+                       const char* file,
+                       int line,
+                       const char* func,
+                       const Msg& msg,
+                       const Fields&... fields)
+            {
+                if (!IsEnabled(msg_level) || shedder_.ShouldDrop(msg_level, nullptr)) {
+                    return;
+                }
+                std::string& buffer = KvEncoder::ThreadBuffer();
+                KvEncoder::EncodeLine(buffer, kv_format_.load(std::memory_order_relaxed), msg_level,
+                                      file, line, func, msg, fields...);
+                WriteLine(msg_level, std::string_view(), buffer);
+            }
+
+            /**
+             * @brief 判断指定级别的消息是否会被输出（按全局日志级别）。
+             *
+             * @param msg_level 消息的日志级别。
+             * @return 消息级别不低于当前日志级别时返回 true。
+             */
+            bool IsEnabled(LogLevel msg_level) const
+            {
+                return msg_level >= current_log_level_.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief 动态设置结构化键值日志的输出格式。
+             *
+             * @param format 新的输出格式 (Json 或 Logfmt)。
+             */
+            void SetKvFormat(KvFormat format);
+
+            /**
+             * @brief 获取结构化键值日志的输出格式。
+             *
+             * @return 当前的输出格式。
+             */
+            KvFormat GetKvFormat() const;
+
             /**
              * @brief 动态设置日志输出模式。
              * 切换日志消息的输出目标。如果模式发生变化，会创建新的 LogWriter 实例并替换当前的。
@@ -231,13 +314,59 @@ namespace LSX_LIB {
              */
             void Flush();
 
+            /**
+             * @brief 设置近期日志存储。
+             * 设置后每条输出的日志在写入 LogWriter 的同时追加到该存储，传入空指针则取消。
+             * 此方法是线程安全的。
+             *
+             * @param store 日志存储，可与 RegisterLogStoreRoutes 共享同一实例。
+             */
+            void SetMemoryStore(std::shared_ptr<LogMemoryStore> store);
+
+            /**
+             * @brief 动态修改自适应降载配置。
+             * 此方法是线程安全的。
+             *
+             * @param config 新的降载配置，enabled 为 false 时立即停止丢弃。
+             */
+            void SetShedding(const SheddingConfig& config);
+
+            /**
+             * @brief 获取自适应降载的统计信息。
+             *
+             * @return 统计信息快照。
+             */
+            SheddingStats GetSheddingStats() const;
+
 
         private:
+            /**
+             * @brief 格式化并输出一条已通过级别过滤的日志。
+             */
+            void Write(LogLevel msg_level,
+                       std::string_view category,
+                       const std::string& msg,
+                       const char* file,
+                       int line,
+                       const char* func);
+            /**
+             * @brief 将一行已格式化的日志交给当前 LogWriter 输出，并追加到近期日志存储。
+             */
+            void WriteLine(LogLevel msg_level, std::string_view category, const std::string& formatted_msg);
+            /**
+             * @brief 以 WARNING 级别输出降载汇总，调用方持有 writer_mutex_。
+             */
+            void WriteSummaryLocked(const std::string& summary);
+
             /**
              * @brief 当前日志记录级别。
              * 原子变量，用于线程安全地读取和修改当前的日志过滤级别。
              */
             std::atomic<LogLevel> current_log_level_; // 当前日志记录级别
+            /**
+             * @brief 结构化键值日志的输出格式。
+             */
+            std::atomic<KvFormat> kv_format_;         // 键值日志输出格式
             /**
              * @brief 日志格式化器实例。
              * 用于将日志消息格式化为字符串。
@@ -253,6 +382,16 @@ namespace LSX_LIB {
              * 用于保护 writer_ 的创建/切换以及对 LogWriter 实例的写入操作，确保线程安全。
              */
             mutable std::mutex writer_mutex_;         //保护 writer_ 的创建/切换以及写入操作
+            /**
+             * @brief 近期日志存储 (可选)。
+             * 受 writer_mutex_ 保护。
+             */
+            std::shared_ptr<LogMemoryStore> memory_store_;
+            /**
+             * @brief 自适应降载器。
+             * 在格式化之前判定是否丢弃，并根据输出锁的排队情况和写入耗时检测过载。
+             */
+            LogShedder shedder_;
 
             // 从初始配置中保存的文件相关设置，用于在切换到文件模式时使用
             /**
@@ -265,6 +404,13 @@ namespace LSX_LIB {
              * 从初始 LoggerConfig 中保存，用于在文件输出模式下控制文件大小。
              */
             int config_max_lines_;
+            /**
+             * @brief 配置的分段轮转参数。
+             * 从初始 LoggerConfig 中保存，为 true 时文件输出使用 RotatingFileWriter。
+             */
+            bool config_rotate_;
+            bool config_compress_rotated_;
+            uint64_t config_max_total_bytes_;
             /**
              * @brief 追踪当前输出模式。
              * 用于判断是否需要切换 LogWriter 实例。
@@ -325,6 +471,67 @@ namespace LSX_LIB {
 #define LSX_LOG_ERROR(logger_instance, message) \
             LSX_LOG_COMMON(logger_instance, LSX_LIB::Logger::LogLevel::ERROR, message)
 
+        /**
+         * @brief 结构化键值日志宏。
+         * level 为 LogLevel 的枚举名 (DEBUG/INFO/WARNING/ERROR)，其后是消息和成对的键值字段。
+         * 级别被过滤时字段表达式不会被求值。
+         *
+         * 示例：`LSX_LOG_KV(logger, INFO, "frame sent", "fd", fd, "bytes", n);`
+         *
+         * @param logger_instance Logger 类的实例。
+         * @param level 日志级别的枚举名。
+         * @param ... 消息，以及 "key", value 形式的字段。
+         */
+#define LSX_LOG_KV(logger_instance, level, ...) \
+            do { \
+                if ((logger_instance).IsEnabled(LSX_LIB::Logger::LogLevel::level)) { \
+                    (logger_instance).LogKv(LSX_LIB::Logger::LogLevel::level, __FILE__, __LINE__, __func__, __VA_ARGS__); \
+                } \
+            } while (0)
+
+        /**
+         * @brief 按分类记录日志的通用宏。
+         * 分类引用以函数内静态变量缓存在调用点，只在首次执行时查询注册表；
+         * 此后每次调用只做一次 relaxed 原子读取，分类被禁用时 message 表达式不会被求值。
+         *
+         * @param logger_instance Logger 类的实例。
+         * @param category 分类名称 (字符串常量，例如 "serial")。
+         * @param level 日志级别 (LogLevel 枚举值)。
+         * @param message 日志消息体字符串。
+         */
+#define LSX_LOG_CAT(logger_instance, category, level, message) \
+            do { \
+                static LSX_LIB::Logger::LogCategory& lsx_log_category_ = \
+                    LSX_LIB::Logger::LogCategoryRegistry::Instance().Get(category); \
+                if (lsx_log_category_.IsEnabled(level)) { \
+                    (logger_instance).Log(lsx_log_category_, (level), (message), __FILE__, __LINE__, __func__); \
+                } \
+            } while (0)
+
+        /**
+         * @brief 按分类记录 DEBUG 级别日志的宏。
+         */
+#define LSX_LOG_CAT_DEBUG(logger_instance, category, message) \
+            LSX_LOG_CAT(logger_instance, category, LSX_LIB::Logger::LogLevel::DEBUG, message)
+
+        /**
+         * @brief 按分类记录 INFO 级别日志的宏。
+         */
+#define LSX_LOG_CAT_INFO(logger_instance, category, message) \
+            LSX_LOG_CAT(logger_instance, category, LSX_LIB::Logger::LogLevel::INFO, message)
+
+        /**
+         * @brief 按分类记录 WARNING 级别日志的宏。
+         */
+#define LSX_LOG_CAT_WARNING(logger_instance, category, message) \
+            LSX_LOG_CAT(logger_instance, category, LSX_LIB::Logger::LogLevel::WARNING, message)
+
+        /**
+         * @brief 按分类记录 ERROR 级别日志的宏。
+         */
+#define LSX_LOG_CAT_ERROR(logger_instance, category, message) \
+            LSX_LOG_CAT(logger_instance, category, LSX_LIB::Logger::LogLevel::ERROR, message)
+
 
     } // namespace Logger
 } // namespace LSX_LIB
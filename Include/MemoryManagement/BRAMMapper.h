@@ -21,11 +21,9 @@
             // 创建 BRAMMapper 实例
             BRAMMapper bram(physicalAddress, mapSize);
 
-            // 读取 12800 字节的数据
+            // 一次性读取 12800 字节的数据（按对齐的 32 位字访问，只加锁一次）
             std::vector<uint8_t> data(mapSize);
-            for (size_t offset = 0; offset < mapSize; ++offset) {
-                data[offset] = bram.read<uint8_t>(offset);
-            }
+            bram.readBlock(0, data.data(), data.size());
 
             // 打印部分数据以验证
             for (size_t i = 0; i < 16; ++i) { // 只打印前 16 字节
@@ -50,6 +48,7 @@
 #include <sys/mman.h>
 #include <stdexcept>
 #include <cstdint>
+#include <cstring>
 #include <mutex>
 /**
  * @brief LSX 库的根命名空间。
@@ -116,6 +115,73 @@ namespace LSX_LIB::Memory {
             *reinterpret_cast<volatile T *>(static_cast<uint8_t *>(mappedBase_) + offset) = value;
         }
 
+        /**
+         * @brief 将一段连续区域整块复制到调用者缓冲区（线程安全）。
+         *
+         * 只加锁一次，中间部分按对齐的 32 位字读取，首尾不对齐的部分按字节读取，
+         * 适合把整块采样数据读出后交给 SampleDecode 解码。
+         *
+         * @param offset 读取的起始偏移位置。
+         * @param dst 目标缓冲区，至少 size 字节。
+         * @param size 读取的字节数。
+         *
+         * @throws std::out_of_range 如果区域超出映射范围。
+         */
+        void readBlock(size_t offset, void *dst, size_t size) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            validateRange(offset, size);
+            const volatile uint8_t *src = static_cast<volatile uint8_t *>(mappedBase_) + offset;
+            uint8_t *out = static_cast<uint8_t *>(dst);
+            // Leading bytes up to the first word boundary
+            while (size > 0 && (reinterpret_cast<uintptr_t>(src) & (sizeof(uint32_t) - 1)) != 0) {
+                *out++ = *src++;
+                --size;
+            }
+            for (; size >= sizeof(uint32_t); size -= sizeof(uint32_t)) {
+                const uint32_t word = *reinterpret_cast<const volatile uint32_t *>(src);
+                std::memcpy(out, &word, sizeof(word));
+                src += sizeof(uint32_t);
+                out += sizeof(uint32_t);
+            }
+            while (size > 0) {
+                *out++ = *src++;
+                --size;
+            }
+        }
+
+        /**
+         * @brief 将调用者缓冲区整块写入指定区域（线程安全）。
+         *
+         * 访问方式与 readBlock 相同：中间部分按对齐的 32 位字写入，首尾按字节写入。
+         *
+         * @param offset 写入的起始偏移位置。
+         * @param src 源缓冲区，至少 size 字节。
+         * @param size 写入的字节数。
+         *
+         * @throws std::out_of_range 如果区域超出映射范围。
+         */
+        void writeBlock(size_t offset, const void *src, size_t size) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            validateRange(offset, size);
+            volatile uint8_t *dst = static_cast<volatile uint8_t *>(mappedBase_) + offset;
+            const uint8_t *in = static_cast<const uint8_t *>(src);
+            while (size > 0 && (reinterpret_cast<uintptr_t>(dst) & (sizeof(uint32_t) - 1)) != 0) {
+                *dst++ = *in++;
+                --size;
+            }
+            for (; size >= sizeof(uint32_t); size -= sizeof(uint32_t)) {
+                uint32_t word;
+                std::memcpy(&word, in, sizeof(word));
+                *reinterpret_cast<volatile uint32_t *>(dst) = word;
+                dst += sizeof(uint32_t);
+                in += sizeof(uint32_t);
+            }
+            while (size > 0) {
+                *dst++ = *in++;
+                --size;
+            }
+        }
+
     private:
         off_t physicalAddress_; // 物理地址
         size_t mapSize_; // 映射大小
@@ -199,6 +265,20 @@ namespace LSX_LIB::Memory {
                 throw std::out_of_range("Offset out of range");
             }
         }
+
+        /**
+         * @brief 验证一段区域是否超出映射区域。
+         *
+         * @param offset 起始偏移位置。
+         * @param size 区域字节数。
+         *
+         * @throws std::out_of_range 如果区域超出映射区域。
+         */
+        void validateRange(size_t offset, size_t size) const {
+            if (offset > mapSize_ || size > mapSize_ - offset) {
+                throw std::out_of_range("Offset out of range");
+            }
+        }
     };
 }
 
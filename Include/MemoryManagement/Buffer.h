@@ -18,6 +18,7 @@
  * - **状态查询**: 提供 `GetSize`, `IsEmpty`, `Capacity` 方法查询缓冲区状态。
  * - **数据指针访问**: `GetData` 方法提供对底层数据指针的访问。
  * - **资源管理**: RAII 模式，`std::vector` 自动管理内存。
+ * - **字节查找**: `FindByte`/`FindPattern` 在锁内直接对底层数据做 SIMD 查找（见 ByteSearch.h），`ReadUntil` 从指定偏移读取到分隔符为止。
  *
  * ### 使用示例
  *
@@ -78,6 +79,13 @@
  * t.join();
  * }
  *
+ * // 查找分隔符
+ * shared_buffer.WriteAt(20, reinterpret_cast<const uint8_t*>("AT+OK\r\n"), 7);
+ * if (auto pos = shared_buffer.FindByte('\n', 20)) {
+ * std::cout << "换行符位于偏移 " << *pos << std::endl;
+ * }
+ * auto line = shared_buffer.ReadUntil(20, '\n'); // 读取 "AT+OK\r\n"
+ *
  * // 调整缓冲区大小
  * shared_buffer.Resize(50);
  * std::cout << "Buffer resized to: " << shared_buffer.GetSize() << std::endl;
@@ -105,8 +113,10 @@
 #include "GlobalErrorMutex.h"
 // 包含 LSX_LIB::LockManager::LockGuard 头文件
 #include "LockGuard.h"
+#include "MemoryTracker.h" // For optional memory accounting (TrackingAllocator)
 #include <vector> // For std::vector
 #include <cstdint> // For uint8_t
+#include <optional> // For std::optional (C++17)
 #include <stdexcept> // For exceptions like bad_alloc, out_of_range
 #include <mutex>    // For thread safety (std::mutex, std::lock_guard)
 #include <algorithm> // For std::min, std::fill
@@ -132,7 +142,7 @@
              * @brief 存储缓冲区数据的底层 vector。
              * 包含实际的字节数据。
              */
-            std::vector<uint8_t> data_vector_;
+            std::vector<uint8_t, TrackingAllocator<uint8_t>> data_vector_;
             /**
              * @brief 互斥锁。
              * 用于保护 data_vector_ 的并发访问，确保线程安全。
@@ -153,6 +163,14 @@
              * @param size 缓冲区的初始大小（字节）。
              */
             Buffer(size_t size); // Buffer with initial size
+            /**
+             * @brief 构造函数，启用内存统计。
+             * 创建一个指定初始大小的缓冲区，底层存储的占用计入 memory_tag，参见 MemoryTracker。
+             *
+             * @param size 缓冲区的初始大小（字节）。
+             * @param memory_tag 内存统计标签，为 nullptr 时不统计。
+             */
+            Buffer(size_t size, MemoryTag* memory_tag);
             /**
              * @brief 析构函数。
              * 默认析构函数，由 std::vector 自动管理内存释放。
@@ -275,6 +293,54 @@
             std::vector<uint8_t> ReadAt(size_t offset, size_t size) const;
 
 
+            // --- Search Functions ---
+            /**
+             * @brief 从指定偏移开始查找字节。
+             * 直接在底层数据上使用 SIMD 查找，不复制数据。
+             *
+             * @param value 要查找的字节值。
+             * @param offset 开始查找的偏移量。
+             * @return 第一个匹配字节在缓冲区中的偏移；未找到或 offset 越界时返回 std::nullopt。
+             */
+            std::optional<size_t> FindByte(uint8_t value, size_t offset = 0) const;
+
+            /**
+             * @brief 从指定偏移开始查找字节序列。
+             * 直接在底层数据上使用 SIMD 查找，不复制数据。
+             *
+             * @param pattern 指向要查找的字节序列。
+             * @param pattern_size 字节序列的长度。
+             * @param offset 开始查找的偏移量。
+             * @return 第一次匹配起始位置在缓冲区中的偏移；未找到、参数无效或 offset 越界时返回 std::nullopt。
+             */
+            std::optional<size_t> FindPattern(const uint8_t* pattern, size_t pattern_size, size_t offset = 0) const;
+            /**
+             * @brief 从指定偏移开始查找字节序列。
+             * 便利方法，参见 FindPattern(const uint8_t*, size_t, size_t)。
+             */
+            std::optional<size_t> FindPattern(const std::vector<uint8_t>& pattern, size_t offset = 0) const;
+
+            /**
+             * @brief 从指定偏移读取数据，直到遇到 delimiter（含）。
+             * 如果在 [offset, offset + size) 范围内找到 delimiter，则复制这一段到 buffer。
+             *
+             * @param offset 读取的起始偏移量。
+             * @param delimiter 分隔符。
+             * @param buffer 指向用于存储数据的缓冲区。
+             * @param size buffer 的大小。
+             * @return 复制的字节数（包含分隔符）；未在 size 字节内找到分隔符或参数无效时返回 0。
+             */
+            size_t ReadUntil(size_t offset, uint8_t delimiter, uint8_t* buffer, size_t size) const;
+            /**
+             * @brief 从指定偏移读取数据，直到遇到 delimiter（含），并返回其拷贝。
+             *
+             * @param offset 读取的起始偏移量。
+             * @param delimiter 分隔符。
+             * @return 包含数据（含分隔符）的 std::vector；未找到分隔符或 offset 越界时返回 std::nullopt。
+             */
+            std::optional<std::vector<uint8_t>> ReadUntil(size_t offset, uint8_t delimiter) const;
+
+
             // --- Status Functions ---
             /**
              * @brief 获取缓冲区的当前大小。
@@ -0,0 +1,110 @@
+/**
+ * @file ByteSearch.h
+ * @brief 向量化字节/模式查找工具
+ * @details 定义了 LSX_LIB::Memory::ByteSearch 命名空间下的字节查找函数，
+ * 用于在一段连续内存中查找单个字节或一个字节序列（模式）。
+ * 实现根据编译目标自动选择 AVX2 / SSE2 (x86) 或 NEON (ARM) 指令集，
+ * 不支持 SIMD 的平台回退到标量实现 (memchr / memcmp)。
+ * 这些函数是 Pipe::FindByte / Pipe::ReadUntil、Buffer::FindByte 等接口的底层实现，
+ * 也可直接用于 BRAMMapper、SharedMemory 等返回裸指针的内存区域。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **FindByte**: 查找第一个等于给定值的字节，每次比较 16 (SSE2/NEON) 或 32 (AVX2) 字节。
+ * - **FindPattern**: 查找第一次出现的字节序列。先用 SIMD 同时匹配模式的首字节和尾字节筛选候选位置，再用 memcmp 校验。
+ * - **零拷贝**: 直接在调用者提供的内存上查找，不做任何复制。
+ * - **指令集选择**: 编译期根据 `__AVX2__` / `__SSE2__` / `__ARM_NEON` 选择实现，可通过 `ActiveInstructionSet()` 查询。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "ByteSearch.h"
+ * #include <cstring>
+ * #include <iostream>
+ *
+ * int main() {
+ * const char* nmea = "$GPGGA,123519,4807.038,N*47\r\n$GPRMC,...";
+ * const uint8_t* data = reinterpret_cast<const uint8_t*>(nmea);
+ * size_t size = std::strlen(nmea);
+ *
+ * // 查找第一个换行符
+ * const uint8_t* lf = LSX_LIB::Memory::ByteSearch::FindByte(data, size, '\n');
+ * if (lf != nullptr) {
+ * std::cout << "第一帧长度: " << (lf - data + 1) << std::endl;
+ * }
+ *
+ * // 查找 "\r\n" 模式
+ * const uint8_t crlf[] = {'\r', '\n'};
+ * const uint8_t* pos = LSX_LIB::Memory::ByteSearch::FindPattern(data, size, crlf, sizeof(crlf));
+ * if (pos != nullptr) {
+ * std::cout << "CRLF 偏移: " << (pos - data) << std::endl;
+ * }
+ *
+ * std::cout << "指令集: " << LSX_LIB::Memory::ByteSearch::ActiveInstructionSet() << std::endl;
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **无状态**: 所有函数都是无状态的纯函数，可在任意线程中并发调用；调用者负责保证查找期间内存不被修改。
+ * - **不越界读取**: 向量化循环只处理完整的 16/32 字节块，剩余的尾部字节使用标量方式处理，不会读取 `size` 之外的内存。
+ * - **空输入**: `size` 为 0、`data` 为空指针、或 `pattern_size` 为 0 / 大于 `size` 时返回 nullptr。
+ */
+
+#ifndef LSX_LIB_MEMORY_BYTE_SEARCH_H
+#define LSX_LIB_MEMORY_BYTE_SEARCH_H
+#pragma once
+#include <cstddef> // For size_t
+#include <cstdint> // For uint8_t
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB {
+    /**
+     * @brief 内存管理相关的命名空间。
+     * 包含内存缓冲区和相关工具。
+     */
+    namespace Memory {
+        /**
+         * @brief 向量化字节查找函数的命名空间。
+         */
+        namespace ByteSearch {
+
+            /**
+             * @brief 在内存区域中查找第一个等于 value 的字节。
+             *
+             * @param data 指向待查找内存区域的起始地址。
+             * @param size 内存区域的字节数。
+             * @param value 要查找的字节值。
+             * @return 指向第一个匹配字节的指针；未找到或参数无效时返回 nullptr。
+             */
+            const uint8_t* FindByte(const uint8_t* data, size_t size, uint8_t value);
+
+            /**
+             * @brief 在内存区域中查找第一次出现的字节序列。
+             * 模式长度为 1 时等价于 FindByte。
+             *
+             * @param data 指向待查找内存区域的起始地址。
+             * @param size 内存区域的字节数。
+             * @param pattern 指向要查找的字节序列。
+             * @param pattern_size 字节序列的长度。
+             * @return 指向第一次匹配起始位置的指针；未找到或参数无效时返回 nullptr。
+             */
+            const uint8_t* FindPattern(const uint8_t* data, size_t size,
+                                       const uint8_t* pattern, size_t pattern_size);
+
+            /**
+             * @brief 获取当前编译所使用的指令集名称。
+             *
+             * @return "AVX2"、"SSE2"、"NEON" 或 "Scalar"。
+             */
+            const char* ActiveInstructionSet();
+
+        } // namespace ByteSearch
+    } // namespace Memory
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_MEMORY_BYTE_SEARCH_H
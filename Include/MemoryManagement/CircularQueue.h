@@ -19,6 +19,7 @@
  * - **线程安全**: 使用内部互斥锁 (`std::mutex`) 保护对队列状态和底层缓冲区的并发访问。
  * - **状态查询**: 提供 `IsEmpty`, `IsFull`, `Size`, `Capacity` 方法查询队列状态和属性。
  * - **Peek 操作**: 支持查看队列头部的元素而不将其移除。
+ * - **事件循环集成**: `EnableNotification()` 后 `NativeHandle()` 返回一个在队列非空时可读的描述符，可与套接字一起加入 epoll/poll，参见 ReadyNotifier.h。
  * - **资源管理**: RAII 模式，`std::vector` 自动管理底层内存。
  *
  * ### 使用示例
@@ -112,6 +113,7 @@
 #include "GlobalErrorMutex.h"
 // 包含 LSX_LIB::LockManager::LockGuard 头文件
 #include "LockGuard.h"
+#include "ReadyNotifier.h" // For pollable readiness notification
 #include <vector> // For std::vector
 #include <optional> // For std::optional (C++17)
 #include <stdexcept> // For exceptions (std::invalid_argument, std::out_of_range)
@@ -174,6 +176,10 @@ namespace LSX_LIB {
              * 用于保护队列的状态变量 (head_, tail_, current_size_) 和底层缓冲区 (data_vector_) 的并发访问。
              */
             mutable std::mutex mutex_; // Thread safety mutex
+            /**
+             * @brief 可选的就绪通知描述符，队列中有元素时可读。
+             */
+            ReadyNotifier notifier_;
             // std::condition_variable cv_read_; // For potential blocking operations (commented out in provided code)
             // std::condition_variable cv_write_; // For potential blocking operations (commented out in provided code)
 
@@ -229,6 +235,7 @@ namespace LSX_LIB {
                 head_ = 0;
                 tail_ = 0;
                 current_size_ = 0;
+                notifier_.Reset();
                 // Data is not erased from vector, just logically reset pointers
                 // std::cout << "CircularQueue: Cleared." << std::endl; // Use logging
                 // cv_write_.notify_all(); // Notify potential waiting writers (if blocking was enabled)
@@ -248,13 +255,14 @@ namespace LSX_LIB {
             // Returns true on success, false if full
             bool Enqueue(const T& value) {
                 std::lock_guard<std::mutex> lock(mutex_); // Thread safe enqueue
-                if (IsFull()) {
+                if (current_size_ == capacity_ - 1) { // Full (IsFull() would re-lock mutex_)
                     // std::cout << "CircularQueue: Queue is full, cannot enqueue." << std::endl; // Use logging
                     return false;
                 }
                 data_vector_[tail_] = value; // Copy assignment
                 tail_ = (tail_ + 1) % capacity_;
                 current_size_++;
+                notifier_.Signal(); // No syscall unless the queue was empty
                 // std::cout << "CircularQueue: Enqueued value." << std::endl; // Use logging
                 // cv_read_.notify_one(); // Notify potential waiting readers (if blocking was enabled)
                 return true;
@@ -281,13 +289,16 @@ namespace LSX_LIB {
             // Remove and return the element from the front (Dequeue / Get)
             std::optional<T> Dequeue() {
                 std::lock_guard<std::mutex> lock(mutex_); // Thread safe dequeue
-                if (IsEmpty()) {
+                if (current_size_ == 0) { // Empty (IsEmpty() would re-lock mutex_)
                     // std::cout << "CircularQueue: Queue is empty, cannot dequeue." << std::endl; // Use logging
                     return std::nullopt; // Use std::optional
                 }
                 T value = std::move(data_vector_[head_]); // Use move to potentially improve performance
                 head_ = (head_ + 1) % capacity_;
                 current_size_--;
+                if (current_size_ == 0) {
+                    notifier_.Reset(); // Drained: descriptor no longer readable
+                }
                 // std::cout << "CircularQueue: Dequeued value." << std::endl; // Use logging
                 // cv_write_.notify_one(); // Notify potential waiting writers (if blocking was enabled)
                 return value;
@@ -314,7 +325,7 @@ namespace LSX_LIB {
             // Get the element at the front without removing it (Peek)
             const T& Peek() const {
                 std::lock_guard<std::mutex> lock(mutex_); // Thread safe peek
-                if (IsEmpty()) {
+                if (current_size_ == 0) { // Empty (IsEmpty() would re-lock mutex_)
                     throw std::out_of_range("CircularQueue: Queue is empty, cannot peek");
                 }
                 return data_vector_[head_];
@@ -366,6 +377,34 @@ namespace LSX_LIB {
             size_t Capacity() const {
                 return capacity_ - 1; // Return actual usable capacity
             }
+
+            // --- Event Loop Integration ---
+            /**
+             * @brief 启用可轮询的就绪通知。
+             * 创建一个在队列非空时可读、被取空后不可读的描述符（Linux 上为 eventfd），参见 ReadyNotifier。
+             *
+             * @return 成功返回 true；平台不支持或创建失败返回 false。已启用时直接返回 true。
+             */
+            bool EnableNotification() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!notifier_.Enable()) {
+                    return false;
+                }
+                if (current_size_ != 0) {
+                    notifier_.Signal(); // Elements queued before enabling must still wake the poller
+                }
+                return true;
+            }
+
+            /**
+             * @brief 获取就绪通知描述符，可加入 epoll/poll/select 等待可读。
+             *
+             * @return 描述符；未启用通知时返回 -1。
+             */
+            int NativeHandle() const {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return notifier_.NativeHandle();
+            }
         };
 
     } // namespace Memory
@@ -108,6 +108,8 @@
 #include "GlobalErrorMutex.h"
 // 包含 LSX_LIB::LockManager::LockGuard 头文件
 #include "LockGuard.h"
+#include "MemoryTracker.h" // For optional memory accounting (TrackingAllocator)
+#include <deque> // For std::deque (underlying container)
 #include <queue> // For std::queue
 #include <optional> // For std::optional (C++17)
 #include <stdexcept> // For exceptions (std::out_of_range)
@@ -143,7 +145,11 @@ namespace LSX_LIB {
              * @brief 存储队列数据的底层 std::queue。
              * 提供了标准的队列操作。
              */
-            std::queue<T> data_queue_;
+            std::queue<T, std::deque<T, TrackingAllocator<T>>> data_queue_;
+            /**
+             * @brief 内存统计标签，为 nullptr 时不统计。
+             */
+            MemoryTag* memory_tag_ = nullptr;
             /**
              * @brief 互斥锁。
              * 用于保护 data_queue_ 的并发访问，确保线程安全。
@@ -160,6 +166,14 @@ namespace LSX_LIB {
              * 创建一个空的 FIFO 队列。
              */
             FIFO() = default;
+            /**
+             * @brief 构造函数，启用内存统计。
+             * 底层存储通过 TrackingAllocator 分配，占用计入 memory_tag，参见 MemoryTracker。
+             *
+             * @param memory_tag 内存统计标签（由 MemoryTracker::Instance().Tag(...) 获取），为 nullptr 时不统计。
+             */
+            explicit FIFO(MemoryTag* memory_tag)
+                : data_queue_(std::deque<T, TrackingAllocator<T>>(TrackingAllocator<T>(memory_tag))), memory_tag_(memory_tag) {}
             /**
              * @brief 析构函数。
              * 默认析构函数，由 std::queue 和底层容器自动管理内存释放。
@@ -188,7 +202,9 @@ namespace LSX_LIB {
             void Clear() {
                 std::lock_guard<std::mutex> lock(mutex_); // Thread safe clear
                 // 使用 swap 方法高效清空队列
-                std::queue<T> empty_queue; // Create a new empty queue
+                // Create a new empty queue (keeping the memory tag)
+                std::queue<T, std::deque<T, TrackingAllocator<T>>> empty_queue{
+                    std::deque<T, TrackingAllocator<T>>(TrackingAllocator<T>(memory_tag_))};
                 std::swap(data_queue_, empty_queue); // Swap with the empty one to clear
                 // Alternative: loop pop (less efficient for large queues)
                 // while(!data_queue_.empty()) data_queue_.pop();
@@ -19,6 +19,7 @@
  * - **线程安全**: 使用内部互斥锁 (`std::mutex`) 保护对队列状态和缓冲区的并发访问，使用条件变量 (`std::condition_variable`) 实现阻塞操作的线程同步。
  * - **状态查询**: 提供 `IsEmpty`, `IsFull`, `Size`, `BlockSize`, `BlockCount`, `TotalSize` 方法查询队列状态和属性。
  * - **Peek 操作**: 支持查看队列头部的块而不将其移除。
+ * - **事件循环集成**: `EnableNotification()` 后 `NativeHandle()` 返回一个在队列非空时可读的描述符，可与套接字一起加入 epoll/poll，参见 ReadyNotifier.h。
  * - **资源管理**: RAII 模式，`std::vector` 自动管理底层内存。
  *
  * ### 使用示例
@@ -117,6 +118,7 @@
 #include "GlobalErrorMutex.h"
 // 包含 LSX_LIB::LockManager::LockGuard 头文件
 #include "LockGuard.h"
+#include "ReadyNotifier.h" // For pollable readiness notification
 #include <vector> // For std::vector
 #include <cstdint> // For uint8_t
 #include <optional> // For std::optional (C++17)
@@ -193,6 +195,7 @@ namespace LSX_LIB {
              * 当队列满时，生产者线程在此等待，直到有空间可用。
              */
             std::condition_variable cv_write_; // For blocking writes
+            ReadyNotifier notifier_; // Optional pollable descriptor, readable while the queue is non-empty
 
             /**
              * @brief 辅助函数，获取指定块索引在底层缓冲区中的内存地址。
@@ -427,6 +430,22 @@ namespace LSX_LIB {
              */
             // Get the total memory size allocated for blocks (BlockSize * BlockCount)
             size_t TotalSize() const { return block_size_ * block_count_; }
+
+            // --- Event Loop Integration ---
+            /**
+             * @brief 启用可轮询的就绪通知。
+             * 创建一个在队列非空时可读、被取空后不可读的描述符（Linux 上为 eventfd），参见 ReadyNotifier。
+             *
+             * @return 成功返回 true；平台不支持或创建失败返回 false。已启用时直接返回 true。
+             */
+            bool EnableNotification();
+
+            /**
+             * @brief 获取就绪通知描述符，可加入 epoll/poll/select 等待可读。
+             *
+             * @return 描述符；未启用通知时返回 -1。
+             */
+            int NativeHandle() const;
         };
 
     } // namespace Memory
@@ -0,0 +1,881 @@
+/**
+ * @file FlatHashMap.h
+ * @brief 开放寻址扁平哈希表 (模板)
+ * @details 定义了 LSX_LIB::Memory 命名空间下的 FlatHashMap 类模板，
+ * 这是一个 SwissTable 风格的开放寻址哈希表：所有元素连续存放在一个槽数组中，
+ * 另有一个每槽 1 字节的控制字节数组记录槽状态和哈希值的低 7 位。
+ * 查找时以 16 个控制字节为一组，用一条 SIMD 比较同时筛选整组候选槽，只有 7 位指纹匹配的槽才会比较键。
+ * 与 std::map / std::unordered_map 的节点式存储相比，查找几乎不产生指针跳转和缓存未命中，
+ * 适合每个数据包都要查询的对端表、配置缓存、主题注册表等场景。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **扁平存储**: 元素存放在连续的槽数组中，没有逐元素的堆分配。
+ * - **分组探测**: 16 个控制字节为一组，SSE2 / NEON 一次比较整组；无 SIMD 时回退到标量实现。
+ * - **异构查找**: `std::string` 键默认使用透明的哈希和比较器，可以直接用 `std::string_view` 或 `const char*` 查找，不构造临时字符串。
+ * - **容量控制**: `reserve` 预留至少可容纳 n 个元素的空间，`rehash` 调整槽数量或收缩，最大负载因子 7/8。
+ * - **墓碑回收**: 删除元素时尽量直接标记为空槽，墓碑过多时原地重建而不是扩容。
+ * - **标准接口**: 接口命名与 std::unordered_map 保持一致（`find`/`insert`/`try_emplace`/`erase`/`operator[]`/迭代器），可以直接替换现有代码中的 std::unordered_map。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "FlatHashMap.h"
+ * #include <iostream>
+ * #include <string>
+ * #include <string_view>
+ *
+ * struct Peer {
+ * int socket;
+ * uint64_t last_seen;
+ * };
+ *
+ * int main() {
+ * LSX_LIB::Memory::FlatHashMap<std::string, Peer> peers;
+ * peers.reserve(1024); // 预留空间，插入 1024 个元素前不会重建
+ *
+ * peers.try_emplace("node-1", Peer{3, 0});
+ * peers["node-2"] = Peer{4, 0};
+ *
+ * // 用 string_view 查找，不构造临时 std::string
+ * std::string_view name = "node-1";
+ * auto it = peers.find(name);
+ * if (it != peers.end()) {
+ * it->second.last_seen = 100;
+ * }
+ *
+ * for (const auto& [key, peer] : peers) {
+ * std::cout << key << " -> socket " << peer.socket << std::endl;
+ * }
+ *
+ * peers.erase("node-2");
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **线程安全**: 与标准容器相同，FlatHashMap 本身不加锁。多线程共享时需要外部同步（例如配合 LockGuard）。
+ * - **迭代器与引用失效**: 任何可能扩容或重建的操作（插入、`reserve`、`rehash`）都会使所有迭代器、指针和引用失效；`erase` 只使被删除元素的迭代器失效。
+ * - **迭代顺序**: 迭代顺序与插入顺序无关，并会在重建后改变。
+ * - **哈希质量**: 内部会对用户哈希值再做一次混合，因此 std::hash 对整数的恒等哈希也能正常工作。
+ * - **元素类型**: 重建时元素会被移动，映射类型最好具有不抛异常的移动构造函数。
+ */
+
+#ifndef LSX_LIB_MEMORY_FLAT_HASH_MAP_H
+#define LSX_LIB_MEMORY_FLAT_HASH_MAP_H
+#pragma once
+#include <algorithm> // For std::fill_n, std::max
+#include <cstddef> // For size_t, ptrdiff_t
+#include <cstdint> // For int8_t, uint8_t, uint64_t
+#include <functional> // For std::hash
+#include <initializer_list> // For std::initializer_list
+#include <iterator> // For std::forward_iterator_tag
+#include <memory> // For std::allocator
+#include <new> // For placement new
+#include <stdexcept> // For std::out_of_range
+#include <string> // For std::string
+#include <string_view> // For std::string_view
+#include <tuple> // For std::piecewise_construct, std::forward_as_tuple
+#include <type_traits> // For std::conditional_t, std::enable_if_t
+#include <utility> // For std::pair, std::move, std::swap
+
+// 编译期选择分组匹配的指令集：SSE2 > NEON > 标量
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LSX_FLAT_HASH_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LSX_FLAT_HASH_NEON 1
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB {
+    /**
+     * @brief 内存管理相关的命名空间。
+     * 包含内存缓冲区和相关工具。
+     */
+    namespace Memory {
+
+        /**
+         * @brief FlatHashMap 的默认哈希器，等价于 std::hash<Key>。
+         */
+        template<typename Key>
+        struct FlatHash {
+            size_t operator()(const Key& key) const { return std::hash<Key>{}(key); }
+        };
+
+        /**
+         * @brief std::string 键的透明哈希器，支持 std::string_view / const char* 异构查找。
+         */
+        template<>
+        struct FlatHash<std::string> {
+            using is_transparent = void;
+            size_t operator()(std::string_view key) const { return std::hash<std::string_view>{}(key); }
+        };
+
+        /**
+         * @brief FlatHashMap 的默认键比较器，等价于 std::equal_to<Key>。
+         */
+        template<typename Key>
+        struct FlatEqual {
+            bool operator()(const Key& lhs, const Key& rhs) const { return lhs == rhs; }
+        };
+
+        /**
+         * @brief std::string 键的透明比较器，支持 std::string_view / const char* 异构查找。
+         */
+        template<>
+        struct FlatEqual<std::string> {
+            using is_transparent = void;
+            bool operator()(std::string_view lhs, std::string_view rhs) const { return lhs == rhs; }
+        };
+
+        /**
+         * @brief FlatHashMap 的内部实现细节。
+         */
+        namespace FlatHashDetail {
+
+            using ctrl_t = int8_t;
+            constexpr ctrl_t kEmpty = -128; // 0b10000000: never used
+            constexpr ctrl_t kDeleted = -2; // 0b11111110: tombstone
+            // Full slots store the low 7 bits of the hash (0..127)
+            constexpr size_t kGroupWidth = 16;
+
+            inline bool IsFull(ctrl_t ctrl) { return ctrl >= 0; }
+
+            // 对用户哈希值做最终混合，避免恒等哈希（如 std::hash<int>）导致低位/高位分布不均
+            inline size_t Mix(size_t hash) {
+                if constexpr (sizeof(size_t) >= 8) {
+                    uint64_t h = static_cast<uint64_t>(hash);
+                    h ^= h >> 30;
+                    h *= 0xbf58476d1ce4e5b9ULL;
+                    h ^= h >> 27;
+                    h *= 0x94d049bb133111ebULL;
+                    h ^= h >> 31;
+                    return static_cast<size_t>(h);
+                } else {
+                    uint32_t h = static_cast<uint32_t>(hash);
+                    h ^= h >> 16;
+                    h *= 0x85ebca6bU;
+                    h ^= h >> 13;
+                    h *= 0xc2b2ae35U;
+                    h ^= h >> 16;
+                    return static_cast<size_t>(h);
+                }
+            }
+
+            inline unsigned CountTrailingZeros(uint64_t mask) {
+#ifdef _MSC_VER
+                unsigned long index = 0;
+                _BitScanForward64(&index, mask);
+                return static_cast<unsigned>(index);
+#else
+                return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+            }
+
+            /**
+             * @brief 一组控制字节的匹配结果，每个匹配的槽对应一个置位。
+             */
+            class BitMask {
+            public:
+                BitMask(uint64_t mask, unsigned shift) : mask_(mask), shift_(shift) {}
+                explicit operator bool() const { return mask_ != 0; }
+                // Index (0..15) of the lowest matching slot in the group
+                size_t Lowest() const { return CountTrailingZeros(mask_) >> shift_; }
+                void ClearLowest() { mask_ &= mask_ - 1; }
+
+            private:
+                uint64_t mask_; // One bit per slot (SSE2 / scalar) or one bit per nibble (NEON)
+                unsigned shift_; // log2(bits per slot)
+            };
+
+            /**
+             * @brief 16 个控制字节组成的探测组。
+             */
+            class Group {
+            public:
+                explicit Group(const ctrl_t* ctrl) {
+#if defined(LSX_FLAT_HASH_SSE2)
+                    ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#elif defined(LSX_FLAT_HASH_NEON)
+                    ctrl_ = vld1q_s8(ctrl);
+#else
+                    ctrl_ = ctrl;
+#endif
+                }
+
+                // Slots whose control byte equals h2
+                BitMask Match(ctrl_t h2) const {
+#if defined(LSX_FLAT_HASH_SSE2)
+                    return BitMask(Movemask(_mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(h2))), 0);
+#elif defined(LSX_FLAT_HASH_NEON)
+                    return NeonMask(vceqq_s8(ctrl_, vdupq_n_s8(h2)));
+#else
+                    return ScalarMask([h2](ctrl_t c) { return c == h2; });
+#endif
+                }
+
+                // Slots that have never been used
+                BitMask MaskEmpty() const {
+#if defined(LSX_FLAT_HASH_SSE2)
+                    return BitMask(Movemask(_mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(kEmpty))), 0);
+#elif defined(LSX_FLAT_HASH_NEON)
+                    return NeonMask(vceqq_s8(ctrl_, vdupq_n_s8(kEmpty)));
+#else
+                    return ScalarMask([](ctrl_t c) { return c == kEmpty; });
+#endif
+                }
+
+                // Slots available for insertion (empty or tombstone: the sign bit is set)
+                BitMask MaskEmptyOrDeleted() const {
+#if defined(LSX_FLAT_HASH_SSE2)
+                    return BitMask(Movemask(ctrl_), 0);
+#elif defined(LSX_FLAT_HASH_NEON)
+                    return NeonMask(vcltq_s8(ctrl_, vdupq_n_s8(0)));
+#else
+                    return ScalarMask([](ctrl_t c) { return c < 0; });
+#endif
+                }
+
+            private:
+#if defined(LSX_FLAT_HASH_SSE2)
+                static uint64_t Movemask(__m128i v) {
+                    return static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(v)));
+                }
+                __m128i ctrl_;
+#elif defined(LSX_FLAT_HASH_NEON)
+                // 将比较结果 (每字节 0x00/0xFF) 压缩成 64 位掩码，每个槽占 4 位，只保留其中一位
+                static BitMask NeonMask(uint8x16_t cmp) {
+                    const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+                    const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+                    return BitMask(mask & 0x8888888888888888ULL, 2);
+                }
+                int8x16_t ctrl_;
+#else
+                template<typename Pred>
+                BitMask ScalarMask(Pred pred) const {
+                    uint64_t mask = 0;
+                    for (size_t i = 0; i < kGroupWidth; ++i) {
+                        if (pred(ctrl_[i])) {
+                            mask |= uint64_t{1} << i;
+                        }
+                    }
+                    return BitMask(mask, 0);
+                }
+                const ctrl_t* ctrl_;
+#endif
+            };
+
+            template<typename T, typename = void>
+            struct IsTransparent : std::false_type {};
+            template<typename T>
+            struct IsTransparent<T, std::void_t<typename T::is_transparent>> : std::true_type {};
+
+            // Lookup argument type: K itself when heterogeneous lookup is enabled, otherwise the key type.
+            // The alias resolves directly to K so that K stays deducible in member function templates.
+            template<bool Transparent>
+            struct KeyArg {
+                template<typename K, typename Key>
+                using type = Key;
+            };
+            template<>
+            struct KeyArg<true> {
+                template<typename K, typename Key>
+                using type = K;
+            };
+
+        } // namespace FlatHashDetail
+
+        /**
+         * @brief 开放寻址扁平哈希表 (模板)。
+         * SwissTable 风格：连续槽数组 + 每槽 1 字节控制字节，按 16 个槽为一组进行 SIMD 探测。
+         *
+         * @tparam Key 键类型。
+         * @tparam T 映射值类型。
+         * @tparam Hash 哈希器。带 `is_transparent` 时启用异构查找。
+         * @tparam KeyEqual 键比较器。带 `is_transparent` 时启用异构查找。
+         */
+        template<typename Key, typename T, typename Hash = FlatHash<Key>, typename KeyEqual = FlatEqual<Key>>
+        class FlatHashMap {
+        public:
+            using key_type = Key;
+            using mapped_type = T;
+            using value_type = std::pair<const Key, T>;
+            using size_type = size_t;
+            using difference_type = ptrdiff_t;
+            using hasher = Hash;
+            using key_equal = KeyEqual;
+            using reference = value_type&;
+            using const_reference = const value_type&;
+
+        private:
+            using ctrl_t = FlatHashDetail::ctrl_t;
+            static constexpr size_t kGroupWidth = FlatHashDetail::kGroupWidth;
+            static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+            // Heterogeneous lookup: K is accepted as-is only when both functors are transparent
+            template<typename K>
+            using key_arg = typename FlatHashDetail::KeyArg<FlatHashDetail::IsTransparent<Hash>::value &&
+                                                            FlatHashDetail::IsTransparent<KeyEqual>::value>::template type<K, Key>;
+
+        public:
+            /**
+             * @brief 前向迭代器。Const 为 true 时为 const_iterator。
+             */
+            template<bool Const>
+            class Iterator {
+                friend class FlatHashMap;
+                using slot_pointer = std::conditional_t<Const, const std::pair<const Key, T>*, std::pair<const Key, T>*>;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = std::pair<const Key, T>;
+                using difference_type = ptrdiff_t;
+                using pointer = slot_pointer;
+                using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+                Iterator() = default;
+                // iterator -> const_iterator
+                template<bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+                Iterator(const Iterator<OtherConst>& other) : ctrl_(other.ctrl_), end_(other.end_), slot_(other.slot_) {}
+
+                reference operator*() const { return *slot_; }
+                pointer operator->() const { return slot_; }
+
+                Iterator& operator++() {
+                    ++ctrl_;
+                    ++slot_;
+                    skip_empty();
+                    return *this;
+                }
+                Iterator operator++(int) {
+                    Iterator previous = *this;
+                    ++*this;
+                    return previous;
+                }
+
+                friend bool operator==(const Iterator& lhs, const Iterator& rhs) { return lhs.ctrl_ == rhs.ctrl_; }
+                friend bool operator!=(const Iterator& lhs, const Iterator& rhs) { return lhs.ctrl_ != rhs.ctrl_; }
+
+            private:
+                template<bool> friend class Iterator;
+
+                Iterator(const ctrl_t* ctrl, const ctrl_t* end, slot_pointer slot) : ctrl_(ctrl), end_(end), slot_(slot) {
+                    skip_empty();
+                }
+                void skip_empty() {
+                    while (ctrl_ != end_ && !FlatHashDetail::IsFull(*ctrl_)) {
+                        ++ctrl_;
+                        ++slot_;
+                    }
+                }
+
+                const ctrl_t* ctrl_ = nullptr; // Control byte of the current slot
+                const ctrl_t* end_ = nullptr; // One past the last control byte
+                slot_pointer slot_ = nullptr; // Current slot
+            };
+
+            using iterator = Iterator<false>;
+            using const_iterator = Iterator<true>;
+
+        private:
+            ctrl_t* ctrl_ = nullptr; // capacity_ control bytes
+            value_type* slots_ = nullptr; // capacity_ slots, constructed where the control byte is full
+            size_t capacity_ = 0; // Number of slots: 0 or a power of two >= kGroupWidth
+            size_t size_ = 0; // Number of elements
+            size_t growth_left_ = 0; // Empty slots that may still be consumed before the next rebuild
+            Hash hash_; // Hash function
+            KeyEqual equal_; // Key comparison
+
+        public:
+            // --- Constructors ---
+            /**
+             * @brief 构造一个空表，不分配内存。
+             */
+            FlatHashMap() = default;
+
+            /**
+             * @brief 构造一个空表并预留至少可容纳 expected_size 个元素的空间。
+             */
+            explicit FlatHashMap(size_t expected_size, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+                : hash_(hash), equal_(equal) {
+                reserve(expected_size);
+            }
+
+            /**
+             * @brief 用初始化列表构造。重复的键保留第一个。
+             */
+            FlatHashMap(std::initializer_list<value_type> init) {
+                reserve(init.size());
+                insert(init.begin(), init.end());
+            }
+
+            FlatHashMap(const FlatHashMap& other) : hash_(other.hash_), equal_(other.equal_) {
+                reserve(other.size_);
+                for (const value_type& value : other) {
+                    insert_unique_unchecked(value);
+                }
+            }
+
+            FlatHashMap(FlatHashMap&& other) noexcept
+                : ctrl_(other.ctrl_), slots_(other.slots_), capacity_(other.capacity_), size_(other.size_),
+                  growth_left_(other.growth_left_), hash_(std::move(other.hash_)), equal_(std::move(other.equal_)) {
+                other.ctrl_ = nullptr;
+                other.slots_ = nullptr;
+                other.capacity_ = 0;
+                other.size_ = 0;
+                other.growth_left_ = 0;
+            }
+
+            FlatHashMap& operator=(const FlatHashMap& other) {
+                if (this != &other) {
+                    FlatHashMap copy(other);
+                    swap(copy);
+                }
+                return *this;
+            }
+
+            FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+                if (this != &other) {
+                    FlatHashMap moved(std::move(other));
+                    swap(moved);
+                }
+                return *this;
+            }
+
+            ~FlatHashMap() { release(); }
+
+            // --- Iterators ---
+            iterator begin() { return iterator_at(0); }
+            iterator end() { return iterator_at(capacity_); }
+            const_iterator begin() const { return iterator_at(0); }
+            const_iterator end() const { return iterator_at(capacity_); }
+            const_iterator cbegin() const { return begin(); }
+            const_iterator cend() const { return end(); }
+
+            // --- Capacity ---
+            /**
+             * @brief 检查表是否为空。
+             */
+            bool empty() const { return size_ == 0; }
+            /**
+             * @brief 获取元素数量。
+             */
+            size_t size() const { return size_; }
+            /**
+             * @brief 获取槽数量（0 或 2 的幂）。
+             */
+            size_t capacity() const { return capacity_; }
+            /**
+             * @brief 获取槽数量，与 capacity() 相同，兼容 std::unordered_map。
+             */
+            size_t bucket_count() const { return capacity_; }
+            /**
+             * @brief 当前负载因子 (size / capacity)。
+             */
+            float load_factor() const { return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / static_cast<float>(capacity_); }
+            /**
+             * @brief 最大负载因子，固定为 7/8。
+             */
+            float max_load_factor() const { return 0.875f; }
+
+            /**
+             * @brief 预留至少可容纳 count 个元素的空间，之后插入 count 个元素前不会扩容。
+             */
+            void reserve(size_t count) {
+                const size_t required = capacity_for(count);
+                if (required > capacity_) {
+                    resize(required);
+                }
+            }
+
+            /**
+             * @brief 把槽数量调整为不小于 slot_count 的 2 的幂，同时保证能容纳现有元素。
+             * slot_count 为 0 时收缩到刚好容纳现有元素（空表释放全部内存），并清除所有墓碑。
+             */
+            void rehash(size_t slot_count) {
+                size_t target = capacity_for(size_);
+                if (slot_count > target) {
+                    target = kGroupWidth;
+                    while (target < slot_count) {
+                        target *= 2;
+                    }
+                }
+                if (target == 0) {
+                    release();
+                } else {
+                    resize(target);
+                }
+            }
+
+            // --- Lookup ---
+            /**
+             * @brief 查找键。
+             *
+             * @param key 要查找的键；`std::string` 键时可以是 std::string_view 或 const char*。
+             * @return 指向元素的迭代器；不存在时返回 end()。
+             */
+            template<typename K = Key>
+            iterator find(const key_arg<K>& key) {
+                const size_t index = find_index(key, hash_of(key));
+                return index == kNotFound ? end() : iterator_at(index);
+            }
+            template<typename K = Key>
+            const_iterator find(const key_arg<K>& key) const {
+                const size_t index = find_index(key, hash_of(key));
+                return index == kNotFound ? end() : iterator_at(index);
+            }
+
+            /**
+             * @brief 检查键是否存在。
+             */
+            template<typename K = Key>
+            bool contains(const key_arg<K>& key) const { return find_index(key, hash_of(key)) != kNotFound; }
+
+            /**
+             * @brief 返回键出现的次数（0 或 1）。
+             */
+            template<typename K = Key>
+            size_t count(const key_arg<K>& key) const { return contains(key) ? 1 : 0; }
+
+            /**
+             * @brief 访问键对应的值。
+             * @throws std::out_of_range 如果键不存在。
+             */
+            template<typename K = Key>
+            T& at(const key_arg<K>& key) {
+                const size_t index = find_index(key, hash_of(key));
+                if (index == kNotFound) {
+                    throw std::out_of_range("FlatHashMap: key not found");
+                }
+                return slots_[index].second;
+            }
+            template<typename K = Key>
+            const T& at(const key_arg<K>& key) const {
+                const size_t index = find_index(key, hash_of(key));
+                if (index == kNotFound) {
+                    throw std::out_of_range("FlatHashMap: key not found");
+                }
+                return slots_[index].second;
+            }
+
+            /**
+             * @brief 访问键对应的值；键不存在时插入值初始化的 T。
+             */
+            T& operator[](const Key& key) { return try_emplace(key).first->second; }
+            T& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
+
+            // --- Modifiers ---
+            /**
+             * @brief 插入元素；键已存在时不修改。
+             *
+             * @return 指向元素的迭代器，以及是否发生了插入。
+             */
+            std::pair<iterator, bool> insert(const value_type& value) { return try_emplace(value.first, value.second); }
+            std::pair<iterator, bool> insert(value_type&& value) { return try_emplace(value.first, std::move(value.second)); }
+
+            /**
+             * @brief 插入 [first, last) 范围内的元素。
+             */
+            template<typename InputIt>
+            void insert(InputIt first, InputIt last) {
+                for (; first != last; ++first) {
+                    insert(*first);
+                }
+            }
+            void insert(std::initializer_list<value_type> init) { insert(init.begin(), init.end()); }
+
+            /**
+             * @brief 键不存在时用 args 原地构造映射值并插入；键已存在时不构造任何对象。
+             *
+             * @return 指向元素的迭代器，以及是否发生了插入。
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+                return emplace_key(key, std::forward<Args>(args)...);
+            }
+            template<typename... Args>
+            std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+                return emplace_key(std::move(key), std::forward<Args>(args)...);
+            }
+
+            /**
+             * @brief 用 args 构造一个元素并插入；键已存在时丢弃构造的元素。
+             */
+            template<typename... Args>
+            std::pair<iterator, bool> emplace(Args&&... args) {
+                value_type value(std::forward<Args>(args)...);
+                return insert(std::move(value));
+            }
+
+            /**
+             * @brief 键不存在时插入，存在时赋值。
+             *
+             * @return 指向元素的迭代器，以及是否发生了插入。
+             */
+            template<typename M>
+            std::pair<iterator, bool> insert_or_assign(const Key& key, M&& mapped) {
+                auto result = try_emplace(key, std::forward<M>(mapped));
+                if (!result.second) {
+                    result.first->second = std::forward<M>(mapped);
+                }
+                return result;
+            }
+            template<typename M>
+            std::pair<iterator, bool> insert_or_assign(Key&& key, M&& mapped) {
+                auto result = try_emplace(std::move(key), std::forward<M>(mapped));
+                if (!result.second) {
+                    result.first->second = std::forward<M>(mapped);
+                }
+                return result;
+            }
+
+            /**
+             * @brief 删除键。
+             *
+             * @return 删除的元素数量（0 或 1）。
+             */
+            template<typename K = Key>
+            size_t erase(const key_arg<K>& key) {
+                const size_t index = find_index(key, hash_of(key));
+                if (index == kNotFound) {
+                    return 0;
+                }
+                erase_at(index);
+                return 1;
+            }
+
+            /**
+             * @brief 删除迭代器指向的元素。
+             *
+             * @return 指向下一个元素的迭代器。
+             */
+            iterator erase(const_iterator pos) {
+                const size_t index = static_cast<size_t>(pos.slot_ - slots_);
+                erase_at(index);
+                return iterator_at(index + 1);
+            }
+            iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+            /**
+             * @brief 删除所有元素，保留已分配的槽。
+             */
+            void clear() {
+                if (capacity_ == 0) {
+                    return;
+                }
+                destroy_all();
+                std::fill_n(ctrl_, capacity_, FlatHashDetail::kEmpty);
+                size_ = 0;
+                growth_left_ = max_load(capacity_);
+            }
+
+            /**
+             * @brief 与另一个表交换内容。
+             */
+            void swap(FlatHashMap& other) noexcept {
+                std::swap(ctrl_, other.ctrl_);
+                std::swap(slots_, other.slots_);
+                std::swap(capacity_, other.capacity_);
+                std::swap(size_, other.size_);
+                std::swap(growth_left_, other.growth_left_);
+                std::swap(hash_, other.hash_);
+                std::swap(equal_, other.equal_);
+            }
+
+            hasher hash_function() const { return hash_; }
+            key_equal key_eq() const { return equal_; }
+
+        private:
+            static size_t max_load(size_t capacity) { return capacity - capacity / 8; }
+
+            // Smallest slot count whose load limit admits count elements
+            static size_t capacity_for(size_t count) {
+                if (count == 0) {
+                    return 0;
+                }
+                size_t capacity = kGroupWidth;
+                while (max_load(capacity) < count) {
+                    capacity *= 2;
+                }
+                return capacity;
+            }
+
+            static ctrl_t h2(size_t hash) { return static_cast<ctrl_t>(hash & 0x7F); }
+            static size_t h1(size_t hash) { return hash >> 7; }
+
+            template<typename K>
+            size_t hash_of(const K& key) const { return FlatHashDetail::Mix(hash_(key)); }
+
+            iterator iterator_at(size_t index) { return iterator(ctrl_ + index, ctrl_ + capacity_, slots_ + index); }
+            const_iterator iterator_at(size_t index) const { return const_iterator(ctrl_ + index, ctrl_ + capacity_, slots_ + index); }
+
+            // Probe sequence over group-aligned positions: triangular steps visit every group once
+            // because the group count is a power of two. A group containing an empty slot ends the search.
+            template<typename K>
+            size_t find_index(const K& key, size_t hash) const {
+                if (capacity_ == 0) {
+                    return kNotFound;
+                }
+                const size_t mask = capacity_ - 1;
+                size_t pos = (h1(hash) * kGroupWidth) & mask;
+                for (size_t step = kGroupWidth; step <= capacity_; step += kGroupWidth) {
+                    const FlatHashDetail::Group group(ctrl_ + pos);
+                    for (FlatHashDetail::BitMask match = group.Match(h2(hash)); match; match.ClearLowest()) {
+                        const size_t index = pos + match.Lowest();
+                        if (equal_(slots_[index].first, key)) {
+                            return index;
+                        }
+                    }
+                    if (group.MaskEmpty()) {
+                        return kNotFound;
+                    }
+                    pos = (pos + step) & mask;
+                }
+                return kNotFound;
+            }
+
+            // First empty or deleted slot on the probe sequence (the table always has one)
+            size_t find_insert_slot(size_t hash) const {
+                const size_t mask = capacity_ - 1;
+                size_t pos = (h1(hash) * kGroupWidth) & mask;
+                for (size_t step = kGroupWidth;; step += kGroupWidth) {
+                    const FlatHashDetail::BitMask available = FlatHashDetail::Group(ctrl_ + pos).MaskEmptyOrDeleted();
+                    if (available) {
+                        return pos + available.Lowest();
+                    }
+                    pos = (pos + step) & mask;
+                }
+            }
+
+            template<typename K, typename... Args>
+            std::pair<iterator, bool> emplace_key(K&& key, Args&&... args) {
+                size_t hash = hash_of(key);
+                size_t index = find_index(key, hash);
+                if (index != kNotFound) {
+                    return {iterator_at(index), false};
+                }
+                if (growth_left_ == 0) {
+                    grow();
+                }
+                index = find_insert_slot(hash);
+                new (slots_ + index) value_type(std::piecewise_construct,
+                                                std::forward_as_tuple(std::forward<K>(key)),
+                                                std::forward_as_tuple(std::forward<Args>(args)...));
+                set_full(index, hash);
+                return {iterator_at(index), true};
+            }
+
+            // Copy construction: keys are known to be distinct
+            void insert_unique_unchecked(const value_type& value) {
+                const size_t hash = hash_of(value.first);
+                const size_t index = find_insert_slot(hash);
+                new (slots_ + index) value_type(value);
+                set_full(index, hash);
+            }
+
+            void set_full(size_t index, size_t hash) {
+                if (ctrl_[index] == FlatHashDetail::kEmpty) {
+                    --growth_left_;
+                }
+                ctrl_[index] = h2(hash);
+                ++size_;
+            }
+
+            void erase_at(size_t index) {
+                slots_[index].~value_type();
+                --size_;
+                // If the slot's group still has an empty slot, no probe ever passed through this group,
+                // so the slot can become empty again instead of a tombstone
+                const size_t group_start = index & ~(kGroupWidth - 1);
+                if (FlatHashDetail::Group(ctrl_ + group_start).MaskEmpty()) {
+                    ctrl_[index] = FlatHashDetail::kEmpty;
+                    ++growth_left_;
+                } else {
+                    ctrl_[index] = FlatHashDetail::kDeleted;
+                }
+            }
+
+            void grow() {
+                if (capacity_ == 0) {
+                    resize(kGroupWidth);
+                } else if (size_ <= max_load(capacity_) / 2) {
+                    resize(capacity_); // Mostly tombstones: rebuild in place instead of doubling
+                } else {
+                    resize(capacity_ * 2);
+                }
+            }
+
+            void resize(size_t new_capacity) {
+                ctrl_t* old_ctrl = ctrl_;
+                value_type* old_slots = slots_;
+                const size_t old_capacity = capacity_;
+
+                std::allocator<value_type> allocator;
+                slots_ = allocator.allocate(new_capacity);
+                try {
+                    ctrl_ = new ctrl_t[new_capacity];
+                } catch (...) {
+                    allocator.deallocate(slots_, new_capacity);
+                    slots_ = old_slots;
+                    throw;
+                }
+                std::fill_n(ctrl_, new_capacity, FlatHashDetail::kEmpty);
+                capacity_ = new_capacity;
+                growth_left_ = max_load(new_capacity) - size_;
+
+                for (size_t i = 0; i < old_capacity; ++i) {
+                    if (!FlatHashDetail::IsFull(old_ctrl[i])) {
+                        continue;
+                    }
+                    value_type& old_value = old_slots[i];
+                    const size_t hash = hash_of(old_value.first);
+                    const size_t index = find_insert_slot(hash);
+                    // The source slot is destroyed right after, so moving out of its const key is safe in practice
+                    new (slots_ + index) value_type(std::move(const_cast<Key&>(old_value.first)), std::move(old_value.second));
+                    old_value.~value_type();
+                    ctrl_[index] = h2(hash);
+                }
+
+                if (old_capacity != 0) {
+                    delete[] old_ctrl;
+                    allocator.deallocate(old_slots, old_capacity);
+                }
+            }
+
+            void destroy_all() {
+                for (size_t i = 0; i < capacity_; ++i) {
+                    if (FlatHashDetail::IsFull(ctrl_[i])) {
+                        slots_[i].~value_type();
+                    }
+                }
+            }
+
+            void release() {
+                if (capacity_ == 0) {
+                    return;
+                }
+                destroy_all();
+                delete[] ctrl_;
+                std::allocator<value_type>().deallocate(slots_, capacity_);
+                ctrl_ = nullptr;
+                slots_ = nullptr;
+                capacity_ = 0;
+                size_ = 0;
+                growth_left_ = 0;
+            }
+        };
+
+    } // namespace Memory
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_MEMORY_FLAT_HASH_MAP_H
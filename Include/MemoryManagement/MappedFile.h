@@ -0,0 +1,348 @@
+/**
+ * @file MappedFile.h
+ * @brief 内存映射文件类
+ * @details 定义了 LSX_LIB::Memory 命名空间下的 MappedFile 类，
+ * 用于把普通文件映射到进程地址空间，以零拷贝方式顺序或随机访问大文件（日志回读、数据回放、配置解析等）。
+ * 支持只读、读写和可增长读写三种模式，提供 madvise 访问提示（顺序、随机、预读、大页等）、
+ * 指定区间的显式预取、指定区间的 msync 刷新，以及指向映射区域的 Span / string_view 访问器。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **打开模式**: `ReadOnly`（只读）、`ReadWrite`（读写，大小固定，可用 `Resize` 调整）、`ReadWriteGrowable`（写入越过末尾时自动按倍数扩展映射）。
+ * - **访问提示**: `Advise` 对整个映射或指定区间调用 madvise (`Sequential`, `Random`, `WillNeed`, `DontNeed`, `HugePage`)。
+ * - **显式预取**: `Prefetch` 对指定区间发起异步预读，适合在处理当前块时提前读入下一块。
+ * - **区间刷新**: `Flush` 对指定区间 (或整个文件) 调用 msync，支持同步和异步两种方式。
+ * - **零拷贝访问**: `Data` / `Range` / `View` 直接返回映射区域的指针、Span 或 std::string_view。
+ * - **拷贝访问**: `Read` / `Write` 在指定偏移复制数据，带边界检查。
+ * - **线程安全**: 管理函数和 `Read` / `Write` 使用内部互斥锁 (`std::mutex`) 保护。
+ * - **资源管理**: RAII 模式，析构时刷新（读写模式）、解除映射并关闭文件。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "MappedFile.h"
+ * #include <iostream>
+ *
+ * using LSX_LIB::Memory::MappedFile;
+ *
+ * int main() {
+ * // 1. 顺序回放记录的数据文件
+ * MappedFile replay;
+ * if (replay.Open("/data/record_0001.bin", MappedFile::Mode::ReadOnly)) {
+ * replay.Advise(MappedFile::Advice::Sequential);
+ * const size_t chunk = 4 * 1024 * 1024;
+ * for (size_t offset = 0; offset < replay.Size(); offset += chunk) {
+ * replay.Prefetch(offset + chunk, chunk); // 提前预读下一块
+ * MappedFile::Span block = replay.Range(offset, chunk);
+ * // ... 处理 block.data / block.size ...
+ * }
+ * }
+ *
+ * // 2. 按行扫描日志文件
+ * MappedFile log;
+ * if (log.Open("/var/log/app.log")) {
+ * std::string_view text = log.View();
+ * size_t lines = 0;
+ * for (char c : text) {
+ * lines += (c == '\n');
+ * }
+ * std::cout << "Lines: " << lines << std::endl;
+ * }
+ *
+ * // 3. 可增长的输出文件
+ * MappedFile out;
+ * if (out.Open("/tmp/output.bin", MappedFile::Mode::ReadWriteGrowable)) {
+ * const uint8_t header[4] = {'L', 'S', 'X', 1};
+ * out.Write(0, header, sizeof(header));
+ * out.Write(out.Size(), header, sizeof(header)); // 追加，自动扩展
+ * out.Flush();
+ * }
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **平台**: 基于 POSIX mmap/madvise/msync 实现；在不支持 POSIX 映射的平台上 `Open` 返回 false。
+ * - **指针失效**: `Data`、`Range`、`View` 返回的指针和视图在 `Resize`、可增长模式下的自动扩展以及 `Close` 之后失效。
+ *   这些访问器本身不加锁，调用者需保证访问期间没有其他线程改变映射。
+ * - **空文件**: 大小为 0 的文件不会建立映射，`Data()` 返回 nullptr，`Size()` 返回 0。
+ * - **可增长模式**: 映射容量按倍数增长，`Size()` 返回实际写入的逻辑大小；磁盘上的文件在 `Close` (或析构) 时才截断到逻辑大小，
+ *   因此进程异常退出时文件末尾可能残留填充 0 的预留空间。
+ * - **外部修改**: 只读映射期间若文件被其他进程截断，访问截断部分会触发 SIGBUS，这是 mmap 的固有行为。
+ * - **大页提示**: `HugePage` 依赖内核对文件映射透明大页的支持，不支持时 `Advise` 返回 false，不影响正常访问。
+ */
+
+#ifndef LSX_LIB_MEMORY_MAPPED_FILE_H
+#define LSX_LIB_MEMORY_MAPPED_FILE_H
+#pragma once
+#include <cstddef> // For size_t
+#include <cstdint> // For uint8_t
+#include <mutex> // For thread safety (std::mutex)
+#include <string> // For std::string
+#include <string_view> // For std::string_view (C++17)
+#include <vector> // For convenience read/write methods
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB {
+    /**
+     * @brief 内存管理相关的命名空间。
+     * 包含内存缓冲区和相关工具。
+     */
+    namespace Memory {
+
+        /**
+         * @brief 内存映射文件类。
+         * 把文件映射到进程地址空间，提供访问提示、预取、区间刷新和零拷贝访问器。
+         */
+        class MappedFile {
+        public:
+            /**
+             * @brief 文件打开模式。
+             */
+            enum class Mode {
+                /**
+                 * @brief 只读映射，文件必须存在。
+                 */
+                ReadOnly,
+                /**
+                 * @brief 读写映射，文件不存在时创建；大小固定，可通过 Resize 调整。
+                 */
+                ReadWrite,
+                /**
+                 * @brief 可增长的读写映射，Write 越过末尾时自动扩展。
+                 */
+                ReadWriteGrowable
+            };
+
+            /**
+             * @brief 访问提示，对应 madvise 的各个选项。
+             */
+            enum class Advice {
+                Normal,     ///< MADV_NORMAL：默认预读行为
+                Sequential, ///< MADV_SEQUENTIAL：顺序访问，加大预读并尽早回收已读页面
+                Random,     ///< MADV_RANDOM：随机访问，关闭预读
+                WillNeed,   ///< MADV_WILLNEED：即将访问，立即发起异步预读
+                DontNeed,   ///< MADV_DONTNEED：暂不需要，允许内核回收页面
+                HugePage    ///< MADV_HUGEPAGE：尽量使用透明大页
+            };
+
+            /**
+             * @brief 指向映射区域中一段连续字节的视图。
+             */
+            struct Span {
+                const uint8_t* data = nullptr; ///< 起始地址
+                size_t size = 0;               ///< 字节数
+
+                const uint8_t* begin() const { return data; }
+                const uint8_t* end() const { return data + size; }
+                bool empty() const { return size == 0; }
+            };
+
+            /**
+             * @brief 构造函数，不打开任何文件。
+             */
+            MappedFile() = default;
+
+            /**
+             * @brief 析构函数。读写模式下先刷新，然后解除映射并关闭文件。
+             */
+            ~MappedFile();
+
+            // Prevent copying and assignment as the mapping owns OS resources
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            // --- Management Functions ---
+            /**
+             * @brief 打开并映射文件。
+             *
+             * @param path 文件路径。
+             * @param mode 打开模式，默认只读。
+             * @param initial_size 读写模式下，文件小于该值时扩展到该大小；只读模式下忽略。
+             * @return 成功返回 true；文件无法打开/创建、映射失败或已打开其他文件时返回 false。
+             */
+            bool Open(const std::string& path, Mode mode = Mode::ReadOnly, size_t initial_size = 0);
+
+            /**
+             * @brief 关闭文件。读写模式下先截断到逻辑大小并同步刷新，然后解除映射。
+             */
+            void Close();
+
+            /**
+             * @brief 调整文件大小（仅读写模式）。
+             * 扩展部分填充为 0；之前通过 Data/Range/View 获取的指针全部失效。
+             *
+             * @param new_size 新的文件大小（字节）。
+             * @return 成功返回 true；只读模式、未打开或系统调用失败时返回 false。
+             */
+            bool Resize(size_t new_size);
+
+            // --- Access Hints ---
+            /**
+             * @brief 对整个映射设置访问提示。
+             *
+             * @param advice 访问提示。
+             * @return 成功返回 true；未打开、文件为空或内核不支持该提示时返回 false。
+             */
+            bool Advise(Advice advice);
+
+            /**
+             * @brief 对指定区间设置访问提示。区间会按页对齐扩展，并裁剪到文件末尾。
+             *
+             * @param offset 区间起始偏移。
+             * @param length 区间长度（字节）。
+             * @param advice 访问提示。
+             * @return 成功返回 true；未打开、区间为空或 madvise 失败时返回 false。
+             */
+            bool Advise(size_t offset, size_t length, Advice advice);
+
+            /**
+             * @brief 对指定区间发起异步预读 (MADV_WILLNEED)，不等待读取完成。
+             * 超出文件末尾的部分被忽略。
+             *
+             * @param offset 区间起始偏移。
+             * @param length 区间长度（字节）。
+             * @return 成功发起预读返回 true；区间为空或失败时返回 false。
+             */
+            bool Prefetch(size_t offset, size_t length);
+
+            // --- Flush ---
+            /**
+             * @brief 把指定区间的修改刷新到文件 (msync)。区间会按页对齐扩展。
+             *
+             * @param offset 区间起始偏移。
+             * @param length 区间长度（字节）。
+             * @param async 为 true 时使用 MS_ASYNC 只发起写回，为 false 时使用 MS_SYNC 等待写回完成。
+             * @return 成功返回 true；只读模式、未打开或 msync 失败时返回 false。
+             */
+            bool Flush(size_t offset, size_t length, bool async = false);
+
+            /**
+             * @brief 把 [0, Size()) 范围内的修改刷新到文件。
+             *
+             * @param async 参见 Flush(size_t, size_t, bool)。
+             * @return 成功返回 true；只读模式、未打开或失败时返回 false。
+             */
+            bool Flush(bool async = false);
+
+            // --- Zero-copy Accessors ---
+            /**
+             * @brief 获取映射区域的起始地址（只读）。文件为空或未打开时返回 nullptr。
+             */
+            const uint8_t* Data() const;
+
+            /**
+             * @brief 获取映射区域的起始地址（可写）。只读模式、文件为空或未打开时返回 nullptr。
+             */
+            uint8_t* MutableData();
+
+            /**
+             * @brief 获取指定区间的视图，区间会被裁剪到文件末尾。
+             *
+             * @param offset 区间起始偏移。
+             * @param length 区间长度（字节），默认到文件末尾。
+             * @return 区间视图；offset 超出文件大小时返回空视图。
+             */
+            Span Range(size_t offset = 0, size_t length = static_cast<size_t>(-1)) const;
+
+            /**
+             * @brief 以 std::string_view 形式获取指定区间，适合文本解析。区间会被裁剪到文件末尾。
+             *
+             * @param offset 区间起始偏移。
+             * @param length 区间长度（字节），默认到文件末尾。
+             * @return 区间的字符串视图；offset 超出文件大小时返回空视图。
+             */
+            std::string_view View(size_t offset = 0, size_t length = static_cast<size_t>(-1)) const;
+
+            // --- Copying Accessors ---
+            /**
+             * @brief 从指定偏移复制数据到缓冲区（线程安全）。
+             *
+             * @param offset 读取的起始偏移。
+             * @param buffer 目标缓冲区。
+             * @param size 要读取的字节数。
+             * @return 实际读取的字节数（被裁剪到文件末尾）；参数无效或未打开时返回 0。
+             */
+            size_t Read(size_t offset, uint8_t* buffer, size_t size) const;
+
+            /**
+             * @brief 从指定偏移读取数据并以 std::vector 返回（线程安全）。
+             *
+             * @param offset 读取的起始偏移。
+             * @param size 要读取的字节数。
+             * @return 读取到的数据（被裁剪到文件末尾）。
+             */
+            std::vector<uint8_t> Read(size_t offset, size_t size) const;
+
+            /**
+             * @brief 把数据写入指定偏移（线程安全，仅读写模式）。
+             * 可增长模式下写入越过末尾时自动扩展文件；固定大小的读写模式下越界写入失败。
+             *
+             * @param offset 写入的起始偏移。
+             * @param data 源数据。
+             * @param size 要写入的字节数。
+             * @return 成功写入的字节数（全部写入返回 size，失败返回 0）。
+             */
+            size_t Write(size_t offset, const uint8_t* data, size_t size);
+
+            /**
+             * @brief 把 std::vector 中的数据写入指定偏移（线程安全，仅读写模式）。
+             */
+            size_t Write(size_t offset, const std::vector<uint8_t>& data);
+
+            // --- Status Functions ---
+            /**
+             * @brief 检查是否已打开文件。
+             */
+            bool IsOpen() const;
+
+            /**
+             * @brief 检查是否以读写模式打开。
+             */
+            bool IsWritable() const;
+
+            /**
+             * @brief 获取文件的逻辑大小（字节）。
+             */
+            size_t Size() const;
+
+            /**
+             * @brief 获取已打开文件的路径；未打开时返回空字符串。
+             */
+            std::string Path() const;
+
+        private:
+            std::string path_; // Path of the opened file
+            Mode mode_ = Mode::ReadOnly; // Open mode
+            int fd_ = -1; // File descriptor
+            uint8_t* base_ = nullptr; // Start of the mapping (nullptr for empty files)
+            size_t size_ = 0; // Logical file size
+            size_t mapped_size_ = 0; // Mapped length (== size_ unless growable)
+            mutable std::mutex mutex_; // Protects the mapping state
+
+            /**
+             * @brief 解除映射并关闭文件。此函数假定调用者已持有互斥锁。
+             */
+            void close_unsafe();
+
+            /**
+             * @brief 把文件和映射调整到 new_mapped 字节，逻辑大小设为 new_size。此函数假定调用者已持有互斥锁。
+             */
+            bool remap_unsafe(size_t new_size, size_t new_mapped);
+
+            /**
+             * @brief 把 [offset, offset + length) 裁剪到映射范围并按页对齐。此函数假定调用者已持有互斥锁。
+             *
+             * @return 对齐后的起始地址；区间为空时返回 nullptr，aligned_length 被置为 0。
+             */
+            uint8_t* page_range_unsafe(size_t offset, size_t length, size_t& aligned_length) const;
+        };
+
+    } // namespace Memory
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_MEMORY_MAPPED_FILE_H
@@ -0,0 +1,310 @@
+/**
+ * @file MemoryTracker.h
+ * @brief 按子系统标签的内存统计与分配跟踪
+ * @details 定义了 LSX_LIB::Memory 命名空间下的 MemoryTag、MemoryTracker 和 TrackingAllocator，
+ * 用于回答 "哪个队列/缓冲区/子系统正在持续占用内存" 这类问题。
+ * 每个标签 (MemoryTag) 统计当前占用字节数、峰值、累计分配字节数以及分配/释放次数；
+ * TrackingAllocator 是一个携带标签的标准分配器，可以直接用于 std::vector、std::deque 等标准容器；
+ * MemoryTracker 是进程内的标签注册表，提供快照、速率计算和文本输出。
+ * Queue、FIFO、Pipe、Buffer 的构造函数可以接收一个标签，在不改变其它行为的前提下启用统计。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **按标签统计**: 当前占用 (live)、峰值 (peak)、累计分配字节数、分配次数、释放次数。
+ * - **标准分配器**: `TrackingAllocator<T>` 满足 C++ Allocator 要求，标签随容器的拷贝/移动/交换一起传递。
+ * - **手动记录**: 对于不经过分配器的内存（共享内存段、mmap、第三方库缓冲区），可以直接调用 `RecordAllocation` / `RecordDeallocation`。
+ * - **快照与速率**: `Snapshot()` 返回所有标签的统计，并给出自上次快照以来的分配次数速率和字节速率。
+ * - **文本输出**: `Dump()` 按当前占用从大到小输出一张表，便于定期写入日志并定位持续增长的容器。
+ * - **按需启用**: 未指定标签的容器不做任何统计，只多一次空指针判断。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "MemoryTracker.h"
+ * #include "Queue.h"
+ * #include "Pipe.h"
+ * #include <iostream>
+ * #include <vector>
+ *
+ * using namespace LSX_LIB::Memory;
+ *
+ * int main() {
+ * MemoryTracker& tracker = MemoryTracker::Instance();
+ *
+ * // 为可疑的无界容器指定标签
+ * Queue<std::vector<uint8_t>> rx_queue(tracker.Tag("net.rx_queue"));
+ * Pipe uart_pipe(tracker.Tag("uart.pipe"));
+ *
+ * // 标准容器也可以直接使用带标签的分配器
+ * std::vector<int, TrackingAllocator<int>> table{TrackingAllocator<int>(tracker.Tag("app.table"))};
+ * table.resize(1000);
+ *
+ * // 共享内存等不经过分配器的内存手动记录
+ * MemoryTag* shm_tag = tracker.Tag("shm.frames");
+ * shm_tag->RecordAllocation(4 * 1024 * 1024);
+ *
+ * rx_queue.Push(std::vector<uint8_t>(1500));
+ * uart_pipe.Write(reinterpret_cast<const uint8_t*>("hello"), 5);
+ *
+ * // 定期输出（例如每分钟一次写入日志）
+ * tracker.Dump(std::cout);
+ *
+ * for (const MemoryTracker::TagStats& stats : tracker.Snapshot()) {
+ * if (stats.live_bytes > 64 * 1024 * 1024) {
+ * std::cerr << stats.name << " is holding " << stats.live_bytes << " bytes" << std::endl;
+ * }
+ * }
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **统计范围**: 只统计通过 TrackingAllocator 分配或手动记录的内存。Queue<T> 等容器只统计容器自身的存储，元素内部的堆内存（如 std::vector 元素的数据）需要元素类型自己使用带标签的分配器。
+ * - **标签生命周期**: 标签由 MemoryTracker 创建并在进程生命周期内保持有效，指针可以放心保存；相同名称返回同一个标签。
+ * - **线程安全**: 标签计数使用原子操作，可在任意线程中更新；注册表操作由互斥锁保护。
+ * - **速率**: `Snapshot()` 中的速率是相对上一次调用 `Snapshot()`（或 `Dump()`）计算的，多个调用方交替调用时会互相影响。
+ */
+
+#ifndef LSX_LIB_MEMORY_MEMORY_TRACKER_H
+#define LSX_LIB_MEMORY_MEMORY_TRACKER_H
+#pragma once
+#include <atomic> // For counters
+#include <chrono> // For rate calculation
+#include <cstddef> // For size_t
+#include <cstdint> // For uint64_t
+#include <map> // For tag registry
+#include <memory> // For std::allocator, std::unique_ptr
+#include <mutex> // For std::mutex
+#include <ostream> // For Dump
+#include <string> // For tag names
+#include <type_traits> // For std::true_type
+#include <vector> // For snapshots
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB {
+    /**
+     * @brief 内存管理相关的命名空间。
+     * 包含内存缓冲区和相关工具。
+     */
+    namespace Memory {
+
+        /**
+         * @brief 一个内存统计标签。
+         * 由 MemoryTracker::Tag 创建，所有计数均为原子操作。
+         */
+        class MemoryTag {
+        public:
+            /**
+             * @brief 构造函数。通常通过 MemoryTracker::Tag 获取标签，而不是直接构造。
+             *
+             * @param name 标签名称。
+             */
+            explicit MemoryTag(std::string name) : name_(std::move(name)) {}
+
+            // Prevent copying and assignment
+            MemoryTag(const MemoryTag&) = delete;
+            MemoryTag& operator=(const MemoryTag&) = delete;
+
+            /**
+             * @brief 获取标签名称。
+             */
+            const std::string& Name() const { return name_; }
+
+            /**
+             * @brief 记录一次分配。
+             *
+             * @param bytes 分配的字节数。
+             */
+            void RecordAllocation(size_t bytes) {
+                const uint64_t live = live_bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+                total_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+                allocations_.fetch_add(1, std::memory_order_relaxed);
+                uint64_t peak = peak_bytes_.load(std::memory_order_relaxed);
+                while (live > peak && !peak_bytes_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+                }
+            }
+
+            /**
+             * @brief 记录一次释放。
+             *
+             * @param bytes 释放的字节数，应与对应的分配一致。
+             */
+            void RecordDeallocation(size_t bytes) {
+                live_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+                deallocations_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief 当前占用的字节数。
+             */
+            uint64_t LiveBytes() const { return live_bytes_.load(std::memory_order_relaxed); }
+            /**
+             * @brief 占用字节数的峰值（自创建或上次 ResetPeak 起）。
+             */
+            uint64_t PeakBytes() const { return peak_bytes_.load(std::memory_order_relaxed); }
+            /**
+             * @brief 累计分配的字节数。
+             */
+            uint64_t TotalAllocatedBytes() const { return total_bytes_.load(std::memory_order_relaxed); }
+            /**
+             * @brief 累计分配次数。
+             */
+            uint64_t AllocationCount() const { return allocations_.load(std::memory_order_relaxed); }
+            /**
+             * @brief 累计释放次数。
+             */
+            uint64_t DeallocationCount() const { return deallocations_.load(std::memory_order_relaxed); }
+
+            /**
+             * @brief 把峰值重置为当前占用。
+             */
+            void ResetPeak() { peak_bytes_.store(LiveBytes(), std::memory_order_relaxed); }
+
+        private:
+            const std::string name_; // Tag name
+            std::atomic<uint64_t> live_bytes_{0}; // Currently allocated bytes
+            std::atomic<uint64_t> peak_bytes_{0}; // High-water mark of live_bytes_
+            std::atomic<uint64_t> total_bytes_{0}; // Bytes allocated since creation
+            std::atomic<uint64_t> allocations_{0}; // Allocation count
+            std::atomic<uint64_t> deallocations_{0}; // Deallocation count
+        };
+
+        /**
+         * @brief 进程内的内存标签注册表。
+         */
+        class MemoryTracker {
+        public:
+            /**
+             * @brief 一个标签的统计快照。
+             */
+            struct TagStats {
+                std::string name; ///< 标签名称
+                uint64_t live_bytes = 0; ///< 当前占用字节数
+                uint64_t peak_bytes = 0; ///< 峰值字节数
+                uint64_t total_allocated_bytes = 0; ///< 累计分配字节数
+                uint64_t allocation_count = 0; ///< 累计分配次数
+                uint64_t deallocation_count = 0; ///< 累计释放次数
+                double allocations_per_s = 0.0; ///< 自上次快照以来的分配次数速率
+                double bytes_per_s = 0.0; ///< 自上次快照以来的分配字节速率
+            };
+
+            /**
+             * @brief 获取全局注册表。
+             * 注册表在首次使用时创建且永不销毁，因此静态对象析构期间释放内存也是安全的。
+             */
+            static MemoryTracker& Instance();
+
+            /**
+             * @brief 获取指定名称的标签，不存在时创建。
+             *
+             * @param name 标签名称，建议使用 "子系统.对象" 形式，如 "net.rx_queue"。
+             * @return 标签指针，在进程生命周期内有效。
+             */
+            MemoryTag* Tag(const std::string& name);
+
+            /**
+             * @brief 获取所有标签的统计快照，按名称排序。
+             * 同时把当前计数保存为下一次速率计算的基准。
+             */
+            std::vector<TagStats> Snapshot();
+
+            /**
+             * @brief 把所有标签按当前占用从大到小输出为文本表格。
+             *
+             * @param os 输出流。
+             */
+            void Dump(std::ostream& os);
+
+            /**
+             * @brief 以字符串形式返回 Dump 的内容。
+             */
+            std::string DumpString();
+
+            /**
+             * @brief 把所有标签的峰值重置为当前占用。
+             */
+            void ResetPeaks();
+
+        private:
+            MemoryTracker() = default;
+
+            /**
+             * @brief 上一次快照时的计数，用于计算速率。
+             */
+            struct RateBase {
+                uint64_t allocations = 0;
+                uint64_t bytes = 0;
+                std::chrono::steady_clock::time_point time;
+            };
+
+            std::mutex mutex_; // Protects tags_ and rate_bases_
+            std::map<std::string, std::unique_ptr<MemoryTag>> tags_; // Registered tags
+            std::map<std::string, RateBase> rate_bases_; // Counters at the previous snapshot
+        };
+
+        /**
+         * @brief 携带内存标签的标准分配器 (模板)。
+         * 标签为空时等同于 std::allocator。标签随容器的拷贝、移动和交换一起传递。
+         *
+         * @tparam T 分配的元素类型。
+         */
+        template<typename T>
+        class TrackingAllocator {
+        public:
+            using value_type = T;
+            using propagate_on_container_copy_assignment = std::true_type;
+            using propagate_on_container_move_assignment = std::true_type;
+            using propagate_on_container_swap = std::true_type;
+
+            /**
+             * @brief 构造一个不统计的分配器。
+             */
+            TrackingAllocator() noexcept = default;
+
+            /**
+             * @brief 构造一个把分配记录到 tag 的分配器。
+             *
+             * @param tag 内存标签，为 nullptr 时不统计。
+             */
+            explicit TrackingAllocator(MemoryTag* tag) noexcept : tag_(tag) {}
+
+            template<typename U>
+            TrackingAllocator(const TrackingAllocator<U>& other) noexcept : tag_(other.Tag()) {}
+
+            T* allocate(size_t n) {
+                T* p = std::allocator<T>().allocate(n);
+                if (tag_ != nullptr) {
+                    tag_->RecordAllocation(n * sizeof(T));
+                }
+                return p;
+            }
+
+            void deallocate(T* p, size_t n) noexcept {
+                if (tag_ != nullptr) {
+                    tag_->RecordDeallocation(n * sizeof(T));
+                }
+                std::allocator<T>().deallocate(p, n);
+            }
+
+            /**
+             * @brief 获取分配器的标签，可能为 nullptr。
+             */
+            MemoryTag* Tag() const noexcept { return tag_; }
+
+            template<typename U>
+            bool operator==(const TrackingAllocator<U>& other) const noexcept { return tag_ == other.Tag(); }
+            template<typename U>
+            bool operator!=(const TrackingAllocator<U>& other) const noexcept { return tag_ != other.Tag(); }
+
+        private:
+            MemoryTag* tag_ = nullptr; // Accounting target, or nullptr for untracked
+        };
+
+    } // namespace Memory
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_MEMORY_MEMORY_TRACKER_H
@@ -2,8 +2,9 @@
  * @file Pipe.h
  * @brief 管道类 (模板)
  * @details 定义了 LSX_LIB::Memory 命名空间下的 Pipe 类，
- * 用于实现一个线程安全的、基于 std::deque 的数据传输管道，通常用于字节流（可变长度）。
- * 提供非阻塞和阻塞（带超时）的数据写入（Write/Put）和读取（Read/Get）操作。
+ * 用于实现一个线程安全的、基于连续内存缓冲区的数据传输管道，通常用于字节流（可变长度）。
+ * 提供非阻塞和阻塞（带超时）的数据写入（Write/Put）和读取（Read/Get）操作，
+ * 以及基于 SIMD 的分隔符/模式查找（FindByte/FindPattern）和按分隔符分帧读取（ReadUntil）。
  * 类内部使用 std::mutex 和 std::condition_variable 来保证在多线程环境下的线程安全访问和同步。
  * 此实现通常是无界的（受限于系统内存）。
  * 类禁用了拷贝和赋值，以避免线程同步状态的复杂性。
@@ -13,12 +14,14 @@
  *
  * ### 核心功能
  * - **可变长度数据**: 支持传输可变长度的数据块（字节流）。
- * - **基于 Deque**: 利用 `std::deque` 作为底层容器，支持高效地在两端进行读写。
+ * - **连续存储**: 底层使用 `std::vector` 加读偏移实现，数据始终连续，读写均为整块 memcpy，已读部分按需压缩回收。
  * - **非阻塞操作**: 提供 `Write`/`Put` 和 `Read`/`Get` 方法，在管道空时立即返回（对于 Read/Get）。
  * - **阻塞操作**: 提供 `WriteBlocking` 和 `ReadBlocking` 方法，支持无限等待、非阻塞或带超时等待。
  * - **线程安全**: 使用内部互斥锁 (`std::mutex`) 保护对管道状态和底层缓冲区的并发访问，使用条件变量 (`std::condition_variable`) 实现阻塞操作的线程同步。
  * - **状态查询**: 提供 `IsEmpty`, `Size` 方法查询管道状态。
  * - **Peek 操作**: 支持查看管道头部的数据而不将其移除。
+ * - **分帧查找**: `FindByte`/`FindPattern` 直接在内部存储上进行向量化查找（见 ByteSearch.h），`ReadUntil`/`ReadUntilBlocking` 按分隔符读取完整的一帧（如 NMEA、AT 命令、按行分隔的 JSON）。
+ * - **事件循环集成**: `EnableNotification()` 后 `NativeHandle()` 返回一个在管道非空时可读的描述符，可与套接字一起加入 epoll/poll，参见 ReadyNotifier.h。
  * - **资源管理**: RAII 模式，`std::deque` 自动管理内存。
  *
  * ### 使用示例
@@ -29,6 +32,7 @@
  * #include <vector>
  * #include <thread>
  * #include <string>
+ * #include <cstring>
  * #include <chrono>
  *
  * // 创建一个 Pipe 实例
@@ -96,14 +100,24 @@
  * byte_pipe.Clear();
  * std::cout << "Pipe cleared. IsEmpty: " << byte_pipe.IsEmpty() << std::endl;
  *
+ * // 示例：按行分帧读取 (NMEA 语句以 "\r\n" 结尾)
+ * const char* nmea = "$GPGGA,123519,4807.038,N*47\r\n$GPRMC,1235";
+ * byte_pipe.Write(reinterpret_cast<const uint8_t*>(nmea), std::strlen(nmea));
+ * if (auto frame = byte_pipe.ReadUntil('\n')) {
+ * std::cout << "完整语句: " << std::string(frame->begin(), frame->end()); // 包含 "\r\n"
+ * }
+ * // 剩余的 "$GPRMC,1235" 留在管道中，等待后续数据补齐
+ * auto next = byte_pipe.ReadUntilBlocking('\n', 100); // 最多等待 100ms
+ *
  * std::cout << "主线程退出。" << std::endl;
  * return 0;
  * }
  * @endcode
  *
  * ### 注意事项
- * - **无界**: 基于 std::deque，Pipe 通常是无界的。如果需要固定容量或阻塞写入直到有空间可用，需要修改实现并设置容量限制。当前的 WriteBlocking 在无界情况下行为与 Write 相同。
- * - **数据复制**: `Write`, `Read`, `Peek` 方法都涉及数据的复制。对于需要避免复制的场景，可能需要修改接口以返回指向内部缓冲区的指针（但需谨慎处理生命周期和线程安全）。
+ * - **无界**: 底层缓冲区按需增长，Pipe 通常是无界的。如果需要固定容量或阻塞写入直到有空间可用，需要修改实现并设置容量限制。当前的 WriteBlocking 在无界情况下行为与 Write 相同。
+ * - **数据复制**: `Write`, `Read`, `Peek` 方法都涉及数据的复制。`FindByte`/`FindPattern` 在锁内直接查找内部存储，不复制数据；`ReadUntil` 只复制找到的那一帧。
+ * - **查找偏移**: `FindByte`/`FindPattern` 返回的偏移量相对于管道当前头部（即下一次 `Read` 读到的第一个字节）。
  * - **线程安全**: 所有公共方法都通过互斥锁保护，支持多线程访问。阻塞方法使用条件变量进行同步。
  * - **阻塞超时**: 阻塞方法的超时参数以毫秒为单位。超时为 -1 表示无限等待，0 表示非阻塞。
  * - **异常处理**: `Read` 和 `Peek` 在尝试读取超过可用数据时不会抛出异常，而是返回实际读取的字节数（可能为 0）。
@@ -117,7 +131,8 @@
 #include "GlobalErrorMutex.h"
 // 包含 LIBLSX::LockManager::LockGuard 头文件
 #include "LockGuard.h"
-#include <deque> // For std::deque
+#include "ReadyNotifier.h" // For pollable readiness notification
+#include "MemoryTracker.h" // For optional memory accounting (TrackingAllocator)
 #include <cstdint> // For uint8_t
 #include <vector> // For std::vector
 #include <optional> // For Peek methods (std::optional, C++17)
@@ -150,10 +165,20 @@ namespace LSX_LIB {
         class Pipe {
         private:
             /**
-             * @brief 存储管道数据的底层 deque。
-             * 用于实现高效的双端读写。
+             * @brief 存储管道数据的底层连续缓冲区。
+             * 有效数据位于 [read_pos_, byte_stream_.size())，保证连续以便整块复制和 SIMD 查找。
+             */
+            std::vector<uint8_t, TrackingAllocator<uint8_t>> byte_stream_;
+            /**
+             * @brief 读偏移。
+             * 指向 byte_stream_ 中下一个待读取的字节，已读部分在 compact_unsafe() 中回收。
              */
-            std::deque<uint8_t> byte_stream_;
+            size_t read_pos_ = 0;
+            /**
+             * @brief 自创建以来从管道头部移除的字节总数。
+             * 用于 ReadUntilBlocking 在多个读取者并存时换算已扫描位置。
+             */
+            size_t consumed_total_ = 0;
             /**
              * @brief 互斥锁。
              * 用于保护 byte_stream_ 的并发访问，确保线程安全。
@@ -172,6 +197,33 @@ namespace LSX_LIB {
             std::condition_variable cv_write_; // For blocking writes (if bounded)
             // size_t capacity_ = std::numeric_limits<size_t>::max(); // Conceptual unbounded capacity
             // size_t capacity_ = 1024; // Example capacity for a bounded pipe
+            /**
+             * @brief 可选的就绪通知描述符，管道中有数据时可读。
+             */
+            ReadyNotifier notifier_;
+
+            /**
+             * @brief 管道中可读数据的起始地址 (调用者须持有锁)。
+             */
+            const uint8_t* data_unsafe() const { return byte_stream_.data() + read_pos_; }
+            /**
+             * @brief 管道中可读数据的字节数 (调用者须持有锁)。
+             */
+            size_t size_unsafe() const { return byte_stream_.size() - read_pos_; }
+            /**
+             * @brief 从头部移除 count 个字节并复制到 buffer (调用者须持有锁，buffer 可为 nullptr 表示丢弃)。
+             */
+            void consume_unsafe(uint8_t* buffer, size_t count);
+            /**
+             * @brief 回收已读部分的空间 (调用者须持有锁)。
+             * 当已读部分超过缓冲区的一半时，将剩余数据移动到缓冲区头部，使摊还复杂度保持 O(1)。
+             */
+            void compact_unsafe();
+            /**
+             * @brief 在可读数据中从 start 开始查找分隔符 (调用者须持有锁)。
+             * @return 分隔符起始位置相对于头部的偏移，未找到返回 std::nullopt。
+             */
+            std::optional<size_t> find_unsafe(const uint8_t* pattern, size_t pattern_size, size_t start) const;
 
 
         public:
@@ -181,9 +233,16 @@ namespace LSX_LIB {
              */
             // Constructor/Destructor
             Pipe(); // Constructor definition will be in .cpp
+            /**
+             * @brief 构造函数，启用内存统计。
+             * 底层存储通过 TrackingAllocator 分配，占用计入 memory_tag，参见 MemoryTracker。
+             *
+             * @param memory_tag 内存统计标签（由 MemoryTracker::Instance().Tag(...) 获取），为 nullptr 时不统计。
+             */
+            explicit Pipe(MemoryTag* memory_tag);
             /**
              * @brief 析构函数。
-             * 清理 Pipe 对象，由 std::deque 自动释放内存。
+             * 清理 Pipe 对象，由 std::vector 自动释放内存。
              */
             ~Pipe(); // Destructor definition will be in .cpp
 
@@ -313,6 +372,72 @@ namespace LSX_LIB {
             std::vector<uint8_t> Peek(size_t size) const; // Convenience method
 
 
+            // --- Search / Framing Functions ---
+            /**
+             * @brief 在管道数据中查找字节 (非阻塞，不移除数据)。
+             * 直接在内部存储上使用 SIMD 查找，不复制数据。
+             *
+             * @param value 要查找的字节值。
+             * @param start 开始查找的位置，相对于管道头部的偏移。
+             * @return 第一个匹配字节相对于管道头部的偏移；未找到返回 std::nullopt。
+             */
+            std::optional<size_t> FindByte(uint8_t value, size_t start = 0) const;
+
+            /**
+             * @brief 在管道数据中查找字节序列 (非阻塞，不移除数据)。
+             * 直接在内部存储上使用 SIMD 查找，不复制数据。
+             *
+             * @param pattern 指向要查找的字节序列。
+             * @param pattern_size 字节序列的长度。
+             * @param start 开始查找的位置，相对于管道头部的偏移。
+             * @return 第一次匹配起始位置相对于管道头部的偏移；未找到或参数无效返回 std::nullopt。
+             */
+            std::optional<size_t> FindPattern(const uint8_t* pattern, size_t pattern_size, size_t start = 0) const;
+            /**
+             * @brief 在管道数据中查找字节序列 (非阻塞，不移除数据)。
+             * 便利方法，参见 FindPattern(const uint8_t*, size_t, size_t)。
+             */
+            std::optional<size_t> FindPattern(const std::vector<uint8_t>& pattern, size_t start = 0) const;
+
+            /**
+             * @brief 读取一帧以 delimiter 结尾的数据 (非阻塞)。
+             * 如果管道中存在 delimiter，且从头部到 delimiter（含）的长度不超过 size，
+             * 则将这一帧复制到 buffer 并从管道中移除；否则管道保持不变并返回 0。
+             *
+             * @param delimiter 帧分隔符。
+             * @param buffer 指向用于存储帧数据的缓冲区。
+             * @param size 缓冲区大小。
+             * @return 读取的帧长度（包含分隔符）；未找到分隔符、帧长度超过 size 或参数无效时返回 0。
+             */
+            size_t ReadUntil(uint8_t delimiter, uint8_t* buffer, size_t size);
+            /**
+             * @brief 读取一帧以 delimiter 结尾的数据，并返回其拷贝 (非阻塞)。
+             *
+             * @param delimiter 帧分隔符。
+             * @return 包含完整一帧（含分隔符）的 std::vector；未找到分隔符时返回 std::nullopt，管道保持不变。
+             */
+            std::optional<std::vector<uint8_t>> ReadUntil(uint8_t delimiter);
+            /**
+             * @brief 读取一帧以字节序列 delimiter 结尾的数据，并返回其拷贝 (非阻塞)。
+             * 适用于多字节分隔符，例如 "\r\n"。
+             *
+             * @param delimiter 帧分隔符序列，不能为空。
+             * @return 包含完整一帧（含分隔符）的 std::vector；未找到分隔符时返回 std::nullopt，管道保持不变。
+             */
+            std::optional<std::vector<uint8_t>> ReadUntil(const std::vector<uint8_t>& delimiter);
+
+            /**
+             * @brief 读取一帧以 delimiter 结尾的数据 (阻塞)。
+             * 如果管道中没有完整的一帧，线程将等待直到新数据中出现分隔符，或直到超时发生。
+             * 每次被唤醒时只查找新写入的数据，不会重复扫描已检查过的部分。
+             *
+             * @param delimiter 帧分隔符。
+             * @param timeout_ms 等待超时时间，单位为毫秒。参见 ReadBlocking(uint8_t*, size_t, long) 的说明。
+             * @return 包含完整一帧（含分隔符）的 std::vector；超时返回 std::nullopt，管道保持不变。
+             */
+            std::optional<std::vector<uint8_t>> ReadUntilBlocking(uint8_t delimiter, long timeout_ms = -1);
+
+
             // --- Data Access Functions (Blocking) ---
             /**
              * @brief 从管道头部读取数据 (阻塞)。
@@ -387,6 +512,22 @@ namespace LSX_LIB {
             // Get the number of bytes currently in the pipe stream
             size_t Size() const;
 
+            // --- Event Loop Integration ---
+            /**
+             * @brief 启用可轮询的就绪通知。
+             * 创建一个在管道非空时可读、被取空后不可读的描述符（Linux 上为 eventfd），参见 ReadyNotifier。
+             *
+             * @return 成功返回 true；平台不支持或创建失败返回 false。已启用时直接返回 true。
+             */
+            bool EnableNotification();
+
+            /**
+             * @brief 获取就绪通知描述符，可加入 epoll/poll/select 等待可读。
+             *
+             * @return 描述符；未启用通知时返回 -1。
+             */
+            int NativeHandle() const;
+
             // Pipe is typically unbounded unless a capacity is set internally.
             // bool IsFull() const;     // If bounded (Not applicable for current unbounded implementation)
             // size_t Capacity() const; // If bounded (Not applicable for current unbounded implementation)
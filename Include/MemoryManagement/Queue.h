@@ -19,6 +19,7 @@
  * - **线程安全**: 使用内部互斥锁 (`std::mutex`) 保护对队列的并发访问。
  * - **状态查询**: 提供 `IsEmpty`, `Size` 方法查询队列状态。
  * - **Peek 操作**: 支持查看队列头部的元素而不将其移除。
+ * - **事件循环集成**: `EnableNotification()` 后 `NativeHandle()` 返回一个在队列非空时可读的描述符，可与套接字一起加入 epoll/poll，参见 ReadyNotifier.h。
  * - **资源管理**: RAII 模式, `std::deque` 自动管理内存。
  *
  * ### 使用示例
@@ -108,6 +109,8 @@
 #include "GlobalErrorMutex.h"
 // 包含 LIBLSX::LockManager::LockGuard 头文件
 #include "LockGuard.h"
+#include "ReadyNotifier.h" // For pollable readiness notification
+#include "MemoryTracker.h" // For optional memory accounting (TrackingAllocator)
 #include <deque> // For std::deque
 #include <optional> // For std::optional (C++17)
 #include <stdexcept> // For exceptions (std::out_of_range)
@@ -144,12 +147,16 @@ namespace LSX_LIB {
              * @brief 存储队列数据的底层 std::deque。
              * 提供了高效的双端操作，std::queue 默认使用它作为底层容器。
              */
-            std::deque<T> data_deque_; // std::queue uses std::deque by default
+            std::deque<T, TrackingAllocator<T>> data_deque_; // std::queue uses std::deque by default
             /**
              * @brief 互斥锁。
              * 用于保护 data_deque_ 的并发访问，确保线程安全。
              */
             mutable std::mutex mutex_; // Thread safety mutex
+            /**
+             * @brief 可选的就绪通知描述符，队列中有元素时可读。
+             */
+            ReadyNotifier notifier_;
             // std::condition_variable cv_read_; // For potential blocking operations (commented out in provided code)
             // std::condition_variable cv_write_; // For potential blocking operations (commented out in provided code)
 
@@ -161,6 +168,13 @@ namespace LSX_LIB {
              * 创建一个空的 Queue。
              */
             Queue() = default;
+            /**
+             * @brief 构造函数，启用内存统计。
+             * 底层存储通过 TrackingAllocator 分配，占用计入 memory_tag，参见 MemoryTracker。
+             *
+             * @param memory_tag 内存统计标签（由 MemoryTracker::Instance().Tag(...) 获取），为 nullptr 时不统计。
+             */
+            explicit Queue(MemoryTag* memory_tag) : data_deque_(TrackingAllocator<T>(memory_tag)) {}
             /**
              * @brief 析构函数。
              * 默认析构函数，由 std::deque 自动管理底层内存释放。
@@ -189,6 +203,7 @@ namespace LSX_LIB {
             void Clear() {
                 std::lock_guard<std::mutex> lock(mutex_); // Thread safe clear
                 data_deque_.clear(); // std::deque::clear()
+                notifier_.Reset();
                 // std::cout << "Queue: Cleared." << std::endl; // Use logging
                 // cv_write_.notify_all(); // Notify potential waiting writers (if blocking was enabled)
                 // cv_read_.notify_all(); // Notify potential waiting readers (if blocking was enabled)
@@ -206,10 +221,23 @@ namespace LSX_LIB {
             void Push(const T& value) {
                 std::lock_guard<std::mutex> lock(mutex_); // Thread safe push
                 data_deque_.push_back(value);
+                notifier_.Signal(); // No syscall unless the queue was empty
                 // std::cout << "Queue: Pushed value." << std::endl; // Use logging
                 // cv_read_.notify_one(); // Notify potential waiting readers (if blocking was enabled)
             }
 
+            /**
+             * @brief 将一个元素移动到队列尾部 (非阻塞)。
+             * 适用于拷贝代价高或只能移动的元素（如 std::vector、std::unique_ptr）。
+             *
+             * @param value 要放入的元素，调用后处于被移动状态。
+             */
+            void Push(T&& value) {
+                std::lock_guard<std::mutex> lock(mutex_); // Thread safe push
+                data_deque_.push_back(std::move(value));
+                notifier_.Signal(); // No syscall unless the queue was empty
+            }
+
             /**
              * @brief 将一个元素添加到队列尾部 (非阻塞)。
              * 便利方法，别名 Push。
@@ -236,6 +264,9 @@ namespace LSX_LIB {
                 }
                 T value = std::move(data_deque_.front()); // Use move for efficiency if T supports it
                 data_deque_.pop_front();
+                if (data_deque_.empty()) {
+                    notifier_.Reset(); // Drained: descriptor no longer readable
+                }
                 // std::cout << "Queue: Popped value." << std::endl; // Use logging
                 // cv_write_.notify_one(); // Notify potential waiting writers (if blocking was enabled)
                 return value;
@@ -291,6 +322,34 @@ namespace LSX_LIB {
                 return data_deque_.size();
             }
 
+            // --- Event Loop Integration ---
+            /**
+             * @brief 启用可轮询的就绪通知。
+             * 创建一个在队列非空时可读、被取空后不可读的描述符（Linux 上为 eventfd），参见 ReadyNotifier。
+             *
+             * @return 成功返回 true；平台不支持或创建失败返回 false。已启用时直接返回 true。
+             */
+            bool EnableNotification() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!notifier_.Enable()) {
+                    return false;
+                }
+                if (!data_deque_.empty()) {
+                    notifier_.Signal(); // Elements queued before enabling must still wake the poller
+                }
+                return true;
+            }
+
+            /**
+             * @brief 获取就绪通知描述符，可加入 epoll/poll/select 等待可读。
+             *
+             * @return 描述符；未启用通知时返回 -1。
+             */
+            int NativeHandle() const {
+                std::lock_guard<std::mutex> lock(mutex_);
+                return notifier_.NativeHandle();
+            }
+
             // Queue is typically unbounded (std::deque). Capacity is conceptual infinite.
             // size_t Capacity() const; // Not applicable for unbounded queue
             // bool IsFull() const; // Not applicable for unbounded queue (unless memory is exhausted)
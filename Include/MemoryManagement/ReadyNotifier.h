@@ -0,0 +1,136 @@
+/**
+ * @file ReadyNotifier.h
+ * @brief 可轮询的数据就绪通知器
+ * @details 定义了 LSX_LIB::Memory 命名空间下的 ReadyNotifier 类，
+ * 为 FixedSizeQueue、Pipe、Queue、CircularQueue 等容器提供一个可放入 epoll/poll/select 的文件描述符。
+ * 容器有数据时描述符可读，被取空时描述符不可读，从而让一个 I/O 线程同时等待 "套接字可读" 和 "队列非空"，
+ * 而无需为每个队列单独开一个阻塞线程。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **可轮询句柄**: Linux 上使用 eventfd，其他 POSIX 平台使用非阻塞的管道对；`NativeHandle()` 返回可读端描述符。
+ * - **电平语义**: 容器从空变为非空时置位（描述符可读），被取空或清空时复位（描述符不可读）。
+ * - **通知抑制**: 已置位期间的后续写入不再触发系统调用，即消费者尚未取空队列时生产者不产生额外的唤醒开销。
+ * - **按需启用**: 默认不创建描述符，容器调用 `EnableNotification()` 后才启用，不使用时没有任何开销。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "FixedSizeQueue.h"
+ * #include <sys/epoll.h>
+ *
+ * LSX_LIB::Memory::FixedSizeQueue queue(256, 64);
+ *
+ * void io_loop(int socket_fd) {
+ * queue.EnableNotification();
+ * int ep = epoll_create1(0);
+ * epoll_event ev{};
+ * ev.events = EPOLLIN;
+ * ev.data.fd = socket_fd;
+ * epoll_ctl(ep, EPOLL_CTL_ADD, socket_fd, &ev);
+ * ev.data.fd = queue.NativeHandle();
+ * epoll_ctl(ep, EPOLL_CTL_ADD, queue.NativeHandle(), &ev);
+ *
+ * uint8_t block[256];
+ * epoll_event events[8];
+ * while (true) {
+ * int n = epoll_wait(ep, events, 8, -1);
+ * for (int i = 0; i < n; ++i) {
+ * if (events[i].data.fd == queue.NativeHandle()) {
+ * while (queue.Get(block, sizeof(block))) {
+ * // 处理队列中的块；取空后描述符自动变为不可读
+ * }
+ * } else {
+ * // 处理套接字数据
+ * }
+ * }
+ * }
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **不要读写描述符**: 描述符的计数由容器维护，只能把它加入 epoll/poll/select 等待可读，不能自行 read/write 或 close。
+ * - **同步**: ReadyNotifier 本身不加锁，`Signal`/`Reset` 必须在所属容器的互斥锁保护下调用。
+ * - **取空**: 描述符可读表示 "容器中可能有数据"。多个消费者并存时，被唤醒的线程应使用非阻塞的 Get/Read 并处理取不到数据的情况。
+ * - **平台**: Windows 上不支持，`Enable` 返回 false，`NativeHandle` 返回 -1。
+ * - **拷贝/移动**: 类禁用了拷贝构造和赋值。
+ */
+
+#ifndef LSX_LIB_MEMORY_READY_NOTIFIER_H
+#define LSX_LIB_MEMORY_READY_NOTIFIER_H
+#pragma once
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB {
+    /**
+     * @brief 内存管理相关的命名空间。
+     * 包含内存缓冲区和相关工具。
+     */
+    namespace Memory {
+
+        /**
+         * @brief 可轮询的数据就绪通知器。
+         * 持有一个 eventfd（或管道对），由所属容器在 "空 -> 非空" 时置位、在取空时复位。
+         */
+        class ReadyNotifier {
+        public:
+            /**
+             * @brief 构造函数。不创建描述符。
+             */
+            ReadyNotifier() = default;
+
+            /**
+             * @brief 析构函数。关闭描述符。
+             */
+            ~ReadyNotifier();
+
+            // Prevent copying and assignment
+            ReadyNotifier(const ReadyNotifier&) = delete;
+            ReadyNotifier& operator=(const ReadyNotifier&) = delete;
+
+            /**
+             * @brief 创建描述符。已启用时直接返回 true。
+             *
+             * @return 成功返回 true；系统调用失败或平台不支持时返回 false。
+             */
+            bool Enable();
+
+            /**
+             * @brief 关闭描述符并回到未启用状态。
+             */
+            void Disable();
+
+            /**
+             * @brief 检查是否已启用。
+             */
+            bool IsEnabled() const { return read_fd_ >= 0; }
+
+            /**
+             * @brief 获取可读端描述符，未启用时返回 -1。
+             */
+            int NativeHandle() const { return read_fd_; }
+
+            /**
+             * @brief 置位：使描述符可读。已置位或未启用时不产生系统调用。
+             */
+            void Signal();
+
+            /**
+             * @brief 复位：使描述符不可读。未置位或未启用时不产生系统调用。
+             */
+            void Reset();
+
+        private:
+            int read_fd_ = -1; // eventfd, or read end of the pipe
+            int write_fd_ = -1; // Same as read_fd_ for eventfd, write end of the pipe otherwise
+            bool signaled_ = false; // Descriptor is currently readable
+        };
+
+    } // namespace Memory
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_MEMORY_READY_NOTIFIER_H
@@ -0,0 +1,195 @@
+/**
+ * @file SampleDecode.h
+ * @brief 采样数据批量解码工具
+ * @details 定义了 LSX_LIB::Memory::SampleDecode 命名空间下的批量解码函数，
+ * 用于处理从 BRAMMapper、RegisterAccess 或 FixedSizeQueue 块中取得的原始采集数据：
+ * 大端字节序转换、10/12/14 位（及任意 1~16 位）紧密打包 ADC 采样的解包、以及整型采样到浮点的比例/偏移换算。
+ * 实现根据编译目标自动选择 NEON (ARM) 或 SSE2/SSSE3/SSE4.1/AVX2 (x86) 指令集，
+ * 不支持的平台或位宽回退到标量实现；整型解包和字节序转换的结果与标量实现逐位一致。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **字节序转换**: `ByteSwap16` / `ByteSwap32` 批量翻转 16/32 位字的字节序，支持原地转换。
+ * - **位解包**: `Unpack` 将紧密打包的 N 位采样解包为 int16_t，支持有符号（补码符号扩展）和无符号，支持高位在前 (MsbFirst) 和低位在前 (LsbFirst) 两种位序。
+ * - **比例/偏移**: `ScaleOffset` 计算 `out = sample * scale + offset`，`UnpackToFloat` 将解包与换算合并为一步。
+ * - **指令集选择**: 编译期根据 `__ARM_NEON` / `__AVX2__` / `__SSE4_1__` / `__SSSE3__` / `__SSE2__` 选择实现，可通过 `ActiveInstructionSet()` 查询。
+ *
+ * ### 打包格式
+ * 采样按顺序首尾相接组成一个位流，第 i 个采样占据位流中 [i*N, i*N+N) 这 N 位：
+ * - **MsbFirst**: 位流按字节从高位到低位排列（大端位流，FPGA/ADC 串行输出常见格式）。
+ *   例如 12 位采样 s0、s1 打包为 3 字节：`s0[11:4]`, `s0[3:0] s1[11:8]`, `s1[7:0]`。
+ * - **LsbFirst**: 位流按字节从低位到高位排列（小端位流）。
+ *   例如 12 位采样 s0、s1 打包为 3 字节：`s0[7:0]`, `s1[3:0] s0[11:8]`, `s1[11:4]`。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "SampleDecode.h"
+ * #include "BRAMMapper.h"
+ * #include "FixedSizeQueue.h"
+ * #include <vector>
+ *
+ * using namespace LSX_LIB::Memory;
+ *
+ * int main() {
+ * const size_t samples = 4096;
+ *
+ * // 1. BRAM 中的 12 位打包采样：整块读出后解包
+ * BRAMMapper bram(0x40020000, SampleDecode::PackedSize(12, samples));
+ * std::vector<uint8_t> raw(SampleDecode::PackedSize(12, samples));
+ * bram.readBlock(0, raw.data(), raw.size());
+ * std::vector<int16_t> adc(samples);
+ * SampleDecode::Unpack(raw.data(), raw.size(), 12, adc.data(), samples);
+ *
+ * // 2. 大端 32 位寄存器字：原地转换为主机字节序
+ * std::vector<uint32_t> words(256);
+ * bram.readBlock(0, words.data(), words.size() * sizeof(uint32_t));
+ * SampleDecode::ByteSwap32(words.data(), words.data(), words.size());
+ *
+ * // 3. 队列中的 14 位采样块：直接解包为电压值 (mV)
+ * FixedSizeQueue queue(SampleDecode::PackedSize(14, 1024), 8);
+ * std::vector<uint8_t> block(queue.BlockSize());
+ * std::vector<float> millivolts(1024);
+ * if (queue.GetBlocking(block.data(), block.size(), 100)) {
+ * SampleDecode::UnpackToFloat(block.data(), block.size(), 14, millivolts.data(), 1024,
+ *                             0.122f, 0.0f);
+ * }
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **无状态**: 所有函数都是无状态的纯函数，可在任意线程中并发调用；调用者负责保证处理期间内存不被修改。
+ * - **不越界读取**: 向量化循环只在剩余输入不少于 16 字节时执行，尾部使用标量实现，不会读取 `src_size` 之外的内存。
+ * - **设备内存**: 不要直接对 /dev/mem 的 O_SYNC 映射做 SIMD 解码（ARM 上对 Device 内存的非对齐/向量访问可能触发总线错误），
+ *   应先用 `BRAMMapper::readBlock` 以对齐的字访问整块复制到普通内存。
+ * - **位宽**: `Unpack` 支持 1~16 位；x86 上 1~10、12、16 位需要 SSSE3，11、13、14 位需要 SSE4.1（AVX2 一次处理 16 个采样），
+ *   NEON 覆盖除 15 位以外的全部位宽；其余情况使用标量实现。
+ */
+
+#ifndef LSX_LIB_MEMORY_SAMPLE_DECODE_H
+#define LSX_LIB_MEMORY_SAMPLE_DECODE_H
+#pragma once
+#include <cstddef> // For size_t
+#include <cstdint> // For uint8_t, int16_t
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB {
+    /**
+     * @brief 内存管理相关的命名空间。
+     * 包含内存缓冲区和相关工具。
+     */
+    namespace Memory {
+        /**
+         * @brief 采样数据批量解码函数的命名空间。
+         */
+        namespace SampleDecode {
+
+            /**
+             * @brief 打包位流的位序。
+             */
+            enum class BitOrder {
+                /**
+                 * @brief 高位在前（大端位流）。
+                 */
+                MsbFirst,
+                /**
+                 * @brief 低位在前（小端位流）。
+                 */
+                LsbFirst
+            };
+
+            /**
+             * @brief 批量翻转 16 位字的字节序。
+             * src 与 dst 可以相同（原地转换），但不能部分重叠。
+             *
+             * @param src 指向输入数据，至少 count * 2 字节，无对齐要求。
+             * @param dst 指向输出数据，至少 count * 2 字节，无对齐要求。
+             * @param count 16 位字的数量。
+             */
+            void ByteSwap16(const void* src, void* dst, size_t count);
+
+            /**
+             * @brief 批量翻转 32 位字的字节序。
+             * src 与 dst 可以相同（原地转换），但不能部分重叠。
+             *
+             * @param src 指向输入数据，至少 count * 4 字节，无对齐要求。
+             * @param dst 指向输出数据，至少 count * 4 字节，无对齐要求。
+             * @param count 32 位字的数量。
+             */
+            void ByteSwap32(const void* src, void* dst, size_t count);
+
+            /**
+             * @brief 计算 count 个 bits 位采样打包后占用的字节数。
+             *
+             * @param bits 每个采样的位数。
+             * @param count 采样数量。
+             * @return 打包后的字节数 (向上取整)。
+             */
+            inline size_t PackedSize(unsigned bits, size_t count) {
+                return (static_cast<size_t>(bits) * count + 7) / 8;
+            }
+
+            /**
+             * @brief 将紧密打包的 N 位采样解包为 int16_t。
+             *
+             * @param src 指向打包数据。
+             * @param src_size 打包数据的字节数，必须不小于 PackedSize(bits, count)。
+             * @param bits 每个采样的位数，范围 1~16。
+             * @param dst 指向输出缓冲区，至少 count 个元素。
+             * @param count 要解包的采样数量。
+             * @param is_signed 为 true 时将采样视为 N 位补码并做符号扩展；为 false 时输出 [0, 2^N) 的值
+             *                  （bits 为 16 时无符号结果按位存入 int16_t）。
+             * @param order 打包位序，默认 MsbFirst。
+             * @return 成功返回 true；参数无效（空指针、位宽越界、src_size 不足）返回 false。
+             */
+            bool Unpack(const uint8_t* src, size_t src_size, unsigned bits,
+                        int16_t* dst, size_t count,
+                        bool is_signed = true, BitOrder order = BitOrder::MsbFirst);
+
+            /**
+             * @brief 将 int16_t 采样换算为浮点：`dst[i] = src[i] * scale + offset`。
+             *
+             * @param src 指向输入采样。
+             * @param dst 指向输出缓冲区，至少 count 个元素。
+             * @param count 采样数量。
+             * @param scale 比例系数。
+             * @param offset 偏移量。
+             */
+            void ScaleOffset(const int16_t* src, float* dst, size_t count, float scale, float offset);
+
+            /**
+             * @brief 解包 N 位采样并直接换算为浮点：`dst[i] = sample[i] * scale + offset`。
+             * 内部按小块解包到栈上的临时缓冲区，再做换算，不分配堆内存。
+             *
+             * @param src 指向打包数据。
+             * @param src_size 打包数据的字节数，必须不小于 PackedSize(bits, count)。
+             * @param bits 每个采样的位数，范围 1~16。
+             * @param dst 指向输出缓冲区，至少 count 个元素。
+             * @param count 要解包的采样数量。
+             * @param scale 比例系数。
+             * @param offset 偏移量。
+             * @param is_signed 参见 Unpack。
+             * @param order 打包位序，默认 MsbFirst。
+             * @return 成功返回 true；参数无效返回 false。
+             */
+            bool UnpackToFloat(const uint8_t* src, size_t src_size, unsigned bits,
+                               float* dst, size_t count, float scale, float offset,
+                               bool is_signed = true, BitOrder order = BitOrder::MsbFirst);
+
+            /**
+             * @brief 获取当前编译所使用的指令集名称。
+             *
+             * @return "NEON"、"AVX2"、"SSE4.1"、"SSSE3"、"SSE2" 或 "Scalar"。
+             */
+            const char* ActiveInstructionSet();
+
+        } // namespace SampleDecode
+    } // namespace Memory
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_MEMORY_SAMPLE_DECODE_H
@@ -0,0 +1,270 @@
+/**
+ * @file StaticCircularQueue.h
+ * @brief 编译期定长的循环队列类 (模板)
+ * @details 定义了 LSX_LIB::Memory::Static 命名空间下的 CircularQueue 类模板，
+ * 它是 LSX_LIB::Memory::CircularQueue<T> 的编译期版本：可用容量 N 作为模板参数给出，
+ * 元素存储在内嵌于对象的 std::array<T, N> 中，不使用堆内存。
+ * 使用元素计数区分满/空，不再需要额外的一个槽位；N 为 2 的幂时索引回绕直接使用位掩码。
+ * 接口与运行时版本保持一致（Enqueue/Put、Dequeue/Get、Peek、Clear 及状态查询）。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **模板类**: 可存储任意可默认构造的类型 T 的元素。
+ * - **编译期容量**: 可用容量 N 为模板参数，`static_assert` 保证 N 大于 0，`Capacity()` 为 constexpr。
+ * - **内嵌存储**: 使用 `std::array<T, N>`，恰好 N 个槽位。
+ * - **位掩码索引**: N 为 2 的幂时 (`kIndexMaskable`)，头尾索引用 `& (N - 1)` 回绕。
+ * - **非阻塞操作**: `Enqueue`/`Put` 和 `Dequeue`/`Get` 在队列满或空时立即返回。
+ * - **线程安全**: 使用内部互斥锁保护队列状态和底层存储。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "StaticCircularQueue.h"
+ * #include <iostream>
+ *
+ * int main() {
+ * // 容量为 8 的整数循环队列 (2 的幂，索引使用位掩码)
+ * LSX_LIB::Memory::Static::CircularQueue<int, 8> queue;
+ *
+ * for (int i = 0; i < 10; ++i) {
+ * if (!queue.Put(i)) {
+ * std::cout << "Queue full at " << i << std::endl;
+ * }
+ * }
+ * std::cout << "Front: " << queue.Peek() << std::endl;
+ * while (auto value = queue.Get()) {
+ * std::cout << *value << " ";
+ * }
+ * std::cout << std::endl;
+ *
+ * static_assert(decltype(queue)::Capacity() == 8, "capacity is compile-time");
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **元素要求**: T 必须可默认构造（std::array 的槽位在构造时被默认初始化）。出队后的槽位保留被移动后的对象，直到被下一次入队覆盖。
+ * - **对象大小**: 存储内嵌在对象中，较大的队列应定义为静态/全局对象或放在堆上，避免线程栈溢出。
+ * - **命名空间**: 与运行时版本同名但位于 `LSX_LIB::Memory::Static` 命名空间中，两者可以同时使用。
+ * - **Peek**: 与运行时版本相同，返回常量引用；引用在元素出队或被覆盖后失效，多线程下应优先使用 `Get`。
+ * - **异常处理**: `Peek` 在队列为空时抛出 `std::out_of_range`。其他操作在失败时返回 false 或 std::nullopt。
+ * - **拷贝/移动**: 类禁用了拷贝构造和赋值。
+ */
+
+#ifndef LSX_LIB_MEMORY_STATIC_CIRCULAR_QUEUE_H
+#define LSX_LIB_MEMORY_STATIC_CIRCULAR_QUEUE_H
+#pragma once
+#include "StaticFixedSizeQueue.h" // For Static::IsPowerOfTwo
+#include <array> // For std::array
+#include <mutex> // For std::mutex, std::lock_guard
+#include <optional> // For std::optional (C++17)
+#include <stdexcept> // For std::out_of_range
+#include <utility> // For std::move
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB {
+    /**
+     * @brief 内存管理相关的命名空间。
+     * 包含内存缓冲区和相关工具。
+     */
+    namespace Memory {
+        /**
+         * @brief 编译期定长容器的命名空间。
+         */
+        namespace Static {
+
+            /**
+             * @brief 编译期定长的循环队列类 (模板)。
+             * 实现一个线程安全的、固定可用容量的循环队列，元素存储内嵌在对象中。
+             *
+             * @tparam T 队列中存储的元素类型。
+             * @tparam N 队列的可用容量。必须大于 0，为 2 的幂时索引使用位掩码。
+             */
+            template<typename T, size_t N>
+            class CircularQueue {
+                static_assert(N > 0, "Static::CircularQueue capacity must be greater than 0");
+
+            public:
+                /**
+                 * @brief 容量是否为 2 的幂（为 true 时索引回绕使用位掩码）。
+                 */
+                static constexpr bool kIndexMaskable = IsPowerOfTwo(N);
+
+            private:
+                /**
+                 * @brief 存储队列数据的底层数组，恰好 N 个槽位。
+                 */
+                std::array<T, N> data_array_{};
+                /**
+                 * @brief 队列头部索引，指向最旧的有效元素。
+                 */
+                size_t head_ = 0; // Index of the front element
+                /**
+                 * @brief 队列尾部索引，指向下一个新元素将要插入的位置。
+                 */
+                size_t tail_ = 0; // Index where the next element will be inserted
+                /**
+                 * @brief 队列中当前存储的元素数量，用于区分满和空。
+                 */
+                size_t current_size_ = 0;
+                /**
+                 * @brief 互斥锁，保护队列状态和底层数组。
+                 */
+                mutable std::mutex mutex_;
+
+                /**
+                 * @brief 计算下一个索引（编译期选择位掩码或比较回绕）。
+                 */
+                static constexpr size_t next_index(size_t index) {
+                    if constexpr (kIndexMaskable) {
+                        return (index + 1) & (N - 1);
+                    } else {
+                        return index + 1 == N ? 0 : index + 1;
+                    }
+                }
+
+            public:
+                /**
+                 * @brief 构造函数。存储内嵌在对象中，不分配内存。
+                 */
+                CircularQueue() = default;
+                /**
+                 * @brief 析构函数。
+                 */
+                ~CircularQueue() = default;
+
+                // Prevent copying and assignment
+                CircularQueue(const CircularQueue&) = delete;
+                CircularQueue& operator=(const CircularQueue&) = delete;
+
+                // --- Management Functions ---
+                /**
+                 * @brief 清空队列。重置头部、尾部和当前大小，但不析构已存储的元素。
+                 */
+                void Clear() {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    head_ = 0;
+                    tail_ = 0;
+                    current_size_ = 0;
+                }
+
+                // --- Data Access Functions (Non-blocking) ---
+                /**
+                 * @brief 将一个元素复制到队列尾部 (非阻塞)。
+                 *
+                 * @param value 要放入的元素。
+                 * @return 成功返回 true；队列已满返回 false。
+                 */
+                bool Enqueue(const T& value) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (current_size_ == N) {
+                        return false;
+                    }
+                    data_array_[tail_] = value;
+                    tail_ = next_index(tail_);
+                    ++current_size_;
+                    return true;
+                }
+
+                /**
+                 * @brief 将一个元素移动到队列尾部 (非阻塞)。
+                 *
+                 * @param value 要放入的元素。
+                 * @return 成功返回 true；队列已满返回 false（此时 value 未被移动）。
+                 */
+                bool Enqueue(T&& value) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (current_size_ == N) {
+                        return false;
+                    }
+                    data_array_[tail_] = std::move(value);
+                    tail_ = next_index(tail_);
+                    ++current_size_;
+                    return true;
+                }
+
+                /**
+                 * @brief 将一个元素添加到队列尾部 (非阻塞)。别名 Enqueue。
+                 */
+                bool Put(const T& value) { return Enqueue(value); }
+
+                /**
+                 * @brief 将一个元素移动到队列尾部 (非阻塞)。别名 Enqueue。
+                 */
+                bool Put(T&& value) { return Enqueue(std::move(value)); }
+
+                /**
+                 * @brief 从队列头部移除并返回元素 (非阻塞)。
+                 *
+                 * @return 包含取出元素的 std::optional<T>；队列为空返回 std::nullopt。
+                 */
+                std::optional<T> Dequeue() {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (current_size_ == 0) {
+                        return std::nullopt;
+                    }
+                    std::optional<T> value(std::move(data_array_[head_]));
+                    head_ = next_index(head_);
+                    --current_size_;
+                    return value;
+                }
+
+                /**
+                 * @brief 从队列头部移除并返回元素 (非阻塞)。别名 Dequeue。
+                 */
+                std::optional<T> Get() { return Dequeue(); }
+
+                /**
+                 * @brief 查看队列头部的元素，但不移除 (非阻塞)。
+                 *
+                 * @return 队列头部元素的常量引用。
+                 * @throws std::out_of_range 如果队列为空。
+                 */
+                const T& Peek() const {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (current_size_ == 0) {
+                        throw std::out_of_range("Static::CircularQueue: Queue is empty, cannot peek");
+                    }
+                    return data_array_[head_];
+                }
+
+                // --- Status Functions ---
+                /**
+                 * @brief 检查队列是否为空。
+                 */
+                bool IsEmpty() const {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    return current_size_ == 0;
+                }
+
+                /**
+                 * @brief 检查队列是否已满。
+                 */
+                bool IsFull() const {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    return current_size_ == N;
+                }
+
+                /**
+                 * @brief 获取队列中当前存储的元素数量。
+                 */
+                size_t Size() const {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    return current_size_;
+                }
+
+                /**
+                 * @brief 获取队列的最大可用容量（编译期常量）。
+                 */
+                static constexpr size_t Capacity() { return N; }
+            };
+
+        } // namespace Static
+    } // namespace Memory
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_MEMORY_STATIC_CIRCULAR_QUEUE_H
@@ -0,0 +1,235 @@
+/**
+ * @file StaticFixedSizePipe.h
+ * @brief 编译期定长的固定大小内存块管道类 (模板)
+ * @details 定义了 LSX_LIB::Memory::Static 命名空间下的 FixedSizePipe 类模板，
+ * 它是 LSX_LIB::Memory::FixedSizePipe 的编译期版本：块大小和块数量作为模板参数给出，不使用堆内存。
+ * 与运行时版本和 FixedSizeQueue 的关系相同，本类以 Static::FixedSizeQueue 为存储，
+ * 只把接口命名为管道的 Write/Read 形式。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **编译期几何**: `BlockSize`、`BlockCount` 为模板参数；块数量为 2 的幂时索引使用位掩码。
+ * - **内嵌存储**: 缓冲区内嵌在对象中，构造和析构都不分配内存。
+ * - **非阻塞操作**: `Write` / `Read` / `Peek` 在管道满或空时立即返回。
+ * - **阻塞操作**: `WriteBlocking` / `ReadBlocking` 支持无限等待、非阻塞或带超时等待。
+ * - **类型安全块**: `Block` 类型 (`std::array<uint8_t, BlockSize>`) 的重载无需传入大小。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "StaticFixedSizePipe.h"
+ * #include <iostream>
+ *
+ * // 32 字节的消息，最多缓存 8 条
+ * static LSX_LIB::Memory::Static::FixedSizePipe<32, 8> pipe;
+ *
+ * int main() {
+ * decltype(pipe)::Block message{};
+ * message[0] = 0x55;
+ * pipe.Write(message);
+ *
+ * decltype(pipe)::Block received;
+ * if (pipe.ReadBlocking(received, 100)) {
+ * std::cout << "Read message, first byte: " << static_cast<int>(received[0]) << std::endl;
+ * }
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **对象大小**: 缓冲区内嵌在对象中，较大的管道应定义为静态/全局对象或放在堆上，避免线程栈溢出。
+ * - **命名空间**: 与运行时版本同名但位于 `LSX_LIB::Memory::Static` 命名空间中，两者可以同时使用。
+ * - **阻塞超时**: 阻塞方法的超时参数以毫秒为单位。超时为 -1 表示无限等待，0 表示非阻塞。
+ * - **拷贝/移动**: 类禁用了拷贝构造和赋值。
+ */
+
+#ifndef LSX_LIB_MEMORY_STATIC_FIXED_SIZE_PIPE_H
+#define LSX_LIB_MEMORY_STATIC_FIXED_SIZE_PIPE_H
+#pragma once
+#include "StaticFixedSizeQueue.h" // Underlying storage
+#include <optional> // For std::optional (C++17)
+#include <vector> // For std::vector overloads
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB {
+    /**
+     * @brief 内存管理相关的命名空间。
+     * 包含内存缓冲区和相关工具。
+     */
+    namespace Memory {
+        /**
+         * @brief 编译期定长容器的命名空间。
+         */
+        namespace Static {
+
+            /**
+             * @brief 编译期定长的固定大小内存块管道类 (模板)。
+             * 实现一个线程安全的、传输固定大小内存块的管道，底层存储内嵌在对象中。
+             *
+             * @tparam BlockSizeV 每个内存块的大小（字节）。必须大于 0。
+             * @tparam BlockCountV 管道可以存储的最大块数量。必须大于 0，为 2 的幂时索引使用位掩码。
+             */
+            template<size_t BlockSizeV, size_t BlockCountV>
+            class FixedSizePipe {
+            public:
+                /**
+                 * @brief 单个块的类型。
+                 */
+                using Block = typename FixedSizeQueue<BlockSizeV, BlockCountV>::Block;
+
+            private:
+                /**
+                 * @brief 底层的编译期定长块队列，负责存储和同步。
+                 */
+                FixedSizeQueue<BlockSizeV, BlockCountV> queue_;
+
+            public:
+                /**
+                 * @brief 构造函数。缓冲区内嵌在对象中，不分配内存。
+                 */
+                FixedSizePipe() = default;
+                /**
+                 * @brief 析构函数。
+                 */
+                ~FixedSizePipe() = default;
+
+                // Prevent copying and assignment
+                FixedSizePipe(const FixedSizePipe&) = delete;
+                FixedSizePipe& operator=(const FixedSizePipe&) = delete;
+
+                // --- Management Functions ---
+                /**
+                 * @brief 清空管道。
+                 */
+                void Clear() { queue_.Clear(); }
+
+                // --- Data Access Functions (Non-blocking) ---
+                /**
+                 * @brief 写入一个数据块到管道 (非阻塞)。
+                 *
+                 * @param data 指向要写入数据的缓冲区。
+                 * @param data_size 要写入数据的字节数。必须等于 BlockSize()。
+                 * @return 成功返回 true；管道已满或参数无效返回 false。
+                 */
+                bool Write(const uint8_t* data, size_t data_size) { return queue_.Put(data, data_size); }
+                /**
+                 * @brief 写入一个 Block 到管道 (非阻塞)。
+                 */
+                bool Write(const Block& block) { return queue_.Put(block); }
+                /**
+                 * @brief 写入 std::vector 中的数据作为一个块 (非阻塞)。其大小必须等于 BlockSize()。
+                 */
+                bool Write(const std::vector<uint8_t>& data) { return queue_.Put(data); }
+
+                /**
+                 * @brief 从管道读取一个数据块 (非阻塞)。
+                 *
+                 * @param buffer 用于存储读取数据的缓冲区。
+                 * @param buffer_size 缓冲区大小，必须至少为 BlockSize()。
+                 * @return 成功返回 true；管道为空或参数无效返回 false。
+                 */
+                bool Read(uint8_t* buffer, size_t buffer_size) { return queue_.Get(buffer, buffer_size); }
+                /**
+                 * @brief 从管道读取一个数据块到 Block 中 (非阻塞)。
+                 */
+                bool Read(Block& block) { return queue_.Get(block); }
+                /**
+                 * @brief 从管道读取一个数据块并按值返回 (非阻塞)。管道为空返回 std::nullopt。
+                 */
+                std::optional<Block> Read() { return queue_.Get(); }
+
+                /**
+                 * @brief 查看管道头部的块，但不移除 (非阻塞)。
+                 *
+                 * @param buffer 用于存储查看数据的缓冲区。
+                 * @param buffer_size 缓冲区大小，必须至少为 BlockSize()。
+                 * @return 成功返回 true；管道为空或参数无效返回 false。
+                 */
+                bool Peek(uint8_t* buffer, size_t buffer_size) const { return queue_.Peek(buffer, buffer_size); }
+                /**
+                 * @brief 查看管道头部的块并按值返回 (非阻塞)。管道为空返回 std::nullopt。
+                 */
+                std::optional<Block> Peek() const { return queue_.Peek(); }
+
+                // --- Data Access Functions (Blocking) ---
+                /**
+                 * @brief 从管道读取一个数据块 (阻塞)。
+                 *
+                 * @param buffer 用于存储读取数据的缓冲区。
+                 * @param buffer_size 缓冲区大小，必须至少为 BlockSize()。
+                 * @param timeout_ms 等待超时时间，单位为毫秒。
+                 * - < 0: 无限等待。
+                 * - == 0: 非阻塞（行为同非阻塞 Read）。
+                 * - > 0: 最多等待指定的毫秒数。
+                 * @return 成功返回 true；超时、管道为空（非阻塞模式）或参数无效返回 false。
+                 */
+                bool ReadBlocking(uint8_t* buffer, size_t buffer_size, long timeout_ms = -1) {
+                    return queue_.GetBlocking(buffer, buffer_size, timeout_ms);
+                }
+                /**
+                 * @brief 从管道读取一个数据块到 Block 中 (阻塞)。
+                 */
+                bool ReadBlocking(Block& block, long timeout_ms = -1) { return queue_.GetBlocking(block, timeout_ms); }
+                /**
+                 * @brief 从管道读取一个数据块并按值返回 (阻塞)。超时返回 std::nullopt。
+                 */
+                std::optional<Block> ReadBlocking(long timeout_ms = -1) { return queue_.GetBlocking(timeout_ms); }
+
+                /**
+                 * @brief 写入一个数据块到管道 (阻塞)。
+                 *
+                 * @param data 指向要写入数据的缓冲区。
+                 * @param data_size 要写入数据的字节数。必须等于 BlockSize()。
+                 * @param timeout_ms 等待超时时间，参见 ReadBlocking(uint8_t*, size_t, long)。
+                 * @return 成功返回 true；超时、管道已满（非阻塞模式）或参数无效返回 false。
+                 */
+                bool WriteBlocking(const uint8_t* data, size_t data_size, long timeout_ms = -1) {
+                    return queue_.PutBlocking(data, data_size, timeout_ms);
+                }
+                /**
+                 * @brief 写入一个 Block 到管道 (阻塞)。
+                 */
+                bool WriteBlocking(const Block& block, long timeout_ms = -1) { return queue_.PutBlocking(block, timeout_ms); }
+                /**
+                 * @brief 写入 std::vector 中的数据作为一个块 (阻塞)。其大小必须等于 BlockSize()。
+                 */
+                bool WriteBlocking(const std::vector<uint8_t>& data, long timeout_ms = -1) {
+                    return queue_.PutBlocking(data, timeout_ms);
+                }
+
+                // --- Status Functions ---
+                /**
+                 * @brief 检查管道是否为空。
+                 */
+                bool IsEmpty() const { return queue_.IsEmpty(); }
+                /**
+                 * @brief 检查管道是否已满。
+                 */
+                bool IsFull() const { return queue_.IsFull(); }
+                /**
+                 * @brief 获取管道中当前存储的块数量。
+                 */
+                size_t Size() const { return queue_.Size(); }
+                /**
+                 * @brief 获取每个内存块的大小（字节，编译期常量）。
+                 */
+                static constexpr size_t BlockSize() { return BlockSizeV; }
+                /**
+                 * @brief 获取管道可以存储的最大块数量（编译期常量）。
+                 */
+                static constexpr size_t BlockCount() { return BlockCountV; }
+                /**
+                 * @brief 获取为存储块分配的总内存大小（字节，编译期常量）。
+                 */
+                static constexpr size_t TotalSize() { return BlockSizeV * BlockCountV; }
+            };
+
+        } // namespace Static
+    } // namespace Memory
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_MEMORY_STATIC_FIXED_SIZE_PIPE_H
@@ -0,0 +1,497 @@
+/**
+ * @file StaticFixedSizeQueue.h
+ * @brief 编译期定长的固定大小内存块队列类 (模板)
+ * @details 定义了 LSX_LIB::Memory::Static 命名空间下的 FixedSizeQueue 类模板，
+ * 它是 LSX_LIB::Memory::FixedSizeQueue 的编译期版本：块大小和块数量作为模板参数给出，
+ * 底层存储是内嵌在对象中的 std::array，不使用堆内存。
+ * 由于几何参数都是编译期常量，块地址计算、索引回绕和块复制 (memcpy) 都能被编译器完全展开：
+ * 块数量为 2 的幂时索引回绕直接使用位掩码。
+ * 接口与运行时版本保持一致（Put/Get/Peek/PutBlocking/GetBlocking 及状态查询），
+ * 另外提供以 std::array 为块类型的重载，省去运行时的大小检查。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **编译期几何**: `BlockSize`、`BlockCount` 为模板参数，`static_assert` 保证二者大于 0。
+ * - **内嵌存储**: 使用 `std::array<uint8_t, BlockSize * BlockCount>` 作为缓冲区，构造和析构都不分配内存。
+ * - **位掩码索引**: 块数量为 2 的幂时 (`kIndexMaskable`)，头尾索引用 `& (BlockCount - 1)` 回绕。
+ * - **定长复制**: 块复制使用编译期常量长度的 memcpy。
+ * - **类型安全块**: `Block` 类型 (`std::array<uint8_t, BlockSize>`) 的重载无需传入大小。
+ * - **阻塞操作**: `PutBlocking` / `GetBlocking` 支持无限等待、非阻塞或带超时等待。
+ * - **线程安全**: 使用内部互斥锁和条件变量，与运行时版本相同。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "StaticFixedSizeQueue.h"
+ * #include <iostream>
+ * #include <thread>
+ *
+ * // 64 字节的块，共 16 个 (2 的幂，索引使用位掩码)；放在静态存储区，避免占用线程栈
+ * static LSX_LIB::Memory::Static::FixedSizeQueue<64, 16> queue;
+ * using Block = decltype(queue)::Block;
+ *
+ * int main() {
+ * std::thread producer([] {
+ * Block block{};
+ * for (uint8_t i = 0; i < 32; ++i) {
+ * block[0] = i;
+ * queue.PutBlocking(block, 100);
+ * }
+ * });
+ *
+ * Block received;
+ * for (int i = 0; i < 32; ++i) {
+ * if (queue.GetBlocking(received, 500)) {
+ * std::cout << "Got block " << static_cast<int>(received[0]) << std::endl;
+ * }
+ * }
+ * producer.join();
+ *
+ * static_assert(decltype(queue)::TotalSize() == 64 * 16, "geometry is compile-time");
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **对象大小**: 缓冲区内嵌在对象中，对象大小约为 `BlockSize * BlockCount` 字节。较大的队列应定义为静态/全局对象或放在堆上，避免线程栈溢出。
+ * - **命名空间**: 与运行时版本同名但位于 `LSX_LIB::Memory::Static` 命名空间中，两者可以同时使用。
+ * - **内存复制**: `Put`, `Get`, `Peek` 方法都涉及数据的复制。
+ * - **阻塞超时**: 阻塞方法的超时参数以毫秒为单位。超时为 -1 表示无限等待，0 表示非阻塞。
+ * - **拷贝/移动**: 类禁用了拷贝构造和赋值。
+ */
+
+#ifndef LSX_LIB_MEMORY_STATIC_FIXED_SIZE_QUEUE_H
+#define LSX_LIB_MEMORY_STATIC_FIXED_SIZE_QUEUE_H
+#pragma once
+#include <array> // For std::array
+#include <chrono> // For std::chrono::milliseconds
+#include <condition_variable> // For std::condition_variable
+#include <cstddef> // For std::max_align_t
+#include <cstdint> // For uint8_t
+#include <cstring> // For std::memcpy
+#include <mutex> // For std::mutex, std::unique_lock
+#include <optional> // For std::optional (C++17)
+#include <vector> // For std::vector overloads
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB {
+    /**
+     * @brief 内存管理相关的命名空间。
+     * 包含内存缓冲区和相关工具。
+     */
+    namespace Memory {
+        /**
+         * @brief 编译期定长容器的命名空间。
+         * 其中的类模板与 LSX_LIB::Memory 下的同名运行时类接口一致，但几何参数在编译期确定且不使用堆内存。
+         */
+        namespace Static {
+
+            /**
+             * @brief 判断一个数是否为 2 的幂 (编译期)。
+             *
+             * @param value 要判断的数。
+             * @return value 为 2 的幂时返回 true。
+             */
+            constexpr bool IsPowerOfTwo(size_t value) {
+                return value != 0 && (value & (value - 1)) == 0;
+            }
+
+            /**
+             * @brief 编译期定长的固定大小内存块队列类 (模板)。
+             * 实现一个线程安全的、存储固定大小内存块的 FIFO 队列，底层存储内嵌在对象中。
+             *
+             * @tparam BlockSizeV 每个内存块的大小（字节）。必须大于 0。
+             * @tparam BlockCountV 队列可以存储的最大块数量。必须大于 0，为 2 的幂时索引使用位掩码。
+             */
+            template<size_t BlockSizeV, size_t BlockCountV>
+            class FixedSizeQueue {
+                static_assert(BlockSizeV > 0, "Static::FixedSizeQueue block size must be greater than 0");
+                static_assert(BlockCountV > 0, "Static::FixedSizeQueue block count must be greater than 0");
+
+            public:
+                /**
+                 * @brief 单个块的类型。
+                 */
+                using Block = std::array<uint8_t, BlockSizeV>;
+
+                /**
+                 * @brief 块数量是否为 2 的幂（为 true 时索引回绕使用位掩码）。
+                 */
+                static constexpr bool kIndexMaskable = IsPowerOfTwo(BlockCountV);
+
+            private:
+                /**
+                 * @brief 存储队列数据的底层内存缓冲区，大小为 BlockSize * BlockCount。
+                 */
+                alignas(alignof(std::max_align_t)) std::array<uint8_t, BlockSizeV * BlockCountV> buffer_{};
+                /**
+                 * @brief 队列头部索引，指向最旧的有效块。
+                 */
+                size_t head_ = 0; // Index of the first valid block
+                /**
+                 * @brief 队列尾部索引，指向下一个新块将要放入的位置。
+                 */
+                size_t tail_ = 0; // Index where the next block will be put
+                /**
+                 * @brief 队列中当前存储的块数量。
+                 */
+                size_t current_size_ = 0;
+                /**
+                 * @brief 互斥锁，保护队列状态和底层缓冲区。
+                 */
+                mutable std::mutex mutex_;
+                /**
+                 * @brief 条件变量，用于阻塞读取操作。
+                 */
+                std::condition_variable cv_read_;
+                /**
+                 * @brief 条件变量，用于阻塞写入操作。
+                 */
+                std::condition_variable cv_write_;
+
+                /**
+                 * @brief 计算下一个块索引（编译期选择位掩码或比较回绕）。
+                 *
+                 * @param index 当前索引。
+                 * @return 回绕后的下一个索引。
+                 */
+                static constexpr size_t next_index(size_t index) {
+                    if constexpr (kIndexMaskable) {
+                        return (index + 1) & (BlockCountV - 1);
+                    } else {
+                        return index + 1 == BlockCountV ? 0 : index + 1;
+                    }
+                }
+
+                // Block address helpers (assume lock is held)
+                uint8_t* block_address_unsafe(size_t index) { return buffer_.data() + index * BlockSizeV; }
+                const uint8_t* block_address_unsafe(size_t index) const { return buffer_.data() + index * BlockSizeV; }
+
+                /**
+                 * @brief 将一个块复制到队列尾部。此函数假定调用者已持有互斥锁且队列未满。
+                 */
+                void push_unsafe(const uint8_t* data) {
+                    std::memcpy(block_address_unsafe(tail_), data, BlockSizeV);
+                    tail_ = next_index(tail_);
+                    ++current_size_;
+                }
+
+                /**
+                 * @brief 将队列头部的块复制出来并移除。此函数假定调用者已持有互斥锁且队列非空。
+                 */
+                void pop_unsafe(uint8_t* buffer) {
+                    std::memcpy(buffer, block_address_unsafe(head_), BlockSizeV);
+                    head_ = next_index(head_);
+                    --current_size_;
+                }
+
+                /**
+                 * @brief 按 timeout_ms 的约定等待条件成立。此函数假定 lock 已持有互斥锁。
+                 *
+                 * @return 条件成立返回 true；非阻塞模式下条件不成立或超时返回 false。
+                 */
+                template<typename Predicate>
+                static bool wait_unsafe(std::unique_lock<std::mutex>& lock, std::condition_variable& cv,
+                                        long timeout_ms, Predicate ready) {
+                    if (ready()) {
+                        return true;
+                    }
+                    if (timeout_ms == 0) {
+                        return false;
+                    }
+                    if (timeout_ms > 0) {
+                        return cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready);
+                    }
+                    cv.wait(lock, ready);
+                    return true;
+                }
+
+            public:
+                /**
+                 * @brief 构造函数。缓冲区内嵌在对象中，不分配内存。
+                 */
+                FixedSizeQueue() = default;
+                /**
+                 * @brief 析构函数。
+                 */
+                ~FixedSizeQueue() = default;
+
+                // Prevent copying and assignment
+                FixedSizeQueue(const FixedSizeQueue&) = delete;
+                FixedSizeQueue& operator=(const FixedSizeQueue&) = delete;
+
+                // --- Management Functions ---
+                /**
+                 * @brief 清空队列。重置头部、尾部和当前大小，并唤醒等待写入的线程。
+                 */
+                void Clear() {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        head_ = 0;
+                        tail_ = 0;
+                        current_size_ = 0;
+                    }
+                    cv_write_.notify_all();
+                }
+
+                // --- Data Access Functions (Non-blocking) ---
+                /**
+                 * @brief 将一个块放入队列尾部 (非阻塞)。
+                 *
+                 * @param data 指向要放入数据的缓冲区。
+                 * @param data_size 要放入数据的字节数。必须等于 BlockSize()。
+                 * @return 成功返回 true；队列已满、data 为空或 data_size 不匹配返回 false。
+                 */
+                bool Put(const uint8_t* data, size_t data_size) {
+                    if (data == nullptr || data_size != BlockSizeV) {
+                        return false;
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        if (current_size_ == BlockCountV) {
+                            return false;
+                        }
+                        push_unsafe(data);
+                    }
+                    cv_read_.notify_one();
+                    return true;
+                }
+
+                /**
+                 * @brief 将一个 Block 放入队列尾部 (非阻塞)。
+                 *
+                 * @param block 要放入的块。
+                 * @return 成功返回 true；队列已满返回 false。
+                 */
+                bool Put(const Block& block) { return Put(block.data(), BlockSizeV); }
+
+                /**
+                 * @brief 将 std::vector 中的数据作为一个块放入队列尾部 (非阻塞)。
+                 *
+                 * @param data 要放入的数据，其大小必须等于 BlockSize()。
+                 * @return 成功返回 true；队列已满或大小不匹配返回 false。
+                 */
+                bool Put(const std::vector<uint8_t>& data) { return Put(data.data(), data.size()); }
+
+                /**
+                 * @brief 从队列头部取出一个块 (非阻塞)。
+                 *
+                 * @param buffer 用于存储取出数据的缓冲区。
+                 * @param buffer_size 缓冲区大小，必须至少为 BlockSize()。
+                 * @return 成功返回 true；队列为空、buffer 为空或 buffer_size 太小返回 false。
+                 */
+                bool Get(uint8_t* buffer, size_t buffer_size) {
+                    if (buffer == nullptr || buffer_size < BlockSizeV) {
+                        return false;
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        if (current_size_ == 0) {
+                            return false;
+                        }
+                        pop_unsafe(buffer);
+                    }
+                    cv_write_.notify_one();
+                    return true;
+                }
+
+                /**
+                 * @brief 从队列头部取出一个块到 Block 中 (非阻塞)。
+                 *
+                 * @param block 用于存储取出数据的块。
+                 * @return 成功返回 true；队列为空返回 false。
+                 */
+                bool Get(Block& block) { return Get(block.data(), BlockSizeV); }
+
+                /**
+                 * @brief 从队列头部取出一个块并按值返回 (非阻塞)。
+                 *
+                 * @return 包含取出块的 std::optional<Block>；队列为空返回 std::nullopt。
+                 */
+                std::optional<Block> Get() {
+                    Block block;
+                    if (!Get(block)) {
+                        return std::nullopt;
+                    }
+                    return block;
+                }
+
+                /**
+                 * @brief 查看队列头部的块，但不移除 (非阻塞)。
+                 *
+                 * @param buffer 用于存储查看数据的缓冲区。
+                 * @param buffer_size 缓冲区大小，必须至少为 BlockSize()。
+                 * @return 成功返回 true；队列为空、buffer 为空或 buffer_size 太小返回 false。
+                 */
+                bool Peek(uint8_t* buffer, size_t buffer_size) const {
+                    if (buffer == nullptr || buffer_size < BlockSizeV) {
+                        return false;
+                    }
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (current_size_ == 0) {
+                        return false;
+                    }
+                    std::memcpy(buffer, block_address_unsafe(head_), BlockSizeV);
+                    return true;
+                }
+
+                /**
+                 * @brief 查看队列头部的块并按值返回，但不移除 (非阻塞)。
+                 *
+                 * @return 包含头部块的 std::optional<Block>；队列为空返回 std::nullopt。
+                 */
+                std::optional<Block> Peek() const {
+                    Block block;
+                    if (!Peek(block.data(), BlockSizeV)) {
+                        return std::nullopt;
+                    }
+                    return block;
+                }
+
+                // --- Data Access Functions (Blocking) ---
+                /**
+                 * @brief 从队列头部取出一个块 (阻塞)。
+                 *
+                 * @param buffer 用于存储取出数据的缓冲区。
+                 * @param buffer_size 缓冲区大小，必须至少为 BlockSize()。
+                 * @param timeout_ms 等待超时时间，单位为毫秒。
+                 * - < 0: 无限等待。
+                 * - == 0: 非阻塞（行为同非阻塞 Get）。
+                 * - > 0: 最多等待指定的毫秒数。
+                 * @return 成功返回 true；超时、队列为空（非阻塞模式）或参数无效返回 false。
+                 */
+                bool GetBlocking(uint8_t* buffer, size_t buffer_size, long timeout_ms = -1) {
+                    if (buffer == nullptr || buffer_size < BlockSizeV) {
+                        return false;
+                    }
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        if (!wait_unsafe(lock, cv_read_, timeout_ms, [this] { return current_size_ != 0; })) {
+                            return false;
+                        }
+                        pop_unsafe(buffer);
+                    }
+                    cv_write_.notify_one();
+                    return true;
+                }
+
+                /**
+                 * @brief 从队列头部取出一个块到 Block 中 (阻塞)。
+                 *
+                 * @param block 用于存储取出数据的块。
+                 * @param timeout_ms 等待超时时间，参见 GetBlocking(uint8_t*, size_t, long)。
+                 * @return 成功返回 true；超时或队列为空（非阻塞模式）返回 false。
+                 */
+                bool GetBlocking(Block& block, long timeout_ms = -1) {
+                    return GetBlocking(block.data(), BlockSizeV, timeout_ms);
+                }
+
+                /**
+                 * @brief 从队列头部取出一个块并按值返回 (阻塞)。
+                 *
+                 * @param timeout_ms 等待超时时间，参见 GetBlocking(uint8_t*, size_t, long)。
+                 * @return 包含取出块的 std::optional<Block>；超时或队列为空（非阻塞模式）返回 std::nullopt。
+                 */
+                std::optional<Block> GetBlocking(long timeout_ms = -1) {
+                    Block block;
+                    if (!GetBlocking(block, timeout_ms)) {
+                        return std::nullopt;
+                    }
+                    return block;
+                }
+
+                /**
+                 * @brief 将一个块放入队列尾部 (阻塞)。
+                 *
+                 * @param data 指向要放入数据的缓冲区。
+                 * @param data_size 要放入数据的字节数。必须等于 BlockSize()。
+                 * @param timeout_ms 等待超时时间，参见 GetBlocking(uint8_t*, size_t, long)。
+                 * @return 成功返回 true；超时、队列已满（非阻塞模式）或参数无效返回 false。
+                 */
+                bool PutBlocking(const uint8_t* data, size_t data_size, long timeout_ms = -1) {
+                    if (data == nullptr || data_size != BlockSizeV) {
+                        return false;
+                    }
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        if (!wait_unsafe(lock, cv_write_, timeout_ms, [this] { return current_size_ != BlockCountV; })) {
+                            return false;
+                        }
+                        push_unsafe(data);
+                    }
+                    cv_read_.notify_one();
+                    return true;
+                }
+
+                /**
+                 * @brief 将一个 Block 放入队列尾部 (阻塞)。
+                 *
+                 * @param block 要放入的块。
+                 * @param timeout_ms 等待超时时间，参见 GetBlocking(uint8_t*, size_t, long)。
+                 * @return 成功返回 true；超时或队列已满（非阻塞模式）返回 false。
+                 */
+                bool PutBlocking(const Block& block, long timeout_ms = -1) {
+                    return PutBlocking(block.data(), BlockSizeV, timeout_ms);
+                }
+
+                /**
+                 * @brief 将 std::vector 中的数据作为一个块放入队列尾部 (阻塞)。
+                 *
+                 * @param data 要放入的数据，其大小必须等于 BlockSize()。
+                 * @param timeout_ms 等待超时时间，参见 GetBlocking(uint8_t*, size_t, long)。
+                 * @return 成功返回 true；超时、队列已满（非阻塞模式）或大小不匹配返回 false。
+                 */
+                bool PutBlocking(const std::vector<uint8_t>& data, long timeout_ms = -1) {
+                    return PutBlocking(data.data(), data.size(), timeout_ms);
+                }
+
+                // --- Status Functions ---
+                /**
+                 * @brief 检查队列是否为空。
+                 */
+                bool IsEmpty() const {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    return current_size_ == 0;
+                }
+
+                /**
+                 * @brief 检查队列是否已满。
+                 */
+                bool IsFull() const {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    return current_size_ == BlockCountV;
+                }
+
+                /**
+                 * @brief 获取队列中当前存储的块数量。
+                 */
+                size_t Size() const {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    return current_size_;
+                }
+
+                /**
+                 * @brief 获取每个内存块的大小（字节，编译期常量）。
+                 */
+                static constexpr size_t BlockSize() { return BlockSizeV; }
+
+                /**
+                 * @brief 获取队列可以存储的最大块数量（编译期常量）。
+                 */
+                static constexpr size_t BlockCount() { return BlockCountV; }
+
+                /**
+                 * @brief 获取为存储块分配的总内存大小（字节，编译期常量）。
+                 */
+                static constexpr size_t TotalSize() { return BlockSizeV * BlockCountV; }
+            };
+
+        } // namespace Static
+    } // namespace Memory
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_MEMORY_STATIC_FIXED_SIZE_QUEUE_H
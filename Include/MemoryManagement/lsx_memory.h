@@ -8,15 +8,25 @@
  * @version 1.0
  *
  * ### 包含模块
+ * - BlockRecorder: 高速原始数据块记录器
  * - Buffer: 通用内存缓冲区
+ * - ByteSearch: 向量化字节/模式查找
  * - CircularFixedSizeQueue: 循环固定大小内存块队列
  * - CircularQueue: 循环队列 (模板)
  * - FIFO: 先进先出队列 (模板)
  * - FixedSizePipe: 固定大小内存块管道
  * - FixedSizeQueue: 固定大小内存块队列
+ * - FlatHashMap: 开放寻址扁平哈希表 (模板)
+ * - MappedFile: 内存映射文件
+ * - MemoryTracker: 按标签的内存统计与 TrackingAllocator
  * - Pipe: 管道 (模板)
  * - Queue: 队列 (模板)
+ * - ReadyNotifier: 可轮询的数据就绪通知器 (eventfd)
+ * - SampleDecode: 采样数据批量解码 (字节序转换/位解包/比例换算)
  * - SharedMemory: 共享内存
+ * - Static::CircularQueue: 编译期定长循环队列 (模板)
+ * - Static::FixedSizePipe: 编译期定长固定大小内存块管道 (模板)
+ * - Static::FixedSizeQueue: 编译期定长固定大小内存块队列 (模板)
  *
  * ### 使用示例
  *
@@ -61,15 +71,25 @@
 #include "LockGuard.h"
 // 主头文件，包含所有内存模块的头文件
 
+#include "BlockRecorder.h" // 高速原始数据块记录器
 #include "Buffer.h" // 通用内存缓冲区
+#include "ByteSearch.h" // 向量化字节/模式查找
 #include "CircularFixedSizeQueue.h" // 循环固定大小内存块队列
 #include "CircularQueue.h" // 循环队列 (模板)
 #include "FIFO.h" // 先进先出队列 (模板)
 #include "FixedSizePipe.h" // 固定大小内存块管道
 #include "FixedSizeQueue.h" // 固定大小内存块队列
+#include "FlatHashMap.h" // 开放寻址扁平哈希表 (模板)
+#include "MappedFile.h" // 内存映射文件
+#include "MemoryTracker.h" // 按标签的内存统计
 #include "Pipe.h" // 管道 (模板)
 #include "Queue.h" // 队列 (模板)
+#include "ReadyNotifier.h" // 可轮询的数据就绪通知器
+#include "SampleDecode.h" // 采样数据批量解码
 #include "SharedMemory.h" // 共享内存
+#include "StaticCircularQueue.h" // 编译期定长循环队列 (模板)
+#include "StaticFixedSizePipe.h" // 编译期定长固定大小内存块管道 (模板)
+#include "StaticFixedSizeQueue.h" // 编译期定长固定大小内存块队列 (模板)
 
 
 #endif // LSX_LIB_MEMORY_LSX_MEMORY_H
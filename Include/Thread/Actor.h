@@ -0,0 +1,423 @@
+/**
+ * @file Actor.h
+ * @brief 基于线程池调度的轻量级 Actor 运行时
+ * @details 定义了 LSX_LIB::Thread 命名空间下的 ActorOptions 结构体和 Actor 模板类。
+ * 每个 Actor 拥有一个类型化的无锁 MPSC 邮箱 (MpscQueue) 和一个消息处理函数。
+ * 邮箱从空变为非空时，Actor 被调度到 IThreadPool 的某个工作线程上执行一 "轮"：
+ * 最多连续处理 `maxBatch` 条消息，如果仍有消息则把自己重新排到线程池队尾。
+ * 同一个 Actor 的消息按顺序逐条处理、绝不并发，而成百上千个 Actor 共享少量工作线程，
+ * 不必像 ThreadWrapper 那样为每个对象开一个线程。
+ * 邮箱可以设置容量上限，超过上限时发送方按 `timeout_ms` 约定被拒绝或阻塞等待，从而形成背压。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **类型化邮箱**: `Actor<Message>` 的邮箱直接保存 Message 对象，不经过 std::function 或字符串序列化。
+ * - **无锁投递**: `tell` 在邮箱未满时只做一次无锁入队和一次原子交换，只有 Actor 从空闲变为有消息时才向线程池提交任务。
+ * - **按需调度**: 没有消息的 Actor 不占用任何线程，也不在线程池队列中。
+ * - **批量处理**: 每轮最多处理 `maxBatch` 条消息，在吞吐量和公平性之间折中。
+ * - **背压**: `mailboxCapacity` 大于 0 时，邮箱已满的 `tell` 按 `timeout_ms` 立即失败、限时等待或无限等待。
+ * - **安全关闭**: `close()`（析构时自动调用）停止接收消息，并等待正在进行的一轮处理结束，之后处理函数不会再被调用。
+ * - **统计**: 邮箱长度、已处理消息数、因背压被拒绝的消息数。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "ThreadPool.h"
+ * #include "Actor.h"
+ * #include <iostream>
+ * #include <memory>
+ * #include <vector>
+ *
+ * struct DeviceEvent {
+ * int type;
+ * std::vector<uint8_t> payload;
+ * };
+ *
+ * class DeviceHandler {
+ * public:
+ * DeviceHandler(LSX_LIB::Thread::IThreadPool& pool, int id)
+ * : id_(id),
+ * actor_(pool, [this](DeviceEvent& ev) { onEvent(ev); }, LSX_LIB::Thread::ActorOptions{16, 1024}) {}
+ *
+ * // 邮箱已满时最多等待 10ms，仍满则返回 false
+ * bool Deliver(DeviceEvent ev) { return actor_.tell(std::move(ev), 10); }
+ *
+ * private:
+ * void onEvent(DeviceEvent& ev) { bytes_ += ev.payload.size(); } // 串行执行，无需加锁
+ *
+ * int id_;
+ * size_t bytes_ = 0;
+ * LSX_LIB::Thread::Actor<DeviceEvent> actor_; // 最后声明：最先析构，关闭后才销毁其他成员
+ * };
+ *
+ * int main() {
+ * LSX_LIB::Thread::ThreadPool pool(4);
+ * std::vector<std::unique_ptr<DeviceHandler>> handlers;
+ * for (int i = 0; i < 500; ++i) handlers.emplace_back(new DeviceHandler(pool, i));
+ *
+ * for (auto& h : handlers) {
+ * if (!h->Deliver(DeviceEvent{1, std::vector<uint8_t>(32)})) {
+ * std::cerr << "mailbox full" << std::endl;
+ * }
+ * }
+ *
+ * handlers.clear(); // 关闭所有 Actor
+ * pool.shutdown();
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **线程池生命周期**: 线程池必须比 Actor 活得更久；线程池停止后，尚未处理的消息不会再被处理。
+ * - **成员声明顺序**: 处理函数捕获了所属对象的 this 时，Actor 应作为最后一个成员声明（最先析构），或在所属对象的析构函数中显式调用 `close()`。
+ * - **容量是软上限**: 多个发送方同时通过容量检查时邮箱会短暂超过上限，超出量不大于并发发送方的数量。
+ * - **给自己发消息**: 在处理函数中给自己 `tell` 时不做容量检查，以免阻塞在自己的邮箱上造成死锁。
+ * - **处理函数中的阻塞发送**: 在处理函数中向其他 Actor 发送消息时应使用 `timeout_ms = 0` 或较短的超时；所有工作线程都阻塞在已满的邮箱上时，没有线程能够处理这些邮箱。
+ * - **异常处理**: 处理函数抛出的异常会被捕获并输出到 std::cerr，不影响后续消息。
+ * - **不要阻塞**: 处理函数占用的是共享的工作线程，长时间阻塞会拖慢同一线程池上的其他 Actor。
+ * - **拷贝/移动**: 类禁用了拷贝构造和赋值。
+ */
+
+#ifndef LSX_LIB_THREAD_ACTOR_H
+#define LSX_LIB_THREAD_ACTOR_H
+#pragma once
+
+#include <atomic> // 包含 std::atomic
+#include <chrono> // 包含 std::chrono::milliseconds
+#include <condition_variable> // 包含 std::condition_variable
+#include <cstddef> // 包含 size_t
+#include <cstdint> // 包含 uint64_t
+#include <exception> // 包含 std::exception
+#include <functional> // 包含 std::function
+#include <iostream> // 包含 std::cerr
+#include <memory> // 包含 std::shared_ptr
+#include <mutex> // 包含 std::mutex
+#include <optional> // 包含 std::optional
+#include <utility> // 包含 std::move
+
+#include "IThreadPool.h" // 包含 IThreadPool 接口定义
+#include "MpscQueue.h" // 包含 MpscQueue 无锁队列
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB
+{
+    /**
+     * @brief 线程相关的命名空间。
+     * 包含线程管理和线程间通信相关的类和工具。
+     */
+    namespace Thread
+    {
+        /**
+         * @brief Actor 的调度与背压参数。
+         */
+        struct ActorOptions
+        {
+            size_t maxBatch = 32; ///< 每轮最多处理的消息数，为 0 时按 1 处理
+            size_t mailboxCapacity = 0; ///< 邮箱容量上限，0 表示不限制
+        };
+
+        /**
+         * @brief Actor 实现细节，用户代码不应直接使用。
+         */
+        namespace ActorDetail
+        {
+            /**
+             * @brief 当前线程正在执行的 Actor（其内部状态的地址）。
+             */
+            inline const void*& CurrentActor()
+            {
+                thread_local const void* current = nullptr;
+                return current;
+            }
+        } // namespace ActorDetail
+
+        /**
+         * @brief 拥有类型化邮箱、在线程池上按需调度的 Actor (模板)。
+         *
+         * @tparam Message 消息类型，需要可移动构造。
+         */
+        template <typename Message>
+        class Actor
+        {
+        public:
+            /**
+             * @brief 消息处理函数类型。消息以非 const 引用传入，处理函数可以移走其内容。
+             */
+            using Handler = std::function<void(Message&)>;
+
+            /**
+             * @brief 构造函数。
+             *
+             * @param pool 执行消息处理的线程池，必须比 Actor 活得更久。
+             * @param handler 消息处理函数，同一 Actor 的调用之间不会并发。
+             * @param options 调度与背压参数。
+             */
+            Actor(IThreadPool& pool, Handler handler, ActorOptions options = ActorOptions())
+                : core_(std::make_shared<Core>(pool, std::move(handler), options))
+            {
+            }
+
+            /**
+             * @brief 析构函数。调用 close()。
+             */
+            ~Actor()
+            {
+                close();
+            }
+
+            // Prevent copying and assignment
+            Actor(const Actor&) = delete;
+            Actor& operator=(const Actor&) = delete;
+
+            /**
+             * @brief 向邮箱投递一条消息。可由任意线程调用。
+             *
+             * @param message 要投递的消息。
+             * @param timeout_ms 邮箱已满时的等待时间（毫秒）。
+             * - `< 0`: 无限期等待，直到邮箱有空位或 Actor 被关闭。
+             * - `0`: 不等待，邮箱已满时立即返回 false。
+             * - `> 0`: 最多等待指定毫秒数。
+             * 未设置容量上限时忽略。
+             * @return 成功投递返回 true；Actor 已关闭或等待超时返回 false。
+             */
+            bool tell(Message message, long timeout_ms = 0)
+            {
+                Core& core = *core_;
+                if (core.closed.load(std::memory_order_acquire))
+                {
+                    return false;
+                }
+                const size_t capacity = core.options.mailboxCapacity;
+                if (capacity > 0 && core.queue.sizeApprox() >= capacity && !runningInThisThread())
+                {
+                    if (!core.waitForSpace(timeout_ms))
+                    {
+                        return false;
+                    }
+                }
+                core.queue.push(std::move(message));
+                if (!core.scheduled.exchange(true))
+                {
+                    core.schedule();
+                }
+                return true;
+            }
+
+            /**
+             * @brief 关闭 Actor。
+             * 之后的 tell 返回 false，阻塞中的发送方被唤醒并返回 false，邮箱中尚未处理的消息被丢弃。
+             * 如果处理函数正在其他线程上运行，等待本轮处理结束后返回；在处理函数内部调用时不等待，
+             * 当前消息处理完后本轮立即结束。重复调用是安全的。
+             */
+            void close()
+            {
+                Core& core = *core_;
+                std::unique_lock<std::mutex> lock(core.mutex);
+                core.closed.store(true, std::memory_order_release);
+                core.cv.notify_all();
+                if (!runningInThisThread())
+                {
+                    core.cv.wait(lock, [&core] { return !core.running; });
+                }
+            }
+
+            /**
+             * @brief 检查 Actor 是否已关闭。
+             */
+            bool isClosed() const
+            {
+                return core_->closed.load(std::memory_order_acquire);
+            }
+
+            /**
+             * @brief 检查当前线程是否正在执行此 Actor 的处理函数。
+             */
+            bool runningInThisThread() const
+            {
+                return ActorDetail::CurrentActor() == core_.get();
+            }
+
+            /**
+             * @brief 获取邮箱中尚未处理的消息数（近似值）。
+             */
+            size_t mailboxSize() const
+            {
+                return core_->queue.sizeApprox();
+            }
+
+            /**
+             * @brief 获取已处理的消息总数。
+             */
+            uint64_t processedCount() const
+            {
+                return core_->processed.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief 获取因邮箱已满被拒绝的消息总数。
+             */
+            uint64_t rejectedCount() const
+            {
+                return core_->rejected.load(std::memory_order_relaxed);
+            }
+
+        private:
+            /**
+             * @brief Actor 的共享状态，由 Actor 对象和线程池中排队的执行任务共同持有。
+             */
+            struct Core : std::enable_shared_from_this<Core>
+            {
+                Core(IThreadPool& p, Handler h, ActorOptions o) : pool(p), handler(std::move(h)), options(o)
+                {
+                    if (options.maxBatch == 0) options.maxBatch = 1;
+                }
+
+                // 把一轮处理提交到线程池，调用前必须已把 scheduled 置为 true
+                void schedule()
+                {
+                    std::shared_ptr<Core> self = this->shared_from_this();
+                    pool.enqueue([self]() { self->runTurn(); });
+                }
+
+                // 等待邮箱出现空位，返回 false 表示超时或已关闭
+                bool waitForSpace(long timeout_ms)
+                {
+                    if (timeout_ms == 0)
+                    {
+                        rejected.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    std::unique_lock<std::mutex> lock(mutex);
+                    ++waiters;
+                    auto has_space = [this] {
+                        return closed.load(std::memory_order_relaxed) || queue.sizeApprox() < options.mailboxCapacity;
+                    };
+                    bool ok = true;
+                    if (timeout_ms < 0)
+                    {
+                        cv.wait(lock, has_space);
+                    }
+                    else
+                    {
+                        ok = cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), has_space);
+                    }
+                    --waiters;
+                    if (closed.load(std::memory_order_relaxed))
+                    {
+                        return false;
+                    }
+                    if (!ok)
+                    {
+                        rejected.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    return ok;
+                }
+
+                // 在工作线程上执行一轮：最多处理 maxBatch 条消息
+                void runTurn()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        running = !closed.load(std::memory_order_relaxed);
+                    }
+
+                    if (running)
+                    {
+                        const void*& current = ActorDetail::CurrentActor();
+                        const void* previous = current;
+                        current = this;
+                        for (size_t n = 0; n < options.maxBatch; ++n)
+                        {
+                            std::optional<Message> message = queue.tryPop();
+                            if (!message)
+                            {
+                                break;
+                            }
+                            invoke(*message);
+                            processed.fetch_add(1, std::memory_order_relaxed);
+                            if (closed.load(std::memory_order_relaxed))
+                            {
+                                break; // close() was called from the handler
+                            }
+                        }
+                        current = previous;
+                    }
+                    else
+                    {
+                        while (queue.tryPop())
+                        {
+                            // Closed: discard the remaining messages
+                        }
+                    }
+
+                    bool notify;
+                    {
+                        // Taken under the mutex so a sender that registered as a waiter either
+                        // sees the freed space or is woken here
+                        std::lock_guard<std::mutex> lock(mutex);
+                        running = false;
+                        notify = waiters > 0 || closed.load(std::memory_order_relaxed);
+                    }
+                    if (notify)
+                    {
+                        cv.notify_all();
+                    }
+
+                    if (closed.load(std::memory_order_acquire))
+                    {
+                        return; // Leave scheduled set: nothing will be processed any more
+                    }
+                    if (!queue.empty())
+                    {
+                        schedule(); // Batch exhausted: requeue behind other work on the pool
+                        return;
+                    }
+                    scheduled.store(false);
+                    // Pairs with the seq_cst exchange in MpscQueue::push: a message pushed after the
+                    // empty() check above is either seen here or its sender sees scheduled == false
+                    if (!queue.empty() && !scheduled.exchange(true))
+                    {
+                        schedule();
+                    }
+                }
+
+                // 调用处理函数并吸收异常
+                void invoke(Message& message)
+                {
+                    try
+                    {
+                        handler(message);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        std::cerr << "Actor message handler failed: " << e.what() << std::endl;
+                    } catch (...)
+                    {
+                        std::cerr << "Actor message handler failed with unknown error." << std::endl;
+                    }
+                }
+
+                IThreadPool& pool; // Executes the turns
+                Handler handler; // User message handler
+                ActorOptions options; // Batch size and mailbox capacity
+                MpscQueue<Message> queue; // Mailbox; consumed only by the turn holding scheduled
+                std::atomic<bool> scheduled{false}; // A turn is queued on or running in the pool
+                std::atomic<bool> closed{false}; // close() has been called
+                std::atomic<uint64_t> processed{0}; // Handled messages
+                std::atomic<uint64_t> rejected{0}; // Messages refused because the mailbox was full
+                std::mutex mutex; // Protects running and waiters; pairs with cv
+                std::condition_variable cv; // Wakes close() and senders blocked on a full mailbox
+                bool running = false; // A turn is executing the handler
+                size_t waiters = 0; // Senders blocked in waitForSpace
+            };
+
+            std::shared_ptr<Core> core_; // Shared with turns queued on the pool
+        };
+    } // namespace Thread
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_THREAD_ACTOR_H
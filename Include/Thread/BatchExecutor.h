@@ -0,0 +1,525 @@
+/**
+ * @file BatchExecutor.h
+ * @brief 按键聚合小任务的微批执行器
+ * @details 定义了 LSX_LIB::Thread 命名空间下的 BatchOptions 结构体和 BatchExecutor 模板类。
+ * 当单个任务只有几百纳秒时，每个任务一次 std::function 构造、一次线程池队列加锁和一次线程唤醒的开销会超过任务本身。
+ * BatchExecutor 把按键提交的数据项先放进该键的缓冲区，缓冲区达到 `maxBatchSize` 条或第一条数据等待超过 `maxDelayMs`
+ * 时封装成一个批次，再以一个线程池任务调用一次批处理函数。SQLite 批量插入、日志批量发送等都是这种模式。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **按键聚合**: 每个键有独立的缓冲区，批处理函数收到的批次只包含同一个键的数据。
+ * - **大小/时间阈值**: 达到 `maxBatchSize` 条立即封批；否则从该批第一条数据算起最多等待 `maxDelayMs` 毫秒后由内部定时线程封批。
+ * - **低开销提交**: `submit` 只做一次短暂加锁和一次 vector 追加，不创建线程池任务、不唤醒线程；每个批次才提交一次线程池任务。
+ * - **键内串行**: 同一个键的批次按封批顺序逐个执行，绝不并发；不同键的批次在线程池上并行执行。
+ * - **背压**: `maxPendingItems` 大于 0 时，尚未处理完的数据项超过上限后 `submit` 返回 false。
+ * - **刷新与关闭**: `flush()` 立即封存所有未满的批次；`close()`（析构时自动调用）刷新后等待所有批次处理完毕。
+ * - **统计**: 已提交、已处理、被拒绝的数据项数以及已处理的批次数。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "ThreadPool.h"
+ * #include "BatchExecutor.h"
+ * #include <iostream>
+ * #include <string>
+ *
+ * struct Sample {
+ * int64_t timestamp;
+ * double value;
+ * };
+ *
+ * int main() {
+ * LSX_LIB::Thread::ThreadPool pool(4);
+ *
+ * LSX_LIB::Thread::BatchOptions options;
+ * options.maxBatchSize = 500; // 每个事务最多 500 行
+ * options.maxDelayMs = 20; // 数据最多延迟 20ms 写入
+ *
+ * // 键为表名：每张表一个事务，同一张表的事务不会并发
+ * LSX_LIB::Thread::BatchExecutor<std::string, Sample> writer(pool,
+ * [](const std::string& table, std::vector<Sample>& batch) {
+ * // BEGIN; INSERT INTO table ... (batch.size() 行); COMMIT;
+ * std::cout << table << ": " << batch.size() << " rows" << std::endl;
+ * }, options);
+ *
+ * for (int i = 0; i < 100000; ++i) {
+ * writer.submit(i % 2 ? "temperature" : "pressure", Sample{i, i * 0.1});
+ * }
+ *
+ * writer.close(); // 写入剩余数据并等待完成
+ * pool.shutdown();
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **线程池生命周期**: 线程池必须比执行器活得更久，并且在 `close()` 返回之前不能停止，否则 `close()` 会一直等待尚未执行的批次。
+ * - **顺序**: 同一个键的数据按提交顺序进入批次（多个线程同时提交同一个键时以加锁顺序为准），批次按封批顺序执行。
+ * - **在批处理函数中调用**: 批处理函数中可以 `submit`（忽略 `maxPendingItems`，以免等待自己），调用 `close()` 时不等待。
+ * - **异常处理**: 批处理函数抛出的异常会被捕获并输出到 std::cerr，该批次计为已处理，不影响后续批次。
+ * - **定时线程**: 每个执行器有一个内部定时线程，只在有未满批次时按最早的截止时间醒来。
+ * - **拷贝/移动**: 类禁用了拷贝构造和赋值。
+ */
+
+#ifndef LSX_LIB_THREAD_BATCH_EXECUTOR_H
+#define LSX_LIB_THREAD_BATCH_EXECUTOR_H
+#pragma once
+
+#include <atomic> // 包含 std::atomic
+#include <chrono> // 包含 std::chrono::steady_clock
+#include <condition_variable> // 包含 std::condition_variable
+#include <cstddef> // 包含 size_t
+#include <cstdint> // 包含 uint64_t
+#include <deque> // 包含 std::deque
+#include <exception> // 包含 std::exception
+#include <functional> // 包含 std::function, std::hash
+#include <iostream> // 包含 std::cerr
+#include <memory> // 包含 std::shared_ptr
+#include <mutex> // 包含 std::mutex
+#include <thread> // 包含 std::thread
+#include <unordered_map> // 包含 std::unordered_map
+#include <utility> // 包含 std::move
+#include <vector> // 包含 std::vector
+
+#include "IThreadPool.h" // 包含 IThreadPool 接口定义
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB
+{
+    /**
+     * @brief 线程相关的命名空间。
+     * 包含线程管理和线程间通信相关的类和工具。
+     */
+    namespace Thread
+    {
+        /**
+         * @brief 微批执行器的聚合与背压参数。
+         */
+        struct BatchOptions
+        {
+            size_t maxBatchSize = 256; ///< 每批最多的数据项数，达到后立即封批，为 0 时按 1 处理
+            long maxDelayMs = 10; ///< 批次中第一条数据最长等待时间（毫秒），<= 0 时只按大小封批（仍可手动 flush）
+            size_t maxPendingItems = 0; ///< 已提交但尚未处理完的数据项上限，0 表示不限制
+        };
+
+        /**
+         * @brief 微批执行器实现细节，用户代码不应直接使用。
+         */
+        namespace BatchDetail
+        {
+            /**
+             * @brief 当前线程正在执行的批处理器（其内部状态的地址）。
+             */
+            inline const void*& CurrentExecutor()
+            {
+                thread_local const void* current = nullptr;
+                return current;
+            }
+        } // namespace BatchDetail
+
+        /**
+         * @brief 按键聚合数据项、按批在线程池上执行的微批执行器 (模板)。
+         *
+         * @tparam Key 键类型，需要可拷贝并可被 Hash 哈希。
+         * @tparam Item 数据项类型，需要可移动构造。
+         * @tparam Hash 键的哈希函数类型。
+         */
+        template <typename Key, typename Item, typename Hash = std::hash<Key>>
+        class BatchExecutor
+        {
+        public:
+            /**
+             * @brief 批处理函数类型。批次以非 const 引用传入，处理函数可以移走其内容。
+             */
+            using Handler = std::function<void(const Key&, std::vector<Item>&)>;
+
+            /**
+             * @brief 构造函数。启动内部定时线程。
+             *
+             * @param pool 执行批处理函数的线程池，必须比执行器活得更久。
+             * @param handler 批处理函数，同一个键的调用之间不会并发。
+             * @param options 聚合与背压参数。
+             */
+            BatchExecutor(IThreadPool& pool, Handler handler, BatchOptions options = BatchOptions())
+                : core_(std::make_shared<Core>(pool, std::move(handler), options))
+            {
+                std::shared_ptr<Core> core = core_;
+                timer_ = std::thread([core]() { core->runTimer(); });
+            }
+
+            /**
+             * @brief 析构函数。调用 close()。
+             */
+            ~BatchExecutor()
+            {
+                close();
+            }
+
+            // Prevent copying and assignment
+            BatchExecutor(const BatchExecutor&) = delete;
+            BatchExecutor& operator=(const BatchExecutor&) = delete;
+
+            /**
+             * @brief 提交一个数据项。可由任意线程调用。
+             *
+             * @param key 数据项所属的键。
+             * @param item 数据项。
+             * @return 成功返回 true；执行器已关闭或超过 maxPendingItems 时返回 false。
+             */
+            bool submit(const Key& key, Item item)
+            {
+                Core& core = *core_;
+                bool dispatch = false;
+                {
+                    std::lock_guard<std::mutex> lock(core.mutex);
+                    if (core.closed)
+                    {
+                        return false;
+                    }
+                    if (core.options.maxPendingItems > 0 && core.pendingItems >= core.options.maxPendingItems &&
+                        BatchDetail::CurrentExecutor() != &core)
+                    {
+                        core.rejected.fetch_add(1, std::memory_order_relaxed);
+                        return false;
+                    }
+                    KeyState& state = core.keys[key];
+                    if (state.open.empty())
+                    {
+                        state.open.reserve(core.options.maxBatchSize);
+                        state.generation = ++core.generation;
+                        if (core.options.maxDelayMs > 0)
+                        {
+                            // 所有键的等待时间相同，截止时间按提交顺序递增，用 FIFO 即可保持有序
+                            core.deadlines.push_back(Deadline{
+                                std::chrono::steady_clock::now() + std::chrono::milliseconds(core.options.maxDelayMs),
+                                key, state.generation});
+                            if (core.deadlines.size() == 1)
+                            {
+                                core.timerCv.notify_one();
+                            }
+                        }
+                    }
+                    state.open.push_back(std::move(item));
+                    ++core.pendingItems;
+                    core.submitted.fetch_add(1, std::memory_order_relaxed);
+                    if (state.open.size() >= core.options.maxBatchSize)
+                    {
+                        dispatch = core.sealLocked(state);
+                    }
+                }
+                if (dispatch)
+                {
+                    core.schedule(key);
+                }
+                return true;
+            }
+
+            /**
+             * @brief 立即封存所有键的未满批次并提交执行，不等待执行完成。
+             */
+            void flush()
+            {
+                core_->flushAll();
+            }
+
+            /**
+             * @brief 立即封存指定键的未满批次并提交执行，不等待执行完成。
+             */
+            void flush(const Key& key)
+            {
+                Core& core = *core_;
+                bool dispatch = false;
+                {
+                    std::lock_guard<std::mutex> lock(core.mutex);
+                    auto it = core.keys.find(key);
+                    if (it != core.keys.end() && !it->second.open.empty())
+                    {
+                        dispatch = core.sealLocked(it->second);
+                    }
+                }
+                if (dispatch)
+                {
+                    core.schedule(key);
+                }
+            }
+
+            /**
+             * @brief 关闭执行器。
+             * 之后的 submit 返回 false；未满的批次被封存，等待所有批次处理完毕后停止定时线程。
+             * 在批处理函数内部调用时只刷新不等待。重复调用是安全的。
+             *
+             * @param timeout_ms 等待批次处理完毕的时间（毫秒）：<0 无限等待，>=0 限时等待。
+             * @return 所有批次均已处理完毕返回 true，超时返回 false。
+             */
+            bool close(long timeout_ms = -1)
+            {
+                Core& core = *core_;
+                {
+                    std::lock_guard<std::mutex> lock(core.mutex);
+                    core.closed = true;
+                    core.timerCv.notify_all();
+                }
+                core.flushAll();
+                if (timer_.joinable() && std::this_thread::get_id() != timer_.get_id())
+                {
+                    timer_.join();
+                }
+                if (BatchDetail::CurrentExecutor() == &core)
+                {
+                    return false;
+                }
+                std::unique_lock<std::mutex> lock(core.mutex);
+                auto drained = [&core] { return core.pendingItems == 0; };
+                if (timeout_ms < 0)
+                {
+                    core.idleCv.wait(lock, drained);
+                    return true;
+                }
+                return core.idleCv.wait_for(lock, std::chrono::milliseconds(timeout_ms), drained);
+            }
+
+            /**
+             * @brief 获取已提交但尚未处理完的数据项数。
+             */
+            size_t pendingItems() const
+            {
+                std::lock_guard<std::mutex> lock(core_->mutex);
+                return core_->pendingItems;
+            }
+
+            /**
+             * @brief 获取成功提交的数据项总数。
+             */
+            uint64_t submittedCount() const
+            {
+                return core_->submitted.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief 获取已处理的数据项总数。
+             */
+            uint64_t processedCount() const
+            {
+                return core_->processed.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief 获取已处理的批次总数。processedCount() / batchCount() 即平均批大小。
+             */
+            uint64_t batchCount() const
+            {
+                return core_->batches.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief 获取因超过 maxPendingItems 被拒绝的数据项总数。
+             */
+            uint64_t rejectedCount() const
+            {
+                return core_->rejected.load(std::memory_order_relaxed);
+            }
+
+        private:
+            /**
+             * @brief 单个键的缓冲状态，受 Core::mutex 保护。
+             */
+            struct KeyState
+            {
+                std::vector<Item> open; // Batch being filled
+                std::deque<std::vector<Item>> sealed; // Batches waiting for the handler, in order
+                uint64_t generation = 0; // Identifies the open batch for its deadline entry
+                bool running = false; // A pool task for this key is queued or executing
+            };
+
+            /**
+             * @brief 未满批次的截止时间。
+             */
+            struct Deadline
+            {
+                std::chrono::steady_clock::time_point when;
+                Key key;
+                uint64_t generation;
+            };
+
+            /**
+             * @brief 执行器的共享状态，由执行器对象、定时线程和线程池中排队的任务共同持有。
+             */
+            struct Core : std::enable_shared_from_this<Core>
+            {
+                Core(IThreadPool& p, Handler h, BatchOptions o) : pool(p), handler(std::move(h)), options(o)
+                {
+                    if (options.maxBatchSize == 0) options.maxBatchSize = 1;
+                }
+
+                // 封存 open 批次，返回是否需要为该键提交线程池任务（调用者须持有 mutex）
+                bool sealLocked(KeyState& state)
+                {
+                    state.sealed.push_back(std::move(state.open));
+                    state.open = std::vector<Item>();
+                    state.generation = 0; // Invalidates the pending deadline entry
+                    if (state.running)
+                    {
+                        return false; // The running task will pick it up
+                    }
+                    state.running = true;
+                    return true;
+                }
+
+                // 为键提交一个线程池任务，调用前必须已把 running 置为 true
+                void schedule(const Key& key)
+                {
+                    std::shared_ptr<Core> self = this->shared_from_this();
+                    pool.enqueue([self, key]() { self->runKey(key); });
+                }
+
+                void flushAll()
+                {
+                    std::vector<Key> dispatch;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        for (auto& entry : keys)
+                        {
+                            if (!entry.second.open.empty() && sealLocked(entry.second))
+                            {
+                                dispatch.push_back(entry.first);
+                            }
+                        }
+                    }
+                    for (const Key& key : dispatch)
+                    {
+                        schedule(key);
+                    }
+                }
+
+                // 在工作线程上处理该键最早的一个批次，仍有批次时重新排到线程池队尾
+                void runKey(const Key& key)
+                {
+                    std::vector<Item> batch;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        KeyState& state = keys[key];
+                        batch = std::move(state.sealed.front());
+                        state.sealed.pop_front();
+                    }
+
+                    const void*& current = BatchDetail::CurrentExecutor();
+                    const void* previous = current;
+                    current = this;
+                    const size_t count = batch.size();
+                    invoke(key, batch);
+                    current = previous;
+                    processed.fetch_add(count, std::memory_order_relaxed);
+                    batches.fetch_add(1, std::memory_order_relaxed);
+
+                    bool again = false;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        pendingItems -= count;
+                        auto it = keys.find(key);
+                        if (!it->second.sealed.empty())
+                        {
+                            again = true;
+                        }
+                        else
+                        {
+                            it->second.running = false;
+                            if (it->second.open.empty())
+                            {
+                                keys.erase(it); // Keep the map limited to active keys
+                            }
+                        }
+                        if (pendingItems == 0)
+                        {
+                            idleCv.notify_all();
+                        }
+                    }
+                    if (again)
+                    {
+                        schedule(key);
+                    }
+                }
+
+                // 定时线程：按截止时间封存未满的批次
+                void runTimer()
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    while (!closed)
+                    {
+                        if (deadlines.empty())
+                        {
+                            timerCv.wait(lock);
+                            continue;
+                        }
+                        const auto when = deadlines.front().when;
+                        if (std::chrono::steady_clock::now() < when)
+                        {
+                            timerCv.wait_until(lock, when);
+                            continue;
+                        }
+                        std::vector<Key> dispatch;
+                        const auto now = std::chrono::steady_clock::now();
+                        while (!deadlines.empty() && deadlines.front().when <= now)
+                        {
+                            Deadline deadline = std::move(deadlines.front());
+                            deadlines.pop_front();
+                            auto it = keys.find(deadline.key);
+                            if (it != keys.end() && it->second.generation == deadline.generation &&
+                                !it->second.open.empty() && sealLocked(it->second))
+                            {
+                                dispatch.push_back(std::move(deadline.key));
+                            }
+                        }
+                        lock.unlock();
+                        for (const Key& key : dispatch)
+                        {
+                            schedule(key);
+                        }
+                        lock.lock();
+                    }
+                }
+
+                // 调用批处理函数并吸收异常
+                void invoke(const Key& key, std::vector<Item>& batch)
+                {
+                    try
+                    {
+                        handler(key, batch);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        std::cerr << "BatchExecutor handler failed: " << e.what() << std::endl;
+                    } catch (...)
+                    {
+                        std::cerr << "BatchExecutor handler failed with unknown error." << std::endl;
+                    }
+                }
+
+                IThreadPool& pool; // Executes the batches
+                Handler handler; // User batch handler
+                BatchOptions options; // Thresholds and back-pressure limit
+                mutable std::mutex mutex; // Protects everything below except the atomics
+                std::condition_variable timerCv; // Wakes the timer thread
+                std::condition_variable idleCv; // Wakes close() when pendingItems drops to 0
+                std::unordered_map<Key, KeyState, Hash> keys; // Per-key buffers
+                std::deque<Deadline> deadlines; // Open-batch deadlines in submission order
+                uint64_t generation = 0; // Source of KeyState::generation values
+                size_t pendingItems = 0; // Submitted and not yet handled
+                bool closed = false; // close() has been called
+                std::atomic<uint64_t> submitted{0}; // Accepted items
+                std::atomic<uint64_t> processed{0}; // Handled items
+                std::atomic<uint64_t> batches{0}; // Handler invocations
+                std::atomic<uint64_t> rejected{0}; // Items refused by maxPendingItems
+            };
+
+            std::shared_ptr<Core> core_; // Shared with the timer thread and queued pool tasks
+            std::thread timer_; // Seals batches whose deadline has passed
+        };
+    } // namespace Thread
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_THREAD_BATCH_EXECUTOR_H
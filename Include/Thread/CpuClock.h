@@ -0,0 +1,102 @@
+/**
+ * @file CpuClock.h
+ * @brief 线程 CPU 时间读取
+ * @details 定义了 LSX_LIB::Thread::CpuClock 命名空间下的线程 CPU 时间读取函数，
+ * 供 Scheduler 的任务 CPU 统计和 ThreadPool 的工作线程 CPU 统计使用。
+ * 墙钟时间包含阻塞和被抢占的时间，只有 CPU 时间能反映一个任务实际占用了多少核心。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **当前线程**: `threadNs()` 基于 `CLOCK_THREAD_CPUTIME_ID` 读取调用线程已消耗的 CPU 时间。
+ * - **其他线程**: `threadNs(std::thread&)` 通过 `pthread_getcpuclockid` 读取指定线程的 CPU 时间，被读取的线程无需任何配合，没有额外开销。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "CpuClock.h"
+ *
+ * const int64_t begin = LSX_LIB::Thread::CpuClock::threadNs();
+ * do_work();
+ * const int64_t cpu_ns = LSX_LIB::Thread::CpuClock::threadNs() - begin; // do_work 消耗的 CPU 时间
+ * @endcode
+ *
+ * ### 注意事项
+ * - **平台**: 仅 POSIX 平台可用，其他平台返回 -1。
+ * - **开销**: 每次读取是一次 clock_gettime 调用（通常不经过 vDSO 快速路径，约数百纳秒），不适合在极短的任务前后调用。
+ * - **线程已结束**: 线程结束（join）后无法再读取，返回 -1。
+ */
+
+#ifndef LSX_LIB_THREAD_CPU_CLOCK_H
+#define LSX_LIB_THREAD_CPU_CLOCK_H
+#pragma once
+
+#include <cstdint> // 包含 int64_t
+#include <thread> // 包含 std::thread
+
+#ifndef _WIN32
+#include <pthread.h> // 包含 pthread_getcpuclockid
+#include <time.h> // 包含 clock_gettime
+#endif
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB
+{
+    /**
+     * @brief 线程相关的命名空间。
+     * 包含线程管理和线程间通信相关的类和工具。
+     */
+    namespace Thread
+    {
+        /**
+         * @brief 线程 CPU 时间读取函数。
+         */
+        namespace CpuClock
+        {
+            /**
+             * @brief 获取调用线程已消耗的 CPU 时间。
+             *
+             * @return CPU 时间（纳秒）；平台不支持时返回 -1。
+             */
+            inline int64_t threadNs()
+            {
+#ifndef _WIN32
+                timespec ts{};
+                if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+                {
+                    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+                }
+#endif
+                return -1;
+            }
+
+            /**
+             * @brief 获取指定线程已消耗的 CPU 时间。
+             *
+             * @param thread 正在运行的线程。
+             * @return CPU 时间（纳秒）；线程未运行、已结束或平台不支持时返回 -1。
+             */
+            inline int64_t threadNs(std::thread& thread)
+            {
+#ifndef _WIN32
+                if (!thread.joinable())
+                {
+                    return -1;
+                }
+                clockid_t clock;
+                timespec ts{};
+                if (pthread_getcpuclockid(thread.native_handle(), &clock) == 0 && clock_gettime(clock, &ts) == 0)
+                {
+                    return static_cast<int64_t>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+                }
+#endif
+                return -1;
+            }
+        } // namespace CpuClock
+    } // namespace Thread
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_THREAD_CPU_CLOCK_H
@@ -0,0 +1,337 @@
+/**
+ * @file EventLoop.h
+ * @brief 基于 epoll 的统一事件循环
+ * @details 定义了 LSX_LIB::Thread 命名空间下的 EventLoop 和 EventLoopGroup 类。
+ * 以往每个 DataTransfer 通信端点、每个 Scheduler 任务和每个 GPIO 轮询都要占用一个阻塞线程，
+ * 网关上的线程数因此达到数十个。EventLoop 在一个线程中用 epoll 同时等待所有事件源，
+ * 事件就绪时调用注册的回调：
+ * - 文件描述符和 ICommunication 通信对象（socket、串口）的可读/可写；
+ * - 一次性和周期性定时器（所有定时器共用一个 timerfd）；
+ * - Memory 模块容器（FixedSizeQueue、Pipe、Queue、CircularQueue 等）的就绪通知描述符；
+ * - sysfs GPIO 的电平变化中断和 UIO 设备中断；
+ * - 其他线程通过 post() 投递的任务（eventfd 唤醒）。
+ * EventLoopGroup 为每个核心创建一个绑定到该核心的 EventLoop，用少量线程承载全部 I/O。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **单线程多路复用**: 一个 EventLoop 线程等待任意数量的描述符和定时器，回调在该线程中依次执行，回调之间无需加锁。
+ * - **定时器**: `addTimer` 支持延迟和固定频率周期，所有定时器按到期时间排序，只占用一个 timerfd。
+ * - **容器**: `addContainer` 在容器非空时调用回调（电平触发），回调应取空容器。
+ * - **GPIO/UIO**: `addGpio` 配置 sysfs GPIO 的 edge 并在电平变化时回调当前电平；`addUio` 在 UIO 中断时回调中断计数并重新使能中断。
+ * - **跨线程投递**: `post` 可在任意线程调用，任务在循环线程中执行；注册和注销也可在任意线程调用。
+ * - **按核心运行**: `start(cpu)` 在新线程中运行循环并可绑定到指定 CPU；EventLoopGroup 为每个核心运行一个循环。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "EventLoop.h"
+ * #include "TcpClient.h"
+ * #include "FixedSizeQueue.h"
+ * #include <iostream>
+ *
+ * using namespace LSX_LIB::Thread;
+ *
+ * int main() {
+ * EventLoop loop;
+ *
+ * LSX_LIB::DataTransfer::TcpClient client("192.168.1.10", 5000);
+ * client.create();
+ * loop.addCommunication(client, [&client](uint32_t events) {
+ * uint8_t buffer[512];
+ * int n = client.receive(buffer, sizeof(buffer)); // 描述符可读，不会阻塞
+ * if (n <= 0) client.close();
+ * });
+ *
+ * LSX_LIB::Memory::FixedSizeQueue tx_queue(256, 64);
+ * loop.addContainer(tx_queue, [&] {
+ * uint8_t block[256];
+ * while (tx_queue.Get(block, sizeof(block))) client.send(block, sizeof(block));
+ * });
+ *
+ * loop.addTimer(0, 1000, [] { std::cout << "heartbeat" << std::endl; }); // 每秒一次
+ *
+ * loop.addGpio("/sys/class/gpio/gpio27", "both", [](bool level) {
+ * std::cout << "gpio27 -> " << level << std::endl;
+ * });
+ *
+ * loop.start(1); // 在新线程中运行，绑定到 CPU 1
+ * // ... 其他线程可以调用 loop.post(...) 把工作交给循环线程
+ * loop.stop();
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **回调不能阻塞**: 所有回调在同一个线程中执行，阻塞的回调会推迟其他所有事件；耗时的工作应投递到 ThreadPool。
+ * - **电平触发**: 描述符以电平触发方式注册，回调没有读完数据时会被再次调用；容器回调应取空容器。
+ * - **注销**: `remove` 在循环线程中调用时立即生效（同一批中尚未分发的事件也不再回调）；在其他线程中调用时，可能正在执行的那一次回调仍会执行完。
+ * - **描述符所有权**: `addFd` / `addCommunication` / `addContainer` 不获取描述符所有权，关闭描述符前应先 `remove`；`addGpio` / `addUio` 打开的描述符由 EventLoop 在注销时关闭。
+ * - **回调异常**: 回调抛出的异常被捕获并输出到 std::cerr，循环继续运行。
+ * - **平台**: 依赖 epoll、timerfd 和 eventfd，仅支持 Linux；其他平台上所有注册函数返回 0，`run` 立即返回。
+ * - **拷贝/移动**: 类禁用了拷贝构造和赋值。
+ */
+
+#ifndef LSX_LIB_THREAD_EVENT_LOOP_H
+#define LSX_LIB_THREAD_EVENT_LOOP_H
+#pragma once
+
+#include <atomic> // 包含 std::atomic
+#include <cstddef> // 包含 size_t
+#include <cstdint> // 包含 uint32_t, uint64_t
+#include <functional> // 包含 std::function
+#include <memory> // 包含 std::unique_ptr
+#include <string> // 包含 std::string
+#include <thread> // 包含 std::thread
+#include <vector> // 包含 std::vector
+#include "ICommunication.h" // 包含 DataTransfer::ICommunication
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB
+{
+    /**
+     * @brief 线程相关的命名空间。
+     * 包含线程管理和线程间通信相关的类和工具。
+     */
+    namespace Thread
+    {
+        /**
+         * @brief 基于 epoll 的单线程事件循环。
+         */
+        class EventLoop
+        {
+        public:
+            /**
+             * @brief 注册 ID，0 表示注册失败。
+             */
+            using Id = uint64_t;
+
+            /**
+             * @brief 描述符回调，参数为就绪的事件（Readable/Writable/Error/HangUp 的组合）。
+             */
+            using IoCallback = std::function<void(uint32_t events)>;
+
+            /**
+             * @brief 事件位。
+             */
+            enum Events : uint32_t
+            {
+                Readable = 0x1, ///< 可读
+                Writable = 0x2, ///< 可写
+                Error = 0x4, ///< 描述符出错
+                HangUp = 0x8 ///< 对端关闭
+            };
+
+            /**
+             * @brief 构造函数。创建 epoll、timerfd 和 eventfd。创建失败时输出错误，valid() 返回 false。
+             */
+            EventLoop();
+
+            /**
+             * @brief 析构函数。停止循环（如果由 start 启动则等待线程退出），关闭所有由 EventLoop 打开的描述符。
+             */
+            ~EventLoop();
+
+            // Prevent copying and assignment
+            EventLoop(const EventLoop&) = delete;
+            EventLoop& operator=(const EventLoop&) = delete;
+
+            /**
+             * @brief 检查事件循环是否创建成功。
+             */
+            bool valid() const;
+
+            /**
+             * @brief 注册描述符。
+             *
+             * @param fd 要等待的描述符，调用者保持所有权。
+             * @param events 要等待的事件（Readable 和/或 Writable）。
+             * @param callback 事件就绪时在循环线程中调用。
+             * @return 注册 ID；失败时返回 0。
+             */
+            Id addFd(int fd, uint32_t events, IoCallback callback);
+
+            /**
+             * @brief 修改描述符注册的等待事件（例如有数据待发送时加上 Writable）。
+             *
+             * @param id addFd / addCommunication 返回的 ID。
+             * @param events 新的等待事件。
+             * @return 成功返回 true。
+             */
+            bool modifyFd(Id id, uint32_t events);
+
+            /**
+             * @brief 注册通信对象（TcpClient、TcpServer、UdpClient、UdpServer、UdpMulticast、SerialPort 等），等待其可读。
+             * 通信对象必须已经 create()（TcpServer 需已接受连接），且 `nativeHandle()` 返回有效描述符。
+             *
+             * @param communication 通信对象，注销前必须保持有效且不能 close()。
+             * @param callback 事件就绪时在循环线程中调用，通常在其中调用 receive()。
+             * @param events 要等待的事件，默认为 Readable。
+             * @return 注册 ID；通信对象没有可用描述符或注册失败时返回 0。
+             */
+            Id addCommunication(DataTransfer::ICommunication& communication, IoCallback callback,
+                                uint32_t events = Readable);
+
+            /**
+             * @brief 注册容器（FixedSizeQueue、Pipe、Queue、CircularQueue 等提供 `EnableNotification()` 和 `NativeHandle()` 的容器）。
+             * 容器非空时调用回调；回调应取空容器，否则会被立即再次调用。
+             *
+             * @tparam Container 容器类型。
+             * @param container 容器，注销前必须保持有效。
+             * @param callback 容器非空时在循环线程中调用。
+             * @return 注册 ID；平台不支持就绪通知或注册失败时返回 0。
+             */
+            template <typename Container>
+            Id addContainer(Container& container, std::function<void()> callback)
+            {
+                if (!container.EnableNotification())
+                {
+                    return 0;
+                }
+                return addFd(container.NativeHandle(), Readable,
+                             [callback = std::move(callback)](uint32_t) { callback(); });
+            }
+
+            /**
+             * @brief 注册 sysfs GPIO 电平变化中断。
+             * 向 `<gpioPath>/edge` 写入 edge，打开 `<gpioPath>/value` 并等待 EPOLLPRI；电平变化时读取当前电平并回调。
+             * 注册成功后会立即以当前电平回调一次。
+             *
+             * @param gpioPath GPIO 目录，如 "/sys/class/gpio/gpio27"（需已 export 并设置为输入）。
+             * @param edge 触发沿："rising"、"falling" 或 "both"。
+             * @param callback 电平变化时在循环线程中调用，参数为当前电平（true 为高）。
+             * @return 注册 ID；GPIO 不支持中断或打开失败时返回 0。
+             */
+            Id addGpio(const std::string& gpioPath, const std::string& edge, std::function<void(bool level)> callback);
+
+            /**
+             * @brief 注册 UIO 设备中断。
+             * 打开 UIO 设备并使能中断；中断到来时读取中断计数并回调，回调返回后重新使能中断。
+             *
+             * @param devicePath UIO 设备，如 "/dev/uio0"。
+             * @param callback 中断时在循环线程中调用，参数为驱动累计的中断计数。
+             * @return 注册 ID；打开失败时返回 0。
+             */
+            Id addUio(const std::string& devicePath, std::function<void(uint32_t count)> callback);
+
+            /**
+             * @brief 注册定时器。
+             *
+             * @param delayMs 第一次触发前的延迟（毫秒），<= 0 表示在下一轮循环中触发。
+             * @param intervalMs 周期（毫秒），<= 0 表示只触发一次（触发后自动注销）。周期定时器按固定频率触发，落后时不补触发。
+             * @param callback 到期时在循环线程中调用。
+             * @return 注册 ID；失败时返回 0。
+             */
+            Id addTimer(long delayMs, long intervalMs, std::function<void()> callback);
+
+            /**
+             * @brief 注销任意类型的注册（描述符、通信对象、容器、GPIO、UIO、定时器）。可在任意线程（包括回调中）调用。
+             *
+             * @param id 注册 ID。
+             * @return ID 存在并已注销返回 true。
+             */
+            bool remove(Id id);
+
+            /**
+             * @brief 投递一个任务到循环线程执行。可在任意线程调用；在循环线程中调用时任务在本轮事件处理完后执行。
+             *
+             * @param task 要执行的任务。
+             * @return 事件循环无效时返回 false。
+             */
+            bool post(std::function<void()> task);
+
+            /**
+             * @brief 在当前线程中运行事件循环，直到 stop() 被调用。
+             */
+            void run();
+
+            /**
+             * @brief 等待并处理一批事件。
+             *
+             * @param timeout_ms 没有事件时最多等待的时间（毫秒）：<0 无限等待，0 不等待，>0 超时时间。
+             * @return 处理的事件数（描述符、定时器和投递的任务）；循环无效或出错时返回 -1。
+             */
+            int runOnce(long timeout_ms);
+
+            /**
+             * @brief 在新线程中运行事件循环。
+             *
+             * @param cpu 要绑定的 CPU 编号，<0 表示不绑定。
+             * @return 已在运行或循环无效时返回 false。
+             */
+            bool start(int cpu = -1);
+
+            /**
+             * @brief 请求停止事件循环。可在任意线程（包括回调中）调用；循环由 start 启动时等待线程退出（在回调中调用时不等待）。
+             */
+            void stop();
+
+            /**
+             * @brief 检查调用线程是否为正在运行本循环的线程。
+             */
+            bool isInLoopThread() const;
+
+            /**
+             * @brief 获取当前的注册数量（描述符和定时器）。
+             */
+            size_t registrationCount() const;
+
+        private:
+            struct Impl;
+            std::unique_ptr<Impl> impl_; // Platform state
+        };
+
+        /**
+         * @brief 事件循环组：每个核心一个 EventLoop，各自在绑定到该核心的线程中运行。
+         */
+        class EventLoopGroup
+        {
+        public:
+            /**
+             * @brief 构造函数。创建并启动事件循环。
+             *
+             * @param loops 事件循环数量，0 表示 CPU 核心数。
+             * @param pinToCores 是否把第 i 个循环绑定到第 i % 核心数 个 CPU。
+             */
+            explicit EventLoopGroup(size_t loops = 0, bool pinToCores = true);
+
+            /**
+             * @brief 析构函数。调用 stop()。
+             */
+            ~EventLoopGroup();
+
+            // Prevent copying and assignment
+            EventLoopGroup(const EventLoopGroup&) = delete;
+            EventLoopGroup& operator=(const EventLoopGroup&) = delete;
+
+            /**
+             * @brief 按轮询顺序返回下一个事件循环，用于分配新的连接或设备。
+             */
+            EventLoop& next();
+
+            /**
+             * @brief 获取指定编号的事件循环。
+             */
+            EventLoop& at(size_t index);
+
+            /**
+             * @brief 获取事件循环数量。
+             */
+            size_t size() const;
+
+            /**
+             * @brief 停止所有事件循环并等待线程退出。
+             */
+            void stop();
+
+        private:
+            std::vector<std::unique_ptr<EventLoop>> loops_; // One loop per core
+            std::atomic<size_t> next_{0}; // Round-robin cursor for next()
+        };
+    } // namespace Thread
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_THREAD_EVENT_LOOP_H
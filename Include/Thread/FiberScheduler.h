@@ -0,0 +1,310 @@
+/**
+ * @file FiberScheduler.h
+ * @brief 用户态纤程调度器与纤程感知的阻塞等待/套接字 I/O
+ * @details 定义了 LSX_LIB::Thread 命名空间下的 FiberOptions、FiberScheduler 类、fiberWait 函数模板和 FiberIO 函数。
+ * 纤程 (fiber) 是在用户态切换的轻量级执行流：每个纤程只占用一个较小的栈（默认 64 KiB，而 OS 线程默认 8 MiB），
+ * 没有内核任务，切换不经过内核调度器。FiberScheduler 在少量 OS 工作线程上运行成千上万个纤程，
+ * 纤程中的代码可以保持 "阻塞式" 写法：等待套接字可读、等待队列非空、休眠时只挂起当前纤程，
+ * 工作线程转而运行其他纤程，并在空闲时通过 epoll 等待描述符就绪或定时器到期。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **上下文切换**: 基于 ucontext（makecontext/swapcontext），在 aarch64、armhf 和 x86_64 的 glibc 上均可用。
+ * - **栈池**: 纤程栈由 mmap 分配，最低地址处有一页 PROT_NONE 保护页，栈溢出时立即触发 SIGSEGV 而不是破坏相邻内存；纤程结束后栈放回工作线程本地的栈池复用。
+ * - **工作线程**: 每个纤程固定在创建时分配到的工作线程上运行（轮询分配），不会跨线程迁移，纤程内使用 thread_local 是安全的。
+ * - **纤程感知的等待**: `waitReadable` / `waitWritable` / `sleepFor` / `yield` 在纤程中挂起当前纤程，在普通线程中退化为 poll/sleep 阻塞。
+ * - **队列等待**: `fiberWait` 借助容器的就绪通知描述符（FixedSizeQueue、Pipe、Queue、CircularQueue 的 `EnableNotification` / `NativeHandle`）在纤程中等待队列非空。
+ * - **套接字 I/O**: `FiberIO::recv/send/read/write/connect/accept` 提供带超时的纤程感知 I/O；`recv`/`send` 使用 MSG_DONTWAIT，可直接用于阻塞模式的套接字。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "FiberScheduler.h"
+ * #include "FixedSizeQueue.h"
+ * #include <iostream>
+ *
+ * using namespace LSX_LIB::Thread;
+ *
+ * int main() {
+ * FiberOptions options;
+ * options.workers = 2; // 2 个 OS 线程
+ * FiberScheduler scheduler(options);
+ *
+ * // 1000 个设备连接，每个连接一个纤程，以阻塞式写法收发
+ * for (int i = 0; i < 1000; ++i) {
+ * scheduler.spawn([i] {
+ * int fd = FiberIO::connect("192.168.1.10", 5000 + i % 8, 3000);
+ * if (fd < 0) return;
+ * uint8_t buffer[512];
+ * while (true) {
+ * ssize_t n = FiberIO::recv(fd, buffer, sizeof(buffer), 5000); // 只挂起本纤程
+ * if (n <= 0) break; // 0: 对端关闭；-1: 错误或超时 (errno == ETIMEDOUT)
+ * FiberIO::send(fd, buffer, static_cast<size_t>(n), 1000);
+ * }
+ * ::close(fd);
+ * });
+ * }
+ *
+ * // 在纤程中等待库中的队列
+ * LSX_LIB::Memory::FixedSizeQueue queue(256, 64);
+ * scheduler.spawn([&queue] {
+ * uint8_t block[256];
+ * while (fiberWait(queue, [&] { return queue.Get(block, sizeof(block)); }, 1000)) {
+ * // 处理 block
+ * }
+ * });
+ *
+ * scheduler.shutdown(); // 等待所有纤程结束
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **不要在纤程中调用真正阻塞的函数**: 阻塞的系统调用、std::mutex 长时间等待、条件变量、`GetBlocking` 等会阻塞整个工作线程及其上的所有纤程。应改用本文件提供的等待函数。
+ * - **不要跨纤程持有锁**: 纤程挂起时持有 std::mutex，同一工作线程上的其他纤程再去加锁会使工作线程死锁。
+ * - **栈大小**: 纤程栈大小固定，深递归或大的栈上数组需要相应增大 `FiberOptions::stackSize`；溢出会触发 SIGSEGV。
+ * - **描述符**: `FiberIO::read/write/accept` 要求描述符为非阻塞模式（可调用 `FiberIO::setNonBlocking`）；`connect` 返回的套接字已是非阻塞模式。
+ * - **关闭**: `shutdown()`（析构时自动调用）不再接受外部创建的新纤程（纤程内部仍可创建子纤程），并等待所有纤程自行结束；长期运行的纤程应检查 `isStopping()`。
+ * - **平台**: 依赖 ucontext 和 epoll，仅支持 Linux；其他平台上 `spawn` 返回 false。
+ * - **拷贝/移动**: 类禁用了拷贝构造和赋值。
+ */
+
+#ifndef LSX_LIB_THREAD_FIBER_SCHEDULER_H
+#define LSX_LIB_THREAD_FIBER_SCHEDULER_H
+#pragma once
+
+#include <atomic> // 包含 std::atomic
+#include <chrono> // 包含 std::chrono::steady_clock
+#include <cstddef> // 包含 size_t
+#include <cstdint> // 包含 uint16_t
+#include <functional> // 包含 std::function
+#include <memory> // 包含 std::unique_ptr
+#include <string> // 包含 std::string
+#include <vector> // 包含 std::vector
+#include <sys/types.h> // 包含 ssize_t
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB
+{
+    /**
+     * @brief 线程相关的命名空间。
+     * 包含线程管理和线程间通信相关的类和工具。
+     */
+    namespace Thread
+    {
+        /**
+         * @brief 纤程调度器参数。
+         */
+        struct FiberOptions
+        {
+            size_t workers = 1; ///< OS 工作线程数，为 0 时按 1 处理
+            size_t stackSize = 64 * 1024; ///< 每个纤程的可用栈大小（字节），向上取整到页大小，另加一页保护页
+            size_t maxPooledStacks = 256; ///< 每个工作线程缓存的空闲栈数量上限
+        };
+
+        /**
+         * @brief 用户态纤程调度器。
+         */
+        class FiberScheduler
+        {
+        public:
+            /**
+             * @brief 构造函数。创建并启动工作线程。
+             *
+             * @param options 调度器参数。
+             */
+            explicit FiberScheduler(const FiberOptions& options = FiberOptions());
+
+            /**
+             * @brief 析构函数。调用 shutdown()。
+             */
+            ~FiberScheduler();
+
+            // Prevent copying and assignment
+            FiberScheduler(const FiberScheduler&) = delete;
+            FiberScheduler& operator=(const FiberScheduler&) = delete;
+
+            /**
+             * @brief 创建一个纤程。可由任意线程（包括纤程）调用。
+             *
+             * @param fn 纤程函数。函数中抛出的异常会被捕获并输出到 std::cerr。
+             * @return 成功返回 true；调度器已关闭（纤程内部创建子纤程除外）或平台不支持时返回 false。
+             */
+            bool spawn(std::function<void()> fn);
+
+            /**
+             * @brief 关闭调度器：不再接受外部创建的新纤程，等待所有纤程结束后停止工作线程。重复调用是安全的。
+             * 不能在纤程内部调用。
+             */
+            void shutdown();
+
+            /**
+             * @brief 是否已调用 shutdown()，长期运行的纤程应据此退出。
+             */
+            bool isStopping() const;
+
+            /**
+             * @brief 当前存活的纤程数。
+             */
+            size_t fiberCount() const;
+
+            /**
+             * @brief 检查当前代码是否运行在纤程中。
+             */
+            static bool inFiber();
+
+            /**
+             * @brief 让出执行权，让同一工作线程上的其他就绪纤程先运行。不在纤程中时调用 std::this_thread::yield()。
+             */
+            static void yield();
+
+            /**
+             * @brief 休眠指定毫秒数。在纤程中只挂起当前纤程。
+             *
+             * @param ms 休眠时间（毫秒），<= 0 时等同于 yield()。
+             */
+            static void sleepFor(long ms);
+
+            /**
+             * @brief 等待描述符可读（或出现错误/挂断）。
+             *
+             * @param fd 描述符。
+             * @param timeout_ms 超时时间（毫秒）：<0 无限等待，0 只检查，>0 限时等待。
+             * @return 就绪返回 true，超时返回 false。无法加入 epoll 的描述符（如普通文件）视为总是就绪。
+             */
+            static bool waitReadable(int fd, long timeout_ms = -1);
+
+            /**
+             * @brief 等待描述符可写（或出现错误/挂断）。参数与返回值同 waitReadable。
+             */
+            static bool waitWritable(int fd, long timeout_ms = -1);
+
+            /**
+             * @brief 工作线程的内部状态（实现细节）。
+             */
+            struct Worker;
+
+        private:
+            FiberOptions options_; // Normalized options
+            std::vector<std::unique_ptr<Worker>> workers_; // One OS thread each
+            std::atomic<size_t> nextWorker_{0}; // Round-robin spawn target
+            std::atomic<size_t> liveFibers_{0}; // Fibers spawned and not yet finished
+            std::atomic<bool> stopping_{false}; // shutdown() has been called
+            std::atomic<bool> joined_{false}; // Workers have been joined
+        };
+
+        /**
+         * @brief 在纤程中等待容器可操作 (模板)。
+         * 先调用一次 tryOp，失败时启用容器的就绪通知描述符并等待其可读，然后重试，直到成功或超时。
+         * 适用于提供 `EnableNotification()` 和 `NativeHandle()` 的容器（FixedSizeQueue、Pipe、Queue、CircularQueue 等）。
+         * 在普通线程中调用时以 poll 阻塞等待。
+         *
+         * @tparam Container 容器类型。
+         * @tparam TryOp 非阻塞操作，返回可转换为 bool 的值，true 表示成功。
+         * @param container 要等待的容器。
+         * @param tryOp 非阻塞操作，如 `[&] { return queue.Get(buf, size); }`。
+         * @param timeout_ms 超时时间（毫秒）：<0 无限等待，0 只尝试一次，>0 限时等待。
+         * @return tryOp 成功返回 true，超时返回 false。
+         */
+        template <typename Container, typename TryOp>
+        bool fiberWait(Container& container, TryOp&& tryOp, long timeout_ms = -1)
+        {
+            if (tryOp())
+            {
+                return true;
+            }
+            if (timeout_ms == 0)
+            {
+                return false;
+            }
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+            const bool notify = container.EnableNotification();
+            while (true)
+            {
+                long remaining = -1;
+                if (timeout_ms > 0)
+                {
+                    const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                        deadline - std::chrono::steady_clock::now()).count();
+                    if (left <= 0)
+                    {
+                        return static_cast<bool>(tryOp());
+                    }
+                    remaining = static_cast<long>(left);
+                }
+                if (notify)
+                {
+                    FiberScheduler::waitReadable(container.NativeHandle(), remaining);
+                }
+                else
+                {
+                    FiberScheduler::sleepFor(1); // No pollable handle on this platform: fall back to polling
+                }
+                if (tryOp())
+                {
+                    return true;
+                }
+            }
+        }
+
+        /**
+         * @brief 纤程感知的描述符 I/O。
+         * 返回值约定：>0 为传输的字节数；0 表示对端关闭（仅接收）；-1 表示错误，超时时 errno 为 ETIMEDOUT。
+         * 超时参数 timeout_ms：<0 无限等待，>0 为整个调用的总超时。
+         */
+        namespace FiberIO
+        {
+            /**
+             * @brief 把描述符设置为非阻塞模式。
+             */
+            bool setNonBlocking(int fd);
+
+            /**
+             * @brief 接收数据（一次，最多 size 字节）。使用 MSG_DONTWAIT，阻塞模式的套接字也可以使用。
+             */
+            ssize_t recv(int fd, void* buffer, size_t size, long timeout_ms = -1);
+
+            /**
+             * @brief 发送全部数据。使用 MSG_DONTWAIT | MSG_NOSIGNAL，阻塞模式的套接字也可以使用。
+             *
+             * @return 成功返回 size，失败或超时返回 -1。
+             */
+            ssize_t send(int fd, const void* data, size_t size, long timeout_ms = -1);
+
+            /**
+             * @brief 读取数据（一次，最多 size 字节）。描述符必须为非阻塞模式（串口、管道等）。
+             */
+            ssize_t read(int fd, void* buffer, size_t size, long timeout_ms = -1);
+
+            /**
+             * @brief 写入全部数据。描述符必须为非阻塞模式。
+             *
+             * @return 成功返回 size，失败或超时返回 -1。
+             */
+            ssize_t write(int fd, const void* data, size_t size, long timeout_ms = -1);
+
+            /**
+             * @brief 建立 TCP 连接。
+             *
+             * @param ip IPv4 地址字符串。
+             * @param port 端口。
+             * @param timeout_ms 连接超时时间（毫秒）。
+             * @return 已连接的非阻塞套接字，失败返回 -1。
+             */
+            int connect(const std::string& ip, uint16_t port, long timeout_ms = -1);
+
+            /**
+             * @brief 接受一个连接。监听套接字必须为非阻塞模式。
+             *
+             * @return 新连接的非阻塞套接字，失败或超时返回 -1。
+             */
+            int accept(int listen_fd, long timeout_ms = -1);
+        } // namespace FiberIO
+    } // namespace Thread
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_THREAD_FIBER_SCHEDULER_H
@@ -0,0 +1,209 @@
+/**
+ * @file MpscQueue.h
+ * @brief 无锁多生产者单消费者队列
+ * @details 定义了 LSX_LIB::Thread 命名空间下的 MpscQueue 模板类，
+ * 这是一个基于链表的无锁多生产者单消费者 (MPSC) 队列（Vyukov 算法）。
+ * 任意数量的线程可以并发调用 `push`，入队只需要一次原子交换和一次原子存储，没有 CAS 重试循环；
+ * 同一时刻只允许一个线程调用 `tryPop` / `empty`。
+ * 它是 Strand 等 "多线程投递、串行执行" 组件的基础数据结构。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **无锁入队**: `push` 对生产者是无等待的 (wait-free)，不会因为其他生产者或消费者被阻塞。
+ * - **FIFO 顺序**: 同一生产者的元素按入队顺序出队；不同生产者之间按原子交换的先后顺序排列。
+ * - **无界**: 每个元素一个链表节点，队列长度只受内存限制；`sizeApprox()` 提供近似长度用于背压判断。
+ * - **任意元素类型**: 元素只需要可移动构造，不要求可默认构造。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "MpscQueue.h"
+ * #include <iostream>
+ * #include <thread>
+ * #include <vector>
+ *
+ * int main() {
+ * LSX_LIB::Thread::MpscQueue<int> queue;
+ *
+ * // 多个生产者并发入队
+ * std::vector<std::thread> producers;
+ * for (int p = 0; p < 4; ++p) {
+ * producers.emplace_back([&queue, p] {
+ * for (int i = 0; i < 1000; ++i) queue.push(p * 1000 + i);
+ * });
+ * }
+ *
+ * // 单个消费者出队
+ * int received = 0;
+ * int value = 0;
+ * while (received < 4000) {
+ * if (queue.tryPop(value)) ++received;
+ * }
+ * for (auto& t : producers) t.join();
+ * std::cout << "received " << received << std::endl;
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **单消费者**: `tryPop` 和 `empty` 只能由同一时刻的一个线程调用，多个消费者需要外部互斥或使用 Strand 保证串行。
+ * - **短暂的不可见**: 生产者在原子交换之后、链接节点之前被抢占时，消费者会暂时看不到该元素及其后的元素（`tryPop` 返回 false，而 `empty` 返回 false）。消费者应稍后重试而不是认为元素丢失。
+ * - **内存分配**: 每次 `push` 分配一个节点，`tryPop` 释放一个节点。
+ * - **拷贝/移动**: 类禁用了拷贝构造和赋值。
+ */
+
+#ifndef LSX_LIB_THREAD_MPSC_QUEUE_H
+#define LSX_LIB_THREAD_MPSC_QUEUE_H
+#pragma once
+
+#include <atomic> // 包含 std::atomic
+#include <cstddef> // 包含 size_t
+#include <optional> // 包含 std::optional
+#include <utility> // 包含 std::move
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB
+{
+    /**
+     * @brief 线程相关的命名空间。
+     * 包含线程管理和线程间通信相关的类和工具。
+     */
+    namespace Thread
+    {
+        /**
+         * @brief 无锁多生产者单消费者队列 (模板)。
+         *
+         * @tparam T 元素类型，需要可移动构造。
+         */
+        template <typename T>
+        class MpscQueue
+        {
+        public:
+            /**
+             * @brief 构造函数。创建一个空队列。
+             */
+            MpscQueue() : head_(new Node()), tail_(head_.load(std::memory_order_relaxed))
+            {
+            }
+
+            /**
+             * @brief 析构函数。释放所有尚未出队的元素。
+             * 调用时不能有其他线程正在访问队列。
+             */
+            ~MpscQueue()
+            {
+                Node* node = tail_;
+                while (node != nullptr)
+                {
+                    Node* next = node->next.load(std::memory_order_relaxed);
+                    delete node;
+                    node = next;
+                }
+            }
+
+            // Prevent copying and assignment
+            MpscQueue(const MpscQueue&) = delete;
+            MpscQueue& operator=(const MpscQueue&) = delete;
+
+            /**
+             * @brief 入队一个元素。可由任意线程并发调用。
+             *
+             * @param value 要入队的元素。
+             */
+            void push(T value)
+            {
+                Node* node = new Node(std::move(value));
+                size_.fetch_add(1, std::memory_order_relaxed);
+                // seq_cst exchange: pairs with the consumer's empty() recheck (see Strand)
+                Node* prev = head_.exchange(node);
+                prev->next.store(node, std::memory_order_release);
+            }
+
+            /**
+             * @brief 尝试出队一个元素。只能由消费者线程调用。
+             *
+             * @param out 出队成功时，元素被移动到此处。
+             * @return 成功返回 true；队列为空（或队首元素尚未链接完成）时返回 false。
+             */
+            bool tryPop(T& out)
+            {
+                Node* tail = tail_;
+                Node* next = tail->next.load(std::memory_order_acquire);
+                if (next == nullptr)
+                {
+                    return false;
+                }
+                out = std::move(*next->value);
+                next->value.reset(); // next becomes the new stub; release the payload now
+                tail_ = next;
+                delete tail;
+                size_.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            /**
+             * @brief 尝试出队一个元素。只能由消费者线程调用。
+             * 适用于不可默认构造的元素类型。
+             *
+             * @return 出队的元素；队列为空（或队首元素尚未链接完成）时返回 std::nullopt。
+             */
+            std::optional<T> tryPop()
+            {
+                Node* tail = tail_;
+                Node* next = tail->next.load(std::memory_order_acquire);
+                if (next == nullptr)
+                {
+                    return std::nullopt;
+                }
+                std::optional<T> out(std::move(next->value));
+                next->value.reset();
+                tail_ = next;
+                delete tail;
+                size_.fetch_sub(1, std::memory_order_relaxed);
+                return out;
+            }
+
+            /**
+             * @brief 检查队列是否为空。只能由消费者线程调用。
+             * 与 `push` 中的原子交换构成顺序一致的配对：生产者完成交换后，消费者一定能观察到非空。
+             *
+             * @return 没有任何已入队（包括尚未链接完成）的元素时返回 true。
+             */
+            bool empty() const
+            {
+                return head_.load() == tail_;
+            }
+
+            /**
+             * @brief 获取近似的元素个数。可由任意线程调用，结果仅供统计和背压判断。
+             */
+            size_t sizeApprox() const
+            {
+                return size_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            /**
+             * @brief 链表节点。队首始终是一个不携带元素的占位节点。
+             */
+            struct Node
+            {
+                Node() = default;
+                explicit Node(T&& v) : value(std::move(v)) {}
+
+                std::atomic<Node*> next{nullptr}; // Link written by the producer that enqueued the successor
+                std::optional<T> value; // Empty for the stub node
+            };
+
+            std::atomic<Node*> head_; // Most recently pushed node (producers)
+            Node* tail_; // Stub node; its successor is the next element to pop (consumer only)
+            std::atomic<size_t> size_{0}; // Approximate element count
+        };
+    } // namespace Thread
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_THREAD_MPSC_QUEUE_H
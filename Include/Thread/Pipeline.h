@@ -0,0 +1,808 @@
+/**
+ * @file Pipeline.h
+ * @brief 流式处理流水线框架
+ * @details 定义了 LSX_LIB::Thread 命名空间下的 Pipeline、Stream、Emitter、StageOptions 和 StageMetrics。
+ * 流水线由若干阶段 (stage) 组成：一个数据源阶段，若干处理阶段，最后一个输出阶段。
+ * 相邻阶段之间通过有界通道连接，通道以批为单位传递数据，底层存储使用 Memory::Queue。
+ * 下游处理不过来时，上游阻塞在已满的通道上，形成逐级背压。
+ * 每个阶段可以单独设置并行度（工作线程数），所有阶段的工作线程运行在流水线内部的 ThreadPool 上，
+ * 调整并行度只需要修改 StageOptions，不必改写阶段函数或重新连接线程和队列。
+ * 流水线为每个阶段统计吞吐量、处理耗时、输入队列深度和因背压阻塞的时间。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **类型化连接**: `source<T>()` 返回 `Stream<T>`，在其上调用 `map` / `flatMap` 得到下游的 Stream，最后用 `sink` / `sinkBatch` 结束，阶段之间的数据类型在编译期检查。
+ * - **可配置并行度**: `StageOptions::parallelism` 指定阶段的工作线程数；同一阶段的多个工作线程从同一个输入通道取数据。
+ * - **有界通道与背压**: `StageOptions::queueCapacity` 指定阶段输入通道的容量（元素个数），通道已满时上游阻塞。
+ * - **批量交接**: 工作线程每次从通道取出最多 `batchSize` 个元素，处理产生的输出在批处理结束后一次性交给下游，每批只加锁一次。
+ * - **批量输出**: `sinkBatch` 以批为单位调用输出函数，适合在一个数据库事务中写入一批数据。
+ * - **有序结束**: 数据源函数返回（或调用 `stop()` 后返回）后，上游数据全部处理完毕时下游依次结束，`wait()` 返回。
+ * - **运行指标**: `metrics()` 返回每个阶段的输入/输出元素数、吞吐量、平均处理耗时、最大批处理耗时、队列深度和背压阻塞时间；`dump()` 输出为文本表格。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "Pipeline.h"
+ * #include "FixedSizeQueue.h"
+ * #include <iostream>
+ *
+ * struct Frame { std::vector<uint8_t> bytes; };
+ * struct Record { int id; double value; };
+ *
+ * int main() {
+ * LSX_LIB::Memory::FixedSizeQueue rx_queue(256, 1024); // 由串口线程写入
+ * LSX_LIB::Thread::Pipeline pipeline;
+ *
+ * LSX_LIB::Thread::StageOptions decode_options;
+ * decode_options.parallelism = 4; // 解码是瓶颈，使用 4 个线程
+ * decode_options.queueCapacity = 4096;
+ *
+ * LSX_LIB::Thread::StageOptions writer_options;
+ * writer_options.batchSize = 500; // 每个事务写入最多 500 条
+ *
+ * pipeline.source<Frame>("serial", [&](LSX_LIB::Thread::Emitter<Frame>& out) {
+ * std::vector<uint8_t> block(256);
+ * while (out.running()) {
+ * if (rx_queue.GetBlocking(block.data(), block.size(), 100)) { // 超时返回以便响应 stop()
+ * out.emit(Frame{block});
+ * }
+ * }
+ * })
+ * .map("decode", [](Frame& f) { return Record{f.bytes[0], f.bytes[1] * 0.1}; }, decode_options)
+ * .sinkBatch("sqlite", [&](std::vector<Record>& batch) {
+ * // BEGIN; INSERT ... (batch.size() 次); COMMIT;
+ * }, writer_options);
+ *
+ * pipeline.start();
+ * for (int i = 0; i < 10; ++i) {
+ * std::this_thread::sleep_for(std::chrono::seconds(1));
+ * pipeline.dump(std::cout); // 定位瓶颈：队列深度持续增长、上游阻塞时间增加的阶段
+ * }
+ * pipeline.stop(); // 数据源退出，剩余数据处理完后各阶段依次结束
+ * pipeline.wait();
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **数据源必须可停止**: 数据源函数应周期性检查 `Emitter::running()`，阻塞读取应使用超时，否则 `stop()` 后数据源无法退出，`wait()` 不会返回。
+ * - **顺序**: 并行度为 1 的阶段保持输入顺序；并行度大于 1 时，不同批次的输出顺序不确定。
+ * - **单一下游**: 每个 Stream 只能连接一个下游阶段；所有 Stream 都必须连接下游（以 sink 结束），否则 `start()` 抛出 std::logic_error。
+ * - **构建时机**: 阶段必须在 `start()` 之前添加，之后添加抛出 std::logic_error。
+ * - **异常处理**: 阶段函数抛出的异常会被捕获并输出到 std::cerr，计入该阶段的错误数，当前元素（或批次）被丢弃，流水线继续运行。
+ * - **数据源的交接**: 数据源的 `emit` 每次调用立即把元素交给下游；需要批量交接时可先收集再调用 `emitBatch`。
+ * - **拷贝/移动**: Pipeline 禁用了拷贝构造和赋值；析构时调用 `stop()` 并等待所有阶段结束。
+ */
+
+#ifndef LSX_LIB_THREAD_PIPELINE_H
+#define LSX_LIB_THREAD_PIPELINE_H
+#pragma once
+
+#include <atomic> // 包含 std::atomic
+#include <chrono> // 包含 std::chrono::steady_clock
+#include <condition_variable> // 包含 std::condition_variable
+#include <cstddef> // 包含 size_t
+#include <cstdint> // 包含 uint64_t
+#include <exception> // 包含 std::exception
+#include <functional> // 包含 std::function
+#include <iostream> // 包含 std::cerr
+#include <iterator> // 包含 std::make_move_iterator
+#include <memory> // 包含 std::shared_ptr, std::unique_ptr
+#include <mutex> // 包含 std::mutex
+#include <ostream> // 包含 std::ostream
+#include <stdexcept> // 包含 std::logic_error
+#include <string> // 包含 std::string
+#include <type_traits> // 包含 std::invoke_result_t
+#include <utility> // 包含 std::move
+#include <vector> // 包含 std::vector
+
+#include "Queue.h" // 包含 Memory::Queue，作为通道的批存储
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB
+{
+    /**
+     * @brief 线程相关的命名空间。
+     * 包含线程管理和线程间通信相关的类和工具。
+     */
+    namespace Thread
+    {
+        class ThreadPool;
+        class Pipeline;
+
+        /**
+         * @brief 流水线阶段参数。
+         */
+        struct StageOptions
+        {
+            size_t parallelism = 1; ///< 工作线程数，为 0 时按 1 处理
+            size_t queueCapacity = 1024; ///< 输入通道容量（元素个数），为 0 时按 1 处理；数据源阶段忽略
+            size_t batchSize = 64; ///< 每次从输入通道取出的最大元素数，为 0 时按 1 处理；数据源阶段忽略
+        };
+
+        /**
+         * @brief 一个阶段的运行指标快照。
+         */
+        struct StageMetrics
+        {
+            std::string name; ///< 阶段名称
+            size_t parallelism = 0; ///< 工作线程数
+            size_t activeWorkers = 0; ///< 尚未结束的工作线程数
+            uint64_t itemsIn = 0; ///< 累计从输入通道取出的元素数（数据源为 0）
+            uint64_t itemsOut = 0; ///< 累计交给下游的元素数（输出阶段为 0）
+            uint64_t errors = 0; ///< 阶段函数抛出异常的次数
+            double itemsPerSecond = 0.0; ///< 自上次快照以来的吞吐量（数据源按输出计算，其他阶段按输入计算）
+            double avgProcessUs = 0.0; ///< 自上次快照以来平均每个元素的处理耗时（微秒）
+            double maxBatchUs = 0.0; ///< 自上次快照以来单个批次的最大处理耗时（微秒）
+            size_t queueDepth = 0; ///< 输入通道当前的元素数
+            size_t queueCapacity = 0; ///< 输入通道容量
+            double blockedMs = 0.0; ///< 累计因下游通道已满而阻塞的时间（毫秒）
+        };
+
+        /**
+         * @brief 流水线实现细节，用户代码不应直接使用。
+         */
+        namespace PipelineDetail
+        {
+            /**
+             * @brief 连接两个阶段的有界批通道 (模板)。
+             * 以 std::vector<T> 为单位存入 Memory::Queue，容量按元素个数计算。
+             */
+            template <typename T>
+            class Channel
+            {
+            public:
+                explicit Channel(size_t capacity) : capacity_(capacity == 0 ? 1 : capacity)
+                {
+                }
+
+                /**
+                 * @brief 放入一批元素，通道空间不足时阻塞。
+                 * 通道为空时总是接受，即使批次大于容量，以免大批次永远无法放入。
+                 *
+                 * @return 因背压阻塞的时间（纳秒）。
+                 */
+                uint64_t push(std::vector<T>&& batch)
+                {
+                    const size_t n = batch.size();
+                    if (n == 0)
+                    {
+                        return 0;
+                    }
+                    uint64_t blocked_ns = 0;
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    auto has_space = [this, n] { return items_ == 0 || items_ + n <= capacity_; };
+                    if (!has_space())
+                    {
+                        const auto start = std::chrono::steady_clock::now();
+                        not_full_.wait(lock, has_space);
+                        blocked_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start).count());
+                    }
+                    items_ += n;
+                    batches_.Push(std::move(batch));
+                    lock.unlock();
+                    not_empty_.notify_one();
+                    return blocked_ns;
+                }
+
+                /**
+                 * @brief 取出最多 maxItems 个元素（按整批取出，最后一批可能使总数超过 maxItems），通道为空时阻塞。
+                 *
+                 * @param out 输出，调用前应为空。
+                 * @param maxItems 目标元素个数。
+                 * @return 取到数据返回 true；通道已关闭且为空时返回 false。
+                 */
+                bool pop(std::vector<T>& out, size_t maxItems)
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    not_empty_.wait(lock, [this] { return items_ > 0 || closed_; });
+                    if (items_ == 0)
+                    {
+                        return false;
+                    }
+                    do
+                    {
+                        std::optional<std::vector<T>> batch = batches_.Pop();
+                        items_ -= batch->size();
+                        if (out.empty())
+                        {
+                            out = std::move(*batch);
+                        }
+                        else
+                        {
+                            out.insert(out.end(), std::make_move_iterator(batch->begin()),
+                                       std::make_move_iterator(batch->end()));
+                        }
+                    }
+                    while (items_ > 0 && out.size() < maxItems);
+                    const bool more = items_ > 0;
+                    lock.unlock();
+                    not_full_.notify_all();
+                    if (more)
+                    {
+                        not_empty_.notify_one(); // Let another worker of the same stage take the rest
+                    }
+                    return true;
+                }
+
+                /**
+                 * @brief 关闭通道：上游已全部结束，取空后 pop 返回 false。
+                 */
+                void close()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        closed_ = true;
+                    }
+                    not_empty_.notify_all();
+                }
+
+                /**
+                 * @brief 当前元素个数。
+                 */
+                size_t depth() const
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    return items_;
+                }
+
+                /**
+                 * @brief 容量（元素个数）。
+                 */
+                size_t capacity() const
+                {
+                    return capacity_;
+                }
+
+            private:
+                Memory::Queue<std::vector<T>> batches_; // Queued batches in FIFO order
+                const size_t capacity_; // Capacity in elements
+                size_t items_ = 0; // Elements in batches_
+                bool closed_ = false; // No more batches will be pushed
+                mutable std::mutex mutex_; // Protects items_, closed_ and the batch order
+                std::condition_variable not_empty_; // Signaled on push and close
+                std::condition_variable not_full_; // Signaled on pop
+            };
+
+            /**
+             * @brief 阶段的输出端口，指向下游阶段的输入通道（连接前为空）。
+             */
+            template <typename T>
+            struct OutputPort
+            {
+                std::shared_ptr<Channel<T>> channel;
+            };
+
+            /**
+             * @brief 阶段计数器，由工作线程更新、由 metrics() 读取。
+             */
+            struct StageCounters
+            {
+                std::atomic<uint64_t> itemsIn{0};
+                std::atomic<uint64_t> itemsOut{0};
+                std::atomic<uint64_t> errors{0};
+                std::atomic<uint64_t> processNs{0};
+                std::atomic<uint64_t> maxBatchNs{0};
+                std::atomic<uint64_t> blockedNs{0};
+
+                void addBatch(uint64_t items, uint64_t ns)
+                {
+                    itemsIn.fetch_add(items, std::memory_order_relaxed);
+                    processNs.fetch_add(ns, std::memory_order_relaxed);
+                    uint64_t max = maxBatchNs.load(std::memory_order_relaxed);
+                    while (ns > max && !maxBatchNs.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+                    {
+                    }
+                }
+            };
+
+            /**
+             * @brief 类型擦除的阶段基类。
+             */
+            class StageBase
+            {
+            public:
+                StageBase(std::string n, const StageOptions& o) : name(std::move(n)), options(o)
+                {
+                    if (options.parallelism == 0) options.parallelism = 1;
+                    if (options.queueCapacity == 0) options.queueCapacity = 1;
+                    if (options.batchSize == 0) options.batchSize = 1;
+                }
+
+                virtual ~StageBase() = default;
+
+                /**
+                 * @brief 一个工作线程的主循环，返回即该工作线程结束。
+                 */
+                virtual void runWorker(const std::atomic<bool>& stopping) = 0;
+
+                /**
+                 * @brief 最后一个工作线程结束时调用，关闭下游通道。
+                 */
+                virtual void closeOutput() = 0;
+
+                /**
+                 * @brief 输出端口是否已连接（输出阶段总是返回 true）。
+                 */
+                virtual bool outputConnected() const = 0;
+
+                /**
+                 * @brief 输入通道的深度和容量（数据源返回 0）。
+                 */
+                virtual size_t queueDepth() const { return 0; }
+                virtual size_t queueCapacity() const { return 0; }
+
+                /**
+                 * @brief 执行阶段函数并吸收异常。
+                 */
+                template <typename F>
+                void guarded(F&& f)
+                {
+                    try
+                    {
+                        f();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        counters.errors.fetch_add(1, std::memory_order_relaxed);
+                        std::cerr << "Pipeline stage '" << name << "' failed: " << e.what() << std::endl;
+                    } catch (...)
+                    {
+                        counters.errors.fetch_add(1, std::memory_order_relaxed);
+                        std::cerr << "Pipeline stage '" << name << "' failed with unknown error." << std::endl;
+                    }
+                }
+
+                const std::string name; // Stage name used in metrics
+                StageOptions options; // Normalized options
+                StageCounters counters; // Runtime counters
+                std::atomic<size_t> activeWorkers{0}; // Workers that have not returned yet
+            };
+        } // namespace PipelineDetail
+
+        /**
+         * @brief 阶段的输出接口 (模板)，由流水线传给数据源函数和 flatMap 函数。
+         *
+         * @tparam T 输出元素类型。
+         */
+        template <typename T>
+        class Emitter
+        {
+        public:
+            /**
+             * @brief 输出一个元素。
+             * 数据源阶段立即交给下游（下游通道已满时阻塞）；处理阶段在当前批次处理完后统一交给下游。
+             */
+            void emit(T value)
+            {
+                buffer_.push_back(std::move(value));
+                if (immediate_)
+                {
+                    flush();
+                }
+            }
+
+            /**
+             * @brief 输出一批元素，数据源阶段立即交给下游。
+             */
+            void emitBatch(std::vector<T>&& values)
+            {
+                if (buffer_.empty())
+                {
+                    buffer_ = std::move(values);
+                }
+                else
+                {
+                    buffer_.insert(buffer_.end(), std::make_move_iterator(values.begin()),
+                                   std::make_move_iterator(values.end()));
+                }
+                if (immediate_)
+                {
+                    flush();
+                }
+            }
+
+            /**
+             * @brief 检查流水线是否仍在运行。调用 Pipeline::stop() 后返回 false，数据源应尽快返回。
+             */
+            bool running() const
+            {
+                return !stopping_.load(std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief 把已缓存的输出交给下游，下游通道已满时阻塞。
+             */
+            void flush()
+            {
+                if (buffer_.empty())
+                {
+                    return;
+                }
+                const size_t n = buffer_.size();
+                const uint64_t blocked_ns = channel_.push(std::move(buffer_));
+                buffer_.clear(); // Moved-from vector: make it a valid empty buffer again
+                counters_.itemsOut.fetch_add(n, std::memory_order_relaxed);
+                counters_.blockedNs.fetch_add(blocked_ns, std::memory_order_relaxed);
+            }
+
+        private:
+            template <typename Out>
+            friend class SourceStage;
+            template <typename In, typename Out>
+            friend class FlatMapStage;
+
+            Emitter(PipelineDetail::Channel<T>& channel, PipelineDetail::StageCounters& counters,
+                    const std::atomic<bool>& stopping, bool immediate)
+                : channel_(channel), counters_(counters), stopping_(stopping), immediate_(immediate)
+            {
+            }
+
+            PipelineDetail::Channel<T>& channel_; // Downstream input channel
+            PipelineDetail::StageCounters& counters_; // Owning stage's counters
+            const std::atomic<bool>& stopping_; // Pipeline stop request
+            const bool immediate_; // Hand off on every emit (source stages)
+            std::vector<T> buffer_; // Outputs not yet handed off
+        };
+
+        /**
+         * @brief 数据源阶段 (模板)。
+         */
+        template <typename Out>
+        class SourceStage : public PipelineDetail::StageBase
+        {
+        public:
+            SourceStage(std::string name, std::function<void(Emitter<Out>&)> fn, const StageOptions& options)
+                : StageBase(std::move(name), options), fn_(std::move(fn))
+            {
+            }
+
+            void runWorker(const std::atomic<bool>& stopping) override
+            {
+                Emitter<Out> emitter(*port.channel, counters, stopping, true);
+                const auto start = std::chrono::steady_clock::now();
+                guarded([&] { fn_(emitter); });
+                guarded([&] { emitter.flush(); });
+                counters.processNs.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count()), std::memory_order_relaxed);
+            }
+
+            void closeOutput() override { port.channel->close(); }
+            bool outputConnected() const override { return port.channel != nullptr; }
+
+            PipelineDetail::OutputPort<Out> port; // Connected by the downstream stage
+
+        private:
+            std::function<void(Emitter<Out>&)> fn_; // User source function
+        };
+
+        /**
+         * @brief 处理阶段 (模板)：对每个输入元素调用 fn(item, emitter)，可以输出 0 个或多个元素。
+         */
+        template <typename In, typename Out>
+        class FlatMapStage : public PipelineDetail::StageBase
+        {
+        public:
+            FlatMapStage(std::string name, std::function<void(In&, Emitter<Out>&)> fn, const StageOptions& options,
+                         std::shared_ptr<PipelineDetail::Channel<In>> input)
+                : StageBase(std::move(name), options), fn_(std::move(fn)), input_(std::move(input))
+            {
+            }
+
+            void runWorker(const std::atomic<bool>& stopping) override
+            {
+                Emitter<Out> emitter(*port.channel, counters, stopping, false);
+                std::vector<In> batch;
+                while (input_->pop(batch, options.batchSize))
+                {
+                    const auto start = std::chrono::steady_clock::now();
+                    for (In& item : batch)
+                    {
+                        guarded([&] { fn_(item, emitter); });
+                    }
+                    const auto end = std::chrono::steady_clock::now();
+                    counters.addBatch(batch.size(), static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+                    batch.clear();
+                    emitter.flush();
+                }
+            }
+
+            void closeOutput() override { port.channel->close(); }
+            bool outputConnected() const override { return port.channel != nullptr; }
+            size_t queueDepth() const override { return input_->depth(); }
+            size_t queueCapacity() const override { return input_->capacity(); }
+
+            PipelineDetail::OutputPort<Out> port; // Connected by the downstream stage
+
+        private:
+            std::function<void(In&, Emitter<Out>&)> fn_; // User per-item function
+            std::shared_ptr<PipelineDetail::Channel<In>> input_; // Upstream channel
+        };
+
+        /**
+         * @brief 输出阶段 (模板)：逐个元素调用 fn(item)，或以批为单位调用 fn(batch)。
+         */
+        template <typename In>
+        class SinkStage : public PipelineDetail::StageBase
+        {
+        public:
+            SinkStage(std::string name, std::function<void(In&)> itemFn, std::function<void(std::vector<In>&)> batchFn,
+                      const StageOptions& options, std::shared_ptr<PipelineDetail::Channel<In>> input)
+                : StageBase(std::move(name), options), itemFn_(std::move(itemFn)), batchFn_(std::move(batchFn)),
+                  input_(std::move(input))
+            {
+            }
+
+            void runWorker(const std::atomic<bool>&) override
+            {
+                std::vector<In> batch;
+                while (input_->pop(batch, options.batchSize))
+                {
+                    const auto start = std::chrono::steady_clock::now();
+                    if (itemFn_)
+                    {
+                        for (In& item : batch)
+                        {
+                            guarded([&] { itemFn_(item); });
+                        }
+                    }
+                    else
+                    {
+                        guarded([&] { batchFn_(batch); });
+                    }
+                    const auto end = std::chrono::steady_clock::now();
+                    counters.addBatch(batch.size(), static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+                    batch.clear();
+                }
+            }
+
+            void closeOutput() override {}
+            bool outputConnected() const override { return true; }
+            size_t queueDepth() const override { return input_->depth(); }
+            size_t queueCapacity() const override { return input_->capacity(); }
+
+        private:
+            std::function<void(In&)> itemFn_; // User per-item function (sink)
+            std::function<void(std::vector<In>&)> batchFn_; // User batch function (sinkBatch), used when itemFn_ is empty
+            std::shared_ptr<PipelineDetail::Channel<In>> input_; // Upstream channel
+        };
+
+        /**
+         * @brief 某个阶段的输出流 (模板)，用于连接下游阶段。
+         * 由 Pipeline::source 或上游 Stream 的 map/flatMap 返回，只能连接一个下游阶段。
+         *
+         * @tparam T 流中的元素类型。
+         */
+        template <typename T>
+        class Stream
+        {
+        public:
+            /**
+             * @brief 连接一个一对一处理阶段。
+             *
+             * @param name 阶段名称。
+             * @param fn 处理函数，签名为 `Out(T&)`。
+             * @param options 阶段参数。
+             * @return 处理阶段的输出流。
+             */
+            template <typename F, typename Out = std::invoke_result_t<F&, T&>>
+            Stream<Out> map(const std::string& name, F fn, const StageOptions& options = StageOptions());
+
+            /**
+             * @brief 连接一个一对多处理阶段（可用于过滤、拆分）。
+             *
+             * @tparam Out 输出元素类型。
+             * @param name 阶段名称。
+             * @param fn 处理函数，签名为 `void(T&, Emitter<Out>&)`，可调用 emit 零次或多次。
+             * @param options 阶段参数。
+             * @return 处理阶段的输出流。
+             */
+            template <typename Out, typename F>
+            Stream<Out> flatMap(const std::string& name, F fn, const StageOptions& options = StageOptions());
+
+            /**
+             * @brief 以逐个元素的输出阶段结束流水线。
+             *
+             * @param name 阶段名称。
+             * @param fn 输出函数，签名为 `void(T&)`。
+             * @param options 阶段参数。
+             */
+            template <typename F>
+            void sink(const std::string& name, F fn, const StageOptions& options = StageOptions());
+
+            /**
+             * @brief 以批量输出阶段结束流水线。
+             *
+             * @param name 阶段名称。
+             * @param fn 输出函数，签名为 `void(std::vector<T>&)`，每次最多约 batchSize 个元素。
+             * @param options 阶段参数。
+             */
+            template <typename F>
+            void sinkBatch(const std::string& name, F fn, const StageOptions& options = StageOptions());
+
+        private:
+            friend class Pipeline;
+            template <typename U>
+            friend class Stream;
+
+            Stream(Pipeline& pipeline, PipelineDetail::OutputPort<T>& port) : pipeline_(&pipeline), port_(&port)
+            {
+            }
+
+            // 为下游阶段创建输入通道并连接到本流的输出端口
+            std::shared_ptr<PipelineDetail::Channel<T>> connect(const StageOptions& options);
+
+            Pipeline* pipeline_; // Owning pipeline
+            PipelineDetail::OutputPort<T>* port_; // Output port of the producing stage
+        };
+
+        /**
+         * @brief 流式处理流水线。
+         */
+        class Pipeline
+        {
+        public:
+            /**
+             * @brief 构造函数。创建一个空流水线。
+             */
+            Pipeline();
+
+            /**
+             * @brief 析构函数。调用 stop() 并等待所有阶段结束。
+             */
+            ~Pipeline();
+
+            // Prevent copying and assignment
+            Pipeline(const Pipeline&) = delete;
+            Pipeline& operator=(const Pipeline&) = delete;
+
+            /**
+             * @brief 添加数据源阶段。
+             *
+             * @tparam Out 输出元素类型。
+             * @param name 阶段名称。
+             * @param fn 数据源函数，签名为 `void(Emitter<Out>&)`；函数返回表示该工作线程的数据已产生完毕。
+             * @param options 阶段参数，只使用 parallelism（每个工作线程各调用一次 fn）。
+             * @return 数据源的输出流。
+             * @throws std::logic_error 如果流水线已启动。
+             */
+            template <typename Out, typename F>
+            Stream<Out> source(const std::string& name, F fn, const StageOptions& options = StageOptions())
+            {
+                ensureNotStarted();
+                auto stage = std::make_unique<SourceStage<Out>>(name, std::function<void(Emitter<Out>&)>(std::move(fn)),
+                                                                 options);
+                PipelineDetail::OutputPort<Out>& port = stage->port;
+                addStage(std::move(stage));
+                return Stream<Out>(*this, port);
+            }
+
+            /**
+             * @brief 启动所有阶段的工作线程。
+             *
+             * @throws std::logic_error 如果已经启动、没有任何阶段或有 Stream 未连接下游。
+             */
+            void start();
+
+            /**
+             * @brief 请求停止：Emitter::running() 变为 false，数据源返回后剩余数据继续处理完毕。不阻塞。
+             */
+            void stop();
+
+            /**
+             * @brief 等待所有阶段结束。
+             *
+             * @param timeout_ms 等待超时时间（毫秒）：<0 无限等待，0 只检查不等待，>0 限时等待。
+             * @return 所有阶段都已结束（或从未启动）返回 true，超时返回 false。
+             */
+            bool wait(long timeout_ms = -1);
+
+            /**
+             * @brief 获取每个阶段的运行指标，按添加顺序排列。
+             * 吞吐量、平均耗时和最大批处理耗时是相对上一次调用 metrics()（或 dump()）计算的。
+             */
+            std::vector<StageMetrics> metrics();
+
+            /**
+             * @brief 把所有阶段的运行指标输出为文本表格。
+             *
+             * @param os 输出流。
+             */
+            void dump(std::ostream& os);
+
+        private:
+            template <typename U>
+            friend class Stream;
+
+            /**
+             * @brief 上一次快照时的计数，用于计算区间指标。
+             */
+            struct RateBase
+            {
+                uint64_t items = 0;
+                uint64_t processNs = 0;
+                std::chrono::steady_clock::time_point time;
+            };
+
+            // 已启动时抛出 std::logic_error
+            void ensureNotStarted();
+
+            // 添加一个阶段，启动后调用抛出 std::logic_error
+            void addStage(std::unique_ptr<PipelineDetail::StageBase> stage);
+
+            // 工作线程主函数
+            void runWorker(PipelineDetail::StageBase* stage);
+
+            std::vector<std::unique_ptr<PipelineDetail::StageBase>> stages_; // In insertion order
+            std::vector<RateBase> rateBases_; // Parallel to stages_
+            std::unique_ptr<ThreadPool> pool_; // Runs every worker loop; created by start()
+            std::atomic<bool> stopping_{false}; // Set by stop(); read through Emitter::running()
+            std::mutex mutex_; // Protects runningWorkers_, started_ and rateBases_
+            std::condition_variable done_cv_; // Signaled when runningWorkers_ reaches 0
+            size_t runningWorkers_ = 0; // Worker loops that have not returned yet
+            bool started_ = false; // start() has been called
+        };
+
+        template <typename T>
+        std::shared_ptr<PipelineDetail::Channel<T>> Stream<T>::connect(const StageOptions& options)
+        {
+            pipeline_->ensureNotStarted();
+            if (port_->channel)
+            {
+                throw std::logic_error("Pipeline: stream is already connected to a downstream stage");
+            }
+            const size_t capacity = options.queueCapacity == 0 ? 1 : options.queueCapacity;
+            auto channel = std::make_shared<PipelineDetail::Channel<T>>(capacity);
+            port_->channel = channel;
+            return channel;
+        }
+
+        template <typename T>
+        template <typename F, typename Out>
+        Stream<Out> Stream<T>::map(const std::string& name, F fn, const StageOptions& options)
+        {
+            return flatMap<Out>(name, [fn = std::move(fn)](T& item, Emitter<Out>& out) mutable
+            {
+                out.emit(fn(item));
+            }, options);
+        }
+
+        template <typename T>
+        template <typename Out, typename F>
+        Stream<Out> Stream<T>::flatMap(const std::string& name, F fn, const StageOptions& options)
+        {
+            auto stage = std::make_unique<FlatMapStage<T, Out>>(
+                name, std::function<void(T&, Emitter<Out>&)>(std::move(fn)), options, connect(options));
+            PipelineDetail::OutputPort<Out>& port = stage->port;
+            pipeline_->addStage(std::move(stage));
+            return Stream<Out>(*pipeline_, port);
+        }
+
+        template <typename T>
+        template <typename F>
+        void Stream<T>::sink(const std::string& name, F fn, const StageOptions& options)
+        {
+            auto stage = std::make_unique<SinkStage<T>>(
+                name, std::function<void(T&)>(std::move(fn)), nullptr, options, connect(options));
+            pipeline_->addStage(std::move(stage));
+        }
+
+        template <typename T>
+        template <typename F>
+        void Stream<T>::sinkBatch(const std::string& name, F fn, const StageOptions& options)
+        {
+            auto stage = std::make_unique<SinkStage<T>>(
+                name, nullptr, std::function<void(std::vector<T>&)>(std::move(fn)), options, connect(options));
+            pipeline_->addStage(std::move(stage));
+        }
+    } // namespace Thread
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_THREAD_PIPELINE_H
@@ -16,6 +16,9 @@
  * - **任务线程管理**: 为每个任务创建并管理独立的线程。
  * - **优雅关闭**: 在析构或调用 shutdown 时，会尝试停止所有由调度器管理的任务线程。
  * - **线程安全**: 使用互斥锁保护内部的任务列表，支持在多线程环境中提交和停止任务。
+ * - **CPU 统计**: 记录每个任务每次执行的 CPU 时间（`CLOCK_THREAD_CPUTIME_ID`）和墙钟时间，通过 `jobStats()` / `dumpStats()` 查看。
+ * - **CPU 预算**: 周期性任务可以设置 CPU 预算（每个窗口内平均最多消耗的 CPU 时间），超支后按设置推迟或跳过后续执行，防止单个任务占满核心。
+ * - **卡死与超时监控**: 通过 `setWatchdog` 关联 Watchdog 后，执行时间超过阈值的任务和单次执行超过周期的周期性任务会被报告，报告中包含调度时给出的任务名。
  *
  * ### 使用示例
  *
@@ -43,9 +46,18 @@
  * std::cout << "调度一个周期性任务，每隔 1 秒执行..." << std::endl;
  * scheduler.schedulePeriodic(1000, my_periodic_task);
  *
+ * // 数据压缩任务每 200 ms 执行一次，但平均每秒最多使用 100 ms CPU，为采集线程保留余量
+ * LSX_LIB::Thread::CpuBudget budget;
+ * budget.cpuMs = 100;
+ * budget.windowMs = 1000;
+ * budget.action = LSX_LIB::Thread::BudgetAction::Skip;
+ * scheduler.schedulePeriodic(200, my_periodic_task, "compress", budget);
+ *
  * std::cout << "主线程等待 5 秒..." << std::endl;
  * std::this_thread::sleep_for(std::chrono::seconds(5));
  *
+ * scheduler.dumpStats(std::cout); // 每个任务的执行次数、CPU/墙钟时间、被推迟/跳过的次数
+ *
  * std::cout << "主线程调用 shutdown 停止所有任务..." << std::endl;
  * scheduler.shutdown();
  *
@@ -57,7 +69,11 @@
  * ### 注意事项
  * - **线程创建**: 每个调度的任务都会创建一个新的 ThreadWrapper 对象，并在其内部启动一个新线程。如果调度大量任务，可能会消耗较多系统资源。
  * - **任务生命周期**: 任务线程的生命周期由 Scheduler 管理。一旦 Scheduler 对象被销毁或调用 shutdown，所有关联的任务线程将被请求停止。
- * - **任务停止**: `shutdown` 方法会向所有任务线程发送停止请求，并等待它们完成。如果任务函数内部没有检查停止标志或没有适当的退出机制，任务线程可能不会立即停止。
+ * - **任务停止**: `shutdown` 方法会向所有任务线程发送停止请求，并等待它们完成。周期性任务在两次执行之间的等待会被立即打断，正在执行的那一次会先执行完。
+ * - **CPU 预算**: 预算按令牌桶计算：每经过 windowMs 补充 cpuMs 的额度（上限为 cpuMs），每次执行扣除实际消耗的 CPU 时间；
+ *   额度为负时，`Defer` 把下一次执行推迟到额度恢复为止，`Skip` 跳过额度恢复前的所有周期。单次执行本身不会被打断。
+ * - **统计**: 已结束的一次性任务的线程和统计在调度新任务时被清理；shutdown 后统计清空。
+ * - **一次性任务**: 延迟等待可被 shutdown 立即打断；已经开始执行的任务，shutdown 会等待其执行完毕。
  * - **异常处理**: 任务函数内部抛出的异常需要在任务函数自身或 ThreadWrapper 内部进行处理，否则可能导致程序崩溃。
  * - **移动语义**: 类支持移动构造和移动赋值，但不允许拷贝，以避免多个 Scheduler 对象管理同一组任务线程。
  */
@@ -75,10 +91,14 @@
 #include "LockGuard.h"
 
 #include "ThreadWrapper.h" // 包含 ThreadWrapper 类定义
+#include "Watchdog.h" // 包含 Watchdog 类定义
 #include <vector> // 包含 std::vector
 #include <memory> // 包含 std::shared_ptr
 #include <functional> // 包含 std::function
 #include <mutex> // 添加 mutex，包含 std::mutex
+#include <string> // 包含 std::string
+#include <cstdint> // 包含 uint64_t
+#include <ostream> // 包含 std::ostream
 
 /**
  * @brief LSX 库的根命名空间。
@@ -91,6 +111,49 @@ namespace LSX_LIB
      */
     namespace Thread
     {
+        /**
+         * @brief 周期性任务超出 CPU 预算后的处理方式。
+         */
+        enum class BudgetAction
+        {
+            Defer, ///< 推迟下一次执行，直到预算恢复
+            Skip ///< 跳过预算恢复之前的周期
+        };
+
+        /**
+         * @brief 周期性任务的 CPU 预算。
+         */
+        struct CpuBudget
+        {
+            long cpuMs = 0; ///< 每个窗口内平均最多消耗的 CPU 时间（毫秒），0 表示不限制
+            long windowMs = 0; ///< 预算窗口（毫秒），0 表示与任务周期相同
+            BudgetAction action = BudgetAction::Defer; ///< 超出预算后的处理方式
+        };
+
+        /**
+         * @brief 单个任务的执行统计。
+         */
+        struct JobStats
+        {
+            std::string name; ///< 调度时给出的任务名
+            bool periodic = false; ///< 是否为周期性任务
+            long intervalMs = 0; ///< 周期或延迟（毫秒）
+            long budgetCpuMs = 0; ///< CPU 预算（毫秒），0 表示不限制
+            long budgetWindowMs = 0; ///< 预算窗口（毫秒）
+            BudgetAction budgetAction = BudgetAction::Defer; ///< 超出预算后的处理方式
+            uint64_t runs = 0; ///< 已执行次数
+            uint64_t deferred = 0; ///< 因超出预算被推迟的次数
+            uint64_t skipped = 0; ///< 因超出预算被跳过的周期数
+            double totalCpuMs = 0; ///< 累计 CPU 时间（毫秒）
+            double totalWallMs = 0; ///< 累计墙钟时间（毫秒）
+            double lastCpuMs = 0; ///< 最近一次执行的 CPU 时间（毫秒）
+            double lastWallMs = 0; ///< 最近一次执行的墙钟时间（毫秒）
+            double maxCpuMs = 0; ///< 单次执行的最大 CPU 时间（毫秒）
+            double maxWallMs = 0; ///< 单次执行的最大墙钟时间（毫秒）
+            double budgetBalanceMs = 0; ///< 当前预算余额（毫秒），为负表示超支
+            bool finished = false; ///< 任务线程是否已结束
+        };
+
         /**
          * @brief 任务调度器。
          * 基于 ThreadWrapper 实现，用于调度一次性延迟任务和周期性任务。
@@ -138,18 +201,51 @@ namespace LSX_LIB
              *
              * @param delayMs 延迟执行的毫秒数。
              * @param func 要执行的可调用对象，其签名必须是 `void()`。
+             * @param name 任务名，出现在 Watchdog 报告中，可为空。
              */
-            void scheduleOnce(int delayMs, std::function<void()> func);
+            void scheduleOnce(int delayMs, std::function<void()> func, const std::string& name = std::string());
 
             /**
              * @brief 每隔指定时间周期性执行任务。
-             * 创建一个 ThreadWrapper 对象，用于每隔指定间隔周期性地执行给定的可调用对象。
-             * 任务线程的生命周期由 Scheduler 管理。
+             * 创建一个循环模式的 ThreadWrapper 对象，按固定频率周期性地执行给定的可调用对象；
+             * 单次执行超过周期时下一次立即执行，不补跑错过的周期。任务线程的生命周期由 Scheduler 管理。
+             *
+             * @param intervalMs 周期性执行的时间间隔，单位为毫秒。
+             * @param func 要执行的可调用对象，其签名必须是 `void()`。
+             * @param name 任务名，出现在 Watchdog 报告中，可为空。
+             */
+            void schedulePeriodic(int intervalMs, std::function<void()> func, const std::string& name = std::string());
+
+            /**
+             * @brief 每隔指定时间周期性执行任务，并限制其 CPU 占用。
+             * 与上一个重载相同，另外按 budget 记账：任务消耗的 CPU 时间超出预算后，按 budget.action 推迟或跳过后续执行。
              *
              * @param intervalMs 周期性执行的时间间隔，单位为毫秒。
              * @param func 要执行的可调用对象，其签名必须是 `void()`。
+             * @param name 任务名，出现在统计和 Watchdog 报告中，可为空。
+             * @param budget CPU 预算，cpuMs 为 0 时不限制。
+             */
+            void schedulePeriodic(int intervalMs, std::function<void()> func, const std::string& name,
+                                  const CpuBudget& budget);
+
+            /**
+             * @brief 获取所有任务的执行统计，按调度顺序排列。
              */
-            void schedulePeriodic(int intervalMs, std::function<void()> func);
+            std::vector<JobStats> jobStats() const;
+
+            /**
+             * @brief 把 jobStats() 格式化为表格输出。
+             */
+            void dumpStats(std::ostream& os) const;
+
+            /**
+             * @brief 关联一个 Watchdog，对之后调度的任务生效。
+             * 每个任务线程创建一个探针：执行时间超过 Watchdog 阈值的任务被报告为卡死，
+             * 周期性任务单次执行时间超过 intervalMs 时报告周期超时。
+             *
+             * @param watchdog 监控器，传入 nullptr 取消关联。Watchdog 可以先于调度器销毁，之后不再监控。
+             */
+            void setWatchdog(Watchdog* watchdog);
 
             /**
              * @brief 停止所有由调度器创建和管理的任务线程。
@@ -159,6 +255,14 @@ namespace LSX_LIB
             void shutdown();
 
         private:
+            struct JobRecord;
+
+            /**
+             * @brief 创建任务的统计记录并加入 jobs_，同时移除已结束的一次性任务的记录。调用者持有 tasks_mtx_。
+             */
+            std::shared_ptr<JobRecord> addJob(const std::string& name, bool periodic, long intervalMs,
+                                              const CpuBudget& budget);
+
             /**
              * @brief 存储所有活跃的任务线程包装器。
              * 使用 std::shared_ptr 管理 ThreadWrapper 对象的生命周期，允许多个地方（例如，如果需要取消特定任务）共享对 ThreadWrapper 的引用。
@@ -168,7 +272,15 @@ namespace LSX_LIB
              * @brief 互斥锁。
              * 用于保护 tasks_ 向量的并发访问，确保在多线程环境下添加、移除或遍历任务列表时的线程安全。
              */
-            std::mutex tasks_mtx_; // 保护 tasks_ 向量的并发访问
+            mutable std::mutex tasks_mtx_; // 保护 tasks_ 和 jobs_ 向量的并发访问
+            /**
+             * @brief 每个任务的统计与预算状态，受 tasks_mtx_ 保护（记录内部的字段由记录自己的锁保护）。
+             */
+            std::vector<std::shared_ptr<JobRecord>> jobs_;
+            /**
+             * @brief 关联的 Watchdog，受 tasks_mtx_ 保护，只在调度任务时用于创建探针。
+             */
+            Watchdog* watchdog_ = nullptr;
         };
     } // namespace Thread
 } // namespace LSX_LIB
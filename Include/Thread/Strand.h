@@ -0,0 +1,163 @@
+/**
+ * @file Strand.h
+ * @brief 基于线程池的串行执行器
+ * @details 定义了 LSX_LIB::Thread 命名空间下的 Strand 类，
+ * 投递到同一个 Strand 的任务保证按投递顺序逐个执行、绝不并发，但可以在线程池的任意工作线程上运行。
+ * 这样大量需要串行处理的对象（每个连接、每个设备的处理器）可以共享一个小线程池，
+ * 而不必各自占用一个 ThreadWrapper 线程，也不必在处理函数外层持有互斥锁。
+ * 内部使用无锁 MPSC 队列 (MpscQueue) 保存任务，并用一个原子 "已调度" 标志保证同一时刻
+ * 线程池中最多只有一个该 Strand 的执行任务。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **串行执行**: 同一 Strand 的任务按投递顺序执行，前一个任务结束后下一个任务才开始，任务之间有 happens-before 关系。
+ * - **无锁投递**: `post` 只做一次无锁入队和一次原子交换；只有 Strand 从空闲变为有任务时才向线程池提交一次执行任务。
+ * - **批量执行**: 每次被调度最多连续执行 `maxBatch` 个任务，然后把自己重新排到线程池队尾，避免一个繁忙的 Strand 长时间占用工作线程。
+ * - **就地执行**: `dispatch` 在当前线程已经处于该 Strand 中时直接执行任务，否则等同于 `post`。
+ * - **带返回值任务**: `submit` 与 ThreadPool::enqueue 相同，返回 std::future。
+ * - **句柄语义**: Strand 对象可以拷贝，副本指向同一个串行队列；排队中的任务持有内部状态，Strand 对象先于任务销毁是安全的。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "ThreadPool.h"
+ * #include "Strand.h"
+ * #include <iostream>
+ * #include <vector>
+ *
+ * class DeviceHandler {
+ * public:
+ * explicit DeviceHandler(LSX_LIB::Thread::IThreadPool& pool) : strand_(pool) {}
+ *
+ * // 可由任意线程调用；onFrame 在 strand_ 上串行执行，无需加锁
+ * void Receive(std::vector<uint8_t> frame) {
+ * strand_.post([this, frame = std::move(frame)] { onFrame(frame); });
+ * }
+ *
+ * private:
+ * void onFrame(const std::vector<uint8_t>& frame) { bytes_ += frame.size(); }
+ *
+ * LSX_LIB::Thread::Strand strand_;
+ * size_t bytes_ = 0;
+ * };
+ *
+ * int main() {
+ * LSX_LIB::Thread::ThreadPool pool(4);
+ *
+ * // 上千个处理器共享 4 个工作线程，每个处理器内部的回调互不并发
+ * std::vector<std::unique_ptr<DeviceHandler>> handlers;
+ * for (int i = 0; i < 1000; ++i) handlers.emplace_back(new DeviceHandler(pool));
+ *
+ * handlers[0]->Receive(std::vector<uint8_t>(64));
+ *
+ * LSX_LIB::Thread::Strand strand(pool);
+ * auto result = strand.submit([](int a, int b) { return a + b; }, 1, 2);
+ * std::cout << "result: " << result.get() << std::endl;
+ *
+ * pool.shutdown();
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **线程池生命周期**: 线程池必须比所有向其投递过任务的 Strand 活得更久。线程池已停止时执行任务无法提交，之后投递到该 Strand 的任务不会再执行。
+ * - **不要阻塞**: Strand 中的任务占用的是共享的工作线程，长时间阻塞会拖慢同一线程池上的其他 Strand。
+ * - **异常处理**: `post`/`dispatch` 提交的任务抛出的异常会被捕获并输出到 std::cerr，不影响后续任务；`submit` 的异常通过 future 传递。
+ * - **对象生命周期**: 任务中捕获的 this 指针需要由调用方保证在任务执行时仍然有效。
+ * - **销毁**: 最后一个 Strand 副本和所有排队中的执行任务都结束后，尚未执行的任务随内部状态一起被丢弃。
+ */
+
+#ifndef LSX_LIB_THREAD_STRAND_H
+#define LSX_LIB_THREAD_STRAND_H
+#pragma once
+
+#include <cstddef> // 包含 size_t
+#include <functional> // 包含 std::function, std::bind
+#include <future> // 包含 std::future, std::packaged_task
+#include <memory> // 包含 std::shared_ptr
+#include <type_traits> // 包含 std::invoke_result_t
+#include <utility> // 包含 std::forward
+
+#include "IThreadPool.h" // 包含 IThreadPool 接口定义
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB
+{
+    /**
+     * @brief 线程相关的命名空间。
+     * 包含线程管理和线程间通信相关的类和工具。
+     */
+    namespace Thread
+    {
+        /**
+         * @brief 基于线程池的串行执行器。
+         * 投递到同一个 Strand 的任务按顺序逐个执行，可以运行在线程池的任意工作线程上。
+         */
+        class Strand
+        {
+        public:
+            /**
+             * @brief 构造函数。
+             *
+             * @param pool 执行任务的线程池，必须比 Strand 及其排队中的任务活得更久。
+             * @param maxBatch 每次被调度时最多连续执行的任务数，为 0 时按 1 处理。
+             */
+            explicit Strand(IThreadPool& pool, size_t maxBatch = 64);
+
+            /**
+             * @brief 投递一个任务。可由任意线程调用，立即返回。
+             *
+             * @param task 要执行的任务。
+             */
+            void post(std::function<void()> task);
+
+            /**
+             * @brief 当前线程已经在此 Strand 中执行时直接调用任务，否则等同于 post。
+             *
+             * @param task 要执行的任务。
+             */
+            void dispatch(std::function<void()> task);
+
+            /**
+             * @brief 投递任意可调用对象作为任务，并返回对应的 future 对象。
+             *
+             * @tparam F 任务函数类型。
+             * @tparam Args 任务函数参数类型。
+             * @param f 要执行的任务函数。
+             * @param args 任务函数的参数。
+             * @return 用于获取任务执行结果（或异常）的 future 对象。
+             */
+            template <class F, class... Args>
+            auto submit(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>>
+            {
+                using return_type = std::invoke_result_t<F, Args...>;
+                auto task = std::make_shared<std::packaged_task<return_type()>>(
+                    std::bind(std::forward<F>(f), std::forward<Args>(args)...)
+                );
+                std::future<return_type> res = task->get_future();
+                post([task]() { (*task)(); });
+                return res;
+            }
+
+            /**
+             * @brief 检查当前线程是否正在执行此 Strand 的任务。
+             */
+            bool runningInThisThread() const;
+
+            /**
+             * @brief 获取尚未执行的任务数（近似值）。
+             */
+            size_t pending() const;
+
+        private:
+            struct Impl;
+            std::shared_ptr<Impl> impl_; // Shared with drain tasks queued on the pool
+        };
+    } // namespace Thread
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_THREAD_STRAND_H
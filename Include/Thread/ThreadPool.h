@@ -11,6 +11,13 @@
  * - void enqueue(std::function<void()> task) override: 实现 IThreadPool 接口，将无返回值无参数的任务添加到任务队列中
  * - template<class F, class... Args>
  * auto enqueue(F&& f, Args&&... args) -> std::future<typename std::result_of<F(Args...)>::type>: 将任意可调用对象作为任务添加到任务队列中，并返回对应的 std::future 对象
+ * - void enqueue_on(size_t worker_id, std::function<void()> task): 将任务放入指定工作线程的本地队列，空闲的其他工作线程可以窃取
+ * - template<class Key> void enqueue_affine(const Key& key, std::function<void()> task): 按 key 的哈希值把任务路由到固定的工作线程
+ * - long current_worker_index() const: 返回当前线程在本线程池中的工作线程编号，不是本线程池的工作线程时返回 -1
+ * - size_t worker_count() const: 返回工作线程数量
+ * - std::vector<double> worker_cpu_time_ms(): 返回每个工作线程已消耗的 CPU 时间（毫秒），用于监控线程池占用的核心
+ * - void attach_watchdog(Watchdog& watchdog, const std::string& name = "pool"): 为每个工作线程创建 Watchdog 探针，监控卡死的任务
+ * - void enqueue_named(const std::string& name, std::function<void()> task): 提交带名称的任务，名称出现在 Watchdog 报告中
  * - void shutdown() override: 实现 IThreadPool 接口，关闭线程池，并等待所有工作线程退出
  * - ~ThreadPool(): 析构函数，调用 shutdown() 方法
  *
@@ -60,6 +67,12 @@
  * return msg.length();
  * }, "Hello Lambda!");
  *
+ * // 同一连接的任务路由到同一工作线程，复用该核心缓存中的连接缓冲区
+ * int connection_id = 42;
+ * pool.enqueue_affine(connection_id, [&pool]() {
+ * std::cout << "Affine task on worker " << pool.current_worker_index() << std::endl;
+ * });
+ *
  * // 获取 future 结果
  * std::cout << "Result of complexTask: " << future1.get() << std::endl;
  * std::cout << "Result of Lambda Task: " << future2.get() << std::endl;
@@ -90,11 +103,17 @@
 #include <vector>
 #include <atomic>
 #include <future>
+#include <deque>
+#include <memory>
 #include <utility> // For std::forward, std::move
 #include <type_traits> // For std::result_of (C++11/14), std::invoke_result (C++17+)
 
 // 包含 IThreadPool 接口定义
 #include "IThreadPool.h"
+// 包含 Watchdog 探针定义
+#include "Watchdog.h"
+// 包含线程 CPU 时间读取函数
+#include "CpuClock.h"
 
 /**
  * @brief LSX 库的根命名空间。
@@ -111,6 +130,10 @@ namespace LSX_LIB
          * @brief 线程池类，管理多个工作线程并执行任务队列中的任务。
          * 该类继承自 IThreadPool 接口，提供了标准的线程池接口，
          * 并额外支持提交带返回值和参数的任务。
+         *
+         * 除共享任务队列外，每个工作线程还有一个本地队列（enqueue_on / enqueue_affine）。
+         * 工作线程优先执行本地队列中的任务，其次是共享队列；两者都为空时从其他工作线程的本地队列窃取任务，
+         * 因此本地队列中的任务不会在有空闲线程时长时间等待。
          */
         class ThreadPool : public Thread::IThreadPool // 继承 IThreadPool 接口
         {
@@ -127,35 +150,16 @@ namespace LSX_LIB
                 // 确保线程数量至少为 1
                 if (numThreads == 0) numThreads = 1;
 
-                // 创建工作线程
+                // 创建每个工作线程的本地状态
                 for (size_t i = 0; i < numThreads; ++i)
                 {
-                    workers.emplace_back([this]
-                    {
-                        // 每个工作线程的主循环
-                        while (true)
-                        {
-                            std::function<void()> task;
-                            {
-                                // 锁定任务队列，等待任务或停止信号
-                                std::unique_lock<std::mutex> lock(queue_mutex);
-
-                                // 等待条件：线程池停止或任务队列不为空
-                                condition.wait(lock, [this] { return stop || !tasks.empty(); });
-
-                                // 如果线程池停止且任务队列为空，则线程退出
-                                if (stop && tasks.empty())
-                                    return;
-
-                                // 从任务队列中取出任务
-                                task = std::move(tasks.front());
-                                tasks.pop();
-                            }
+                    local_workers.emplace_back(new WorkerSlot());
+                }
 
-                            // 执行任务
-                            task();
-                        }
-                    });
+                // 创建工作线程
+                for (size_t i = 0; i < numThreads; ++i)
+                {
+                    workers.emplace_back([this, i] { workerLoop(i); });
                 }
             }
 
@@ -182,9 +186,130 @@ namespace LSX_LIB
 
                     // 将任务添加到队列
                     tasks.emplace(std::move(task));
+                    // 通知一个空闲的工作线程有新任务
+                    notifyIdleWorker(local_workers.size());
+                }
+            }
+
+            /**
+             * @brief 向指定工作线程的本地队列添加一个任务。
+             *
+             * 该工作线程会优先执行本地队列中的任务；当它忙碌而其他工作线程空闲时，空闲线程会窃取该任务，
+             * 因此只是位置提示，并不保证任务一定在该线程上执行，也不保证同一队列中任务的执行顺序。
+             *
+             * @param worker_id 工作线程编号（0 ~ worker_count()-1），超出范围时按 worker_count() 取模。
+             * @param task 要执行的无返回值无参数任务。
+             */
+            void enqueue_on(size_t worker_id, std::function<void()> task)
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                if (stop)
+                {
+                    std::cerr << "ThreadPool is stopped, cannot enqueue task." << std::endl;
+                    return;
+                }
+                const size_t index = worker_id % local_workers.size();
+                WorkerSlot& slot = *local_workers[index];
+                slot.tasks.emplace_back(std::move(task));
+                if (slot.idle)
+                {
+                    slot.idle = false; // 与 notifyIdleWorker 一致：紧接着的 enqueue 应唤醒另一个空闲线程
+                    slot.cv.notify_one();
+                }
+                else
+                {
+                    // 目标线程忙碌：唤醒一个空闲线程来窃取，避免任务在有空闲线程时等待
+                    notifyIdleWorker(index);
+                }
+            }
+
+            /**
+             * @brief 按 key 把任务路由到固定的工作线程（key 的哈希值对工作线程数取模）。
+             *
+             * 同一个 key（如连接编号）的任务通常在同一个工作线程上执行，可以复用该核心缓存中的数据。
+             * 路由规则与 enqueue_on 相同，忙碌时仍可能被空闲线程窃取。
+             *
+             * @tparam Key 可被 std::hash 哈希的键类型。
+             * @param key 亲和键。
+             * @param task 要执行的无返回值无参数任务。
+             */
+            template <class Key>
+            void enqueue_affine(const Key& key, std::function<void()> task)
+            {
+                enqueue_on(std::hash<Key>()(key), std::move(task));
+            }
+
+            /**
+             * @brief 获取当前线程在本线程池中的工作线程编号。
+             *
+             * @return 工作线程编号（0 ~ worker_count()-1）；当前线程不是本线程池的工作线程时返回 -1。
+             */
+            long current_worker_index() const
+            {
+                const CurrentWorker& current = currentWorker();
+                return current.pool == this ? static_cast<long>(current.index) : -1;
+            }
+
+            /**
+             * @brief 获取工作线程数量。
+             */
+            size_t worker_count() const
+            {
+                return local_workers.size();
+            }
+
+            /**
+             * @brief 获取每个工作线程已消耗的 CPU 时间。
+             *
+             * 通过线程的 CPU 时钟从外部读取，工作线程执行任务时没有额外开销。
+             * 两次调用结果之差除以间隔即为该线程在这段时间内占用的核心比例。
+             * 不要与 shutdown() 并发调用。
+             *
+             * @return 下标为工作线程编号的 CPU 时间（毫秒）；线程已退出或平台不支持时为 -1。
+             */
+            std::vector<double> worker_cpu_time_ms()
+            {
+                std::vector<double> times;
+                times.reserve(workers.size());
+                for (std::thread& worker : workers)
+                {
+                    const int64_t ns = CpuClock::threadNs(worker);
+                    times.push_back(ns < 0 ? -1.0 : static_cast<double>(ns) / 1e6);
+                }
+                return times;
+            }
+
+            /**
+             * @brief 让 Watchdog 监控本线程池的工作线程。
+             *
+             * 为每个工作线程创建一个探针（线程名为 "name-编号"），之后开始执行的任务超过 Watchdog 阈值时会被报告。
+             * 重复调用时替换为新 Watchdog 的探针。
+             *
+             * @param watchdog 监控器。Watchdog 可以先于线程池销毁，之后不再监控。
+             * @param name 线程名前缀，出现在报告中。
+             */
+            void attach_watchdog(Watchdog& watchdog, const std::string& name = "pool")
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                for (size_t i = 0; i < local_workers.size(); ++i)
+                {
+                    local_workers[i]->probe = watchdog.createProbe(name + "-" + std::to_string(i));
                 }
-                // 通知一个等待中的工作线程有新任务
-                condition.notify_one();
+            }
+
+            /**
+             * @brief 提交一个带名称的任务。名称在任务执行期间出现在 Watchdog 的报告和 activeTasks() 中。
+             *
+             * @param name 任务名称。
+             * @param task 要执行的无返回值无参数任务。
+             */
+            void enqueue_named(const std::string& name, std::function<void()> task)
+            {
+                enqueue(std::function<void()>([name, task = std::move(task)]()
+                {
+                    Watchdog::setCurrentTaskName(name);
+                    task();
+                }));
             }
 
 
@@ -241,9 +366,9 @@ namespace LSX_LIB
 
                     // 将 packaged_task 的执行包装成 std::function<void()> 并添加到任务队列
                     tasks.emplace([task]() { (*task)(); });
+                    // 通知一个空闲的工作线程有新任务
+                    notifyIdleWorker(local_workers.size());
                 }
-                // 通知一个等待中的工作线程有新任务
-                condition.notify_one();
                 // 返回 future 对象
                 return res;
             }
@@ -260,9 +385,12 @@ namespace LSX_LIB
                     // 锁定任务队列，设置停止标志
                     std::lock_guard<std::mutex> lock(queue_mutex);
                     stop = true;
+                    // 通知所有等待中的工作线程
+                    for (auto& slot : local_workers)
+                    {
+                        slot->cv.notify_all();
+                    }
                 }
-                // 通知所有等待中的工作线程
-                condition.notify_all();
                 // 等待所有工作线程退出
                 for (std::thread& worker : workers)
                     if (worker.joinable()) // 检查线程是否可 join
@@ -280,10 +408,121 @@ namespace LSX_LIB
             }
 
         private:
+            /**
+             * @brief 单个工作线程的本地状态，受 queue_mutex 保护。
+             */
+            struct WorkerSlot
+            {
+                std::deque<std::function<void()>> tasks; /**< 本地任务队列。本线程从队头取，窃取者从队尾取。 */
+                std::condition_variable cv; /**< 本线程空闲时在此等待。 */
+                bool idle = false; /**< 本线程是否正在等待任务。 */
+                std::shared_ptr<Watchdog::Probe> probe; /**< Watchdog 探针，未启用监控时为空。 */
+            };
+
+            /**
+             * @brief 当前线程所属的线程池及工作线程编号。
+             */
+            struct CurrentWorker
+            {
+                const ThreadPool* pool = nullptr;
+                size_t index = 0;
+            };
+
+            static CurrentWorker& currentWorker()
+            {
+                static thread_local CurrentWorker current;
+                return current;
+            }
+
+            /**
+             * @brief 唤醒一个空闲的工作线程（调用者须持有 queue_mutex）。
+             *
+             * @param skip 不唤醒的工作线程编号，传入 local_workers.size() 表示不跳过。
+             */
+            void notifyIdleWorker(size_t skip)
+            {
+                for (size_t i = 0; i < local_workers.size(); ++i)
+                {
+                    if (i != skip && local_workers[i]->idle)
+                    {
+                        local_workers[i]->idle = false; // 避免连续提交时重复唤醒同一线程
+                        local_workers[i]->cv.notify_one();
+                        return;
+                    }
+                }
+            }
+
+            /**
+             * @brief 取出一个任务（调用者须持有 queue_mutex）：本地队列 → 共享队列 → 窃取其他线程的本地队列。
+             */
+            bool takeTask(size_t index, std::function<void()>& task)
+            {
+                WorkerSlot& own = *local_workers[index];
+                if (!own.tasks.empty())
+                {
+                    task = std::move(own.tasks.front());
+                    own.tasks.pop_front();
+                    return true;
+                }
+                if (!tasks.empty())
+                {
+                    task = std::move(tasks.front());
+                    tasks.pop();
+                    return true;
+                }
+                for (size_t n = 1; n < local_workers.size(); ++n)
+                {
+                    WorkerSlot& victim = *local_workers[(index + n) % local_workers.size()];
+                    if (!victim.tasks.empty())
+                    {
+                        task = std::move(victim.tasks.back());
+                        victim.tasks.pop_back();
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /**
+             * @brief 工作线程的主循环。
+             */
+            void workerLoop(size_t index)
+            {
+                currentWorker().pool = this;
+                currentWorker().index = index;
+                WorkerSlot& own = *local_workers[index];
+                while (true)
+                {
+                    std::function<void()> task;
+                    std::shared_ptr<Watchdog::Probe> probe;
+                    {
+                        // 锁定任务队列，等待任务或停止信号
+                        std::unique_lock<std::mutex> lock(queue_mutex);
+                        while (!takeTask(index, task))
+                        {
+                            // 如果线程池停止且所有队列为空，则线程退出
+                            if (stop)
+                            {
+                                own.idle = false;
+                                return;
+                            }
+                            own.idle = true;
+                            own.cv.wait(lock);
+                        }
+                        own.idle = false;
+                        probe = own.probe;
+                    }
+
+                    // 执行任务
+                    Watchdog::Scope scope(probe.get());
+                    task();
+                }
+            }
+
             std::vector<std::thread> workers; /**< 工作线程数组。存储线程池中的工作线程对象。 */
             std::queue<std::function<void()>> tasks; /**< 任务队列。存储待执行的任务，每个任务是一个 `std::function<void()>`。 */
-            std::mutex queue_mutex; /**< 互斥锁，保护任务队列的并发访问。 */
-            std::condition_variable condition; /**< 条件变量，用于工作线程在任务队列为空时等待，以及在有新任务或线程池停止时被唤醒。 */
+            std::vector<std::unique_ptr<WorkerSlot>> local_workers; /**< 每个工作线程的本地队列与等待条件，下标即工作线程编号。 */
+            std::mutex queue_mutex; /**< 互斥锁，保护共享任务队列和所有本地队列的并发访问。 */
             std::atomic<bool> stop; /**< 原子布尔标志，指示线程池是否已请求停止。 */
         };
     }
@@ -19,6 +19,8 @@
  * - **状态跟踪**: 使用 `ThreadState` 枚举和原子变量跟踪线程状态。
  * - **优雅停止**: 通过原子标志和条件变量实现可控的停止机制。
  * - **暂停/恢复**: 利用条件变量实现线程的暂停和恢复功能。
+ * - **循环模式**: `setLoopTask` 绑定的任务在同一个 OS 线程中按迭代反复调用，每次迭代之间检查暂停/停止；
+ *   可选地在迭代之间等待定时器 (`setLoopInterval`) 或队列/描述符可读 (`setLoopWaitHandle` / `setLoopWaitContainer`)，等待期间的暂停/停止请求立即生效，无需轮询。
  * - **资源管理**: 使用 RAII 模式和禁止拷贝确保线程资源的正确管理。
  * - **线程安全**: 使用互斥锁和原子变量保证内部状态和操作的线程安全。
  * - **扩展接口**: 包含未来集成线程池和线程间通信的占位接口。
@@ -100,13 +102,35 @@
  * }
  * @endcode
  *
+ * 循环模式示例：
+ *
+ * @code
+ * LSX_LIB::Memory::FixedSizeQueue rx_queue(256, 1024);
+ * LSX_LIB::Thread::ThreadWrapper consumer;
+ *
+ * consumer.setLoopTask([&rx_queue] {
+ * uint8_t block[256];
+ * while (rx_queue.Get(block, sizeof(block))) {
+ * // 处理数据块；每次迭代应取空队列
+ * }
+ * });
+ * consumer.setLoopWaitContainer(rx_queue); // 队列非空时才执行下一次迭代
+ * consumer.setLoopInterval(1000); // 队列一直为空时也至少每秒执行一次
+ * consumer.start();
+ *
+ * consumer.pause(); // 当前迭代结束后暂停，等待中的线程立即进入暂停
+ * consumer.resume();
+ * consumer.stop(); // 立即从等待中唤醒并退出
+ * @endcode
+ *
  * ### 注意事项
- * - **任务实现**: 绑定的任务函数内部需要包含一个循环，并在循环中检查 `stopFlag_` 来响应停止请求，以及检查 `pauseFlag_` 和使用条件变量 `cv_` 来实现暂停/恢复。直接执行一次就结束的任务不需要这些控制逻辑。
+ * - **循环模式与一次性模式**: `setTask` 绑定的任务只执行一次，`setLoopTask` 绑定的任务按迭代反复执行，后绑定的一个生效；循环模式下任务函数不需要自己检查停止/暂停标志，但单次迭代不应长时间阻塞。
+ * - **任务实现**: 一次性模式下，需要长期运行的任务函数内部需要包含一个循环，并在循环中检查 `stopFlag_` 来响应停止请求，以及检查 `pauseFlag_` 和使用条件变量 `cv_` 来实现暂停/恢复。直接执行一次就结束的任务不需要这些控制逻辑。
  * - **线程安全**: `ThreadWrapper` 类内部通过互斥锁和原子变量保证了自身的线程安全。但是，如果绑定的任务函数访问共享资源，任务函数本身需要自行处理同步问题。
  * - **拷贝/移动**: 线程对象是不可拷贝的，因为线程句柄是唯一的资源。支持移动语义，允许转移线程的所有权。
  * - **分离线程**: 如果使用 `start(true)` 启动分离线程，主程序退出时不会等待该线程。分离线程的资源由系统管理。通常推荐使用可 join 的线程，并在需要时调用 `stop` 或 `join`。
  * - **占位接口**: `threadPool_` 和 `communicator_` 成员变量以及相关的 `set` 方法是占位符，当前 `ThreadWrapper` 的核心功能不依赖于它们。
- * - **异常处理**: 任务函数内部抛出的未捕获异常会导致程序终止。建议在任务函数内部捕获并处理异常。
+ * - **异常处理**: 任务函数抛出的异常会被捕获并输出到 std::cerr，之后线程停止（循环模式下不再执行后续迭代）。
  */
 
 //
@@ -127,7 +151,11 @@
 #include <atomic> // 包含 std::atomic
 #include <functional> // 包含 std::function, std::bind
 #include <memory> // 包含 std::shared_ptr
+#include <chrono> // 包含 std::chrono::steady_clock
+#include <cstdint> // 包含 uint64_t
+#include <type_traits> // 包含 std::is_same
 #include "ThreadState.h" // 包含 ThreadState 枚举定义
+#include "ReadyNotifier.h" // 包含 Memory::ReadyNotifier，用于唤醒循环模式中的等待
 #include "IThreadPool.h" // 包含 IThreadPool 接口定义 (占位)
 #include "ICommunicator.h" // 包含 ICommunicator 接口定义 (占位)
 
@@ -199,10 +227,79 @@ namespace LSX_LIB
                 std::lock_guard<std::mutex> lk(mtx_); // 保护 task_ 和 state_ 的访问
                 // 使用 std::bind 绑定函数和参数，std::forward 保持参数的左右值属性
                 task_ = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+                loopTask_ = nullptr;
                 // 设置状态为 INIT，表示任务已设置但线程未启动
                 state_.store(ThreadState::INIT);
             }
 
+            /**
+             * @brief 绑定循环模式的任务：线程启动后在同一个 OS 线程中反复调用该任务，直到 stop()。
+             * 每次迭代之前检查暂停/停止请求，并按 setLoopInterval / setLoopWaitHandle 的设置等待。
+             * 只能在线程未运行时调用。
+             *
+             * @tparam F 可调用对象类型，返回 void 或 bool；返回 false 时结束循环，线程退出。
+             * @tparam Args 可调用对象的参数类型。
+             * @param f 每次迭代执行的可调用对象。
+             * @param args 可调用对象的参数。
+             */
+            template <typename F, typename... Args>
+            void setLoopTask(F&& f, Args&&... args)
+            {
+                auto bound = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+                std::lock_guard<std::mutex> lk(mtx_);
+                if constexpr (std::is_same<decltype(bound()), void>::value)
+                {
+                    loopTask_ = [bound]() mutable { bound(); return true; };
+                }
+                else
+                {
+                    loopTask_ = [bound]() mutable { return static_cast<bool>(bound()); };
+                }
+                task_ = nullptr;
+                state_.store(ThreadState::INIT);
+            }
+
+            /**
+             * @brief 设置循环模式下迭代的周期（固定频率）。
+             * 两次迭代开始时间的间隔为 intervalMs；迭代耗时超过周期时下一次立即开始，不会补跑错过的迭代。
+             * 与 setLoopWaitHandle 同时使用时，描述符可读或周期到期都会触发一次迭代。
+             *
+             * @param intervalMs 周期（毫秒），<= 0 表示不按时间等待（默认）。
+             */
+            void setLoopInterval(long intervalMs);
+
+            /**
+             * @brief 设置循环模式下每次迭代之前等待可读的描述符。
+             * 描述符可读时执行一次迭代；迭代中应把数据读完，否则下一次等待会立即返回。
+             *
+             * @param fd 要等待的描述符，-1 表示不等待（默认）。描述符由调用者管理，线程运行期间必须保持有效。
+             */
+            void setLoopWaitHandle(int fd);
+
+            /**
+             * @brief 设置循环模式下每次迭代之前等待容器非空 (模板)。
+             * 适用于提供 `EnableNotification()` 和 `NativeHandle()` 的容器（FixedSizeQueue、Pipe、Queue、CircularQueue 等）。
+             *
+             * @tparam Container 容器类型。
+             * @param container 要等待的容器，线程运行期间必须保持有效。
+             * @return 成功返回 true；平台不支持就绪通知时返回 false（此时不等待容器）。
+             */
+            template <typename Container>
+            bool setLoopWaitContainer(Container& container)
+            {
+                if (!container.EnableNotification())
+                {
+                    return false;
+                }
+                setLoopWaitHandle(container.NativeHandle());
+                return true;
+            }
+
+            /**
+             * @brief 获取循环模式下已完成的迭代次数（重新启动后清零）。
+             */
+            uint64_t getIterations() const { return iterations_.load(); }
+
             /**
              * @brief 启动线程并执行绑定的任务。
              * 创建并启动内部的 std::thread 对象，该线程将执行 threadFunc 方法。
@@ -233,7 +330,8 @@ namespace LSX_LIB
 
             /**
              * @brief 停止当前线程（如果正在运行）并重新启动。
-             * 调用 stop() 停止并等待当前线程，然后调用 start() 启动一个新的线程执行绑定的任务。
+             * 调用 stop() 停止并等待当前线程，然后调用 start() 启动一个新的线程执行原来绑定的任务。
+             * 需要反复执行的工作应使用循环模式和 pause()/resume()，避免重复创建 OS 线程。
              *
              * @param detached 如果为 true，新线程将分离；否则默认可 join。
              */
@@ -276,6 +374,23 @@ namespace LSX_LIB
              */
             void threadFunc();
 
+            /**
+             * @brief 循环模式的主循环。
+             */
+            void runLoop();
+
+            /**
+             * @brief 循环模式下等待下一次迭代。
+             *
+             * @return 应执行一次迭代返回 true；等待被暂停/停止请求打断返回 false。
+             */
+            bool waitForIteration();
+
+            /**
+             * @brief 唤醒循环模式中正在等待的线程（暂停/停止请求时调用）。
+             */
+            void wakeLoop();
+
             /**
              * @brief 工作线程对象。
              * 封装了底层的 std::thread。
@@ -288,6 +403,36 @@ namespace LSX_LIB
              */
             std::function<void()> task_;
 
+            /**
+             * @brief 存储通过 setLoopTask 绑定的循环任务，非空表示循环模式；返回 false 时结束循环。
+             */
+            std::function<bool()> loopTask_;
+
+            /**
+             * @brief 循环模式下的迭代周期（毫秒），<= 0 表示不按时间等待。
+             */
+            long loopIntervalMs_ = 0;
+
+            /**
+             * @brief 循环模式下迭代前等待可读的描述符，-1 表示不等待。
+             */
+            int loopWaitFd_ = -1;
+
+            /**
+             * @brief 循环模式下一次按周期触发的迭代时间（仅线程内部使用）。
+             */
+            std::chrono::steady_clock::time_point nextRun_;
+
+            /**
+             * @brief 循环模式下已完成的迭代次数。
+             */
+            std::atomic<uint64_t> iterations_{0};
+
+            /**
+             * @brief 唤醒通知器。等待描述符时与其一起 poll，暂停/停止请求时置位。受 mtx_ 保护。
+             */
+            Memory::ReadyNotifier wakeNotifier_;
+
             /**
              * @brief 互斥锁。
              * 用于保护 task_ 的访问以及与条件变量 cv_ 配合使用。
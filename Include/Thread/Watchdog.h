@@ -0,0 +1,339 @@
+/**
+ * @file Watchdog.h
+ * @brief 任务卡死与周期任务超时监控
+ * @details 定义了 LSX_LIB::Thread 命名空间下的 WatchdogOptions、StallReport、ActiveTask 结构体和 Watchdog 类。
+ * 线程池中的任务一旦阻塞（如卡在 `TcpClient::send` 或等待 SQLite 锁），线程池吞吐量会无声无息地下降。
+ * Watchdog 为每个被监控的线程分配一个探针 (Probe)：线程开始执行任务时在探针中记录开始时间，结束时清除。
+ * 后台监控线程按 `checkIntervalMs` 周期扫描所有探针，执行时间超过 `stallThresholdMs` 的任务
+ * 连同其注册的名称（以及启用 captureStack 时所在线程的调用栈）一起报告；Scheduler 的周期任务单次执行时间超过周期时报告超时。
+ * @author 连思鑫（liansixin）
+ * @date 2025-5-7
+ * @version 1.0
+ *
+ * ### 核心功能
+ * - **低开销探针**: `Probe::begin/end` 只做两次原子写入，不加锁、不分配内存，可用于每个线程池任务。
+ * - **卡死检测**: 同一次任务执行最多报告一次，报告中包含线程名、任务名、已执行时间和调用栈。
+ * - **调用栈捕获**: 设置 `captureStack = true` 后，在 Linux/glibc 上向卡住的线程发送信号，在该线程的信号处理函数中用 backtrace() 采集调用栈。
+ * - **周期任务超时**: Scheduler 的周期任务单次执行超过其周期时报告 `PeriodOverrun`。
+ * - **监控接口**: `activeTasks()` / `dump()` 给出所有正在执行的任务及其已执行时间；报告默认输出到 std::cerr，也可以自定义处理函数。
+ * - **集成**: `ThreadPool::attach_watchdog` / `ThreadPool::enqueue_named`、`Scheduler::setWatchdog`。
+ *
+ * ### 使用示例
+ *
+ * @code
+ * #include "Watchdog.h"
+ * #include "ThreadPool.h"
+ * #include "Scheduler.h"
+ * #include <iostream>
+ *
+ * using namespace LSX_LIB::Thread;
+ *
+ * int main() {
+ * WatchdogOptions options;
+ * options.stallThresholdMs = 2000; // 执行超过 2 秒的任务视为卡死
+ * options.captureStack = true;     // 采集调用栈，注意信号会打断阻塞调用
+ *
+ * Watchdog watchdog(options, [](const StallReport& report) {
+ * std::cerr << report.toString() << std::endl; // 也可以写日志或上报
+ * });
+ *
+ * ThreadPool pool(4);
+ * pool.attach_watchdog(watchdog, "io-pool");
+ * pool.enqueue_named("upload-records", [] {
+ * // 如果这里卡在网络发送上超过 2 秒，会报告任务名 upload-records 及调用栈
+ * });
+ *
+ * Scheduler scheduler;
+ * scheduler.setWatchdog(&watchdog);
+ * scheduler.schedulePeriodic(1000, [] {
+ * // 单次执行超过 1 秒会报告周期超时
+ * }, "sync-clock");
+ *
+ * watchdog.dump(std::cout); // 当前正在执行的任务
+ * return 0;
+ * }
+ * @endcode
+ *
+ * ### 注意事项
+ * - **信号**: 调用栈捕获使用实时信号 `SIGRTMIN + 3`（可通过 `stackSignal` 修改），应用程序不应再使用该信号；捕获到的调用栈在信号处理函数中采集，只包含函数地址和符号名（需要 `-rdynamic` 才能显示非导出函数名）。
+ * - **EINTR**: 采集调用栈的信号会打断被监控线程中 SA_RESTART 不会自动重启的阻塞调用：设置了 SO_RCVTIMEO/SO_SNDTIMEO 的
+ *   `recv`/`send`、`poll`、`epoll_wait`、`select` 等会返回 -1/EINTR。`TcpClient::receive` 等不重试 EINTR 的代码会因此提前失败，
+ *   所以 captureStack 默认关闭；只在被监控的任务能处理 EINTR 或排查问题时开启。
+ * - **平台**: 调用栈捕获仅在 Linux/glibc 上可用，其他平台的报告中不含调用栈。
+ * - **探针归属**: 探针在第一次 `begin()` 时绑定到调用线程，之后只能由该线程使用；每个被监控的线程各创建一个探针。
+ * - **生命周期**: 探针由 shared_ptr 管理，Watchdog 销毁后探针仍可安全使用（不再被监控）。
+ * - **报告处理函数**: 卡死报告在监控线程中调用，周期超时报告在周期任务所在线程中调用，处理函数不应长时间阻塞。
+ * - **拷贝/移动**: 类禁用了拷贝构造和赋值。
+ */
+
+#ifndef LSX_LIB_THREAD_WATCHDOG_H
+#define LSX_LIB_THREAD_WATCHDOG_H
+#pragma once
+
+#include <atomic> // 包含 std::atomic
+#include <chrono> // 包含 std::chrono::steady_clock
+#include <cstdint> // 包含 int64_t, uint64_t
+#include <functional> // 包含 std::function
+#include <memory> // 包含 std::shared_ptr, std::weak_ptr
+#include <mutex> // 包含 std::mutex
+#include <ostream> // 包含 std::ostream
+#include <string> // 包含 std::string
+#include <utility> // 包含 std::move
+#include <vector> // 包含 std::vector
+#include <pthread.h> // 包含 pthread_t
+
+/**
+ * @brief LSX 库的根命名空间。
+ */
+namespace LSX_LIB
+{
+    /**
+     * @brief 线程相关的命名空间。
+     * 包含线程管理和线程间通信相关的类和工具。
+     */
+    namespace Thread
+    {
+        /**
+         * @brief Watchdog 的检测参数。
+         */
+        struct WatchdogOptions
+        {
+            long checkIntervalMs = 100; ///< 扫描探针的周期（毫秒）
+            long stallThresholdMs = 1000; ///< 任务执行时间超过该值视为卡死（毫秒）
+            bool captureStack = false; ///< 报告卡死时是否采集调用栈（默认关闭，信号会打断被监控线程的阻塞调用，见注意事项）
+            size_t maxStackFrames = 32; ///< 调用栈最大帧数（最多 64）
+            int stackSignal = 0; ///< 用于采集调用栈的信号，0 表示 SIGRTMIN + 3
+        };
+
+        /**
+         * @brief 卡死或超时报告。
+         */
+        struct StallReport
+        {
+            /**
+             * @brief 报告类型。
+             */
+            enum class Kind
+            {
+                StalledTask, ///< 任务执行时间超过 stallThresholdMs
+                PeriodOverrun ///< 周期任务单次执行时间超过其周期
+            };
+
+            Kind kind = Kind::StalledTask; ///< 报告类型
+            std::string threadName; ///< 探针注册的线程名
+            std::string taskName; ///< 任务名，未命名时为空
+            long threadId = 0; ///< 内核线程 ID，未知时为 0
+            long elapsedMs = 0; ///< 已执行时间（毫秒）
+            long limitMs = 0; ///< 触发报告的阈值：stallThresholdMs 或周期
+            std::vector<std::string> stack; ///< 调用栈，未采集时为空
+
+            /**
+             * @brief 格式化为多行文本。
+             */
+            std::string toString() const;
+        };
+
+        /**
+         * @brief 正在执行的任务信息。
+         */
+        struct ActiveTask
+        {
+            std::string threadName; ///< 探针注册的线程名
+            std::string taskName; ///< 任务名，未命名时为空
+            long threadId = 0; ///< 内核线程 ID
+            long elapsedMs = 0; ///< 已执行时间（毫秒）
+        };
+
+        /**
+         * @brief 任务卡死监控器。
+         */
+        class Watchdog
+        {
+            struct Impl;
+
+        public:
+            /**
+             * @brief 报告处理函数类型。
+             */
+            using ReportHandler = std::function<void(const StallReport&)>;
+
+            /**
+             * @brief 线程探针。被监控的线程在执行每个任务前后调用 begin()/end()。
+             */
+            class Probe
+            {
+            public:
+                /**
+                 * @brief 标记当前线程开始执行一个任务。
+                 */
+                void begin()
+                {
+                    if (threadId_ == 0)
+                    {
+                        // 第一次调用时绑定线程，监控线程只在看到 startNs_ 非 0 后读取这两个字段
+                        thread_ = pthread_self();
+                        threadId_ = currentThreadId();
+                    }
+                    sequence_.fetch_add(1, std::memory_order_relaxed);
+                    startNs_.store(nowNs(), std::memory_order_release);
+                    current() = this;
+                }
+
+                /**
+                 * @brief 标记当前任务执行结束，并清除任务名。
+                 */
+                void end()
+                {
+                    startNs_.store(0, std::memory_order_release);
+                    current() = nullptr;
+                    if (hasTaskName_.load(std::memory_order_relaxed))
+                    {
+                        std::lock_guard<std::mutex> lk(nameMutex_);
+                        taskName_.clear();
+                        hasTaskName_.store(false, std::memory_order_relaxed);
+                    }
+                }
+
+                /**
+                 * @brief 设置当前任务的名称，end() 时清除。
+                 */
+                void setTaskName(const std::string& name);
+
+                /**
+                 * @brief 报告一次周期任务超时（由 Scheduler 调用）。Watchdog 已销毁时忽略。
+                 *
+                 * @param periodMs 任务周期（毫秒）。
+                 * @param elapsedMs 本次执行时间（毫秒）。
+                 */
+                void reportOverrun(long periodMs, long elapsedMs);
+
+                /**
+                 * @brief 获取探针注册的线程名。
+                 */
+                const std::string& threadName() const { return threadName_; }
+
+                /**
+                 * @brief 构造函数，由 Watchdog::createProbe 调用。
+                 */
+                Probe(std::weak_ptr<Impl> owner, std::string threadName)
+                    : owner_(std::move(owner)), threadName_(std::move(threadName))
+                {
+                }
+
+                // Prevent copying and assignment
+                Probe(const Probe&) = delete;
+                Probe& operator=(const Probe&) = delete;
+
+                /**
+                 * @brief 当前线程正在使用的探针（begin 与 end 之间），没有时为 nullptr。
+                 */
+                static Probe*& current()
+                {
+                    thread_local Probe* probe = nullptr;
+                    return probe;
+                }
+
+            private:
+                friend class Watchdog;
+                friend struct Watchdog::Impl;
+
+                static int64_t nowNs()
+                {
+                    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count();
+                }
+
+                static long currentThreadId();
+
+                std::weak_ptr<Impl> owner_; // Watchdog that monitors this probe
+                std::string threadName_; // Name given at registration
+                std::atomic<int64_t> startNs_{0}; // Start of the current task, 0 when idle
+                std::atomic<uint64_t> sequence_{0}; // Incremented per task; a stall is reported once per task
+                uint64_t reportedSequence_ = 0; // Last reported task (monitor thread only)
+                pthread_t thread_{}; // Thread bound by the first begin()
+                long threadId_ = 0; // Kernel thread id of that thread, 0 until bound
+                std::atomic<bool> hasTaskName_{false}; // Avoids locking in end() for unnamed tasks
+                mutable std::mutex nameMutex_; // Protects taskName_
+                std::string taskName_; // Name of the current task
+            };
+
+            /**
+             * @brief RAII 辅助类：构造时 begin()，析构时 end()。探针为空时不做任何事。
+             */
+            class Scope
+            {
+            public:
+                explicit Scope(Probe* probe) : probe_(probe)
+                {
+                    if (probe_) probe_->begin();
+                }
+
+                ~Scope()
+                {
+                    if (probe_) probe_->end();
+                }
+
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+
+            private:
+                Probe* probe_;
+            };
+
+            /**
+             * @brief 构造函数。启动监控线程。
+             *
+             * @param options 检测参数。
+             * @param handler 报告处理函数，为空时输出到 std::cerr。
+             */
+            explicit Watchdog(const WatchdogOptions& options = WatchdogOptions(), ReportHandler handler = nullptr);
+
+            /**
+             * @brief 析构函数。调用 stop()。
+             */
+            ~Watchdog();
+
+            // Prevent copying and assignment
+            Watchdog(const Watchdog&) = delete;
+            Watchdog& operator=(const Watchdog&) = delete;
+
+            /**
+             * @brief 创建一个被监控的探针。可由任意线程调用。
+             *
+             * @param threadName 线程名，出现在报告中。
+             * @return 探针。所有持有者释放后自动停止监控。
+             */
+            std::shared_ptr<Probe> createProbe(const std::string& threadName);
+
+            /**
+             * @brief 设置当前线程正在执行的任务的名称。当前线程没有正在使用的探针时忽略。
+             */
+            static void setCurrentTaskName(const std::string& name);
+
+            /**
+             * @brief 停止监控线程。重复调用是安全的。
+             */
+            void stop();
+
+            /**
+             * @brief 获取所有正在执行任务的探针信息，按已执行时间降序排列。
+             */
+            std::vector<ActiveTask> activeTasks() const;
+
+            /**
+             * @brief 把 activeTasks() 格式化为表格输出。
+             */
+            void dump(std::ostream& os) const;
+
+            /**
+             * @brief 获取已发出的报告总数（卡死和周期超时）。
+             */
+            uint64_t reportCount() const;
+
+        private:
+            std::shared_ptr<Impl> impl_; // Shared with probes through weak_ptr
+        };
+    } // namespace Thread
+} // namespace LSX_LIB
+
+#endif // LSX_LIB_THREAD_WATCHDOG_H
@@ -0,0 +1,517 @@
+
+// ---------- File: RpcChannel.cpp ----------
+#include "RpcChannel.h"
+#include "GlobalErrorMutex.h" // 包含全局错误锁 (用于同步错误输出)
+#include "LockGuard.h" // 包含 LIBLSX::LockManager::LockGuard
+#include <iostream> // For std::cerr (错误输出)
+#include <algorithm> // 包含 std::min, std::max
+#ifndef _WIN32
+#include <poll.h> // For poll (等待 socket 可读)
+#include <unistd.h> // For read (直接从描述符读取)
+#include <errno.h> // For errno
+#endif
+
+namespace LSX_LIB::DataTransfer
+{
+    // 帧格式 (网络字节序):
+    // [0..3]  uint32 长度：本字段之后的字节数 (8 + 方法名长度 + 负载长度)
+    // [4]     uint8  帧类型
+    // [5]     uint8  保留，为 0
+    // [6..7]  uint16 方法名长度 (仅请求帧非 0)
+    // [8..11] uint32 请求 ID
+    // 之后依次为方法名和负载；错误帧的负载为 1 字节 RpcStatus 加错误描述
+    static const size_t kHeaderBytes = 12;
+    static const uint8_t kFrameRequest = 1;
+    static const uint8_t kFrameResponse = 2;
+    static const uint8_t kFrameError = 3;
+    static const int kPollIntervalMs = 50; // 读线程的最长等待时间，决定 stop 的响应速度
+    static const size_t kReadChunk = 16 * 1024;
+
+    static void PutU32(uint8_t* p, uint32_t v)
+    {
+        p[0] = static_cast<uint8_t>(v >> 24);
+        p[1] = static_cast<uint8_t>(v >> 16);
+        p[2] = static_cast<uint8_t>(v >> 8);
+        p[3] = static_cast<uint8_t>(v);
+    }
+
+    static uint32_t GetU32(const uint8_t* p)
+    {
+        return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+               (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+    }
+
+    RpcChannel::RpcChannel(std::unique_ptr<ICommunication> transport,
+                           Thread::IThreadPool* pool,
+                           size_t maxFrameBytes)
+        : transport_(std::move(transport)),
+          pool_(pool),
+          maxFrameBytes_(std::max(maxFrameBytes, kHeaderBytes))
+    {
+    }
+
+    RpcChannel::~RpcChannel()
+    {
+        stop(); // transport_ 析构时关闭连接
+    }
+
+    void RpcChannel::registerMethod(const std::string& method, Handler handler)
+    {
+        LSX_LIB::LockManager::LockGuard<std::mutex> lock(handlersMutex_);
+        handlers_[method] = std::make_shared<Handler>(std::move(handler));
+    }
+
+    bool RpcChannel::start()
+    {
+        if (!transport_ || running_.load() || !connected_.load())
+        {
+            return false;
+        }
+        if (reader_.joinable())
+        {
+            reader_.join(); // 上一次 stop 时从读线程内部调用而未能 join
+        }
+        handle_ = transport_->nativeHandle();
+        if (handle_ < 0)
+        {
+            // 没有可 poll 的描述符，退化为带超时的 receive 轮询
+            transport_->setReceiveTimeout(kPollIntervalMs);
+        }
+        running_.store(true);
+        reader_ = std::thread(&RpcChannel::readLoop, this);
+        return true;
+    }
+
+    void RpcChannel::stop()
+    {
+        running_.store(false);
+        if (reader_.joinable() && reader_.get_id() != std::this_thread::get_id())
+        {
+            reader_.join();
+        }
+        failAll("channel stopped");
+
+        // 处理函数会通过 transport_ 发送应答，必须等它们结束
+        std::unique_lock<std::mutex> lock(activeMutex_);
+        activeCv_.wait(lock, [this] { return activeHandlers_ == 0; });
+    }
+
+    bool RpcChannel::isRunning() const
+    {
+        return running_.load() && connected_.load();
+    }
+
+    size_t RpcChannel::inFlight() const
+    {
+        LSX_LIB::LockManager::LockGuard<std::mutex> lock(pendingMutex_);
+        return pending_.size();
+    }
+
+    void RpcChannel::call(const std::string& method, const std::vector<uint8_t>& payload, int timeoutMs,
+                          Callback callback)
+    {
+        Pending pending;
+        pending.callback = std::move(callback);
+        startCall(method, payload, timeoutMs, std::move(pending));
+    }
+
+    std::future<RpcResult> RpcChannel::call(const std::string& method, const std::vector<uint8_t>& payload,
+                                            int timeoutMs)
+    {
+        Pending pending;
+        pending.promise = std::make_shared<std::promise<RpcResult>>();
+        std::future<RpcResult> future = pending.promise->get_future();
+        startCall(method, payload, timeoutMs, std::move(pending));
+        return future;
+    }
+
+    void RpcChannel::startCall(const std::string& method, const std::vector<uint8_t>& payload, int timeoutMs,
+                               Pending pending)
+    {
+        if (method.size() > 0xFFFF)
+        {
+            complete(std::move(pending), RpcResult{RpcStatus::SendFailed, {}, "method name too long"});
+            return;
+        }
+
+        uint32_t id = 0;
+        {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(pendingMutex_);
+            // 在锁内检查状态：stop/断开先改状态再在锁内清空 pending_，这里登记的调用一定会被完成
+            if (!running_.load() || !connected_.load())
+            {
+                id = 0;
+            }
+            else
+            {
+                id = nextId_++;
+                if (nextId_ == 0)
+                {
+                    nextId_ = 1; // 0 保留不用
+                }
+                if (timeoutMs > 0)
+                {
+                    pending.hasDeadline = true;
+                    pending.deadline = deadlines_.emplace(Clock::now() + std::chrono::milliseconds(timeoutMs), id);
+                }
+                pending_.emplace(id, std::move(pending));
+            }
+        }
+        if (id == 0)
+        {
+            complete(std::move(pending), RpcResult{RpcStatus::Disconnected, {}, "channel not running"});
+            return;
+        }
+
+        if (!sendFrame(kFrameRequest, id, method, payload.data(), payload.size()))
+        {
+            Pending failed;
+            if (takePending(id, failed))
+            {
+                complete(std::move(failed), RpcResult{RpcStatus::SendFailed, {}, "send failed"});
+            }
+        }
+    }
+
+    bool RpcChannel::takePending(uint32_t id, Pending& pending)
+    {
+        LSX_LIB::LockManager::LockGuard<std::mutex> lock(pendingMutex_);
+        auto it = pending_.find(id);
+        if (it == pending_.end())
+        {
+            return false;
+        }
+        pending = std::move(it->second);
+        pending_.erase(it);
+        if (pending.hasDeadline)
+        {
+            deadlines_.erase(pending.deadline);
+            pending.hasDeadline = false;
+        }
+        return true;
+    }
+
+    void RpcChannel::complete(Pending pending, RpcResult result)
+    {
+        if (pending.promise)
+        {
+            // future 直接就绪，不经过线程池，避免在线程池任务中等待 future 时线程池被占满
+            pending.promise->set_value(std::move(result));
+            return;
+        }
+        if (!pending.callback)
+        {
+            return;
+        }
+        if (pool_)
+        {
+            // 任务只持有回调和结果，不引用 this，RpcChannel 销毁后执行也是安全的
+            auto callback = std::make_shared<Callback>(std::move(pending.callback));
+            auto shared_result = std::make_shared<RpcResult>(std::move(result));
+            pool_->enqueue([callback, shared_result]() { (*callback)(std::move(*shared_result)); });
+        }
+        else
+        {
+            // 在读线程中执行，异常不能传出读线程
+            try
+            {
+                pending.callback(std::move(result));
+            }
+            catch (const std::exception& e)
+            {
+                LSX_LIB::LockManager::LockGuard<std::mutex> lock_err(g_error_mutex); // 锁定错误输出
+                std::cerr << "RpcChannel::complete: Callback threw exception: " << e.what() << std::endl;
+            }
+            catch (...)
+            {
+                LSX_LIB::LockManager::LockGuard<std::mutex> lock_err(g_error_mutex); // 锁定错误输出
+                std::cerr << "RpcChannel::complete: Callback threw unknown exception." << std::endl;
+            }
+        }
+    }
+
+    bool RpcChannel::sendFrame(uint8_t type, uint32_t id, const std::string& method,
+                               const uint8_t* payload, size_t size)
+    {
+        if (!connected_.load())
+        {
+            return false;
+        }
+        const size_t body = kHeaderBytes - 4 + method.size() + size;
+        if (body > maxFrameBytes_ - 4)
+        {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock_err(g_error_mutex); // 锁定错误输出
+            std::cerr << "RpcChannel::sendFrame: Frame of " << (body + 4) << " bytes exceeds maxFrameBytes." << std::endl;
+            return false;
+        }
+
+        std::vector<uint8_t> frame(kHeaderBytes + method.size() + size);
+        PutU32(frame.data(), static_cast<uint32_t>(body));
+        frame[4] = type;
+        frame[5] = 0;
+        frame[6] = static_cast<uint8_t>(method.size() >> 8);
+        frame[7] = static_cast<uint8_t>(method.size());
+        PutU32(frame.data() + 8, id);
+        std::copy(method.begin(), method.end(), frame.begin() + kHeaderBytes);
+        if (size > 0)
+        {
+            std::copy(payload, payload + size, frame.begin() + kHeaderBytes + method.size());
+        }
+
+        bool ok;
+        {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(sendMutex_);
+            ok = transport_->send(frame.data(), frame.size());
+        }
+        if (!ok && connected_.exchange(false))
+        {
+            // 帧可能只发送了一部分，字节流已无法继续使用
+            failAll("send failed, connection closed");
+        }
+        return ok;
+    }
+
+    void RpcChannel::sendError(uint32_t id, RpcStatus status, const std::string& message)
+    {
+        std::vector<uint8_t> payload;
+        payload.reserve(1 + message.size());
+        payload.push_back(static_cast<uint8_t>(status));
+        payload.insert(payload.end(), message.begin(), message.end());
+        sendFrame(kFrameError, id, std::string(), payload.data(), payload.size());
+    }
+
+    int RpcChannel::nextWaitMs()
+    {
+        LSX_LIB::LockManager::LockGuard<std::mutex> lock(pendingMutex_);
+        if (deadlines_.empty())
+        {
+            return kPollIntervalMs;
+        }
+        const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadlines_.begin()->first - Clock::now()).count() + 1;
+        return static_cast<int>(std::max<long long>(0, std::min<long long>(wait, kPollIntervalMs)));
+    }
+
+    void RpcChannel::readLoop()
+    {
+        std::vector<uint8_t> buffer;
+        while (running_.load() && connected_.load())
+        {
+            if (!readSome(buffer, nextWaitMs()) || !parseFrames(buffer))
+            {
+                if (connected_.exchange(false))
+                {
+                    failAll("connection closed");
+                }
+                break;
+            }
+            expireCalls();
+        }
+    }
+
+    bool RpcChannel::readSome(std::vector<uint8_t>& buffer, int waitMs)
+    {
+#ifndef _WIN32
+        if (handle_ >= 0)
+        {
+            // 先等待可读再直接读取描述符。不能调用 transport_->receive：TcpClient/TcpServer 的 send
+            // 在整个阻塞发送期间持有同一把互斥锁，对端缓冲区满时读线程会被卡住而无法排空对端的数据，两端互相等待
+            struct pollfd pfd;
+            pfd.fd = handle_;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            const int ready = ::poll(&pfd, 1, waitMs);
+            if (ready < 0)
+            {
+                return errno == EINTR;
+            }
+            if (ready == 0)
+            {
+                return true; // 超时，交给 expireCalls 处理截止时间
+            }
+
+            uint8_t chunk[kReadChunk];
+            const ssize_t received = ::read(handle_, chunk, sizeof(chunk));
+            if (received < 0)
+            {
+                return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+            if (received == 0)
+            {
+                return false; // poll 报告可读却读到 0 字节表示对端关闭
+            }
+            buffer.insert(buffer.end(), chunk, chunk + received);
+            return true;
+        }
+#else
+        (void)waitMs;
+#endif
+        // 没有可 poll 的描述符：使用带超时的 receive 轮询，0 表示超时
+        uint8_t chunk[kReadChunk];
+        const int received = transport_->receive(chunk, sizeof(chunk));
+        if (received < 0)
+        {
+            return false;
+        }
+        buffer.insert(buffer.end(), chunk, chunk + received);
+        return true;
+    }
+
+    bool RpcChannel::parseFrames(std::vector<uint8_t>& buffer)
+    {
+        size_t offset = 0;
+        while (buffer.size() - offset >= 4)
+        {
+            const uint8_t* p = buffer.data() + offset;
+            const uint32_t body = GetU32(p);
+            // 先与 maxFrameBytes_ - 4 比较再做加法：body + 4 在 uint32 (及 32 位 size_t) 下会回绕，
+            // 0xFFFFFFFF 之类的长度会通过检查，读线程随后无限制地缓存数据
+            if (body < kHeaderBytes - 4 || body > maxFrameBytes_ - 4)
+            {
+                LSX_LIB::LockManager::LockGuard<std::mutex> lock_err(g_error_mutex); // 锁定错误输出
+                std::cerr << "RpcChannel::parseFrames: Invalid frame length " << body << "." << std::endl;
+                return false;
+            }
+            if (buffer.size() - offset < 4 + static_cast<size_t>(body))
+            {
+                break; // 帧尚未收全
+            }
+
+            const uint8_t type = p[4];
+            const size_t methodLen = (static_cast<size_t>(p[6]) << 8) | p[7];
+            const uint32_t id = GetU32(p + 8);
+            if (kHeaderBytes - 4 + methodLen > body)
+            {
+                LSX_LIB::LockManager::LockGuard<std::mutex> lock_err(g_error_mutex); // 锁定错误输出
+                std::cerr << "RpcChannel::parseFrames: Method name exceeds frame length." << std::endl;
+                return false;
+            }
+            const uint8_t* method = p + kHeaderBytes;
+            const uint8_t* payload = method + methodLen;
+            const uint8_t* end = p + 4 + body;
+
+            if (type == kFrameRequest)
+            {
+                dispatchRequest(id, std::string(method, method + methodLen), std::vector<uint8_t>(payload, end));
+            }
+            else if (type == kFrameResponse || type == kFrameError)
+            {
+                Pending pending;
+                if (takePending(id, pending)) // 已超时的调用找不到，迟到的应答直接丢弃
+                {
+                    RpcResult result;
+                    if (type == kFrameResponse)
+                    {
+                        result.payload.assign(payload, end);
+                    }
+                    else
+                    {
+                        result.status = payload < end ? static_cast<RpcStatus>(*payload) : RpcStatus::HandlerError;
+                        result.error.assign(payload < end ? payload + 1 : end, end);
+                    }
+                    complete(std::move(pending), std::move(result));
+                }
+            }
+            else
+            {
+                LSX_LIB::LockManager::LockGuard<std::mutex> lock_err(g_error_mutex); // 锁定错误输出
+                std::cerr << "RpcChannel::parseFrames: Unknown frame type " << static_cast<int>(type) << "." << std::endl;
+                return false;
+            }
+            offset += 4 + body;
+        }
+        buffer.erase(buffer.begin(), buffer.begin() + offset);
+        return true;
+    }
+
+    void RpcChannel::dispatchRequest(uint32_t id, std::string method, std::vector<uint8_t> payload)
+    {
+        std::shared_ptr<Handler> handler;
+        {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(handlersMutex_);
+            auto it = handlers_.find(method);
+            if (it != handlers_.end())
+            {
+                handler = it->second;
+            }
+        }
+        if (!handler)
+        {
+            sendError(id, RpcStatus::MethodNotFound, "method not found: " + method);
+            return;
+        }
+
+        auto run = [this, id, handler, payload = std::move(payload)]() {
+            try
+            {
+                const std::vector<uint8_t> reply = (*handler)(payload);
+                sendFrame(kFrameResponse, id, std::string(), reply.data(), reply.size());
+            }
+            catch (const std::exception& e)
+            {
+                sendError(id, RpcStatus::HandlerError, e.what());
+            }
+            catch (...)
+            {
+                sendError(id, RpcStatus::HandlerError, "unknown exception");
+            }
+        };
+
+        if (!pool_)
+        {
+            run();
+            return;
+        }
+        {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(activeMutex_);
+            ++activeHandlers_;
+        }
+        // 多个请求在线程池中并发处理，先完成的先应答
+        pool_->enqueue([this, run]() {
+            run();
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(activeMutex_);
+            if (--activeHandlers_ == 0)
+            {
+                activeCv_.notify_all();
+            }
+        });
+    }
+
+    void RpcChannel::expireCalls()
+    {
+        std::vector<Pending> expired;
+        {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(pendingMutex_);
+            const auto now = Clock::now();
+            while (!deadlines_.empty() && deadlines_.begin()->first <= now)
+            {
+                auto it = pending_.find(deadlines_.begin()->second);
+                deadlines_.erase(deadlines_.begin());
+                if (it != pending_.end())
+                {
+                    it->second.hasDeadline = false;
+                    expired.push_back(std::move(it->second));
+                    pending_.erase(it);
+                }
+            }
+        }
+        for (auto& pending : expired)
+        {
+            complete(std::move(pending), RpcResult{RpcStatus::Timeout, {}, "deadline exceeded"});
+        }
+    }
+
+    void RpcChannel::failAll(const std::string& reason)
+    {
+        std::map<uint32_t, Pending> failed;
+        {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(pendingMutex_);
+            failed.swap(pending_);
+            deadlines_.clear();
+        }
+        for (auto& entry : failed)
+        {
+            complete(std::move(entry.second), RpcResult{RpcStatus::Disconnected, {}, reason});
+        }
+    }
+} // namespace LSX_LIB::DataTransfer
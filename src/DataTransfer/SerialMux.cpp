@@ -0,0 +1,584 @@
+
+// ---------- File: SerialMux.cpp ----------
+#include "SerialMux.h"
+#include "GlobalErrorMutex.h" // 包含全局错误锁 (用于同步错误输出)
+#include "LockGuard.h" // 包含 LIBLSX::LockManager::LockGuard
+#include <iostream> // For std::cerr (错误输出)
+#include <algorithm> // 包含 std::min, std::max
+#include <climits> // 包含 INT_MAX
+#ifndef _WIN32
+#include <poll.h> // For poll (等待串口可读)
+#include <sys/ioctl.h> // For ioctl(TIOCOUTQ) (查询驱动输出队列长度)
+#include <termios.h> // For TIOCOUTQ
+#include <errno.h> // For errno
+#endif
+
+namespace LSX_LIB::DataTransfer
+{
+    // 帧格式: [A5][通道][类型][长度][偏移高][偏移低][数据 x 长度][CRC16 高][CRC16 低]
+    // CRC16-CCITT 覆盖通道到数据的全部字节；偏移为该块在通道字节流中位置的低 16 位，用于发现丢帧
+    static const uint8_t kSof = 0xA5;
+    static const size_t kHeaderBytes = 6;
+    static const size_t kTrailerBytes = 2;
+    static const uint8_t kTypeData = 0x10;   // 低两位为 kFlagFirst/kFlagLast
+    static const uint8_t kTypeCredit = 0x20; // 负载为 4 字节的累计可发送上限
+    static const uint8_t kFlagFirst = 0x01;
+    static const uint8_t kFlagLast = 0x02;
+    static const size_t kMaxWindow = 32768;  // 偏移只有 16 位，窗口不能超过其一半
+    static const int kPollIntervalMs = 50;   // 读线程的最长等待时间，决定 stop 的响应速度
+    static const size_t kReadChunk = 1024;
+
+    SerialMux::SerialMux(std::unique_ptr<ICommunication> link, const SerialMuxConfig& config)
+        : link_(std::move(link)),
+          config_(config)
+    {
+    }
+
+    SerialMux::~SerialMux()
+    {
+        stop(); // link_ 析构时关闭链路
+    }
+
+    bool SerialMux::openChannel(uint8_t channel, const MuxChannelConfig& config)
+    {
+        LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+        Channel& ch = channels_[channel];
+        if (ch.open)
+        {
+            return false;
+        }
+        ch.open = true;
+        ch.config = config;
+        ch.config.receiveWindow = std::min(std::max<size_t>(config.receiveWindow, 1), kMaxWindow);
+        ch.creditDue = true; // 尽快告诉对端可以发送
+        writerCv_.notify_one();
+        return true;
+    }
+
+    void SerialMux::setHandler(uint8_t channel, Handler handler)
+    {
+        LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+        channels_[channel].handler = std::move(handler);
+    }
+
+    bool SerialMux::start()
+    {
+        if (!link_ || running_.load())
+        {
+            return false;
+        }
+        if (reader_.joinable())
+        {
+            reader_.join(); // 链路出错后线程已自行退出
+        }
+        if (writer_.joinable())
+        {
+            writer_.join();
+        }
+        handle_ = link_->nativeHandle();
+        {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+            stopping_ = false;
+            for (auto& ch : channels_)
+            {
+                ch.creditDue = ch.open;
+            }
+            nextRefresh_ = Clock::now() + std::chrono::milliseconds(config_.creditRefreshMs);
+        }
+        running_.store(true);
+        reader_ = std::thread(&SerialMux::readLoop, this);
+        writer_ = std::thread(&SerialMux::writeLoop, this);
+        return true;
+    }
+
+    void SerialMux::stop()
+    {
+        running_.store(false);
+        wakeAll();
+        for (std::thread* t : {&reader_, &writer_})
+        {
+            if (t->joinable() && t->get_id() != std::this_thread::get_id())
+            {
+                t->join();
+            }
+        }
+    }
+
+    void SerialMux::wakeAll()
+    {
+        LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        writerCv_.notify_all();
+        for (auto& ch : channels_)
+        {
+            ch.txSpace.notify_all();
+            ch.rxReady.notify_all();
+        }
+    }
+
+    bool SerialMux::send(uint8_t channel, const uint8_t* data, size_t size, int timeoutMs)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        Channel& ch = channels_[channel];
+        if (!ch.open || size > ch.config.receiveWindow)
+        {
+            return false;
+        }
+        // 队列为空时总是接受，保证不超过 receiveWindow 的消息一定能发出
+        auto ready = [&] {
+            return stopping_ || ch.txQueuedBytes == 0 || ch.txQueuedBytes + size <= ch.config.sendQueueBytes;
+        };
+        if (timeoutMs < 0)
+        {
+            ch.txSpace.wait(lock, ready);
+        }
+        else if (!ch.txSpace.wait_for(lock, std::chrono::milliseconds(timeoutMs), ready))
+        {
+            return false;
+        }
+        if (stopping_)
+        {
+            return false; // 已停止或链路出错
+        }
+        ch.txQueue.emplace_back(data, data + size);
+        ch.txQueuedBytes += size;
+        writerCv_.notify_one();
+        return true;
+    }
+
+    int SerialMux::receive(uint8_t channel, std::vector<uint8_t>& message, int timeoutMs)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        Channel& ch = channels_[channel];
+        if (!ch.open)
+        {
+            return -1;
+        }
+        auto ready = [&] { return stopping_ || !ch.rxQueue.empty(); };
+        if (timeoutMs < 0)
+        {
+            ch.rxReady.wait(lock, ready);
+        }
+        else
+        {
+            ch.rxReady.wait_for(lock, std::chrono::milliseconds(timeoutMs), ready);
+        }
+        if (ch.rxQueue.empty())
+        {
+            return stopping_ ? -1 : 0;
+        }
+        message = std::move(ch.rxQueue.front());
+        ch.rxQueue.pop_front();
+        ch.rxQueuedBytes -= message.size();
+        consumeLocked(ch, message.size());
+        return 1;
+    }
+
+    MuxChannelStats SerialMux::getStats(uint8_t channel) const
+    {
+        LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+        const Channel& ch = channels_[channel];
+        if (!ch.open)
+        {
+            return MuxChannelStats();
+        }
+        MuxChannelStats stats = ch.stats;
+        stats.txQueuedBytes = ch.txQueuedBytes;
+        stats.rxQueuedBytes = ch.rxQueuedBytes;
+        const int32_t credit = static_cast<int32_t>(ch.peerLimit - ch.txSent);
+        stats.peerCredit = credit > 0 ? static_cast<size_t>(credit) : 0;
+        return stats;
+    }
+
+    void SerialMux::consumeLocked(Channel& ch, size_t bytes)
+    {
+        ch.rxConsumed += static_cast<uint32_t>(bytes);
+        // 可用窗口比上次通告增长了四分之一以上才通告，避免每条小消息都回一帧信用
+        const uint32_t limit = ch.rxConsumed + static_cast<uint32_t>(ch.config.receiveWindow);
+        if (limit - ch.advertised >= ch.config.receiveWindow / 4)
+        {
+            ch.creditDue = true;
+            writerCv_.notify_one();
+        }
+    }
+
+    uint16_t SerialMux::Crc16(const uint8_t* data, size_t size)
+    {
+        // CRC16-CCITT (多项式 0x1021，初值 0xFFFF)
+        uint16_t crc = 0xFFFF;
+        for (size_t i = 0; i < size; ++i)
+        {
+            crc ^= static_cast<uint16_t>(data[i]) << 8;
+            for (int bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    void SerialMux::buildFrame(std::vector<uint8_t>& frame, uint8_t channel, uint8_t type, uint16_t offset,
+                               const uint8_t* data, size_t size)
+    {
+        frame.resize(kHeaderBytes + size + kTrailerBytes);
+        frame[0] = kSof;
+        frame[1] = channel;
+        frame[2] = type;
+        frame[3] = static_cast<uint8_t>(size);
+        frame[4] = static_cast<uint8_t>(offset >> 8);
+        frame[5] = static_cast<uint8_t>(offset);
+        std::copy(data, data + size, frame.begin() + kHeaderBytes);
+        const uint16_t crc = Crc16(frame.data() + 1, kHeaderBytes - 1 + size);
+        frame[kHeaderBytes + size] = static_cast<uint8_t>(crc >> 8);
+        frame[kHeaderBytes + size + 1] = static_cast<uint8_t>(crc);
+    }
+
+    bool SerialMux::nextFrame(std::vector<uint8_t>& frame)
+    {
+        // 1. 信用通告优先于一切数据
+        for (int i = 0; i < 256; ++i)
+        {
+            Channel& ch = channels_[i];
+            if (ch.open && ch.creditDue)
+            {
+                ch.creditDue = false;
+                ch.advertised = ch.rxConsumed + static_cast<uint32_t>(ch.config.receiveWindow);
+                const uint8_t limit[4] = {
+                    static_cast<uint8_t>(ch.advertised >> 24), static_cast<uint8_t>(ch.advertised >> 16),
+                    static_cast<uint8_t>(ch.advertised >> 8), static_cast<uint8_t>(ch.advertised)
+                };
+                buildFrame(frame, static_cast<uint8_t>(i), kTypeCredit, 0, limit, sizeof(limit));
+                return true;
+            }
+        }
+
+        // 2. 偏移探测帧：不带数据和首尾标志，对端据其偏移发现缺口并归还丢失部分占用的信用
+        for (int i = 0; i < 256; ++i)
+        {
+            Channel& ch = channels_[i];
+            if (ch.open && ch.probeDue)
+            {
+                ch.probeDue = false;
+                buildFrame(frame, static_cast<uint8_t>(i), kTypeData, static_cast<uint16_t>(ch.txSent), nullptr, 0);
+                return true;
+            }
+        }
+
+        // 3. 最高优先级且有信用的通道；从上次发送的通道之后开始找，同优先级的通道轮流发送
+        int best = -1;
+        int bestPriority = INT_MAX;
+        for (int i = 1; i <= 256; ++i)
+        {
+            const int index = (rrCursor_ + i) & 0xFF;
+            const Channel& ch = channels_[index];
+            if (!ch.open || ch.txQueue.empty() || ch.config.priority >= bestPriority)
+            {
+                continue;
+            }
+            const int32_t credit = static_cast<int32_t>(ch.peerLimit - ch.txSent);
+            if (credit > 0 || ch.txQueue.front().empty())
+            {
+                best = index;
+                bestPriority = ch.config.priority;
+            }
+        }
+        if (best < 0)
+        {
+            return false;
+        }
+
+        rrCursor_ = static_cast<uint8_t>(best);
+        Channel& ch = channels_[best];
+        const std::vector<uint8_t>& message = ch.txQueue.front();
+        const size_t credit = static_cast<size_t>(std::max<int32_t>(static_cast<int32_t>(ch.peerLimit - ch.txSent), 0));
+        const size_t chunk = std::min(std::max<size_t>(config_.chunkBytes, 16), size_t(255));
+        const size_t n = std::min({chunk, credit, message.size() - ch.txOffset});
+
+        uint8_t type = kTypeData;
+        if (ch.txOffset == 0)
+        {
+            type |= kFlagFirst;
+        }
+        if (ch.txOffset + n == message.size())
+        {
+            type |= kFlagLast;
+        }
+        buildFrame(frame, static_cast<uint8_t>(best), type, static_cast<uint16_t>(ch.txSent),
+                   message.data() + ch.txOffset, n);
+
+        ch.txOffset += n;
+        ch.txSent += static_cast<uint32_t>(n);
+        ch.txQueuedBytes -= n;
+        ch.stats.txBytes += n;
+        if (ch.txOffset == message.size())
+        {
+            ch.txQueue.pop_front();
+            ch.txOffset = 0;
+            ch.stats.txMessages++;
+        }
+        ch.txSpace.notify_all();
+        return true;
+    }
+
+    void SerialMux::waitOutQueue()
+    {
+#ifndef _WIN32
+        if (handle_ < 0 || config_.maxOutQueueBytes <= 0)
+        {
+            return;
+        }
+        // 驱动输出队列是 FIFO，积压的数据越多，之后的控制帧等得越久；等它排空到阈值以下再决定下一块发什么
+        while (running_.load())
+        {
+            int queued = 0;
+            if (::ioctl(handle_, TIOCOUTQ, &queued) != 0 || queued <= config_.maxOutQueueBytes)
+            {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+#endif
+    }
+
+    void SerialMux::writeLoop()
+    {
+        std::vector<uint8_t> frame;
+        while (running_.load())
+        {
+            waitOutQueue();
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                bool ready = false;
+                while (running_.load())
+                {
+                    const auto now = Clock::now();
+                    if (now >= nextRefresh_)
+                    {
+                        // 定期重发信用通告，丢失的通告或对端晚启动都能恢复。
+                        // 因缺少信用而发不出数据的通道同时发送一个空的偏移探测帧：若丢失的正是某条消息的最后一块，
+                        // 对端只能从后续数据帧的偏移发现缺口，而信用耗尽时不会再有数据帧，两端将永远互相等待
+                        for (auto& ch : channels_)
+                        {
+                            ch.creditDue = ch.creditDue || ch.open;
+                            ch.probeDue = ch.open && !ch.txQueue.empty() && !ch.txQueue.front().empty() &&
+                                          static_cast<int32_t>(ch.peerLimit - ch.txSent) <= 0;
+                        }
+                        nextRefresh_ = now + std::chrono::milliseconds(std::max(config_.creditRefreshMs, 1));
+                    }
+                    if (nextFrame(frame))
+                    {
+                        ready = true;
+                        break;
+                    }
+                    writerCv_.wait_until(lock, nextRefresh_);
+                }
+                if (!ready)
+                {
+                    break;
+                }
+            }
+            if (!link_->send(frame.data(), frame.size()))
+            {
+                {
+                    LSX_LIB::LockManager::LockGuard<std::mutex> lock_err(g_error_mutex); // 锁定错误输出
+                    std::cerr << "SerialMux::writeLoop: Link send failed, stopping." << std::endl;
+                }
+                running_.store(false);
+                wakeAll();
+                break;
+            }
+        }
+    }
+
+    void SerialMux::readLoop()
+    {
+        std::vector<uint8_t> buffer;
+        while (running_.load())
+        {
+            if (!readSome(buffer))
+            {
+                {
+                    LSX_LIB::LockManager::LockGuard<std::mutex> lock_err(g_error_mutex); // 锁定错误输出
+                    std::cerr << "SerialMux::readLoop: Link receive failed, stopping." << std::endl;
+                }
+                running_.store(false);
+                wakeAll();
+                break;
+            }
+            parseFrames(buffer);
+        }
+    }
+
+    bool SerialMux::readSome(std::vector<uint8_t>& buffer)
+    {
+#ifndef _WIN32
+        if (handle_ >= 0)
+        {
+            // 先等待可读再调用 receive，避免 receive 在读超时内持有链路的互斥锁而阻塞写线程
+            struct pollfd pfd;
+            pfd.fd = handle_;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            const int ready = ::poll(&pfd, 1, kPollIntervalMs);
+            if (ready < 0)
+            {
+                return errno == EINTR;
+            }
+            if (ready == 0)
+            {
+                return true;
+            }
+        }
+#endif
+        uint8_t chunk[kReadChunk];
+        const int received = link_->receive(chunk, sizeof(chunk));
+        if (received < 0)
+        {
+            return false;
+        }
+        buffer.insert(buffer.end(), chunk, chunk + received); // 串口读超时返回 0，不表示断开
+        return true;
+    }
+
+    void SerialMux::parseFrames(std::vector<uint8_t>& buffer)
+    {
+        std::vector<Delivery> deliveries;
+        size_t pos = 0;
+        {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+            while (true)
+            {
+                while (pos < buffer.size() && buffer[pos] != kSof)
+                {
+                    ++pos; // 丢弃帧头之前的字节，重新同步
+                }
+                if (buffer.size() - pos < kHeaderBytes)
+                {
+                    break;
+                }
+                const size_t size = buffer[pos + 3];
+                if (buffer.size() - pos < kHeaderBytes + size + kTrailerBytes)
+                {
+                    break; // 帧尚未收全
+                }
+                const uint8_t* frame = buffer.data() + pos;
+                const uint16_t crc = static_cast<uint16_t>((frame[kHeaderBytes + size] << 8) | frame[kHeaderBytes + size + 1]);
+                if (Crc16(frame + 1, kHeaderBytes - 1 + size) != crc)
+                {
+                    crcErrors_.fetch_add(1, std::memory_order_relaxed);
+                    ++pos; // 可能是数据中的 A5，从下一个字节继续寻找帧头
+                    continue;
+                }
+                handleFrame(frame[1], frame[2], static_cast<uint16_t>((frame[4] << 8) | frame[5]),
+                            frame + kHeaderBytes, size, deliveries);
+                pos += kHeaderBytes + size + kTrailerBytes;
+            }
+        }
+        buffer.erase(buffer.begin(), buffer.begin() + pos);
+
+        // handler 在锁外执行，返回后才归还信用；抛出异常时记录后同样归还，否则该通道的信用会永久减少
+        for (auto& delivery : deliveries)
+        {
+            const size_t bytes = delivery.message.size();
+            try
+            {
+                delivery.handler(std::move(delivery.message));
+            }
+            catch (const std::exception& e)
+            {
+                LSX_LIB::LockManager::LockGuard<std::mutex> lock_err(g_error_mutex); // 锁定错误输出
+                std::cerr << "SerialMux::parseFrames: Handler for channel " << static_cast<int>(delivery.channel)
+                          << " threw exception: " << e.what() << std::endl;
+            }
+            catch (...)
+            {
+                LSX_LIB::LockManager::LockGuard<std::mutex> lock_err(g_error_mutex); // 锁定错误输出
+                std::cerr << "SerialMux::parseFrames: Handler for channel " << static_cast<int>(delivery.channel)
+                          << " threw unknown exception." << std::endl;
+            }
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+            consumeLocked(channels_[delivery.channel], bytes);
+        }
+    }
+
+    void SerialMux::handleFrame(uint8_t channel, uint8_t type, uint16_t offset, const uint8_t* data, size_t size,
+                                std::vector<Delivery>& deliveries)
+    {
+        Channel& ch = channels_[channel];
+        if (!ch.open)
+        {
+            return; // 本端未打开的通道不会通告信用，对端不应发送
+        }
+
+        if (type == kTypeCredit)
+        {
+            if (size == 4)
+            {
+                const uint32_t limit = (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+                                       (static_cast<uint32_t>(data[2]) << 8) | static_cast<uint32_t>(data[3]);
+                if (static_cast<int32_t>(limit - ch.peerLimit) > 0) // 忽略乱序到达的旧通告
+                {
+                    ch.peerLimit = limit;
+                    writerCv_.notify_one();
+                }
+            }
+            return;
+        }
+        if ((type & ~(kFlagFirst | kFlagLast)) != kTypeData)
+        {
+            return;
+        }
+
+        const uint16_t gap = static_cast<uint16_t>(offset - static_cast<uint16_t>(ch.rxReceived));
+        if (gap >= 0x8000)
+        {
+            return; // 偏移落后于已收到的位置，是重复的旧帧
+        }
+        if (gap != 0)
+        {
+            // 中间有块丢失：丢弃正在重组的消息，丢失的字节直接归还信用，保持两端字节计数一致
+            ch.rxReceived += gap;
+            ch.stats.rxDropped++;
+            consumeLocked(ch, gap + ch.rxPartial.size());
+            ch.rxPartial.clear();
+            ch.rxSkipping = true;
+        }
+        ch.rxReceived += static_cast<uint32_t>(size);
+        ch.stats.rxBytes += size;
+
+        if (type & kFlagFirst)
+        {
+            if (!ch.rxPartial.empty())
+            {
+                ch.stats.rxDropped++; // 上一条消息的结束块丢失
+                consumeLocked(ch, ch.rxPartial.size());
+                ch.rxPartial.clear();
+            }
+            ch.rxSkipping = false;
+        }
+        if (ch.rxSkipping)
+        {
+            consumeLocked(ch, size);
+            return;
+        }
+
+        ch.rxPartial.insert(ch.rxPartial.end(), data, data + size);
+        if (!(type & kFlagLast))
+        {
+            return;
+        }
+
+        ch.stats.rxMessages++;
+        if (ch.handler)
+        {
+            deliveries.push_back(Delivery{channel, ch.handler, std::move(ch.rxPartial)});
+        }
+        else
+        {
+            ch.rxQueuedBytes += ch.rxPartial.size();
+            ch.rxQueue.push_back(std::move(ch.rxPartial));
+            ch.rxReady.notify_one();
+        }
+        ch.rxPartial.clear();
+    }
+} // namespace LSX_LIB::DataTransfer
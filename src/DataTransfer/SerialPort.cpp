@@ -572,4 +572,14 @@ namespace LSX_LIB::DataTransfer
 
         return false; // 指示未完全实现/支持通用超时
     }
+
+    int SerialPort::nativeHandle()
+    {
+#ifdef _WIN32
+        return -1; // Windows 句柄不是文件描述符
+#else
+        LSX_LIB::LockManager::LockGuard<std::mutex> lock(mtx); // 锁定互斥锁
+        return fd;
+#endif
+    }
 } // namespace LSX_LIB
@@ -116,7 +116,7 @@ namespace LSX_LIB::DataTransfer
         }
 
         // 在接受新连接前关闭任何现有连接 (单客户端行为)
-        closeClientConnection(); // closeClientConnection 内部已加锁，此处不会死锁
+        closeClientConnectionLocked(); // 已持有 mtx，不能再调用加锁的 closeClientConnection
 
         struct sockaddr_in clientAddr;
         socklen_t len = sizeof(clientAddr);
@@ -328,7 +328,11 @@ namespace LSX_LIB::DataTransfer
     void TcpServer::closeClientConnection()
     {
         LSX_LIB::LockManager::LockGuard<std::mutex> lock(mtx); // 锁定互斥锁
+        closeClientConnectionLocked();
+    }
 
+    void TcpServer::closeClientConnectionLocked()
+    {
         if (connFd >= 0
 #ifdef _WIN32
         || connFd != INVALID_SOCKET
@@ -356,7 +360,7 @@ namespace LSX_LIB::DataTransfer
     {
         LSX_LIB::LockManager::LockGuard<std::mutex> lock(mtx); // 锁定互斥锁
 
-        closeClientConnection(); // 先关闭已接受的连接 (closeClientConnection 内部已加锁，此处不会死锁)
+        closeClientConnectionLocked(); // 先关闭已接受的连接 (已持有 mtx)
 
         if (listenFd >= 0
 #ifdef _WIN32
@@ -456,4 +460,24 @@ namespace LSX_LIB::DataTransfer
 #endif
         return true;
     }
+
+    int TcpServer::nativeHandle()
+    {
+#ifdef _WIN32
+        return -1; // Windows 句柄不是文件描述符
+#else
+        LSX_LIB::LockManager::LockGuard<std::mutex> lock(mtx); // 锁定互斥锁
+        return connFd;
+#endif
+    }
+
+    int TcpServer::listenHandle()
+    {
+#ifdef _WIN32
+        return -1; // Windows 句柄不是文件描述符
+#else
+        LSX_LIB::LockManager::LockGuard<std::mutex> lock(mtx); // 锁定互斥锁
+        return listenFd;
+#endif
+    }
 } // namespace LSX_LIB
@@ -249,4 +249,14 @@ namespace LSX_LIB::DataTransfer
 #endif
         return true;
     }
+
+    int UdpServer::nativeHandle()
+    {
+#ifdef _WIN32
+        return -1; // Windows 句柄不是文件描述符
+#else
+        LSX_LIB::LockManager::LockGuard<std::mutex> lock(mtx); // 锁定互斥锁
+        return sockfd;
+#endif
+    }
 } // namespace LSX_LIB
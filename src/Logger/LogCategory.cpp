@@ -0,0 +1,177 @@
+#include "LogCategory.h"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+
+namespace LSX_LIB {
+namespace Logger {
+
+// 去除首尾空白的辅助函数
+static std::string Trim(const std::string& text) {
+    const auto begin = text.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    const auto end = text.find_last_not_of(" \t\r\n");
+    return text.substr(begin, end - begin + 1);
+}
+
+// JSON 字符串转义的辅助函数 (分类名称通常是普通标识符，这里只处理必须转义的字符)
+static std::string JsonEscape(const std::string& text) {
+    std::ostringstream oss;
+    for (char c : text) {
+        switch (c) {
+            case '"':  oss << "\\\""; break;
+            case '\\': oss << "\\\\"; break;
+            case '\n': oss << "\\n"; break;
+            case '\r': oss << "\\r"; break;
+            case '\t': oss << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    oss << "\\u00" << "0123456789abcdef"[(c >> 4) & 0xF] << "0123456789abcdef"[c & 0xF];
+                } else {
+                    oss << c;
+                }
+        }
+    }
+    return oss.str();
+}
+
+LogCategoryRegistry& LogCategoryRegistry::Instance() {
+    // 有意不析构：分类引用被各调用点的静态变量缓存，静态对象析构期间仍可能记录日志
+    static LogCategoryRegistry* instance = new LogCategoryRegistry();
+    return *instance;
+}
+
+LogCategory& LogCategoryRegistry::GetLocked(const std::string& name) {
+    auto it = categories_.find(name);
+    if (it == categories_.end()) {
+        it = categories_.emplace(name, std::unique_ptr<LogCategory>(new LogCategory(name, default_level_))).first;
+    }
+    return *it->second;
+}
+
+LogCategory& LogCategoryRegistry::Get(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return GetLocked(name);
+}
+
+void LogCategoryRegistry::SetLevel(const std::string& name, LogLevel level) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    LogCategory& category = GetLocked(name);
+    category.explicit_level_ = true;
+    category.level_.store(static_cast<int>(level), std::memory_order_release);
+}
+
+void LogCategoryRegistry::SetDefaultLevel(LogLevel level) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    default_level_ = level;
+    for (auto& entry : categories_) {
+        if (!entry.second->explicit_level_) {
+            entry.second->level_.store(static_cast<int>(level), std::memory_order_release);
+        }
+    }
+}
+
+void LogCategoryRegistry::SetLowPriority(const std::string& name, bool low_priority) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    GetLocked(name).low_priority_.store(low_priority, std::memory_order_relaxed);
+}
+
+LogLevel LogCategoryRegistry::GetDefaultLevel() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return default_level_;
+}
+
+bool LogCategoryRegistry::Apply(const std::string& spec) {
+    // 先完整解析，任意一项无效则整体放弃，避免只应用了一半
+    std::vector<std::pair<std::string, LogLevel>> items;
+    std::istringstream iss(spec);
+    std::string item;
+    while (std::getline(iss, item, ',')) {
+        item = Trim(item);
+        if (item.empty()) {
+            continue;
+        }
+        const auto eq = item.find('=');
+        if (eq == std::string::npos) {
+            return false;
+        }
+        const std::string name = Trim(item.substr(0, eq));
+        LogLevel level;
+        if (name.empty() || !ParseLevel(Trim(item.substr(eq + 1)), level)) {
+            return false;
+        }
+        items.emplace_back(name, level);
+    }
+    if (items.empty()) {
+        return false;
+    }
+
+    for (const auto& entry : items) {
+        if (entry.first == "*") {
+            SetDefaultLevel(entry.second);
+        } else {
+            SetLevel(entry.first, entry.second);
+        }
+    }
+    return true;
+}
+
+std::vector<std::pair<std::string, LogLevel>> LogCategoryRegistry::List() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::pair<std::string, LogLevel>> result;
+    result.reserve(categories_.size());
+    for (const auto& entry : categories_) {
+        result.emplace_back(entry.first, entry.second->GetLevel());
+    }
+    return result;
+}
+
+bool LogCategoryRegistry::ParseLevel(const std::string& text, LogLevel& level) {
+    std::string upper = text;
+    std::transform(upper.begin(), upper.end(), upper.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    if (upper == "DEBUG") {
+        level = LogLevel::DEBUG;
+    } else if (upper == "INFO") {
+        level = LogLevel::INFO;
+    } else if (upper == "WARNING" || upper == "WARN") {
+        level = LogLevel::WARNING;
+    } else if (upper == "ERROR") {
+        level = LogLevel::ERROR;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* LogCategoryRegistry::LevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG:   return "DEBUG";
+        case LogLevel::INFO:    return "INFO";
+        case LogLevel::WARNING: return "WARNING";
+        case LogLevel::ERROR:   return "ERROR";
+        default:                return "UNKNOWN";
+    }
+}
+
+std::string LogCategoryRegistry::ToJson() const {
+    const auto categories = List();
+    std::ostringstream oss;
+    oss << "{\"default\":\"" << LevelName(GetDefaultLevel()) << "\",\"categories\":{";
+    bool first = true;
+    for (const auto& entry : categories) {
+        if (!first) {
+            oss << ",";
+        }
+        first = false;
+        oss << "\"" << JsonEscape(entry.first) << "\":\"" << LevelName(entry.second) << "\"";
+    }
+    oss << "}}";
+    return oss.str();
+}
+
+} // namespace Logger
+} // namespace LSX_LIB
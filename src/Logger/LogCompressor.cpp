@@ -0,0 +1,460 @@
+#include "LogCompressor.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+namespace LSX_LIB {
+namespace Logger {
+
+// --- gzip 编码器 (LZ77 + 固定 Huffman 表，RFC 1951/1952) ---
+
+namespace {
+
+// 按 LSB 优先顺序输出比特流
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+    void Put(uint32_t value, int bits) {
+        acc_ |= static_cast<uint64_t>(value) << count_;
+        count_ += bits;
+        while (count_ >= 8) {
+            out_.push_back(static_cast<uint8_t>(acc_));
+            acc_ >>= 8;
+            count_ -= 8;
+        }
+    }
+
+    // Huffman 码按 MSB 优先存放，需要先反转
+    void PutHuffman(uint32_t code, int bits) {
+        uint32_t reversed = 0;
+        for (int i = 0; i < bits; ++i) {
+            reversed = (reversed << 1) | ((code >> i) & 1u);
+        }
+        Put(reversed, bits);
+    }
+
+    void Finish() {
+        if (count_ > 0) {
+            out_.push_back(static_cast<uint8_t>(acc_));
+        }
+        acc_ = 0;
+        count_ = 0;
+    }
+
+private:
+    std::vector<uint8_t>& out_;
+    uint64_t acc_ = 0;
+    int count_ = 0;
+};
+
+const uint16_t kLengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                  35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                  3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t kDistBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const uint8_t kDistExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+const int kWindowSize = 32768;
+const int kMinMatch = 3;
+const int kMaxMatch = 258;
+const int kMaxChain = 32;
+const int kHashBits = 15;
+
+// 固定 Huffman 表中的字面量/长度符号 (0-287)
+void PutLiteralLength(BitWriter& bw, int symbol) {
+    if (symbol < 144) {
+        bw.PutHuffman(0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        bw.PutHuffman(0x190 + (symbol - 144), 9);
+    } else if (symbol < 280) {
+        bw.PutHuffman(symbol - 256, 7);
+    } else {
+        bw.PutHuffman(0xC0 + (symbol - 280), 8);
+    }
+}
+
+void PutMatch(BitWriter& bw, int length, int distance) {
+    int li = 28;
+    while (kLengthBase[li] > length) {
+        --li;
+    }
+    PutLiteralLength(bw, 257 + li);
+    bw.Put(length - kLengthBase[li], kLengthExtra[li]);
+
+    int di = 29;
+    while (kDistBase[di] > distance) {
+        --di;
+    }
+    bw.PutHuffman(di, 5);
+    bw.Put(distance - kDistBase[di], kDistExtra[di]);
+}
+
+uint32_t Crc32(const uint8_t* data, size_t size) {
+    static uint32_t table[256];
+    static const bool table_ready = [] {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+        return true;
+    }();
+    (void)table_ready;
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void PutLe32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+// 将 data 编码为完整的 gzip 数据 (单个固定 Huffman 块)
+std::vector<uint8_t> GzipEncode(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> out;
+    out.reserve(data.size() / 3 + 64);
+    const uint8_t header[10] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 3}; // deflate, 无附加字段, OS=Unix
+    out.insert(out.end(), header, header + 10);
+
+    BitWriter bw(out);
+    bw.Put(1, 1); // BFINAL
+    bw.Put(1, 2); // BTYPE = 01 固定 Huffman
+
+    const int size = static_cast<int>(data.size());
+    std::vector<int> head(1 << kHashBits, -1);
+    std::vector<int> prev(kWindowSize, -1);
+    auto hash_at = [&data](int pos) {
+        const uint32_t v = (static_cast<uint32_t>(data[pos]) << 16) |
+                           (static_cast<uint32_t>(data[pos + 1]) << 8) | data[pos + 2];
+        return static_cast<int>((v * 2654435761u) >> (32 - kHashBits));
+    };
+    auto insert = [&](int pos) {
+        if (pos + kMinMatch <= size) {
+            const int h = hash_at(pos);
+            prev[pos & (kWindowSize - 1)] = head[h];
+            head[h] = pos;
+        }
+    };
+
+    int pos = 0;
+    while (pos < size) {
+        int best_len = 0;
+        int best_dist = 0;
+        if (pos + kMinMatch <= size) {
+            const int max_len = std::min(kMaxMatch, size - pos);
+            int candidate = head[hash_at(pos)];
+            for (int chain = 0; candidate >= 0 && chain < kMaxChain; ++chain) {
+                const int dist = pos - candidate;
+                if (dist > kWindowSize - 1) {
+                    break;
+                }
+                if (data[candidate + best_len] == data[pos + best_len]) {
+                    int len = 0;
+                    while (len < max_len && data[candidate + len] == data[pos + len]) {
+                        ++len;
+                    }
+                    if (len > best_len) {
+                        best_len = len;
+                        best_dist = dist;
+                        if (len == max_len) {
+                            break;
+                        }
+                    }
+                }
+                const int next = prev[candidate & (kWindowSize - 1)];
+                if (next >= candidate) {
+                    break; // 该槽位已被更新的位置覆盖
+                }
+                candidate = next;
+            }
+        }
+
+        if (best_len >= kMinMatch) {
+            PutMatch(bw, best_len, best_dist);
+            for (int i = 0; i < best_len; ++i) {
+                insert(pos + i);
+            }
+            pos += best_len;
+        } else {
+            PutLiteralLength(bw, data[pos]);
+            insert(pos);
+            ++pos;
+        }
+    }
+    PutLiteralLength(bw, 256); // 块结束
+    bw.Finish();
+
+    PutLe32(out, Crc32(data.data(), data.size()));
+    PutLe32(out, static_cast<uint32_t>(data.size()));
+    return out;
+}
+
+// 拆分路径为目录和文件名
+void SplitPath(const std::string& path, std::string& dir, std::string& name) {
+    const auto slash = path.find_last_of("/\\");
+    if (slash == std::string::npos) {
+        dir = ".";
+        name = path;
+    } else {
+        dir = slash == 0 ? path.substr(0, 1) : path.substr(0, slash);
+        name = path.substr(slash + 1);
+    }
+}
+
+bool EndsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() &&
+           text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// 判断 file 是否为 RotatingFileWriter::NextSegmentPath 生成的分段名：
+// <name>.YYYYMMDD-HHMMSS.NNN，可带 .gz 或 .gz.tmp 后缀。同目录下的 <name>.log、<name>.bak 等文件不属于分段
+bool IsSegmentName(const std::string& file, const std::string& prefix) {
+    if (file.compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    std::string rest = file.substr(prefix.size());
+    if (EndsWith(rest, ".gz.tmp")) {
+        rest.resize(rest.size() - 7);
+    } else if (EndsWith(rest, ".gz")) {
+        rest.resize(rest.size() - 3);
+    }
+    // 时间戳 15 个字符，序号至少 3 位 (同一秒内轮转超过 999 次时变宽)
+    if (rest.size() < 19 || rest[8] != '-' || rest[15] != '.') {
+        return false;
+    }
+    for (size_t i = 0; i < rest.size(); ++i) {
+        if (i != 8 && i != 15 && !std::isdigit(static_cast<unsigned char>(rest[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 列出 basePath 对应的所有分段文件 (完整路径，按名称即时间顺序排序)
+std::vector<std::string> ListSegments(const std::string& base_path) {
+    std::string dir, name;
+    SplitPath(base_path, dir, name);
+    const std::string prefix = name + ".";
+    std::vector<std::string> result;
+#ifdef _WIN32
+    WIN32_FIND_DATAA fd;
+    HANDLE h = FindFirstFileA((dir + "\\" + prefix + "*").c_str(), &fd);
+    if (h != INVALID_HANDLE_VALUE) {
+        do {
+            if (!(fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && IsSegmentName(fd.cFileName, prefix)) {
+                result.push_back(dir + "\\" + fd.cFileName);
+            }
+        } while (FindNextFileA(h, &fd));
+        FindClose(h);
+    }
+#else
+    DIR* d = opendir(dir.c_str());
+    if (d != nullptr) {
+        while (dirent* entry = readdir(d)) {
+            const std::string file = entry->d_name;
+            if (IsSegmentName(file, prefix)) {
+                result.push_back(dir + "/" + file);
+            }
+        }
+        closedir(d);
+    }
+#endif
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+uint64_t FileSize(const std::string& path) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(st.st_size);
+}
+
+// 将调用线程降为最低 CPU 和 I/O 优先级
+void LowerCurrentThreadPriority() {
+#ifdef __linux__
+    sched_param param{};
+    param.sched_priority = 0;
+    pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#ifdef SYS_ioprio_set
+    const int kIoprioWhoProcess = 1;     // who 为 0 时作用于调用线程
+    const int kIoprioClassIdle = 3 << 13;
+    syscall(SYS_ioprio_set, kIoprioWhoProcess, 0, kIoprioClassIdle);
+#endif
+#endif
+}
+
+} // namespace
+
+bool LogCompressor::GzipFile(const std::string& src, const std::string& dst) {
+    std::ifstream in(src, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "LogCompressor Error: Could not open " << src << std::endl;
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    const std::vector<uint8_t> encoded = GzipEncode(data);
+    const std::string tmp = dst + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            std::cerr << "LogCompressor Error: Could not create " << tmp << std::endl;
+            return false;
+        }
+        out.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+        if (!out.good()) {
+            out.close();
+            std::remove(tmp.c_str());
+            std::cerr << "LogCompressor Error: Failed to write " << tmp << std::endl;
+            return false;
+        }
+    }
+#ifdef _WIN32
+    std::remove(dst.c_str()); // Windows 上 rename 不会覆盖已有文件
+#endif
+    if (std::rename(tmp.c_str(), dst.c_str()) != 0) {
+        std::remove(tmp.c_str());
+        std::cerr << "LogCompressor Error: Could not rename " << tmp << " to " << dst << std::endl;
+        return false;
+    }
+    return true;
+}
+
+LogCompressor::LogCompressor(std::string basePath, bool compress, uint64_t maxTotalBytes)
+    : base_path_(std::move(basePath)),
+      compress_(compress),
+      max_total_bytes_(maxTotalBytes) {
+    RecoverPending();
+    worker_ = std::thread(&LogCompressor::Run, this);
+}
+
+LogCompressor::~LogCompressor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void LogCompressor::Submit(const std::string& segmentPath) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(segmentPath);
+    }
+    cv_.notify_one();
+}
+
+void LogCompressor::WaitIdle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] { return (queue_.empty() && !busy_) || stop_; });
+}
+
+void LogCompressor::RecoverPending() {
+    // 构造时后台线程尚未启动，无需加锁
+    for (const auto& path : ListSegments(base_path_)) {
+        if (EndsWith(path, ".tmp")) {
+            std::remove(path.c_str()); // 上次压缩中断留下的临时文件
+        } else if (compress_ && !EndsWith(path, ".gz")) {
+            queue_.push_back(path);
+        }
+    }
+}
+
+void LogCompressor::Run() {
+    LowerCurrentThreadPriority();
+    EnforceQuota();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (stop_) {
+            break;
+        }
+        const std::string segment = queue_.front();
+        queue_.pop_front();
+        busy_ = true;
+        lock.unlock();
+
+        Process(segment);
+        EnforceQuota();
+
+        lock.lock();
+        busy_ = false;
+        if (queue_.empty()) {
+            idle_cv_.notify_all();
+        }
+    }
+    idle_cv_.notify_all();
+}
+
+void LogCompressor::Process(const std::string& segmentPath) {
+    if (!compress_) {
+        return;
+    }
+    struct stat st;
+    if (stat(segmentPath.c_str(), &st) != 0) {
+        return; // 排队期间已被磁盘配额删除
+    }
+    if (GzipFile(segmentPath, segmentPath + ".gz")) {
+        std::remove(segmentPath.c_str());
+    }
+}
+
+void LogCompressor::EnforceQuota() {
+    if (max_total_bytes_ == 0) {
+        return;
+    }
+    const std::vector<std::string> segments = ListSegments(base_path_);
+    std::vector<uint64_t> sizes;
+    uint64_t total = 0;
+    for (const auto& path : segments) {
+        sizes.push_back(FileSize(path));
+        total += sizes.back();
+    }
+    // 从最旧的分段开始删除，直到总大小不超过上限
+    for (size_t i = 0; i < segments.size() && total > max_total_bytes_; ++i) {
+        if (EndsWith(segments[i], ".tmp")) {
+            continue;
+        }
+        if (std::remove(segments[i].c_str()) == 0) {
+            total -= sizes[i];
+        }
+    }
+}
+
+} // namespace Logger
+} // namespace LSX_LIB
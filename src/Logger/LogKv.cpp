@@ -0,0 +1,242 @@
+#include "LogKv.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <sstream>
+#include <thread>
+
+namespace LSX_LIB {
+namespace Logger {
+
+// 提取文件名（不含路径）
+static const char* BaseFileName(const char* filepath) {
+    if (filepath == nullptr) {
+        return "UnknownFile";
+    }
+    const char* base = filepath;
+    for (const char* p = filepath; *p != '\0'; ++p) {
+        if (*p == '/' || *p == '\\') {
+            base = p + 1;
+        }
+    }
+    return base;
+}
+
+// 当前线程 ID 的文本形式，每个线程只格式化一次
+static const std::string& ThreadIdText() {
+    thread_local const std::string text = [] {
+        std::ostringstream oss;
+        oss << std::this_thread::get_id();
+        return oss.str();
+    }();
+    return text;
+}
+
+// 追加 "YYYY-MM-DD HH:MM:SS.mmm"，同一秒内复用已格式化的日期部分
+static void AppendTimestamp(std::string& out) {
+    thread_local std::time_t cached_sec = -1;
+    thread_local char cached_text[24] = {0};
+
+    const auto now = std::chrono::system_clock::now();
+    const std::time_t sec = std::chrono::system_clock::to_time_t(now);
+    if (sec != cached_sec) {
+        std::tm now_tm;
+#ifdef _WIN32
+        localtime_s(&now_tm, &sec);
+#else
+        localtime_r(&sec, &now_tm);
+#endif
+        std::strftime(cached_text, sizeof(cached_text), "%Y-%m-%d %H:%M:%S", &now_tm);
+        cached_sec = sec;
+    }
+    const int ms = static_cast<int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000);
+    out.append(cached_text);
+    const char frac[4] = {'.', static_cast<char>('0' + ms / 100), static_cast<char>('0' + ms / 10 % 10),
+                          static_cast<char>('0' + ms % 10)};
+    out.append(frac, 4);
+}
+
+static const char* LevelText(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG:   return "DEBUG";
+        case LogLevel::INFO:    return "INFO";
+        case LogLevel::WARNING: return "WARNING";
+        case LogLevel::ERROR:   return "ERROR";
+        default:                return "UNKNOWN";
+    }
+}
+
+// logfmt 中需要加引号的值：空值，或包含空白、'='、'"'、控制字符
+static bool LogfmtNeedsQuote(std::string_view value) {
+    if (value.empty()) {
+        return true;
+    }
+    for (char c : value) {
+        if (c == ' ' || c == '=' || c == '"' || static_cast<unsigned char>(c) < 0x20) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 追加转义后的字符串内容 (不含首尾引号)，JSON 与 logfmt 共用同一套转义规则
+static void AppendEscaped(std::string& out, std::string_view value) {
+    static const char kHex[] = "0123456789abcdef";
+    size_t run_begin = 0;
+    for (size_t i = 0; i < value.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out.append(value.data() + run_begin, i - run_begin); // 成段追加无需转义的字符
+        run_begin = i + 1;
+        switch (c) {
+            case '"':  out.append("\\\"", 2); break;
+            case '\\': out.append("\\\\", 2); break;
+            case '\n': out.append("\\n", 2); break;
+            case '\r': out.append("\\r", 2); break;
+            case '\t': out.append("\\t", 2); break;
+            default: {
+                const char esc[6] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF]};
+                out.append(esc, 6);
+            }
+        }
+    }
+    out.append(value.data() + run_begin, value.size() - run_begin);
+}
+
+std::string& KvEncoder::ThreadBuffer() {
+    thread_local std::string buffer;
+    buffer.clear(); // clear 不释放容量，后续编码不再分配
+    return buffer;
+}
+
+void KvEncoder::BeginLine(std::string& out, KvFormat format, LogLevel level,
+                          const char* file, int line, const char* func) {
+    if (format == KvFormat::Json) {
+        out.append("{\"ts\":\"");
+        AppendTimestamp(out);
+        out.append("\",\"level\":\"");
+        out.append(LevelText(level));
+        out.append("\",\"thread\":\"");
+        out.append(ThreadIdText());
+        out.append("\"");
+    } else {
+        out.append("ts=\"");
+        AppendTimestamp(out);
+        out.append("\" level=");
+        out.append(LevelText(level));
+        out.append(" thread=");
+        out.append(ThreadIdText());
+    }
+
+    // src 字段为 "文件名:行号"
+    AppendKey(out, format, "src");
+    const char* base = BaseFileName(file);
+    char line_text[16];
+    const int line_len = std::snprintf(line_text, sizeof(line_text), ":%d", line);
+    if (format == KvFormat::Json) {
+        out.push_back('"');
+        AppendEscaped(out, base);
+        out.append(line_text, static_cast<size_t>(line_len));
+        out.push_back('"');
+    } else {
+        const bool quote = LogfmtNeedsQuote(base);
+        if (quote) {
+            out.push_back('"');
+        }
+        AppendEscaped(out, base);
+        out.append(line_text, static_cast<size_t>(line_len));
+        if (quote) {
+            out.push_back('"');
+        }
+    }
+
+    AppendKey(out, format, "func");
+    AppendString(out, format, func != nullptr ? func : "UnknownFunc");
+}
+
+void KvEncoder::EndLine(std::string& out, KvFormat format) {
+    if (format == KvFormat::Json) {
+        out.push_back('}');
+    }
+}
+
+void KvEncoder::AppendKey(std::string& out, KvFormat format, const char* key) {
+    if (format == KvFormat::Json) {
+        out.append(",\"");
+        AppendEscaped(out, key);
+        out.append("\":");
+    } else {
+        out.push_back(' ');
+        out.append(key);
+        out.push_back('=');
+    }
+}
+
+void KvEncoder::AppendBool(std::string& out, bool value) {
+    if (value) {
+        out.append("true", 4);
+    } else {
+        out.append("false", 5);
+    }
+}
+
+void KvEncoder::AppendUint(std::string& out, uint64_t value) {
+    char digits[20];
+    int n = 0;
+    do {
+        digits[n++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    while (n > 0) {
+        out.push_back(digits[--n]);
+    }
+}
+
+void KvEncoder::AppendInt(std::string& out, int64_t value) {
+    if (value < 0) {
+        out.push_back('-');
+        // 先转为无符号再取反，避免 INT64_MIN 溢出
+        AppendUint(out, 0 - static_cast<uint64_t>(value));
+    } else {
+        AppendUint(out, static_cast<uint64_t>(value));
+    }
+}
+
+void KvEncoder::AppendDouble(std::string& out, KvFormat format, double value) {
+    if (!std::isfinite(value)) {
+        if (format == KvFormat::Json) {
+            out.append("null", 4); // JSON 不支持 NaN/Inf
+        } else {
+            out.append(std::isnan(value) ? "NaN" : (value > 0 ? "+Inf" : "-Inf"));
+        }
+        return;
+    }
+    // 优先使用较短的 15 位有效数字，无法精确还原时再使用 17 位
+    char text[32];
+    int len = std::snprintf(text, sizeof(text), "%.15g", value);
+    if (std::strtod(text, nullptr) != value) {
+        len = std::snprintf(text, sizeof(text), "%.17g", value);
+    }
+    out.append(text, static_cast<size_t>(len));
+}
+
+void KvEncoder::AppendString(std::string& out, KvFormat format, std::string_view value) {
+    const bool quote = format == KvFormat::Json || LogfmtNeedsQuote(value);
+    if (quote) {
+        out.push_back('"');
+    }
+    AppendEscaped(out, value);
+    if (quote) {
+        out.push_back('"');
+    }
+}
+
+} // namespace Logger
+} // namespace LSX_LIB
@@ -0,0 +1,224 @@
+#include "LogMemoryStore.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <sstream>
+
+namespace LSX_LIB {
+namespace Logger {
+
+// 单个存储块：文本区和记录表预先分配，写入方填好记录后再通过 count 发布
+struct LogMemoryStore::Block {
+    std::unique_ptr<char[]> text;
+    std::unique_ptr<Entry[]> entries;
+    size_t textUsed = 0;                          // 仅写入方访问
+    std::atomic<size_t> count{0};                 // 已发布的记录数
+    std::atomic<int64_t> minTimeMs{INT64_MAX};    // 块内最早时间
+    std::atomic<int64_t> maxTimeMs{INT64_MIN};    // 块内最晚时间
+    std::atomic<uint32_t> levelMask{0};           // 块内出现过的级别
+    std::atomic<uint64_t> categoryMask{0};        // 块内出现过的分类
+};
+
+static uint64_t CategoryBit(uint16_t id) {
+    return 1ull << std::min<uint16_t>(id, 63);
+}
+
+LogMemoryStore::LogMemoryStore(size_t capacityBytes, size_t blockBytes)
+    : block_bytes_(std::max<size_t>(blockBytes, 1024)),
+      block_entries_(std::max<size_t>(block_bytes_ / 48, 16)), // 按平均每条 48 字节估算记录表容量
+      max_blocks_(std::max<size_t>(capacityBytes / block_bytes_, 1)) {
+    category_names_.emplace_back(); // 编号 0 表示无分类
+    current_ = NewBlock();
+}
+
+std::shared_ptr<LogMemoryStore::Block> LogMemoryStore::NewBlock() const {
+    auto block = std::make_shared<Block>();
+    block->text.reset(new char[block_bytes_]);
+    block->entries.reset(new Entry[block_entries_]);
+    return block;
+}
+
+uint16_t LogMemoryStore::CategoryId(std::string_view category) {
+    if (category.empty()) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(category_mutex_);
+    auto it = category_ids_.find(category);
+    if (it != category_ids_.end()) {
+        return it->second;
+    }
+    if (category_names_.size() > UINT16_MAX) {
+        return UINT16_MAX; // 分类过多时共用最后一个编号
+    }
+    const auto id = static_cast<uint16_t>(category_names_.size());
+    category_names_.emplace_back(category);
+    category_ids_.emplace(std::string(category), id);
+    return id;
+}
+
+void LogMemoryStore::SealCurrent() {
+    auto fresh = NewBlock(); // 在锁外分配
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+    sealed_.push_back(std::move(current_));
+    current_ = std::move(fresh);
+    // 当前块也占用一个块的内存，已封存的块最多保留 max_blocks_ - 1 个
+    while (!sealed_.empty() && sealed_.size() + 1 > max_blocks_) {
+        sealed_.pop_front(); // 正在被查询的块由查询方的 shared_ptr 保持存活
+    }
+}
+
+void LogMemoryStore::Append(LogLevel level, std::string_view category, std::string_view text) {
+    const int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const size_t length = std::min(text.size(), block_bytes_);
+
+    std::lock_guard<std::mutex> lock(append_mutex_);
+    const uint16_t category_id = CategoryId(category);
+
+    Block* block = current_.get();
+    const size_t index = block->count.load(std::memory_order_relaxed);
+    if (index == block_entries_ || block->textUsed + length > block_bytes_) {
+        SealCurrent();
+        block = current_.get();
+    }
+
+    const size_t slot = block->count.load(std::memory_order_relaxed);
+    std::memcpy(block->text.get() + block->textUsed, text.data(), length);
+    Entry& entry = block->entries[slot];
+    entry.seq = next_seq_.load(std::memory_order_relaxed);
+    entry.timeMs = now_ms;
+    entry.offset = static_cast<uint32_t>(block->textUsed);
+    entry.length = static_cast<uint32_t>(length);
+    entry.categoryId = category_id;
+    entry.level = static_cast<uint8_t>(level);
+    block->textUsed += length;
+
+    if (now_ms < block->minTimeMs.load(std::memory_order_relaxed)) {
+        block->minTimeMs.store(now_ms, std::memory_order_relaxed);
+    }
+    if (now_ms > block->maxTimeMs.load(std::memory_order_relaxed)) {
+        block->maxTimeMs.store(now_ms, std::memory_order_relaxed);
+    }
+    block->levelMask.fetch_or(1u << static_cast<unsigned>(level), std::memory_order_relaxed);
+    block->categoryMask.fetch_or(CategoryBit(category_id), std::memory_order_relaxed);
+
+    // release 发布：查询方 acquire 读到 count 后，之前的记录、文本和索引都已可见
+    block->count.store(slot + 1, std::memory_order_release);
+    next_seq_.store(entry.seq + 1, std::memory_order_release);
+}
+
+std::vector<LogRecordView> LogMemoryStore::Query(const LogQuery& query) const {
+    std::vector<LogRecordView> result;
+    if (query.limit == 0 || query.sinceMs > query.untilMs) {
+        return result;
+    }
+
+    // 解析分类条件，并复制分类名称表用于填充结果
+    std::vector<std::string> names;
+    bool filter_category = false;
+    uint16_t wanted_category = 0;
+    {
+        std::lock_guard<std::mutex> lock(category_mutex_);
+        if (!query.category.empty() && query.category != "-") {
+            auto it = category_ids_.find(query.category);
+            if (it == category_ids_.end()) {
+                return result; // 从未出现过的分类
+            }
+            wanted_category = it->second;
+        }
+        filter_category = !query.category.empty();
+        names = category_names_;
+    }
+
+    uint32_t wanted_levels = 0;
+    for (int level = static_cast<int>(query.minLevel); level <= static_cast<int>(LogLevel::ERROR); ++level) {
+        wanted_levels |= 1u << level;
+    }
+
+    // 只在复制块指针时持锁，扫描过程不影响写入
+    std::vector<std::shared_ptr<Block>> blocks;
+    {
+        std::lock_guard<std::mutex> lock(blocks_mutex_);
+        blocks.assign(sealed_.begin(), sealed_.end());
+        blocks.push_back(current_);
+    }
+
+    // 从最新的块开始向前扫描，收集到 limit 条后停止
+    for (auto it = blocks.rbegin(); it != blocks.rend() && result.size() < query.limit; ++it) {
+        const Block& block = **it;
+        const size_t count = block.count.load(std::memory_order_acquire);
+        if (count == 0 ||
+            block.maxTimeMs.load(std::memory_order_relaxed) < query.sinceMs ||
+            block.minTimeMs.load(std::memory_order_relaxed) > query.untilMs ||
+            (block.levelMask.load(std::memory_order_relaxed) & wanted_levels) == 0 ||
+            (filter_category &&
+             (block.categoryMask.load(std::memory_order_relaxed) & CategoryBit(wanted_category)) == 0)) {
+            continue;
+        }
+
+        for (size_t i = count; i-- > 0 && result.size() < query.limit;) {
+            const Entry& entry = block.entries[i];
+            if (entry.timeMs < query.sinceMs || entry.timeMs > query.untilMs ||
+                (wanted_levels & (1u << entry.level)) == 0 ||
+                (filter_category && entry.categoryId != wanted_category)) {
+                continue;
+            }
+            const std::string_view text(block.text.get() + entry.offset, entry.length);
+            if (!query.contains.empty() && text.find(query.contains) == std::string_view::npos) {
+                continue;
+            }
+            result.push_back(LogRecordView{entry.seq, entry.timeMs, static_cast<LogLevel>(entry.level),
+                                           entry.categoryId < names.size() ? names[entry.categoryId] : std::string(),
+                                           std::string(text)});
+        }
+    }
+
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+// JSON 字符串转义
+static void AppendJsonString(std::ostringstream& oss, const std::string& text) {
+    static const char kHex[] = "0123456789abcdef";
+    oss << '"';
+    for (char c : text) {
+        const unsigned char uc = static_cast<unsigned char>(c);
+        switch (c) {
+            case '"':  oss << "\\\""; break;
+            case '\\': oss << "\\\\"; break;
+            case '\n': oss << "\\n"; break;
+            case '\r': oss << "\\r"; break;
+            case '\t': oss << "\\t"; break;
+            default:
+                if (uc < 0x20) {
+                    oss << "\\u00" << kHex[uc >> 4] << kHex[uc & 0xF];
+                } else {
+                    oss << c;
+                }
+        }
+    }
+    oss << '"';
+}
+
+std::string LogMemoryStore::ToJson(const std::vector<LogRecordView>& records) {
+    std::ostringstream oss;
+    oss << "{\"count\":" << records.size() << ",\"records\":[";
+    for (size_t i = 0; i < records.size(); ++i) {
+        const auto& record = records[i];
+        if (i > 0) {
+            oss << ',';
+        }
+        oss << "{\"seq\":" << record.seq << ",\"ts\":" << record.timeMs
+            << ",\"level\":\"" << LogCategoryRegistry::LevelName(record.level) << "\",\"category\":";
+        AppendJsonString(oss, record.category);
+        oss << ",\"text\":";
+        AppendJsonString(oss, record.text);
+        oss << '}';
+    }
+    oss << "]}";
+    return oss.str();
+}
+
+} // namespace Logger
+} // namespace LSX_LIB
@@ -0,0 +1,157 @@
+#include "LogShedder.h"
+
+#include <sstream>
+
+namespace LSX_LIB {
+namespace Logger {
+
+// 写入耗时滑动平均的平滑系数
+static const double kLatencyAlpha = 0.2;
+
+int64_t LogShedder::NowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void LogShedder::Configure(const SheddingConfig& config) {
+    max_pending_.store(config.maxPendingWriters > 1 ? config.maxPendingWriters : 2, std::memory_order_relaxed);
+    max_latency_us_.store(config.maxWriteLatencyUs > 0 ? config.maxWriteLatencyUs : 1, std::memory_order_relaxed);
+    protect_level_.store(static_cast<int>(config.protectLevel), std::memory_order_relaxed);
+    sample_every_.store(config.sampleEvery > 0 ? config.sampleEvery : 0, std::memory_order_relaxed);
+    recover_ms_.store(config.recoverMs > 0 ? config.recoverMs : 0, std::memory_order_relaxed);
+    enabled_.store(config.enabled, std::memory_order_release);
+    if (!config.enabled) {
+        shedding_.store(false, std::memory_order_relaxed); // 关闭后立即停止丢弃
+    }
+}
+
+SheddingConfig LogShedder::GetConfig() const {
+    SheddingConfig config;
+    config.enabled = enabled_.load(std::memory_order_acquire);
+    config.maxPendingWriters = max_pending_.load(std::memory_order_relaxed);
+    config.maxWriteLatencyUs = max_latency_us_.load(std::memory_order_relaxed);
+    config.protectLevel = static_cast<LogLevel>(protect_level_.load(std::memory_order_relaxed));
+    config.sampleEvery = sample_every_.load(std::memory_order_relaxed);
+    config.recoverMs = recover_ms_.load(std::memory_order_relaxed);
+    return config;
+}
+
+bool LogShedder::ShouldDropSlow(LogLevel level, const LogCategory* category) {
+    if (static_cast<int>(level) >= protect_level_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    // 恢复期已过：放行这条日志，由它的 EndWrite 判断是否结束降载。
+    // 否则 sampleEvery 为 0 且只有低级别日志时，没有任何写入能触发恢复
+    if (NowMs() - last_overload_ms_.load(std::memory_order_relaxed) >= recover_ms_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    const int index = static_cast<int>(level);
+    if (category != nullptr && category->IsLowPriority()) {
+        dropped_low_priority_.fetch_add(1, std::memory_order_relaxed);
+        dropped_[index].fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    const int sample_every = sample_every_.load(std::memory_order_relaxed);
+    if (sample_every > 0) {
+        thread_local uint32_t counter = 0; // 按线程计数，避免在过载时再争用一个共享计数器
+        if (counter++ % static_cast<uint32_t>(sample_every) == 0) {
+            return false;
+        }
+    }
+    dropped_[index].fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool LogShedder::BeginWrite() {
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+std::string LogShedder::EndWrite(bool registered, int64_t write_ns) {
+    if (!registered) {
+        return std::string();
+    }
+    // 包括自己在内的排队写入者数
+    const int pending = pending_.fetch_sub(1, std::memory_order_relaxed);
+    const double write_us = static_cast<double>(write_ns) / 1000.0;
+    double avg = avg_write_us_.load(std::memory_order_relaxed) * (1.0 - kLatencyAlpha) + write_us * kLatencyAlpha;
+    if (shedding_.load(std::memory_order_relaxed) &&
+        NowMs() - last_overload_ms_.load(std::memory_order_relaxed) >= recover_ms_.load(std::memory_order_relaxed)) {
+        // 恢复期已过时放行的探测写入：降载期间几乎没有写入更新平均值，它仍停留在过载时的水平，
+        // 只按 20% 衰减会让探测反复判定为过载。以本次写入的耗时重新开始计算
+        avg = write_us;
+    }
+    avg_write_us_.store(avg, std::memory_order_relaxed);
+
+    if (!enabled_.load(std::memory_order_relaxed)) {
+        return std::string();
+    }
+    const bool overloaded = pending >= max_pending_.load(std::memory_order_relaxed) ||
+                            avg > static_cast<double>(max_latency_us_.load(std::memory_order_relaxed));
+    return UpdateState(overloaded);
+}
+
+std::string LogShedder::Poll() {
+    if (!shedding_.load(std::memory_order_relaxed)) {
+        return std::string();
+    }
+    return UpdateState(false);
+}
+
+std::string LogShedder::UpdateState(bool overloaded) {
+    const int64_t now = NowMs();
+    const bool shedding = shedding_.load(std::memory_order_relaxed);
+
+    if (overloaded) {
+        last_overload_ms_.store(now, std::memory_order_relaxed);
+        if (!shedding) {
+            episode_start_ms_ = now;
+            for (int i = 0; i < 4; ++i) {
+                episode_base_[i] = dropped_[i].load(std::memory_order_relaxed);
+            }
+            episode_base_[4] = dropped_low_priority_.load(std::memory_order_relaxed);
+            episodes_.fetch_add(1, std::memory_order_relaxed);
+            shedding_.store(true, std::memory_order_relaxed);
+        }
+        return std::string();
+    }
+
+    if (!shedding || now - last_overload_ms_.load(std::memory_order_relaxed) < recover_ms_.load(std::memory_order_relaxed)) {
+        return std::string();
+    }
+
+    // 降载结束，生成本次降载的汇总
+    shedding_.store(false, std::memory_order_relaxed);
+    uint64_t by_level[4];
+    uint64_t total = 0;
+    for (int i = 0; i < 4; ++i) {
+        by_level[i] = dropped_[i].load(std::memory_order_relaxed) - episode_base_[i];
+        total += by_level[i];
+    }
+    const uint64_t low_priority = dropped_low_priority_.load(std::memory_order_relaxed) - episode_base_[4];
+
+    std::ostringstream oss;
+    oss << "Log shedding ended: dropped " << total << " records in " << (now - episode_start_ms_) << " ms ("
+        << "DEBUG " << by_level[0] << ", INFO " << by_level[1] << ", WARNING " << by_level[2]
+        << ", ERROR " << by_level[3] << "; low-priority categories " << low_priority << ")";
+    return oss.str();
+}
+
+SheddingStats LogShedder::GetStats() const {
+    SheddingStats stats;
+    stats.shedding = shedding_.load(std::memory_order_relaxed);
+    stats.episodes = episodes_.load(std::memory_order_relaxed);
+    for (int i = 0; i < 4; ++i) {
+        stats.droppedByLevel[i] = dropped_[i].load(std::memory_order_relaxed);
+        stats.droppedTotal += stats.droppedByLevel[i];
+    }
+    stats.droppedLowPriority = dropped_low_priority_.load(std::memory_order_relaxed);
+    stats.avgWriteUs = avg_write_us_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace Logger
+} // namespace LSX_LIB
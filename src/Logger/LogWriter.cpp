@@ -1,5 +1,7 @@
 #include "LogWriter.h"
 #include "LogCommon.h" // 主要为了调试时可能用到的 std::cerr
+#include <cstdio>
+#include <ctime>
 
 namespace LSX_LIB {
 namespace Logger {
@@ -94,5 +96,105 @@ void FileWriter::RotateLogs() {
     file_stream_.flush(); // 在写入所有缓冲行后手动刷新
 }
 
+// --- RotatingFileWriter 实现 ---
+RotatingFileWriter::RotatingFileWriter(const std::string& filepath, int max_lines, bool compress,
+                                       uint64_t max_total_bytes)
+    : filepath_(filepath),
+      max_lines_(max_lines > 0 ? max_lines : 1),
+      compressor_(new LogCompressor(filepath, compress, max_total_bytes)) {
+    OpenFile();
+}
+
+RotatingFileWriter::~RotatingFileWriter() {
+    if (file_stream_.is_open()) {
+        file_stream_.flush();
+        file_stream_.close();
+    }
+    compressor_.reset(); // 等待正在进行的压缩完成
+}
+
+void RotatingFileWriter::OpenFile() {
+    // 统计已有行数，使重启后的活动文件仍按 max_lines 切分
+    line_count_ = 0;
+    {
+        std::ifstream existing(filepath_);
+        std::string line;
+        while (std::getline(existing, line)) {
+            ++line_count_;
+        }
+    }
+    file_stream_.open(filepath_, std::ios::out | std::ios::app);
+    if (!file_stream_.is_open()) {
+        std::cerr << "Error: Could not open log file: " << filepath_ << std::endl;
+    }
+}
+
+std::string RotatingFileWriter::NextSegmentPath() {
+    const std::time_t now = std::time(nullptr);
+    std::tm now_tm;
+#ifdef _WIN32
+    localtime_s(&now_tm, &now);
+#else
+    localtime_r(&now, &now_tm);
+#endif
+    char stamp[32];
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &now_tm);
+
+    // 同一秒内多次轮转时递增序号；序号定宽，保证按文件名排序即按时间排序
+    if (last_stamp_ != stamp) {
+        last_stamp_ = stamp;
+        stamp_seq_ = 0;
+    }
+    while (true) {
+        char suffix[48];
+        std::snprintf(suffix, sizeof(suffix), ".%s.%03d", stamp, stamp_seq_++);
+        const std::string path = filepath_ + suffix;
+        // 跳过已存在的分段 (例如进程在同一秒内重启)
+        if (!std::ifstream(path).good() && !std::ifstream(path + ".gz").good()) {
+            return path;
+        }
+    }
+}
+
+void RotatingFileWriter::Rotate() {
+    file_stream_.close();
+    const std::string segment = NextSegmentPath();
+    if (std::rename(filepath_.c_str(), segment.c_str()) == 0) {
+        compressor_->Submit(segment);
+    } else {
+        std::cerr << "Error: Could not rotate log file " << filepath_ << " to " << segment << std::endl;
+    }
+    file_stream_.open(filepath_, std::ios::out | std::ios::trunc);
+    line_count_ = 0;
+    if (!file_stream_.is_open()) {
+        std::cerr << "Error: Could not reopen log file after rotation: " << filepath_ << std::endl;
+    }
+}
+
+void RotatingFileWriter::Write(const std::string& text) {
+    if (!file_stream_.is_open()) {
+        OpenFile();
+        if (!file_stream_.is_open()) {
+            std::cerr << "Error: Log file " << filepath_ << " is not open. Cannot write log." << std::endl;
+            return;
+        }
+    }
+    if (line_count_ >= max_lines_) {
+        Rotate();
+        if (!file_stream_.is_open()) {
+            return;
+        }
+    }
+    file_stream_ << text << '\n';
+    file_stream_.flush(); // 与 FileWriter 一致，每条日志立即落盘
+    ++line_count_;
+}
+
+void RotatingFileWriter::Flush() {
+    if (file_stream_.is_open()) {
+        file_stream_.flush();
+    }
+}
+
 } // namespace Logger
 } // namespace LSX_LIB
\ No newline at end of file
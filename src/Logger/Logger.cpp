@@ -1,21 +1,27 @@
 #include "Logger.h"
 #include <iostream>
+#include <chrono>
 
 namespace LSX_LIB {
 namespace Logger {
 
 Logger::Logger(const LoggerConfig& config)
     : current_log_level_(config.level),
+      kv_format_(config.kvFormat),
       formatter_(),
       writer_(nullptr), // 初始化为空指针
       config_filepath_(config.filepath),
       config_max_lines_(config.maxLines > 0 ? config.maxLines : 1000), // 确保max_lines有效
+      config_rotate_(config.rotate),
+      config_compress_rotated_(config.compressRotated),
+      config_max_total_bytes_(config.maxTotalBytes),
       current_output_mode_(config.mode) {
     if (config_filepath_.empty() && config.mode == OutputMode::File) {
         std::cerr << "Logger Warning: File output mode selected but no filepath provided. Defaulting to 'app.log'." << std::endl;
         config_filepath_ = "app.log";
     }
     SetOutputMode(config.mode); // 根据初始配置设置输出器
+    shedder_.Configure(config.shedding);
 }
 
 void Logger::Log(LogLevel msg_level,
@@ -28,18 +34,72 @@ void Logger::Log(LogLevel msg_level,
     if (msg_level < current_log_level_.load(std::memory_order_relaxed)) {
         return;
     }
+    // 后端过载时在格式化之前丢弃
+    if (shedder_.ShouldDrop(msg_level, nullptr)) {
+        return;
+    }
+
+    Write(msg_level, std::string_view(), msg, file, line, func);
+}
+
+void Logger::Log(const LogCategory& category,
+                 LogLevel msg_level,
+                 const std::string& msg,
+                 const char* file,
+                 int line,
+                 const char* func) {
+    // 分类日志只受分类级别控制，直接调用 Log 时也要检查一次
+    if (!category.IsEnabled(msg_level) || shedder_.ShouldDrop(msg_level, &category)) {
+        return;
+    }
 
+    Write(msg_level, category.GetName(), "[" + category.GetName() + "] " + msg, file, line, func);
+}
+
+void Logger::Write(LogLevel msg_level,
+                   std::string_view category,
+                   const std::string& msg,
+                   const char* file,
+                   int line,
+                   const char* func) {
     // 2. 格式化日志消息
     std::string formatted_msg = formatter_.Format(msg_level, msg, file, line, func);
 
-    // 3. 输出日志 (线程安全)
+    // 3. 输出日志
+    WriteLine(msg_level, category, formatted_msg);
+}
+
+void Logger::WriteLine(LogLevel msg_level, std::string_view category, const std::string& formatted_msg) {
+    // 在等待输出锁之前登记，排队的线程数是判断过载的依据之一
+    const bool registered = shedder_.BeginWrite();
+    // 输出日志 (线程安全)
     std::lock_guard<std::mutex> lock(writer_mutex_);
+    if (memory_store_) {
+        memory_store_->Append(msg_level, category, formatted_msg);
+    }
+    const auto start = std::chrono::steady_clock::now();
     if (writer_) {
         writer_->Write(formatted_msg);
     } else {
         // 备用输出，例如当 writer_ 意外为空时
         std::cerr << "Logger Error: Log writer is not initialized. Message: " << formatted_msg << std::endl;
     }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    const std::string summary = shedder_.EndWrite(
+        registered, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    if (!summary.empty()) {
+        WriteSummaryLocked(summary);
+    }
+}
+
+void Logger::WriteSummaryLocked(const std::string& summary) {
+    const std::string formatted_msg = formatter_.Format(LogLevel::WARNING, summary, __FILE__, __LINE__, __func__);
+    if (memory_store_) {
+        memory_store_->Append(LogLevel::WARNING, std::string_view(), formatted_msg);
+    }
+    if (writer_) {
+        writer_->Write(formatted_msg);
+    }
 }
 
 void Logger::SetOutputMode(OutputMode mode) {
@@ -67,7 +127,12 @@ void Logger::SetOutputMode(OutputMode mode) {
             std::cerr << "Logger Warning: Switched back to Console output due to empty filepath." << std::endl;
             return;
         }
-        writer_ = std::make_unique<FileWriter>(config_filepath_, config_max_lines_);
+        if (config_rotate_) {
+            writer_ = std::make_unique<RotatingFileWriter>(config_filepath_, config_max_lines_,
+                                                           config_compress_rotated_, config_max_total_bytes_);
+        } else {
+            writer_ = std::make_unique<FileWriter>(config_filepath_, config_max_lines_);
+        }
     }
 }
 
@@ -89,8 +154,34 @@ LogLevel Logger::GetLogLevel() const {
     return current_log_level_.load(std::memory_order_acquire);
 }
 
+void Logger::SetKvFormat(KvFormat format) {
+    kv_format_.store(format, std::memory_order_release);
+}
+
+KvFormat Logger::GetKvFormat() const {
+    return kv_format_.load(std::memory_order_acquire);
+}
+
+void Logger::SetMemoryStore(std::shared_ptr<LogMemoryStore> store) {
+    std::lock_guard<std::mutex> lock(writer_mutex_);
+    memory_store_ = std::move(store);
+}
+
+void Logger::SetShedding(const SheddingConfig& config) {
+    shedder_.Configure(config);
+}
+
+SheddingStats Logger::GetSheddingStats() const {
+    return shedder_.GetStats();
+}
+
 void Logger::Flush() {
     std::lock_guard<std::mutex> lock(writer_mutex_);
+    // 降载结束后若没有新日志写入，由 Flush 负责输出汇总
+    const std::string summary = shedder_.Poll();
+    if (!summary.empty()) {
+        WriteSummaryLocked(summary);
+    }
     if (writer_) {
         writer_->Flush();
     }
@@ -0,0 +1,402 @@
+#include "BlockRecorder.h"
+
+#include <algorithm> // For std::min, std::max
+#include <cerrno> // For errno
+#include <cstdio> // For std::snprintf
+#include <cstdlib> // For posix_memalign, free
+#include <cstring> // For memcpy, memset, strerror
+#include <iostream> // For std::cerr
+#include <stdexcept> // For std::invalid_argument
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace LSX_LIB {
+namespace Memory {
+
+namespace {
+
+// O_DIRECT 要求缓冲区地址、长度和文件偏移按逻辑块对齐；4096 覆盖常见的 512/4K 扇区
+constexpr size_t kDirectIoAlignment = 4096;
+
+constexpr uint64_t AlignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+double ToMilliseconds(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+BlockRecorder::BlockRecorder(const Config& config) : config_(config) {
+    if (config_.buffer_size == 0 || config_.file_size == 0) {
+        throw std::invalid_argument("BlockRecorder: buffer_size and file_size must be greater than 0");
+    }
+    if (config_.buffer_count < 2) {
+        throw std::invalid_argument("BlockRecorder: buffer_count must be at least 2");
+    }
+    config_.buffer_size = static_cast<size_t>(AlignUp(config_.buffer_size, kDirectIoAlignment));
+    config_.file_size = AlignUp(config_.file_size, config_.buffer_size);
+}
+
+BlockRecorder::~BlockRecorder() {
+    Stop();
+}
+
+bool BlockRecorder::Start(FixedSizeQueue& queue) {
+    if (running_) {
+        std::cerr << "BlockRecorder: Start failed. Already recording." << std::endl;
+        return false;
+    }
+
+    buffers_.assign(config_.buffer_count, IoBuffer{});
+    for (IoBuffer& buffer : buffers_) {
+        void* memory = nullptr;
+        if (posix_memalign(&memory, kDirectIoAlignment, config_.buffer_size) != 0) {
+            std::cerr << "BlockRecorder: Failed to allocate " << config_.buffer_count << " buffers of "
+                      << config_.buffer_size << " bytes." << std::endl;
+            release_buffers();
+            return false;
+        }
+        buffer.data = static_cast<uint8_t*>(memory);
+    }
+
+    queue_ = &queue;
+    free_buffers_.clear();
+    full_buffers_.clear();
+    for (size_t i = 0; i < buffers_.size(); ++i) {
+        free_buffers_.push_back(i);
+    }
+    drain_done_ = false;
+    fd_ = -1;
+    file_offset_ = 0;
+    file_payload_ = 0;
+    file_index_ = 0;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_ = Stats{};
+        current_file_.clear();
+        start_time_ = Clock::now();
+        window_start_ = start_time_;
+        window_bytes_ = 0;
+    }
+
+    stop_requested_ = false;
+    running_ = true;
+    writer_thread_ = std::thread(&BlockRecorder::writer_loop, this);
+    drain_thread_ = std::thread(&BlockRecorder::drain_loop, this);
+    return true;
+}
+
+void BlockRecorder::Stop() {
+    if (!running_) {
+        return;
+    }
+    stop_requested_ = true;
+    if (drain_thread_.joinable()) {
+        drain_thread_.join();
+    }
+    if (writer_thread_.joinable()) {
+        writer_thread_.join();
+    }
+    release_buffers();
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.elapsed_s = std::chrono::duration<double>(Clock::now() - start_time_).count();
+        stats_.average_mb_per_s = stats_.elapsed_s > 0.0
+                                      ? static_cast<double>(stats_.bytes_written) / stats_.elapsed_s / 1e6
+                                      : 0.0;
+    }
+    queue_ = nullptr;
+    running_ = false;
+}
+
+bool BlockRecorder::IsRunning() const {
+    return running_;
+}
+
+BlockRecorder::Stats BlockRecorder::GetStats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    Stats snapshot = stats_;
+    if (running_) {
+        const Clock::time_point now = Clock::now();
+        snapshot.elapsed_s = std::chrono::duration<double>(now - start_time_).count();
+        snapshot.average_mb_per_s = snapshot.elapsed_s > 0.0
+                                        ? static_cast<double>(snapshot.bytes_written) / snapshot.elapsed_s / 1e6
+                                        : 0.0;
+        // 写线程空闲时窗口不会结算，这里用当前未结算的窗口修正，避免显示过期的速率
+        const double window_s = std::chrono::duration<double>(now - window_start_).count();
+        if (window_s >= 2.0) {
+            snapshot.recent_mb_per_s = static_cast<double>(window_bytes_) / window_s / 1e6;
+        }
+    }
+    return snapshot;
+}
+
+std::string BlockRecorder::CurrentFile() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    return current_file_;
+}
+
+void BlockRecorder::drain_loop() {
+    const size_t block_size = queue_->BlockSize();
+    std::vector<uint8_t> spill(block_size); // Staging area for blocks that straddle two buffers
+
+    // Take a free buffer, counting the wait as a stall (the writer is behind)
+    auto acquire = [this]() -> size_t {
+        std::unique_lock<std::mutex> lock(buffer_mutex_);
+        if (free_buffers_.empty()) {
+            const Clock::time_point wait_start = Clock::now();
+            cv_free_.wait(lock, [this] { return !free_buffers_.empty(); });
+            const double waited = ToMilliseconds(Clock::now() - wait_start);
+            std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+            stats_.stall_ms += waited;
+            stats_.stall_count++;
+        }
+        const size_t index = free_buffers_.front();
+        free_buffers_.pop_front();
+        buffers_[index].used = 0;
+        return index;
+    };
+    auto submit = [this](size_t index) {
+        {
+            std::lock_guard<std::mutex> lock(buffer_mutex_);
+            full_buffers_.push_back(index);
+        }
+        cv_full_.notify_one();
+    };
+
+    size_t current = acquire();
+    while (true) {
+        // After Stop() keep draining without waiting until the queue is empty
+        const long timeout_ms = stop_requested_ ? 0 : config_.poll_timeout_ms;
+        IoBuffer* buffer = &buffers_[current];
+        const size_t space = config_.buffer_size - buffer->used;
+
+        if (space >= block_size) {
+            // Fast path: dequeue straight into the aligned buffer
+            if (!queue_->GetBlocking(buffer->data + buffer->used, block_size, timeout_ms)) {
+                if (stop_requested_) {
+                    break;
+                }
+                continue;
+            }
+            buffer->used += block_size;
+        } else {
+            if (!queue_->GetBlocking(spill.data(), block_size, timeout_ms)) {
+                if (stop_requested_) {
+                    break;
+                }
+                continue;
+            }
+            size_t copied = 0;
+            while (copied < block_size) {
+                buffer = &buffers_[current];
+                const size_t n = std::min(block_size - copied, config_.buffer_size - buffer->used);
+                std::memcpy(buffer->data + buffer->used, spill.data() + copied, n);
+                buffer->used += n;
+                copied += n;
+                if (buffer->used == config_.buffer_size && copied < block_size) {
+                    submit(current);
+                    current = acquire();
+                }
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.blocks_recorded++;
+        }
+        if (buffers_[current].used == config_.buffer_size) {
+            submit(current);
+            current = acquire();
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(buffer_mutex_);
+        if (buffers_[current].used > 0) {
+            full_buffers_.push_back(current); // Final partial buffer
+        } else {
+            free_buffers_.push_back(current);
+        }
+        drain_done_ = true;
+    }
+    cv_full_.notify_one();
+}
+
+void BlockRecorder::writer_loop() {
+    while (true) {
+        size_t index;
+        {
+            std::unique_lock<std::mutex> lock(buffer_mutex_);
+            cv_full_.wait(lock, [this] { return !full_buffers_.empty() || drain_done_; });
+            if (full_buffers_.empty()) {
+                break; // drain_done_ and nothing left to write
+            }
+            index = full_buffers_.front();
+            full_buffers_.pop_front();
+        }
+        write_buffer(buffers_[index]);
+        {
+            std::lock_guard<std::mutex> lock(buffer_mutex_);
+            free_buffers_.push_back(index);
+        }
+        cv_free_.notify_one();
+    }
+    close_file();
+}
+
+bool BlockRecorder::open_next_file() {
+    char name[32];
+    std::snprintf(name, sizeof(name), "_%06llu.bin", static_cast<unsigned long long>(file_index_));
+    const std::string path = config_.directory + "/" + config_.file_prefix + name;
+
+    int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+    bool direct = false;
+#ifdef O_DIRECT
+    if (config_.direct_io) {
+        flags |= O_DIRECT;
+        direct = true;
+    }
+#endif
+    int fd = ::open(path.c_str(), flags, 0644);
+#ifdef O_DIRECT
+    if (fd < 0 && direct && errno == EINVAL) {
+        // File system without O_DIRECT support (e.g. tmpfs): fall back to buffered writes
+        direct = false;
+        fd = ::open(path.c_str(), flags & ~O_DIRECT, 0644);
+    }
+#endif
+    if (fd < 0) {
+        std::cerr << "BlockRecorder: Failed to create '" << path << "': " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+#ifdef __linux__
+    if (config_.preallocate && ::fallocate(fd, 0, 0, static_cast<off_t>(config_.file_size)) != 0) {
+        std::cerr << "BlockRecorder: fallocate failed for '" << path << "': " << std::strerror(errno)
+                  << ". Continuing without preallocation." << std::endl;
+    }
+#endif
+
+    fd_ = fd;
+    file_offset_ = 0;
+    file_payload_ = 0;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        current_file_ = path;
+        stats_.current_file_index = file_index_;
+        stats_.direct_io_active = direct;
+    }
+    file_index_++;
+    return true;
+}
+
+void BlockRecorder::close_file() {
+    if (fd_ < 0) {
+        return;
+    }
+    // Drop the preallocated tail and any alignment padding of the final buffer
+    if (file_payload_ != config_.file_size && ::ftruncate(fd_, static_cast<off_t>(file_payload_)) != 0) {
+        std::cerr << "BlockRecorder: ftruncate failed: " << std::strerror(errno) << std::endl;
+    }
+    ::close(fd_);
+    fd_ = -1;
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.files_completed++;
+}
+
+bool BlockRecorder::write_buffer(const IoBuffer& buffer) {
+    if (fd_ < 0 || file_offset_ >= config_.file_size) {
+        close_file();
+        if (!open_next_file()) {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.write_errors++;
+            return false;
+        }
+    }
+
+    // Only the final buffer can be partial; pad it so the O_DIRECT write stays aligned
+    const size_t length = static_cast<size_t>(AlignUp(buffer.used, kDirectIoAlignment));
+    if (length != buffer.used) {
+        std::memset(buffer.data + buffer.used, 0, length - buffer.used);
+    }
+
+    const Clock::time_point write_start = Clock::now();
+    size_t written = 0;
+    bool ok = true;
+    while (written < length) {
+        const ssize_t n = ::pwrite(fd_, buffer.data + written, length - written,
+                                   static_cast<off_t>(file_offset_ + written));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+#ifdef O_DIRECT
+            const int fl = ::fcntl(fd_, F_GETFL);
+            if (errno == EINVAL && fl >= 0 && (fl & O_DIRECT) != 0) {
+                // The device rejected the alignment: continue this file with buffered writes
+                ::fcntl(fd_, F_SETFL, fl & ~O_DIRECT);
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                stats_.direct_io_active = false;
+                continue;
+            }
+#endif
+            std::cerr << "BlockRecorder: Write failed: " << std::strerror(errno) << std::endl;
+            ok = false;
+            break;
+        }
+        written += static_cast<size_t>(n);
+    }
+
+#ifdef __linux__
+    bool direct_active;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        direct_active = stats_.direct_io_active;
+    }
+    if (ok && !direct_active) {
+        // Buffered fallback: write the range back now and drop it from the page cache
+        ::sync_file_range(fd_, static_cast<off_t>(file_offset_), static_cast<off_t>(length),
+                          SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+        ::posix_fadvise(fd_, static_cast<off_t>(file_offset_), static_cast<off_t>(length), POSIX_FADV_DONTNEED);
+    }
+#endif
+    const Clock::time_point write_end = Clock::now();
+
+    if (ok) {
+        file_offset_ += length;
+        file_payload_ += buffer.used;
+    }
+    // On failure the offset stays put: the next buffer rewrites this range, so the file never has a hole
+    // and close_file() truncates to the end of the last successful write
+
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    if (!ok) {
+        stats_.write_errors++;
+        return false;
+    }
+    stats_.bytes_written += buffer.used;
+    stats_.max_write_ms = std::max(stats_.max_write_ms, ToMilliseconds(write_end - write_start));
+    window_bytes_ += buffer.used;
+    const double window_s = std::chrono::duration<double>(write_end - window_start_).count();
+    if (window_s >= 1.0) {
+        stats_.recent_mb_per_s = static_cast<double>(window_bytes_) / window_s / 1e6;
+        window_start_ = write_end;
+        window_bytes_ = 0;
+    }
+    return true;
+}
+
+void BlockRecorder::release_buffers() {
+    for (IoBuffer& buffer : buffers_) {
+        std::free(buffer.data);
+        buffer.data = nullptr;
+    }
+    buffers_.clear();
+}
+
+} // namespace Memory
+} // namespace LSX_LIB
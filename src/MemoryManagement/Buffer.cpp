@@ -6,6 +6,7 @@
 #include <iostream>
 #include "LockGuard.h"
 #include "MultiLockGuard.h"
+#include "ByteSearch.h"
 
 
 namespace LSX_LIB::Memory {
@@ -14,7 +15,10 @@ Buffer::Buffer() {
     // std::cout << "Buffer: Created empty buffer." << std::endl; // Use logging
 }
 
-Buffer::Buffer(size_t size) {
+Buffer::Buffer(size_t size) : Buffer(size, nullptr) {
+}
+
+Buffer::Buffer(size_t size, MemoryTag* memory_tag) : data_vector_(TrackingAllocator<uint8_t>(memory_tag)) {
     if (size > 0) {
         try {
             LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
@@ -129,6 +133,71 @@ std::vector<uint8_t> Buffer::ReadAt(size_t offset, size_t size) const {
 }
 
 
+std::optional<size_t> Buffer::FindByte(uint8_t value, size_t offset) const {
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    if (offset >= data_vector_.size()) {
+        return std::nullopt;
+    }
+    const uint8_t* base = data_vector_.data();
+    const uint8_t* hit = ByteSearch::FindByte(base + offset, data_vector_.size() - offset, value);
+    if (hit == nullptr) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(hit - base);
+}
+
+std::optional<size_t> Buffer::FindPattern(const uint8_t* pattern, size_t pattern_size, size_t offset) const {
+    if (pattern == nullptr || pattern_size == 0) {
+        return std::nullopt;
+    }
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    if (offset >= data_vector_.size()) {
+        return std::nullopt;
+    }
+    const uint8_t* base = data_vector_.data();
+    const uint8_t* hit = ByteSearch::FindPattern(base + offset, data_vector_.size() - offset, pattern, pattern_size);
+    if (hit == nullptr) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(hit - base);
+}
+
+std::optional<size_t> Buffer::FindPattern(const std::vector<uint8_t>& pattern, size_t offset) const {
+    return FindPattern(pattern.data(), pattern.size(), offset);
+}
+
+size_t Buffer::ReadUntil(size_t offset, uint8_t delimiter, uint8_t* buffer, size_t size) const {
+    if (buffer == nullptr || size == 0) {
+        return 0;
+    }
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    if (offset >= data_vector_.size()) {
+        return 0;
+    }
+    const uint8_t* src = data_vector_.data() + offset;
+    const uint8_t* hit = ByteSearch::FindByte(src, std::min(size, data_vector_.size() - offset), delimiter);
+    if (hit == nullptr) {
+        return 0;
+    }
+    size_t bytes_to_read = static_cast<size_t>(hit - src) + 1;
+    std::memcpy(buffer, src, bytes_to_read);
+    return bytes_to_read;
+}
+
+std::optional<std::vector<uint8_t>> Buffer::ReadUntil(size_t offset, uint8_t delimiter) const {
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    if (offset >= data_vector_.size()) {
+        return std::nullopt;
+    }
+    const uint8_t* src = data_vector_.data() + offset;
+    const uint8_t* hit = ByteSearch::FindByte(src, data_vector_.size() - offset, delimiter);
+    if (hit == nullptr) {
+        return std::nullopt;
+    }
+    return std::vector<uint8_t>(src, hit + 1);
+}
+
+
 size_t Buffer::GetSize() const {
     LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
     return data_vector_.size();
@@ -0,0 +1,208 @@
+#include "ByteSearch.h"
+
+#include <cstring> // For memchr, memcmp
+
+// 编译期选择指令集：AVX2 > SSE2 > NEON > 标量
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define LSX_BYTE_SEARCH_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LSX_BYTE_SEARCH_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LSX_BYTE_SEARCH_NEON 1
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace LSX_LIB::Memory::ByteSearch {
+
+namespace {
+
+// 返回最低位 1 的位置 (mask 必须非 0)
+inline unsigned CountTrailingZeros(uint64_t mask) {
+#ifdef _MSC_VER
+    unsigned long index = 0;
+    _BitScanForward64(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+// 标量回退：逐个候选位置校验模式 (利用 memchr 跳到首字节)
+const uint8_t* FindPatternScalar(const uint8_t* data, size_t size,
+                                 const uint8_t* pattern, size_t pattern_size) {
+    const uint8_t first = pattern[0];
+    const size_t limit = size - pattern_size + 1; // 候选起始位置数量
+    size_t i = 0;
+    while (i < limit) {
+        const void* hit = std::memchr(data + i, first, limit - i);
+        if (hit == nullptr) {
+            return nullptr;
+        }
+        i = static_cast<size_t>(static_cast<const uint8_t*>(hit) - data);
+        if (std::memcmp(data + i + 1, pattern + 1, pattern_size - 1) == 0) {
+            return data + i;
+        }
+        ++i;
+    }
+    return nullptr;
+}
+
+#if defined(LSX_BYTE_SEARCH_NEON)
+// 将 vceqq_u8 的结果 (每字节 0x00/0xFF) 压缩成 64 位掩码，每个字节占 4 位
+inline uint64_t NeonMovemask(uint8x16_t cmp) {
+    const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+#endif
+
+} // namespace
+
+
+const uint8_t* FindByte(const uint8_t* data, size_t size, uint8_t value) {
+    if (data == nullptr || size == 0) {
+        return nullptr;
+    }
+    size_t i = 0;
+
+#if defined(LSX_BYTE_SEARCH_AVX2)
+    const __m256i needle = _mm256_set1_epi8(static_cast<char>(value));
+    // 每次处理 64 字节：两次比较合并后只做一次分支判断
+    for (; i + 64 <= size; i += 64) {
+        const __m256i a = _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), needle);
+        const __m256i b = _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32)), needle);
+        if (_mm256_movemask_epi8(_mm256_or_si256(a, b)) != 0) {
+            const uint32_t mask_a = static_cast<uint32_t>(_mm256_movemask_epi8(a));
+            if (mask_a != 0) {
+                return data + i + CountTrailingZeros(mask_a);
+            }
+            const uint32_t mask_b = static_cast<uint32_t>(_mm256_movemask_epi8(b));
+            return data + i + 32 + CountTrailingZeros(mask_b);
+        }
+    }
+    for (; i + 32 <= size; i += 32) {
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), needle)));
+        if (mask != 0) {
+            return data + i + CountTrailingZeros(mask);
+        }
+    }
+#elif defined(LSX_BYTE_SEARCH_SSE2)
+    const __m128i needle = _mm_set1_epi8(static_cast<char>(value));
+    for (; i + 16 <= size; i += 16) {
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), needle)));
+        if (mask != 0) {
+            return data + i + CountTrailingZeros(mask);
+        }
+    }
+#elif defined(LSX_BYTE_SEARCH_NEON)
+    const uint8x16_t needle = vdupq_n_u8(value);
+    for (; i + 16 <= size; i += 16) {
+        const uint64_t mask = NeonMovemask(vceqq_u8(vld1q_u8(data + i), needle));
+        if (mask != 0) {
+            return data + i + (CountTrailingZeros(mask) >> 2);
+        }
+    }
+#endif
+
+    // 尾部 (或无 SIMD 时的全部数据)
+    if (i < size) {
+        return static_cast<const uint8_t*>(std::memchr(data + i, value, size - i));
+    }
+    return nullptr;
+}
+
+
+const uint8_t* FindPattern(const uint8_t* data, size_t size,
+                           const uint8_t* pattern, size_t pattern_size) {
+    if (data == nullptr || pattern == nullptr || pattern_size == 0 || pattern_size > size) {
+        return nullptr;
+    }
+    if (pattern_size == 1) {
+        return FindByte(data, size, pattern[0]);
+    }
+
+    // 首尾字节过滤：只有 data[i] == pattern[0] 且 data[i + m - 1] == pattern[m - 1] 的位置才用 memcmp 校验
+    const size_t last_offset = pattern_size - 1;
+    const size_t limit = size - last_offset; // 候选起始位置数量
+    size_t i = 0;
+
+#if defined(LSX_BYTE_SEARCH_AVX2)
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(pattern[0]));
+    const __m256i last = _mm256_set1_epi8(static_cast<char>(pattern[last_offset]));
+    for (; i + 32 <= limit; i += 32) {
+        const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + last_offset));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(
+            _mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last))));
+        while (mask != 0) {
+            const size_t pos = i + CountTrailingZeros(mask);
+            if (std::memcmp(data + pos + 1, pattern + 1, pattern_size - 2) == 0) {
+                return data + pos;
+            }
+            mask &= mask - 1; // 清除最低位
+        }
+    }
+#elif defined(LSX_BYTE_SEARCH_SSE2)
+    const __m128i first = _mm_set1_epi8(static_cast<char>(pattern[0]));
+    const __m128i last = _mm_set1_epi8(static_cast<char>(pattern[last_offset]));
+    for (; i + 16 <= limit; i += 16) {
+        const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + last_offset));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+            _mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last))));
+        while (mask != 0) {
+            const size_t pos = i + CountTrailingZeros(mask);
+            if (std::memcmp(data + pos + 1, pattern + 1, pattern_size - 2) == 0) {
+                return data + pos;
+            }
+            mask &= mask - 1;
+        }
+    }
+#elif defined(LSX_BYTE_SEARCH_NEON)
+    const uint8x16_t first = vdupq_n_u8(pattern[0]);
+    const uint8x16_t last = vdupq_n_u8(pattern[last_offset]);
+    for (; i + 16 <= limit; i += 16) {
+        const uint8x16_t eq = vandq_u8(vceqq_u8(vld1q_u8(data + i), first),
+                                       vceqq_u8(vld1q_u8(data + i + last_offset), last));
+        uint64_t mask = NeonMovemask(eq);
+        while (mask != 0) {
+            const unsigned lane = CountTrailingZeros(mask) >> 2;
+            const size_t pos = i + lane;
+            if (std::memcmp(data + pos + 1, pattern + 1, pattern_size - 2) == 0) {
+                return data + pos;
+            }
+            mask &= ~(static_cast<uint64_t>(0xF) << (lane * 4)); // 清除该字节对应的 4 位
+        }
+    }
+#endif
+
+    if (i < limit) {
+        // 剩余候选位置：在 [i, size) 上做标量查找，保证不越界
+        return FindPatternScalar(data + i, size - i, pattern, pattern_size);
+    }
+    return nullptr;
+}
+
+
+const char* ActiveInstructionSet() {
+#if defined(LSX_BYTE_SEARCH_AVX2)
+    return "AVX2";
+#elif defined(LSX_BYTE_SEARCH_SSE2)
+    return "SSE2";
+#elif defined(LSX_BYTE_SEARCH_NEON)
+    return "NEON";
+#else
+    return "Scalar";
+#endif
+}
+
+} // namespace LSX_LIB::Memory::ByteSearch
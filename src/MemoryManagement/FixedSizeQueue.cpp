@@ -71,6 +71,7 @@ namespace LSX_LIB
             head_ = 0;
             tail_ = 0;
             current_size_ = 0;
+            notifier_.Reset();
             // std::cout << "FixedSizeQueue: Cleared." << std::endl;
             cv_write_.notify_all();
             cv_read_.notify_all();
@@ -98,6 +99,7 @@ namespace LSX_LIB
 
             tail_ = (tail_ + 1) % block_count_; // Move tail circularly
             current_size_++;
+            notifier_.Signal(); // No syscall unless the queue was empty
 
             // std::cout << "FixedSizeQueue: Put block. New tail: " << tail_ << ", New size: " << current_size_ << std::endl;
             cv_read_.notify_one();
@@ -132,6 +134,10 @@ namespace LSX_LIB
 
             head_ = (head_ + 1) % block_count_; // Move head circularly
             current_size_--;
+            if (current_size_ == 0)
+            {
+                notifier_.Reset(); // Drained: descriptor no longer readable
+            }
 
             // std::cout << "FixedSizeQueue: Got block. New head: " << head_ << ", New size: " << current_size_ << std::endl;
             cv_write_.notify_one();
@@ -154,6 +160,10 @@ namespace LSX_LIB
 
             head_ = (head_ + 1) % block_count_;
             current_size_--;
+            if (current_size_ == 0)
+            {
+                notifier_.Reset(); // Drained: descriptor no longer readable
+            }
 
             // std::cout << "FixedSizeQueue: Got block (vector). New head: " << head_ << ", New size: " << current_size_ << std::endl;
             cv_write_.notify_one();
@@ -251,6 +261,10 @@ namespace LSX_LIB
 
             head_ = (head_ + 1) % block_count_;
             current_size_--;
+            if (current_size_ == 0)
+            {
+                notifier_.Reset(); // Drained: descriptor no longer readable
+            }
 
             // std::cout << "FixedSizeQueue: GetBlocking got block. New head: " << head_ << ", New size: " << current_size_ << std::endl;
             lock.unlock(); // Unlock before notifying to avoid lock contention
@@ -298,6 +312,10 @@ namespace LSX_LIB
 
             head_ = (head_ + 1) % block_count_;
             current_size_--;
+            if (current_size_ == 0)
+            {
+                notifier_.Reset(); // Drained: descriptor no longer readable
+            }
 
             // std::cout << "FixedSizeQueue: GetBlocking got block (vector). New head: " << head_ << ", New size: " << current_size_ << std::endl;
             lock.unlock();
@@ -349,6 +367,7 @@ namespace LSX_LIB
 
             tail_ = (tail_ + 1) % block_count_;
             current_size_++;
+            notifier_.Signal(); // No syscall unless the queue was empty
 
             // std::cout << "FixedSizeQueue: PutBlocking put block. New tail: " << tail_ << ", New size: " << current_size_ << std::endl;
             lock.unlock();
@@ -387,5 +406,27 @@ namespace LSX_LIB
             LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
             return current_size_;
         }
+
+
+        // --- Event Loop Integration ---
+        bool FixedSizeQueue::EnableNotification()
+        {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+            if (!notifier_.Enable())
+            {
+                return false;
+            }
+            if (current_size_ != 0)
+            {
+                notifier_.Signal(); // Blocks queued before enabling must still wake the poller
+            }
+            return true;
+        }
+
+        int FixedSizeQueue::NativeHandle() const
+        {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+            return notifier_.NativeHandle();
+        }
     } // namespace Memory
 } // namespace LSX_LIB
@@ -0,0 +1,358 @@
+#include "MappedFile.h"
+
+#include <algorithm> // For std::min, std::max
+#include <cerrno> // For errno
+#include <cstring> // For memcpy, strerror
+#include <iostream> // For std::cerr
+#include "LockGuard.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace LSX_LIB {
+namespace Memory {
+
+namespace {
+
+// 可增长模式下映射容量的最小扩展步长
+constexpr size_t kMinGrowSize = 64 * 1024;
+
+#ifndef _WIN32
+size_t PageSize() {
+    static const size_t page_size = [] {
+        const long size = sysconf(_SC_PAGESIZE);
+        return size > 0 ? static_cast<size_t>(size) : static_cast<size_t>(4096);
+    }();
+    return page_size;
+}
+
+int ToMadvise(MappedFile::Advice advice) {
+    switch (advice) {
+        case MappedFile::Advice::Sequential: return MADV_SEQUENTIAL;
+        case MappedFile::Advice::Random: return MADV_RANDOM;
+        case MappedFile::Advice::WillNeed: return MADV_WILLNEED;
+        case MappedFile::Advice::DontNeed: return MADV_DONTNEED;
+        case MappedFile::Advice::HugePage:
+#ifdef MADV_HUGEPAGE
+            return MADV_HUGEPAGE;
+#else
+            return -1; // Not supported on this platform
+#endif
+        case MappedFile::Advice::Normal:
+        default: return MADV_NORMAL;
+    }
+}
+#endif
+
+} // namespace
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+bool MappedFile::Open(const std::string& path, Mode mode, size_t initial_size) {
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    if (fd_ >= 0) {
+        std::cerr << "MappedFile: Open failed. Already managing '" << path_ << "'. Close first." << std::endl;
+        return false;
+    }
+#ifdef _WIN32
+    (void)mode;
+    (void)initial_size;
+    std::cerr << "MappedFile: Open failed for '" << path << "'. Not supported on this platform." << std::endl;
+    return false;
+#else
+    const bool writable = mode != Mode::ReadOnly;
+    const int flags = writable ? (O_RDWR | O_CREAT | O_CLOEXEC) : (O_RDONLY | O_CLOEXEC);
+    const int fd = ::open(path.c_str(), flags, 0644);
+    if (fd < 0) {
+        std::cerr << "MappedFile: Failed to open '" << path << "': " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        std::cerr << "MappedFile: fstat failed for '" << path << "': " << std::strerror(errno) << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    fd_ = fd;
+    mode_ = mode;
+    path_ = path;
+    base_ = nullptr;
+    size_ = 0;
+    mapped_size_ = 0;
+
+    const size_t file_size = static_cast<size_t>(st.st_size);
+    const size_t target_size = writable ? std::max(file_size, initial_size) : file_size;
+    if (target_size > 0) {
+        if (!remap_unsafe(target_size, target_size)) {
+            close_unsafe();
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+void MappedFile::Close() {
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    close_unsafe();
+}
+
+bool MappedFile::Resize(size_t new_size) {
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    if (fd_ < 0 || mode_ == Mode::ReadOnly) {
+        std::cerr << "MappedFile: Resize failed. File not open for writing." << std::endl;
+        return false;
+    }
+    return remap_unsafe(new_size, new_size);
+}
+
+bool MappedFile::Advise(Advice advice) {
+    return Advise(0, static_cast<size_t>(-1), advice);
+}
+
+bool MappedFile::Advise(size_t offset, size_t length, Advice advice) {
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+#ifdef _WIN32
+    (void)offset; (void)length; (void)advice;
+    return false;
+#else
+    const int native = ToMadvise(advice);
+    if (native < 0) {
+        return false;
+    }
+    size_t aligned_length = 0;
+    uint8_t* start = page_range_unsafe(offset, length, aligned_length);
+    if (start == nullptr) {
+        return false;
+    }
+    return ::madvise(start, aligned_length, native) == 0;
+#endif
+}
+
+bool MappedFile::Prefetch(size_t offset, size_t length) {
+    return Advise(offset, length, Advice::WillNeed);
+}
+
+bool MappedFile::Flush(size_t offset, size_t length, bool async) {
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    if (mode_ == Mode::ReadOnly) {
+        return false;
+    }
+#ifdef _WIN32
+    (void)offset; (void)length; (void)async;
+    return false;
+#else
+    size_t aligned_length = 0;
+    uint8_t* start = page_range_unsafe(offset, length, aligned_length);
+    if (start == nullptr) {
+        return fd_ >= 0 && size_ == 0; // Nothing to flush for an empty file
+    }
+    if (::msync(start, aligned_length, async ? MS_ASYNC : MS_SYNC) != 0) {
+        std::cerr << "MappedFile: msync failed for '" << path_ << "': " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+#endif
+}
+
+bool MappedFile::Flush(bool async) {
+    return Flush(0, static_cast<size_t>(-1), async);
+}
+
+const uint8_t* MappedFile::Data() const {
+    return base_;
+}
+
+uint8_t* MappedFile::MutableData() {
+    return mode_ == Mode::ReadOnly ? nullptr : base_;
+}
+
+MappedFile::Span MappedFile::Range(size_t offset, size_t length) const {
+    if (base_ == nullptr || offset >= size_) {
+        return Span{};
+    }
+    return Span{base_ + offset, std::min(length, size_ - offset)};
+}
+
+std::string_view MappedFile::View(size_t offset, size_t length) const {
+    const Span span = Range(offset, length);
+    if (span.empty()) {
+        return std::string_view();
+    }
+    return std::string_view(reinterpret_cast<const char*>(span.data), span.size);
+}
+
+size_t MappedFile::Read(size_t offset, uint8_t* buffer, size_t size) const {
+    if (buffer == nullptr || size == 0) {
+        return 0;
+    }
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    if (base_ == nullptr || offset >= size_) {
+        return 0;
+    }
+    const size_t count = std::min(size, size_ - offset);
+    std::memcpy(buffer, base_ + offset, count);
+    return count;
+}
+
+std::vector<uint8_t> MappedFile::Read(size_t offset, size_t size) const {
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    if (base_ == nullptr || offset >= size_) {
+        return {};
+    }
+    const size_t count = std::min(size, size_ - offset);
+    return std::vector<uint8_t>(base_ + offset, base_ + offset + count);
+}
+
+size_t MappedFile::Write(size_t offset, const uint8_t* data, size_t size) {
+    if (data == nullptr || size == 0) {
+        return 0;
+    }
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    if (fd_ < 0 || mode_ == Mode::ReadOnly) {
+        std::cerr << "MappedFile: Write failed. File not open for writing." << std::endl;
+        return 0;
+    }
+    if (offset > static_cast<size_t>(-1) - size) {
+        return 0; // Overflow
+    }
+    const size_t required = offset + size;
+    if (required > size_) {
+        if (mode_ != Mode::ReadWriteGrowable) {
+            std::cerr << "MappedFile: Write failed. Range [" << offset << ", " << required
+                      << ") exceeds file size " << size_ << "." << std::endl;
+            return 0;
+        }
+        if (required > mapped_size_) {
+            // Grow capacity geometrically so appends stay amortised O(1)
+            const size_t new_mapped = std::max({required, mapped_size_ * 2, kMinGrowSize});
+            if (!remap_unsafe(size_, new_mapped)) {
+                return 0;
+            }
+        }
+        size_ = required;
+    }
+    std::memcpy(base_ + offset, data, size);
+    return size;
+}
+
+size_t MappedFile::Write(size_t offset, const std::vector<uint8_t>& data) {
+    return Write(offset, data.data(), data.size());
+}
+
+bool MappedFile::IsOpen() const {
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    return fd_ >= 0;
+}
+
+bool MappedFile::IsWritable() const {
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    return fd_ >= 0 && mode_ != Mode::ReadOnly;
+}
+
+size_t MappedFile::Size() const {
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    return size_;
+}
+
+std::string MappedFile::Path() const {
+    LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+    return path_;
+}
+
+void MappedFile::close_unsafe() {
+#ifndef _WIN32
+    if (base_ != nullptr) {
+        if (mode_ != Mode::ReadOnly && size_ > 0) {
+            ::msync(base_, size_, MS_SYNC);
+        }
+        ::munmap(base_, mapped_size_);
+    }
+    if (fd_ >= 0) {
+        // Drop the growable reserve so the file ends at the last written byte
+        if (mode_ == Mode::ReadWriteGrowable && mapped_size_ != size_) {
+            if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+                std::cerr << "MappedFile: ftruncate failed for '" << path_ << "': " << std::strerror(errno) << std::endl;
+            }
+        }
+        ::close(fd_);
+    }
+#endif
+    fd_ = -1;
+    base_ = nullptr;
+    size_ = 0;
+    mapped_size_ = 0;
+    path_.clear();
+    mode_ = Mode::ReadOnly;
+}
+
+bool MappedFile::remap_unsafe(size_t new_size, size_t new_mapped) {
+#ifdef _WIN32
+    (void)new_size; (void)new_mapped;
+    return false;
+#else
+    const bool writable = mode_ != Mode::ReadOnly;
+    if (writable && new_mapped != mapped_size_) {
+        if (::ftruncate(fd_, static_cast<off_t>(new_mapped)) != 0) {
+            std::cerr << "MappedFile: ftruncate failed for '" << path_ << "': " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+
+    void* mapped = nullptr;
+    if (new_mapped == 0) {
+        if (base_ != nullptr) {
+            ::munmap(base_, mapped_size_);
+        }
+    } else if (base_ == nullptr) {
+        const int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        mapped = ::mmap(nullptr, new_mapped, prot, MAP_SHARED, fd_, 0);
+    } else if (new_mapped == mapped_size_) {
+        mapped = base_;
+    } else {
+#ifdef MREMAP_MAYMOVE
+        mapped = ::mremap(base_, mapped_size_, new_mapped, MREMAP_MAYMOVE);
+#else
+        ::munmap(base_, mapped_size_);
+        base_ = nullptr;
+        const int prot = writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+        mapped = ::mmap(nullptr, new_mapped, prot, MAP_SHARED, fd_, 0);
+#endif
+    }
+    if (mapped == MAP_FAILED) {
+        std::cerr << "MappedFile: Memory mapping failed for '" << path_ << "': " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    base_ = static_cast<uint8_t*>(mapped);
+    size_ = new_size;
+    mapped_size_ = new_mapped;
+    return true;
+#endif
+}
+
+uint8_t* MappedFile::page_range_unsafe(size_t offset, size_t length, size_t& aligned_length) const {
+    aligned_length = 0;
+#ifdef _WIN32
+    (void)offset; (void)length;
+    return nullptr;
+#else
+    if (base_ == nullptr || offset >= size_ || length == 0) {
+        return nullptr;
+    }
+    const size_t end = offset + std::min(length, size_ - offset);
+    const size_t start = offset & ~(PageSize() - 1);
+    aligned_length = end - start;
+    return base_ + start;
+#endif
+}
+
+} // namespace Memory
+} // namespace LSX_LIB
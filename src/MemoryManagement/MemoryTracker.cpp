@@ -0,0 +1,113 @@
+#include "MemoryTracker.h"
+
+#include <algorithm> // For std::sort
+#include <cstdio> // For std::snprintf
+#include <sstream> // For DumpString
+
+namespace LSX_LIB {
+namespace Memory {
+
+namespace {
+
+// 以 B/KiB/MiB/GiB 为单位格式化字节数
+std::string FormatBytes(double bytes) {
+    static const char* const kUnits[] = {"B", "KiB", "MiB", "GiB", "TiB"};
+    size_t unit = 0;
+    while (bytes >= 1024.0 && unit + 1 < sizeof(kUnits) / sizeof(kUnits[0])) {
+        bytes /= 1024.0;
+        ++unit;
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), unit == 0 ? "%.0f %s" : "%.1f %s", bytes, kUnits[unit]);
+    return text;
+}
+
+} // namespace
+
+MemoryTracker& MemoryTracker::Instance() {
+    // Intentionally leaked: containers with static storage duration may free memory after main() returns
+    static MemoryTracker* instance = new MemoryTracker();
+    return *instance;
+}
+
+MemoryTag* MemoryTracker::Tag(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_ptr<MemoryTag>& tag = tags_[name];
+    if (!tag) {
+        tag.reset(new MemoryTag(name));
+        rate_bases_[name].time = std::chrono::steady_clock::now();
+    }
+    return tag.get();
+}
+
+std::vector<MemoryTracker::TagStats> MemoryTracker::Snapshot() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::vector<TagStats> result;
+    result.reserve(tags_.size());
+    for (const auto& entry : tags_) {
+        const MemoryTag& tag = *entry.second;
+        TagStats stats;
+        stats.name = entry.first;
+        stats.live_bytes = tag.LiveBytes();
+        stats.peak_bytes = tag.PeakBytes();
+        stats.total_allocated_bytes = tag.TotalAllocatedBytes();
+        stats.allocation_count = tag.AllocationCount();
+        stats.deallocation_count = tag.DeallocationCount();
+
+        RateBase& base = rate_bases_[entry.first];
+        const double elapsed_s = std::chrono::duration<double>(now - base.time).count();
+        if (elapsed_s > 0.0) {
+            stats.allocations_per_s = static_cast<double>(stats.allocation_count - base.allocations) / elapsed_s;
+            stats.bytes_per_s = static_cast<double>(stats.total_allocated_bytes - base.bytes) / elapsed_s;
+        }
+        base.allocations = stats.allocation_count;
+        base.bytes = stats.total_allocated_bytes;
+        base.time = now;
+
+        result.push_back(std::move(stats));
+    }
+    return result;
+}
+
+void MemoryTracker::Dump(std::ostream& os) {
+    std::vector<TagStats> snapshot = Snapshot();
+    std::sort(snapshot.begin(), snapshot.end(),
+              [](const TagStats& a, const TagStats& b) { return a.live_bytes > b.live_bytes; });
+
+    uint64_t total_live = 0;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-32s %12s %12s %12s %12s %12s %12s %12s\n",
+                  "tag", "live", "peak", "allocated", "allocs", "frees", "alloc/s", "bytes/s");
+    os << line;
+    for (const TagStats& stats : snapshot) {
+        total_live += stats.live_bytes;
+        std::snprintf(line, sizeof(line), "%-32s %12s %12s %12s %12llu %12llu %12.0f %12s\n",
+                      stats.name.c_str(),
+                      FormatBytes(static_cast<double>(stats.live_bytes)).c_str(),
+                      FormatBytes(static_cast<double>(stats.peak_bytes)).c_str(),
+                      FormatBytes(static_cast<double>(stats.total_allocated_bytes)).c_str(),
+                      static_cast<unsigned long long>(stats.allocation_count),
+                      static_cast<unsigned long long>(stats.deallocation_count),
+                      stats.allocations_per_s,
+                      FormatBytes(stats.bytes_per_s).c_str());
+        os << line;
+    }
+    os << "total live: " << FormatBytes(static_cast<double>(total_live)) << " in " << snapshot.size() << " tags\n";
+}
+
+std::string MemoryTracker::DumpString() {
+    std::ostringstream os;
+    Dump(os);
+    return os.str();
+}
+
+void MemoryTracker::ResetPeaks() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& entry : tags_) {
+        entry.second->ResetPeak();
+    }
+}
+
+} // namespace Memory
+} // namespace LSX_LIB
@@ -7,25 +7,75 @@
 #include <condition_variable> // For std::condition_variable
 #include <chrono> // For std::chrono::milliseconds
 // #include <iostream>  // For example output - prefer logging
+#include <cstring> // For memcpy, memmove
 #include "LockGuard.h"
 #include "MultiLockGuard.h"
+#include "ByteSearch.h"
 
 namespace LSX_LIB {
     namespace Memory {
 
+        // 已读部分至少达到该字节数才进行压缩，避免小数据量时频繁 memmove
+        static constexpr size_t kPipeCompactThreshold = 4096;
+
         Pipe::Pipe() {
             // Constructor implementation (if needed beyond default)
             // std::cout << "Pipe: Created." << std::endl; // Use logging
         }
 
+        Pipe::Pipe(MemoryTag *memory_tag) : byte_stream_(TrackingAllocator<uint8_t>(memory_tag)) {
+        }
+
         Pipe::~Pipe() {
             // Destructor implementation (if needed beyond default)
             // std::cout << "Pipe: Destroyed." << std::endl; // Use logging
         }
 
+        void Pipe::consume_unsafe(uint8_t *buffer, size_t count) {
+            if (buffer != nullptr && count > 0) {
+                std::memcpy(buffer, data_unsafe(), count);
+            }
+            read_pos_ += count;
+            consumed_total_ += count;
+            compact_unsafe();
+            if (size_unsafe() == 0) {
+                notifier_.Reset(); // Drained: descriptor no longer readable
+            }
+        }
+
+        void Pipe::compact_unsafe() {
+            if (read_pos_ == byte_stream_.size()) {
+                // 全部读完：直接复位，保留已分配的容量
+                byte_stream_.clear();
+                read_pos_ = 0;
+            } else if (read_pos_ >= kPipeCompactThreshold && read_pos_ * 2 >= byte_stream_.size()) {
+                // 已读部分超过一半：把剩余数据移到头部
+                byte_stream_.erase(byte_stream_.begin(), byte_stream_.begin() + static_cast<std::ptrdiff_t>(read_pos_));
+                read_pos_ = 0;
+            }
+        }
+
+        std::optional<size_t> Pipe::find_unsafe(const uint8_t *pattern, size_t pattern_size, size_t start) const {
+            const size_t available = size_unsafe();
+            if (pattern == nullptr || pattern_size == 0 || start >= available) {
+                return std::nullopt;
+            }
+            const uint8_t* base = data_unsafe();
+            const uint8_t* hit = (pattern_size == 1)
+                                 ? ByteSearch::FindByte(base + start, available - start, pattern[0])
+                                 : ByteSearch::FindPattern(base + start, available - start, pattern, pattern_size);
+            if (hit == nullptr) {
+                return std::nullopt;
+            }
+            return static_cast<size_t>(hit - base);
+        }
+
         void Pipe::Clear() {
             LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);// Thread safe clear
-            byte_stream_.clear(); // std::deque::clear()
+            consumed_total_ += size_unsafe();
+            byte_stream_.clear();
+            read_pos_ = 0;
+            notifier_.Reset();
             // std::cout << "Pipe: Cleared." << std::endl; // Use logging
             // cv_write_.notify_all(); // Notify potential waiting writers (if bounded pipe)
             cv_read_.notify_all(); // Notify potential waiting readers (they will read 0 bytes)
@@ -43,9 +93,8 @@ namespace LSX_LIB {
 
             size_t bytes_to_write = size; // In unbounded pipe, write all
 
-            for (size_t i = 0; i < bytes_to_write; ++i) {
-                byte_stream_.push_back(data[i]);
-            }
+            byte_stream_.insert(byte_stream_.end(), data, data + bytes_to_write);
+            notifier_.Signal(); // No syscall unless the pipe was empty
             // std::cout << "Pipe: Wrote " << bytes_to_write << " bytes." << std::endl; // Use logging
 
             cv_read_.notify_all(); // Notify readers (all waiting readers might be able to read now)
@@ -66,12 +115,9 @@ namespace LSX_LIB {
 
             // Optional: check and wait if pipe is empty (for blocking read, handled in ReadBlocking)
 
-            size_t bytes_to_read = std::min(size, byte_stream_.size());
+            size_t bytes_to_read = std::min(size, size_unsafe());
 
-            for (size_t i = 0; i < bytes_to_read; ++i) {
-                buffer[i] = byte_stream_.front();
-                byte_stream_.pop_front();
-            }
+            consume_unsafe(buffer, bytes_to_read);
             // std::cout << "Pipe: Read " << bytes_to_read << " bytes." << std::endl; // Use logging
 
             // cv_write_.notify_all(); // Notify writers (if bounded pipe and space was freed)
@@ -92,10 +138,10 @@ namespace LSX_LIB {
             }
             LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);// Thread safe peek
 
-            size_t bytes_to_peek = std::min(size, byte_stream_.size());
+            size_t bytes_to_peek = std::min(size, size_unsafe());
 
-            for (size_t i = 0; i < bytes_to_peek; ++i) {
-                buffer[i] = byte_stream_[i]; // Access directly
+            if (bytes_to_peek > 0) {
+                std::memcpy(buffer, data_unsafe(), bytes_to_peek);
             }
             // std::cout << "Pipe: Peeked " << bytes_to_peek << " bytes." << std::endl; // Use logging
             return bytes_to_peek;
@@ -116,35 +162,32 @@ namespace LSX_LIB {
             }
             std::unique_lock<std::mutex> lock(mutex_); // Use unique_lock for condition variables
 
-            if (byte_stream_.empty()) {
+            if (size_unsafe() == 0) {
                 if (timeout_ms == 0) { // Non-blocking mode
                     // std::cout << "Pipe: ReadBlocking (non-blocking) empty." << std::endl; // Use logging
                     return 0;
                 } else if (timeout_ms > 0) { // Timed wait
                     auto duration = std::chrono::milliseconds(timeout_ms);
                     // wait_for returns false if the timeout elapsed without notification
-                    if (!cv_read_.wait_for(lock, duration, [&] { return !byte_stream_.empty(); })) {
+                    if (!cv_read_.wait_for(lock, duration, [&] { return size_unsafe() != 0; })) {
                         // std::cout << "Pipe: ReadBlocking timed out." << std::endl; // Use logging
                         return 0; // Timeout
                     }
                 } else { // Infinite wait
                     // std::cout << "Pipe: ReadBlocking waiting indefinitely." << std::endl; // Use logging
-                    cv_read_.wait(lock, [&] { return !byte_stream_.empty(); }); // Wait until not empty
+                    cv_read_.wait(lock, [&] { return size_unsafe() != 0; }); // Wait until not empty
                 }
                 // If we reached here, the queue is not empty (or we woke up spuriously and checked again)
                 // Check again if queue is still empty after wait.
-                if (byte_stream_.empty()) {
+                if (size_unsafe() == 0) {
                     // std::cout << "Pipe: ReadBlocking woke up but still empty." << std::endl; // Use logging
                     return 0; // Still empty
                 }
             }
 
             // Now read, similar to non-blocking Read
-            size_t bytes_to_read = std::min(size, byte_stream_.size());
-            for (size_t i = 0; i < bytes_to_read; ++i) {
-                buffer[i] = byte_stream_.front();
-                byte_stream_.pop_front();
-            }
+            size_t bytes_to_read = std::min(size, size_unsafe());
+            consume_unsafe(buffer, bytes_to_read);
             // std::cout << "Pipe: ReadBlocking got " << bytes_to_read << " bytes." << std::endl; // Use logging
             // cv_write_.notify_all(); // Notify writers (if bounded pipe)
             return bytes_to_read;
@@ -176,9 +219,8 @@ namespace LSX_LIB {
 
             size_t bytes_to_write = size; // In unbounded pipe, write all
 
-            for (size_t i = 0; i < bytes_to_write; ++i) {
-                byte_stream_.push_back(data[i]);
-            }
+            byte_stream_.insert(byte_stream_.end(), data, data + bytes_to_write);
+            notifier_.Signal(); // No syscall unless the pipe was empty
             // std::cout << "Pipe: WriteBlocking put " << bytes_to_write << " bytes." << std::endl; // Use logging
             cv_read_.notify_all(); // Notify readers
 
@@ -190,15 +232,121 @@ namespace LSX_LIB {
         }
 
 
+// --- Search / Framing Functions ---
+        std::optional<size_t> Pipe::FindByte(uint8_t value, size_t start) const {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+            return find_unsafe(&value, 1, start);
+        }
+
+        std::optional<size_t> Pipe::FindPattern(const uint8_t *pattern, size_t pattern_size, size_t start) const {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+            return find_unsafe(pattern, pattern_size, start);
+        }
+
+        std::optional<size_t> Pipe::FindPattern(const std::vector<uint8_t> &pattern, size_t start) const {
+            return FindPattern(pattern.data(), pattern.size(), start);
+        }
+
+        size_t Pipe::ReadUntil(uint8_t delimiter, uint8_t *buffer, size_t size) {
+            if (buffer == nullptr || size == 0) {
+                return 0;
+            }
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+
+            // 只需在前 size 个字节内查找：更远的分隔符意味着帧放不进 buffer
+            const uint8_t* base = data_unsafe();
+            const uint8_t* hit = ByteSearch::FindByte(base, std::min(size, size_unsafe()), delimiter);
+            if (hit == nullptr) {
+                return 0;
+            }
+            size_t frame_size = static_cast<size_t>(hit - base) + 1;
+            consume_unsafe(buffer, frame_size);
+            return frame_size;
+        }
+
+        std::optional<std::vector<uint8_t>> Pipe::ReadUntil(uint8_t delimiter) {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+            std::optional<size_t> pos = find_unsafe(&delimiter, 1, 0);
+            if (!pos) {
+                return std::nullopt;
+            }
+            std::vector<uint8_t> frame(*pos + 1);
+            consume_unsafe(frame.data(), frame.size());
+            return frame;
+        }
+
+        std::optional<std::vector<uint8_t>> Pipe::ReadUntil(const std::vector<uint8_t> &delimiter) {
+            if (delimiter.empty()) {
+                return std::nullopt;
+            }
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+            std::optional<size_t> pos = find_unsafe(delimiter.data(), delimiter.size(), 0);
+            if (!pos) {
+                return std::nullopt;
+            }
+            std::vector<uint8_t> frame(*pos + delimiter.size());
+            consume_unsafe(frame.data(), frame.size());
+            return frame;
+        }
+
+        std::optional<std::vector<uint8_t>> Pipe::ReadUntilBlocking(uint8_t delimiter, long timeout_ms) {
+            std::unique_lock<std::mutex> lock(mutex_); // Use unique_lock for condition variables
+
+            // 已扫描位置以绝对字节序号记录，其他读取者移除数据后仍可正确换算为相对偏移
+            size_t scanned_until = consumed_total_;
+            std::optional<size_t> pos;
+            auto frame_ready = [&] {
+                size_t start = scanned_until > consumed_total_ ? scanned_until - consumed_total_ : 0;
+                pos = find_unsafe(&delimiter, 1, start);
+                scanned_until = consumed_total_ + size_unsafe();
+                return pos.has_value();
+            };
+
+            if (!frame_ready()) {
+                if (timeout_ms == 0) { // Non-blocking mode
+                    return std::nullopt;
+                } else if (timeout_ms > 0) { // Timed wait
+                    auto duration = std::chrono::milliseconds(timeout_ms);
+                    if (!cv_read_.wait_for(lock, duration, frame_ready)) {
+                        return std::nullopt; // Timeout
+                    }
+                } else { // Infinite wait
+                    cv_read_.wait(lock, frame_ready);
+                }
+            }
+
+            std::vector<uint8_t> frame(*pos + 1);
+            consume_unsafe(frame.data(), frame.size());
+            return frame;
+        }
+
+
 // --- Status Functions ---
         bool Pipe::IsEmpty() const {
             std::lock_guard<std::mutex> lock(mutex_);
-            return byte_stream_.empty();
+            return size_unsafe() == 0;
         }
 
         size_t Pipe::Size() const {
             std::lock_guard<std::mutex> lock(mutex_);
-            return byte_stream_.size();
+            return size_unsafe();
+        }
+
+// --- Event Loop Integration ---
+        bool Pipe::EnableNotification() {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+            if (!notifier_.Enable()) {
+                return false;
+            }
+            if (size_unsafe() != 0) {
+                notifier_.Signal(); // Data written before enabling must still wake the poller
+            }
+            return true;
+        }
+
+        int Pipe::NativeHandle() const {
+            LSX_LIB::LockManager::LockGuard<std::mutex> lock(mutex_);
+            return notifier_.NativeHandle();
         }
 
 // bool Pipe::IsFull() const { /* ... */ } // If bounded
@@ -0,0 +1,102 @@
+#include "ReadyNotifier.h"
+
+#include <cerrno> // For errno
+#include <cstdint> // For uint64_t
+#include <cstring> // For strerror
+#include <iostream> // For std::cerr
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+#endif
+
+namespace LSX_LIB {
+namespace Memory {
+
+ReadyNotifier::~ReadyNotifier() {
+    Disable();
+}
+
+bool ReadyNotifier::Enable() {
+    if (read_fd_ >= 0) {
+        return true;
+    }
+#if defined(_WIN32)
+    std::cerr << "ReadyNotifier: Not supported on this platform." << std::endl;
+    return false;
+#elif defined(__linux__)
+    const int fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "ReadyNotifier: eventfd failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    read_fd_ = fd;
+    write_fd_ = fd;
+#else
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        std::cerr << "ReadyNotifier: pipe failed: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    for (int fd : fds) {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    read_fd_ = fds[0];
+    write_fd_ = fds[1];
+#endif
+    signaled_ = false;
+    return true;
+}
+
+void ReadyNotifier::Disable() {
+#ifndef _WIN32
+    if (write_fd_ >= 0 && write_fd_ != read_fd_) {
+        ::close(write_fd_);
+    }
+    if (read_fd_ >= 0) {
+        ::close(read_fd_);
+    }
+#endif
+    read_fd_ = -1;
+    write_fd_ = -1;
+    signaled_ = false;
+}
+
+void ReadyNotifier::Signal() {
+    if (signaled_ || write_fd_ < 0) {
+        return; // Already readable: the consumer has not drained the container yet
+    }
+#ifndef _WIN32
+#ifdef __linux__
+    const uint64_t one = 1;
+#else
+    const uint8_t one = 1;
+#endif
+    // Only fails if the counter would overflow, which cannot happen with a single pending signal
+    if (::write(write_fd_, &one, sizeof(one)) == static_cast<ssize_t>(sizeof(one))) {
+        signaled_ = true;
+    }
+#endif
+}
+
+void ReadyNotifier::Reset() {
+    if (!signaled_ || read_fd_ < 0) {
+        return;
+    }
+#ifndef _WIN32
+#ifdef __linux__
+    uint64_t value = 0;
+#else
+    uint8_t value = 0;
+#endif
+    (void)::read(read_fd_, &value, sizeof(value));
+#endif
+    signaled_ = false;
+}
+
+} // namespace Memory
+} // namespace LSX_LIB
@@ -0,0 +1,463 @@
+#include "SampleDecode.h"
+
+#include <algorithm> // For std::min
+#include <cstring>   // For memcpy
+
+// 编译期选择指令集：NEON (ARM)；x86 上以 SSE2 为基础，按 SSSE3 / SSE4.1 / AVX2 逐级启用更多内核
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LSX_SAMPLE_DECODE_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define LSX_SAMPLE_DECODE_SSE2 1
+#if defined(__SSSE3__)
+#define LSX_SAMPLE_DECODE_SSSE3 1
+#endif
+#if defined(__SSE4_1__)
+#define LSX_SAMPLE_DECODE_SSE41 1
+#endif
+#if defined(__AVX2__)
+#define LSX_SAMPLE_DECODE_AVX2 1
+#endif
+#endif
+
+namespace LSX_LIB::Memory::SampleDecode {
+
+namespace {
+
+// UnpackToFloat 每次解包到栈上的采样数 (必须是 8 的倍数，保证每块从字节边界开始)
+constexpr size_t kFloatChunkSamples = 512;
+
+inline uint16_t Swap16(uint16_t v) {
+    return static_cast<uint16_t>((v << 8) | (v >> 8));
+}
+
+inline uint32_t Swap32(uint32_t v) {
+    return ((v & 0x000000FFu) << 24) | ((v & 0x0000FF00u) << 8) |
+           ((v & 0x00FF0000u) >> 8) | ((v & 0xFF000000u) >> 24);
+}
+
+// 标量解包：逐个采样从位流中取出最多 3 个字节的窗口
+void UnpackScalar(const uint8_t* src, size_t src_size, unsigned bits,
+                  int16_t* dst, size_t count, bool is_signed, BitOrder order) {
+    const uint32_t mask = (1u << bits) - 1;
+    const uint32_t sign = is_signed ? (1u << (bits - 1)) : 0;
+    for (size_t i = 0; i < count; ++i) {
+        const size_t bit_pos = i * bits;
+        const size_t byte = bit_pos >> 3;
+        const unsigned shift = static_cast<unsigned>(bit_pos & 7);
+        const size_t avail = src_size - byte;
+        const uint32_t b0 = src[byte];
+        const uint32_t b1 = avail > 1 ? src[byte + 1] : 0;
+        const uint32_t b2 = avail > 2 ? src[byte + 2] : 0;
+
+        uint32_t value;
+        if (order == BitOrder::MsbFirst) {
+            value = (((b0 << 16) | (b1 << 8) | b2) >> (24 - shift - bits)) & mask;
+        } else {
+            value = ((b0 | (b1 << 8) | (b2 << 16)) >> shift) & mask;
+        }
+        // 补码符号扩展：(v ^ sign) - sign；无符号时 sign 为 0
+        const int32_t extended = static_cast<int32_t>(value ^ sign) - static_cast<int32_t>(sign);
+        dst[i] = static_cast<int16_t>(static_cast<uint16_t>(extended));
+    }
+}
+
+void ScaleOffsetScalar(const int16_t* src, float* dst, size_t count, float scale, float offset) {
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = static_cast<float>(src[i]) * scale + offset;
+    }
+}
+
+#if defined(LSX_SAMPLE_DECODE_SSSE3) || defined(LSX_SAMPLE_DECODE_NEON)
+/**
+ * 向量化解包方案：每 8 个采样恰好占 bits 个字节，从一次 16 字节加载中用字节重排
+ * 把每个采样所在的字节窗口收集到独立的 16 位 (narrow) 或 32 位 (wide) 通道里，
+ * 再左移把采样的最高位对齐到通道最高位，最后逻辑/算术右移 (W - bits) 得到无符号/有符号结果。
+ */
+struct UnpackPlan {
+    bool wide = false;            // true: 32 位通道，8 个采样分两组各 4 个
+    uint8_t index[2][16] = {};    // 字节重排索引 (narrow 只用 index[0])
+    uint16_t left16[8] = {};      // narrow 通道左移位数
+    uint32_t left32[2][4] = {};   // wide 通道左移位数
+    unsigned right = 0;           // 右移位数 (W - bits)
+};
+
+// 按给定通道宽度生成方案；窗口超出 16 字节加载范围或通道宽度不足时返回 false
+bool BuildPlan(unsigned bits, BitOrder order, bool wide, UnpackPlan& plan) {
+    const unsigned lane_bits = wide ? 32 : 16;
+    const unsigned lane_bytes = lane_bits / 8;
+    plan.wide = wide;
+    plan.right = lane_bits - bits;
+    for (unsigned k = 0; k < 8; ++k) {
+        const unsigned bit_pos = k * bits;
+        const unsigned byte = bit_pos >> 3;
+        const unsigned bit = bit_pos & 7;
+        if (bit + bits > lane_bits || byte + lane_bytes > 16) {
+            return false;
+        }
+        const unsigned half = wide ? k / 4 : 0;
+        const unsigned lane = wide ? k % 4 : k;
+        for (unsigned j = 0; j < lane_bytes; ++j) {
+            // 小端通道：第 j 个字节是通道的第 j 低字节
+            const unsigned from = (order == BitOrder::MsbFirst) ? byte + (lane_bytes - 1 - j) : byte + j;
+            plan.index[half][lane * lane_bytes + j] = static_cast<uint8_t>(from);
+        }
+        const unsigned left = (order == BitOrder::MsbFirst) ? bit : lane_bits - bits - bit;
+        if (wide) {
+            plan.left32[half][lane] = left;
+        } else {
+            plan.left16[lane] = static_cast<uint16_t>(left);
+        }
+    }
+    return true;
+}
+#endif
+
+#if defined(LSX_SAMPLE_DECODE_SSSE3)
+// 返回已解包的采样数 (8 的倍数)
+template<bool Signed>
+size_t UnpackNarrowSse(const uint8_t* src, size_t src_size, unsigned bits,
+                       int16_t* dst, size_t count, const UnpackPlan& plan) {
+    const __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(plan.index[0]));
+    alignas(16) uint16_t mul[8];
+    for (int k = 0; k < 8; ++k) {
+        mul[k] = static_cast<uint16_t>(1u << plan.left16[k]); // 左移用乘法实现 (SSE 无逐通道移位)
+    }
+    const __m128i multiplier = _mm_load_si128(reinterpret_cast<const __m128i*>(mul));
+    const __m128i right = _mm_cvtsi32_si128(static_cast<int>(plan.right));
+    size_t done = 0;
+    size_t in = 0;
+
+#if defined(LSX_SAMPLE_DECODE_AVX2)
+    // 每次处理两组：两个 16 字节窗口分别放在 256 位寄存器的两个 128 位通道中
+    const __m256i index2 = _mm256_broadcastsi128_si256(index);
+    const __m256i multiplier2 = _mm256_broadcastsi128_si256(multiplier);
+    for (; done + 16 <= count && in + bits + 16 <= src_size; done += 16, in += 2 * bits) {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + in));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + in + bits));
+        __m256i v = _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), index2);
+        v = _mm256_mullo_epi16(v, multiplier2);
+        v = Signed ? _mm256_sra_epi16(v, right) : _mm256_srl_epi16(v, right);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + done), v);
+    }
+#endif
+
+    for (; done + 8 <= count && in + 16 <= src_size; done += 8, in += bits) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + in)), index);
+        v = _mm_mullo_epi16(v, multiplier);
+        v = Signed ? _mm_sra_epi16(v, right) : _mm_srl_epi16(v, right);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + done), v);
+    }
+    return done;
+}
+#endif
+
+#if defined(LSX_SAMPLE_DECODE_SSE41)
+template<bool Signed>
+size_t UnpackWideSse(const uint8_t* src, size_t src_size, unsigned bits,
+                     int16_t* dst, size_t count, const UnpackPlan& plan) {
+    const __m128i index_a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(plan.index[0]));
+    const __m128i index_b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(plan.index[1]));
+    const __m128i right = _mm_cvtsi32_si128(static_cast<int>(plan.right));
+    size_t done = 0;
+    size_t in = 0;
+
+#if defined(LSX_SAMPLE_DECODE_AVX2)
+    const __m256i index_a2 = _mm256_broadcastsi128_si256(index_a);
+    const __m256i index_b2 = _mm256_broadcastsi128_si256(index_b);
+    const __m256i left_a2 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(plan.left32[0])));
+    const __m256i left_b2 = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(plan.left32[1])));
+    for (; done + 16 <= count && in + bits + 16 <= src_size; done += 16, in += 2 * bits) {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + in));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + in + bits));
+        const __m256i raw = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        __m256i a = _mm256_sllv_epi32(_mm256_shuffle_epi8(raw, index_a2), left_a2);
+        __m256i b = _mm256_sllv_epi32(_mm256_shuffle_epi8(raw, index_b2), left_b2);
+        a = Signed ? _mm256_sra_epi32(a, right) : _mm256_srl_epi32(a, right);
+        b = Signed ? _mm256_sra_epi32(b, right) : _mm256_srl_epi32(b, right);
+        // packs 在每个 128 位通道内拼接 a、b，结果恰好是两组按顺序排列的 16 个采样
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + done), _mm256_packs_epi32(a, b));
+    }
+#endif
+
+    alignas(16) uint32_t mul[2][4];
+    for (int h = 0; h < 2; ++h) {
+        for (int k = 0; k < 4; ++k) {
+            mul[h][k] = 1u << plan.left32[h][k];
+        }
+    }
+    const __m128i multiplier_a = _mm_load_si128(reinterpret_cast<const __m128i*>(mul[0]));
+    const __m128i multiplier_b = _mm_load_si128(reinterpret_cast<const __m128i*>(mul[1]));
+    for (; done + 8 <= count && in + 16 <= src_size; done += 8, in += bits) {
+        const __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + in));
+        __m128i a = _mm_mullo_epi32(_mm_shuffle_epi8(raw, index_a), multiplier_a);
+        __m128i b = _mm_mullo_epi32(_mm_shuffle_epi8(raw, index_b), multiplier_b);
+        a = Signed ? _mm_sra_epi32(a, right) : _mm_srl_epi32(a, right);
+        b = Signed ? _mm_sra_epi32(b, right) : _mm_srl_epi32(b, right);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + done), _mm_packs_epi32(a, b));
+    }
+    return done;
+}
+#endif
+
+#if defined(LSX_SAMPLE_DECODE_NEON)
+inline uint8x16_t NeonGather(uint8x16_t table, uint8x16_t index) {
+#if defined(__aarch64__)
+    return vqtbl1q_u8(table, index);
+#else
+    uint8x8x2_t t;
+    t.val[0] = vget_low_u8(table);
+    t.val[1] = vget_high_u8(table);
+    return vcombine_u8(vtbl2_u8(t, vget_low_u8(index)), vtbl2_u8(t, vget_high_u8(index)));
+#endif
+}
+
+template<bool Signed>
+size_t UnpackNarrowNeon(const uint8_t* src, size_t src_size, unsigned bits,
+                        int16_t* dst, size_t count, const UnpackPlan& plan) {
+    const uint8x16_t index = vld1q_u8(plan.index[0]);
+    const int16x8_t left = vreinterpretq_s16_u16(vld1q_u16(plan.left16));
+    const int16x8_t right = vdupq_n_s16(-static_cast<int16_t>(plan.right)); // 负数表示右移
+    size_t done = 0;
+    size_t in = 0;
+    for (; done + 8 <= count && in + 16 <= src_size; done += 8, in += bits) {
+        const uint16x8_t v = vshlq_u16(vreinterpretq_u16_u8(NeonGather(vld1q_u8(src + in), index)), left);
+        if (Signed) {
+            vst1q_s16(dst + done, vshlq_s16(vreinterpretq_s16_u16(v), right));
+        } else {
+            vst1q_s16(dst + done, vreinterpretq_s16_u16(vshlq_u16(v, right)));
+        }
+    }
+    return done;
+}
+
+template<bool Signed>
+size_t UnpackWideNeon(const uint8_t* src, size_t src_size, unsigned bits,
+                      int16_t* dst, size_t count, const UnpackPlan& plan) {
+    const uint8x16_t index_a = vld1q_u8(plan.index[0]);
+    const uint8x16_t index_b = vld1q_u8(plan.index[1]);
+    const int32x4_t left_a = vreinterpretq_s32_u32(vld1q_u32(plan.left32[0]));
+    const int32x4_t left_b = vreinterpretq_s32_u32(vld1q_u32(plan.left32[1]));
+    const int32x4_t right = vdupq_n_s32(-static_cast<int32_t>(plan.right));
+    size_t done = 0;
+    size_t in = 0;
+    for (; done + 8 <= count && in + 16 <= src_size; done += 8, in += bits) {
+        const uint8x16_t raw = vld1q_u8(src + in);
+        const uint32x4_t a = vshlq_u32(vreinterpretq_u32_u8(NeonGather(raw, index_a)), left_a);
+        const uint32x4_t b = vshlq_u32(vreinterpretq_u32_u8(NeonGather(raw, index_b)), left_b);
+        int32x4_t ra;
+        int32x4_t rb;
+        if (Signed) {
+            ra = vshlq_s32(vreinterpretq_s32_u32(a), right);
+            rb = vshlq_s32(vreinterpretq_s32_u32(b), right);
+        } else {
+            ra = vreinterpretq_s32_u32(vshlq_u32(a, right));
+            rb = vreinterpretq_s32_u32(vshlq_u32(b, right));
+        }
+        vst1q_s16(dst + done, vcombine_s16(vmovn_s32(ra), vmovn_s32(rb)));
+    }
+    return done;
+}
+#endif
+
+// 向量化解包主体，返回已处理的采样数；剩余部分由调用者用标量实现处理
+size_t UnpackVector(const uint8_t* src, size_t src_size, unsigned bits,
+                    int16_t* dst, size_t count, bool is_signed, BitOrder order) {
+#if defined(LSX_SAMPLE_DECODE_SSSE3) || defined(LSX_SAMPLE_DECODE_NEON)
+    if (count < 8 || src_size < 16) {
+        return 0;
+    }
+    UnpackPlan plan;
+    if (BuildPlan(bits, order, false, plan)) {
+#if defined(LSX_SAMPLE_DECODE_NEON)
+        return is_signed ? UnpackNarrowNeon<true>(src, src_size, bits, dst, count, plan)
+                         : UnpackNarrowNeon<false>(src, src_size, bits, dst, count, plan);
+#else
+        return is_signed ? UnpackNarrowSse<true>(src, src_size, bits, dst, count, plan)
+                         : UnpackNarrowSse<false>(src, src_size, bits, dst, count, plan);
+#endif
+    }
+    if (BuildPlan(bits, order, true, plan)) {
+#if defined(LSX_SAMPLE_DECODE_NEON)
+        return is_signed ? UnpackWideNeon<true>(src, src_size, bits, dst, count, plan)
+                         : UnpackWideNeon<false>(src, src_size, bits, dst, count, plan);
+#elif defined(LSX_SAMPLE_DECODE_SSE41)
+        return is_signed ? UnpackWideSse<true>(src, src_size, bits, dst, count, plan)
+                         : UnpackWideSse<false>(src, src_size, bits, dst, count, plan);
+#endif
+    }
+#else
+    (void)src; (void)src_size; (void)bits; (void)dst; (void)count; (void)is_signed; (void)order;
+#endif
+    return 0;
+}
+
+} // namespace
+
+
+void ByteSwap16(const void* src, void* dst, size_t count) {
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    size_t i = 0; // 已处理的字数
+
+#if defined(LSX_SAMPLE_DECODE_AVX2)
+    const __m256i swap = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                          1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    for (; i + 16 <= count; i += 16) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * 2));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 2), _mm256_shuffle_epi8(v, swap));
+    }
+#endif
+#if defined(LSX_SAMPLE_DECODE_SSE2)
+    for (; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2),
+                         _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+    }
+#elif defined(LSX_SAMPLE_DECODE_NEON)
+    for (; i + 8 <= count; i += 8) {
+        vst1q_u8(out + i * 2, vrev16q_u8(vld1q_u8(in + i * 2)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        uint16_t v;
+        std::memcpy(&v, in + i * 2, sizeof(v));
+        v = Swap16(v);
+        std::memcpy(out + i * 2, &v, sizeof(v));
+    }
+}
+
+
+void ByteSwap32(const void* src, void* dst, size_t count) {
+    const uint8_t* in = static_cast<const uint8_t*>(src);
+    uint8_t* out = static_cast<uint8_t*>(dst);
+    size_t i = 0;
+
+#if defined(LSX_SAMPLE_DECODE_AVX2)
+    const __m256i swap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                          3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    for (; i + 8 <= count; i += 8) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 4), _mm256_shuffle_epi8(v, swap));
+    }
+#endif
+#if defined(LSX_SAMPLE_DECODE_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+        // 先交换每个 32 位字中的两个 16 位半字，再交换半字内的字节
+        v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 4),
+                         _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+    }
+#elif defined(LSX_SAMPLE_DECODE_NEON)
+    for (; i + 4 <= count; i += 4) {
+        vst1q_u8(out + i * 4, vrev32q_u8(vld1q_u8(in + i * 4)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        uint32_t v;
+        std::memcpy(&v, in + i * 4, sizeof(v));
+        v = Swap32(v);
+        std::memcpy(out + i * 4, &v, sizeof(v));
+    }
+}
+
+
+bool Unpack(const uint8_t* src, size_t src_size, unsigned bits,
+            int16_t* dst, size_t count, bool is_signed, BitOrder order) {
+    if (count == 0) {
+        return true;
+    }
+    if (src == nullptr || dst == nullptr || bits == 0 || bits > 16 || src_size < PackedSize(bits, count)) {
+        return false;
+    }
+    // 向量化部分每 8 个采样消耗 bits 个字节，剩余部分从字节边界开始
+    const size_t done = UnpackVector(src, src_size, bits, dst, count, is_signed, order);
+    const size_t consumed = done / 8 * bits;
+    UnpackScalar(src + consumed, src_size - consumed, bits, dst + done, count - done, is_signed, order);
+    return true;
+}
+
+
+void ScaleOffset(const int16_t* src, float* dst, size_t count, float scale, float offset) {
+    if (src == nullptr || dst == nullptr) {
+        return;
+    }
+    size_t i = 0;
+
+#if defined(LSX_SAMPLE_DECODE_AVX2)
+    const __m256 vscale = _mm256_set1_ps(scale);
+    const __m256 voffset = _mm256_set1_ps(offset);
+    for (; i + 8 <= count; i += 8) {
+        const __m256i wide = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        const __m256 x = _mm256_cvtepi32_ps(wide);
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_mul_ps(x, vscale), voffset));
+    }
+#elif defined(LSX_SAMPLE_DECODE_SSE2)
+    const __m128 vscale = _mm_set1_ps(scale);
+    const __m128 voffset = _mm_set1_ps(offset);
+    for (; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        // 与自身交错后算术右移 16 位，完成 int16 -> int32 的符号扩展
+        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(lo), vscale), voffset));
+        _mm_storeu_ps(dst + i + 4, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(hi), vscale), voffset));
+    }
+#elif defined(LSX_SAMPLE_DECODE_NEON)
+    const float32x4_t voffset = vdupq_n_f32(offset);
+    for (; i + 8 <= count; i += 8) {
+        const int16x8_t v = vld1q_s16(src + i);
+        const float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+        const float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+        vst1q_f32(dst + i, vmlaq_n_f32(voffset, lo, scale));
+        vst1q_f32(dst + i + 4, vmlaq_n_f32(voffset, hi, scale));
+    }
+#endif
+
+    ScaleOffsetScalar(src + i, dst + i, count - i, scale, offset);
+}
+
+
+bool UnpackToFloat(const uint8_t* src, size_t src_size, unsigned bits,
+                   float* dst, size_t count, float scale, float offset,
+                   bool is_signed, BitOrder order) {
+    if (count == 0) {
+        return true;
+    }
+    if (src == nullptr || dst == nullptr || bits == 0 || bits > 16 || src_size < PackedSize(bits, count)) {
+        return false;
+    }
+    int16_t chunk[kFloatChunkSamples];
+    for (size_t done = 0; done < count; done += kFloatChunkSamples) {
+        const size_t n = std::min(kFloatChunkSamples, count - done);
+        const size_t consumed = done / 8 * bits; // done 是 8 的倍数，块起点总在字节边界上
+        Unpack(src + consumed, src_size - consumed, bits, chunk, n, is_signed, order);
+        ScaleOffset(chunk, dst + done, n, scale, offset);
+    }
+    return true;
+}
+
+
+const char* ActiveInstructionSet() {
+#if defined(LSX_SAMPLE_DECODE_NEON)
+    return "NEON";
+#elif defined(LSX_SAMPLE_DECODE_AVX2)
+    return "AVX2";
+#elif defined(LSX_SAMPLE_DECODE_SSE41)
+    return "SSE4.1";
+#elif defined(LSX_SAMPLE_DECODE_SSSE3)
+    return "SSSE3";
+#elif defined(LSX_SAMPLE_DECODE_SSE2)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+
+} // namespace LSX_LIB::Memory::SampleDecode
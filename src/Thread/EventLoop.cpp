@@ -0,0 +1,712 @@
+#include "EventLoop.h"
+#include <algorithm> // 用于 std::max/std::min
+#include <chrono>
+#include <exception>
+#include <iostream> // 用于错误输出
+#include <mutex>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring> // 用于 strerror
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#endif
+
+namespace LSX_LIB::Thread
+{
+#ifdef __linux__
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+        using Callback = std::function<void(uint32_t)>;
+
+        // epoll_event.data.u64 中的保留值，普通注册的 ID 从 1 开始递增
+        constexpr uint64_t kWakeKey = std::numeric_limits<uint64_t>::max();
+        constexpr uint64_t kTimerKey = std::numeric_limits<uint64_t>::max() - 1;
+
+        // 由 EventLoop 打开的描述符（GPIO/UIO），最后一个引用释放时关闭，
+        // 这样在其他线程中注销时，正在执行的回调仍可安全使用描述符
+        struct OwnedFd
+        {
+            explicit OwnedFd(int fd) : fd(fd) {}
+            ~OwnedFd() { if (fd >= 0) ::close(fd); }
+            OwnedFd(const OwnedFd&) = delete;
+            OwnedFd& operator=(const OwnedFd&) = delete;
+            int fd;
+        };
+
+        uint32_t toEpoll(uint32_t events)
+        {
+            uint32_t result = 0;
+            if (events & EventLoop::Readable) result |= EPOLLIN;
+            if (events & EventLoop::Writable) result |= EPOLLOUT;
+            return result;
+        }
+
+        uint32_t fromEpoll(uint32_t events)
+        {
+            uint32_t result = 0;
+            if (events & (EPOLLIN | EPOLLPRI)) result |= EventLoop::Readable;
+            if (events & EPOLLOUT) result |= EventLoop::Writable;
+            if (events & EPOLLERR) result |= EventLoop::Error;
+            if (events & (EPOLLHUP | EPOLLRDHUP)) result |= EventLoop::HangUp;
+            return result;
+        }
+
+        // 在循环线程中执行回调，异常不影响循环
+        template <typename F>
+        void invokeSafely(F&& fn)
+        {
+            try
+            {
+                fn();
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "EventLoop callback failed: " << e.what() << std::endl;
+            } catch (...)
+            {
+                std::cerr << "EventLoop callback failed with unknown error." << std::endl;
+            }
+        }
+    }
+
+    struct EventLoop::Impl
+    {
+        struct Registration
+        {
+            int fd = -1; // Descriptor registered in epoll, -1 for timers
+            bool timer = false;
+            Clock::time_point deadline; // Timers only
+            long intervalMs = 0; // Timers only, <= 0 for one-shot
+            std::shared_ptr<Callback> callback; // Shared so a running callback survives remove()
+        };
+
+        int epfd = -1;
+        int timerFd = -1;
+        int wakeFd = -1;
+
+        mutable std::mutex mtx; // Protects everything below
+        std::unordered_map<Id, Registration> registrations;
+        std::multimap<Clock::time_point, Id> timers; // Pending timers by deadline
+        Clock::time_point armed = Clock::time_point::max(); // Deadline currently programmed in timerFd
+        std::vector<std::function<void()>> posted;
+        Id nextId = 1;
+        std::thread thread; // Started by start()
+
+        std::atomic<bool> stopping{false};
+        std::atomic<std::thread::id> loopThread{std::thread::id()};
+
+        void wake()
+        {
+            const uint64_t one = 1;
+            ssize_t ret;
+            do
+            {
+                ret = ::write(wakeFd, &one, sizeof(one));
+            }
+            while (ret < 0 && errno == EINTR);
+        }
+
+        // 把 timerFd 设置为最早的定时器到期时间。调用者持有 mtx
+        void rearm()
+        {
+            const Clock::time_point next = timers.empty() ? Clock::time_point::max() : timers.begin()->first;
+            if (next == armed)
+            {
+                return;
+            }
+            armed = next;
+            itimerspec spec{};
+            if (next != Clock::time_point::max())
+            {
+                const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(next.time_since_epoch()).count();
+                spec.it_value.tv_sec = static_cast<time_t>(ns / 1000000000LL);
+                spec.it_value.tv_nsec = static_cast<long>(ns % 1000000000LL);
+                if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0)
+                {
+                    spec.it_value.tv_nsec = 1; // 全 0 表示停止定时器
+                }
+            }
+            // steady_clock 在 Linux 上即 CLOCK_MONOTONIC
+            if (::timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) != 0)
+            {
+                std::cerr << "EventLoop: timerfd_settime failed: " << std::strerror(errno) << std::endl;
+            }
+        }
+
+        Id addFd(int fd, uint32_t epollEvents, std::shared_ptr<Callback> callback)
+        {
+            if (epfd < 0 || fd < 0 || !callback)
+            {
+                return 0;
+            }
+            std::lock_guard<std::mutex> lk(mtx);
+            const Id id = nextId++;
+            epoll_event ev{};
+            ev.events = epollEvents;
+            ev.data.u64 = id;
+            if (::epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) != 0)
+            {
+                std::cerr << "EventLoop: epoll_ctl(ADD, " << fd << ") failed: " << std::strerror(errno) << std::endl;
+                return 0;
+            }
+            Registration reg;
+            reg.fd = fd;
+            reg.callback = std::move(callback);
+            registrations.emplace(id, std::move(reg));
+            return id;
+        }
+
+        // 取出并执行到期的定时器，返回执行的数量
+        int fireTimers()
+        {
+            uint64_t expirations;
+            while (::read(timerFd, &expirations, sizeof(expirations)) > 0)
+            {
+            }
+
+            std::vector<Id> due;
+            {
+                std::lock_guard<std::mutex> lk(mtx);
+                const Clock::time_point now = Clock::now();
+                while (!timers.empty() && timers.begin()->first <= now)
+                {
+                    const Id id = timers.begin()->second;
+                    timers.erase(timers.begin());
+                    auto it = registrations.find(id);
+                    if (it == registrations.end())
+                    {
+                        continue;
+                    }
+                    due.push_back(id);
+                    Registration& reg = it->second;
+                    if (reg.intervalMs > 0)
+                    {
+                        // 固定频率：落后时从当前时间重新开始计时，不补触发
+                        reg.deadline += std::chrono::milliseconds(reg.intervalMs);
+                        if (reg.deadline <= now)
+                        {
+                            reg.deadline = now + std::chrono::milliseconds(reg.intervalMs);
+                        }
+                        timers.emplace(reg.deadline, id);
+                    }
+                }
+                armed = Clock::time_point::max(); // timerFd 已到期，需要重新设置
+                rearm();
+            }
+
+            int fired = 0;
+            for (const Id id : due)
+            {
+                std::shared_ptr<Callback> callback;
+                {
+                    // 同一批中前面的回调可能已经注销了这个定时器
+                    std::lock_guard<std::mutex> lk(mtx);
+                    auto it = registrations.find(id);
+                    if (it == registrations.end())
+                    {
+                        continue;
+                    }
+                    callback = it->second.callback;
+                    if (it->second.intervalMs <= 0)
+                    {
+                        registrations.erase(it); // 一次性定时器触发后自动注销
+                    }
+                }
+                invokeSafely([&] { (*callback)(0); });
+                ++fired;
+            }
+            return fired;
+        }
+
+        int runPosted()
+        {
+            std::vector<std::function<void()>> tasks;
+            {
+                std::lock_guard<std::mutex> lk(mtx);
+                tasks.swap(posted);
+            }
+            for (auto& task : tasks)
+            {
+                invokeSafely(task);
+            }
+            return static_cast<int>(tasks.size());
+        }
+    };
+
+    EventLoop::EventLoop() : impl_(new Impl())
+    {
+        impl_->epfd = ::epoll_create1(EPOLL_CLOEXEC);
+        impl_->timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        impl_->wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (impl_->epfd < 0 || impl_->timerFd < 0 || impl_->wakeFd < 0)
+        {
+            std::cerr << "EventLoop: failed to create epoll/timerfd/eventfd: " << std::strerror(errno) << std::endl;
+        }
+        else
+        {
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.u64 = kWakeKey;
+            const bool wake_ok = ::epoll_ctl(impl_->epfd, EPOLL_CTL_ADD, impl_->wakeFd, &ev) == 0;
+            ev.data.u64 = kTimerKey;
+            const bool timer_ok = ::epoll_ctl(impl_->epfd, EPOLL_CTL_ADD, impl_->timerFd, &ev) == 0;
+            if (wake_ok && timer_ok)
+            {
+                return;
+            }
+            std::cerr << "EventLoop: epoll_ctl failed: " << std::strerror(errno) << std::endl;
+        }
+        // 创建失败：关闭已创建的描述符，valid() 返回 false
+        for (int* fd : {&impl_->epfd, &impl_->timerFd, &impl_->wakeFd})
+        {
+            if (*fd >= 0) ::close(*fd);
+            *fd = -1;
+        }
+    }
+
+    EventLoop::~EventLoop()
+    {
+        stop();
+        {
+            std::lock_guard<std::mutex> lk(impl_->mtx);
+            impl_->registrations.clear(); // 释放回调，关闭 GPIO/UIO 描述符
+            impl_->timers.clear();
+        }
+        for (int fd : {impl_->epfd, impl_->timerFd, impl_->wakeFd})
+        {
+            if (fd >= 0) ::close(fd);
+        }
+    }
+
+    bool EventLoop::valid() const
+    {
+        return impl_->epfd >= 0;
+    }
+
+    EventLoop::Id EventLoop::addFd(int fd, uint32_t events, IoCallback callback)
+    {
+        if (!callback)
+        {
+            return 0;
+        }
+        return impl_->addFd(fd, toEpoll(events), std::make_shared<Callback>(std::move(callback)));
+    }
+
+    bool EventLoop::modifyFd(Id id, uint32_t events)
+    {
+        std::lock_guard<std::mutex> lk(impl_->mtx);
+        auto it = impl_->registrations.find(id);
+        if (it == impl_->registrations.end() || it->second.timer)
+        {
+            return false;
+        }
+        epoll_event ev{};
+        ev.events = toEpoll(events);
+        ev.data.u64 = id;
+        if (::epoll_ctl(impl_->epfd, EPOLL_CTL_MOD, it->second.fd, &ev) != 0)
+        {
+            std::cerr << "EventLoop: epoll_ctl(MOD) failed: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    EventLoop::Id EventLoop::addCommunication(DataTransfer::ICommunication& communication, IoCallback callback,
+                                              uint32_t events)
+    {
+        const int fd = communication.nativeHandle();
+        if (fd < 0)
+        {
+            std::cerr << "EventLoop: communication object has no native handle (not created?)." << std::endl;
+            return 0;
+        }
+        return addFd(fd, events, std::move(callback));
+    }
+
+    EventLoop::Id EventLoop::addGpio(const std::string& gpioPath, const std::string& edge,
+                                     std::function<void(bool level)> callback)
+    {
+        if (!valid() || !callback)
+        {
+            return 0;
+        }
+        {
+            std::ofstream edge_file(gpioPath + "/edge");
+            if (!edge_file.is_open() || !(edge_file << edge) || !edge_file.flush())
+            {
+                std::cerr << "EventLoop: failed to set GPIO edge: " << gpioPath << std::endl;
+                return 0;
+            }
+        }
+        const std::string value_path = gpioPath + "/value";
+        auto fd = std::make_shared<OwnedFd>(::open(value_path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC));
+        if (fd->fd < 0)
+        {
+            std::cerr << "EventLoop: failed to open " << value_path << ": " << std::strerror(errno) << std::endl;
+            return 0;
+        }
+
+        // 读取 value 会清除 sysfs 的中断状态；每次都从文件开头读
+        auto read_level = [fd]()
+        {
+            char value = '0';
+            ::lseek(fd->fd, 0, SEEK_SET);
+            return ::read(fd->fd, &value, 1) == 1 && value == '1';
+        };
+        const bool initial = read_level();
+
+        auto user = std::make_shared<std::function<void(bool)>>(std::move(callback));
+        const Id id = impl_->addFd(fd->fd, EPOLLPRI | EPOLLERR,
+                                   std::make_shared<Callback>([read_level, user](uint32_t)
+                                   {
+                                       (*user)(read_level());
+                                   }));
+        if (id != 0)
+        {
+            // 以当前电平回调一次，回调前检查是否已被注销
+            post([this, id, user, initial]
+            {
+                std::unique_lock<std::mutex> lk(impl_->mtx);
+                if (impl_->registrations.count(id) == 0) return;
+                lk.unlock();
+                (*user)(initial);
+            });
+        }
+        return id;
+    }
+
+    EventLoop::Id EventLoop::addUio(const std::string& devicePath, std::function<void(uint32_t count)> callback)
+    {
+        if (!valid() || !callback)
+        {
+            return 0;
+        }
+        auto fd = std::make_shared<OwnedFd>(::open(devicePath.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC));
+        if (fd->fd < 0)
+        {
+            std::cerr << "EventLoop: failed to open " << devicePath << ": " << std::strerror(errno) << std::endl;
+            return 0;
+        }
+
+        // 向设备写入 1 使能中断；驱动不支持 irqcontrol 时写入失败，忽略
+        auto enable_irq = [fd]()
+        {
+            const uint32_t one = 1;
+            (void)!::write(fd->fd, &one, sizeof(one));
+        };
+        enable_irq();
+
+        auto user = std::make_shared<std::function<void(uint32_t)>>(std::move(callback));
+        return impl_->addFd(fd->fd, EPOLLIN, std::make_shared<Callback>([fd, enable_irq, user](uint32_t)
+        {
+            uint32_t count = 0;
+            if (::read(fd->fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count)))
+            {
+                return;
+            }
+            (*user)(count);
+            enable_irq();
+        }));
+    }
+
+    EventLoop::Id EventLoop::addTimer(long delayMs, long intervalMs, std::function<void()> callback)
+    {
+        if (!valid() || !callback)
+        {
+            return 0;
+        }
+        std::lock_guard<std::mutex> lk(impl_->mtx);
+        const Id id = impl_->nextId++;
+        Impl::Registration reg;
+        reg.timer = true;
+        reg.deadline = Clock::now() + std::chrono::milliseconds(delayMs > 0 ? delayMs : 0);
+        reg.intervalMs = intervalMs;
+        reg.callback = std::make_shared<Callback>([callback = std::move(callback)](uint32_t) { callback(); });
+        impl_->timers.emplace(reg.deadline, id);
+        impl_->registrations.emplace(id, std::move(reg));
+        impl_->rearm();
+        return id;
+    }
+
+    bool EventLoop::remove(Id id)
+    {
+        std::shared_ptr<Callback> callback; // 在锁外释放回调（可能关闭 GPIO/UIO 描述符）
+        std::lock_guard<std::mutex> lk(impl_->mtx);
+        auto it = impl_->registrations.find(id);
+        if (it == impl_->registrations.end())
+        {
+            return false;
+        }
+        Impl::Registration& reg = it->second;
+        if (reg.timer)
+        {
+            auto range = impl_->timers.equal_range(reg.deadline);
+            for (auto t = range.first; t != range.second; ++t)
+            {
+                if (t->second == id)
+                {
+                    impl_->timers.erase(t);
+                    break;
+                }
+            }
+            impl_->rearm();
+        }
+        else if (::epoll_ctl(impl_->epfd, EPOLL_CTL_DEL, reg.fd, nullptr) != 0 && errno != EBADF && errno != ENOENT)
+        {
+            std::cerr << "EventLoop: epoll_ctl(DEL) failed: " << std::strerror(errno) << std::endl;
+        }
+        callback = std::move(reg.callback);
+        impl_->registrations.erase(it);
+        return true;
+    }
+
+    bool EventLoop::post(std::function<void()> task)
+    {
+        if (!valid() || !task)
+        {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lk(impl_->mtx);
+            impl_->posted.push_back(std::move(task));
+        }
+        impl_->wake();
+        return true;
+    }
+
+    int EventLoop::runOnce(long timeout_ms)
+    {
+        if (!valid())
+        {
+            return -1;
+        }
+        const std::thread::id self = std::this_thread::get_id();
+        const bool nested = impl_->loopThread.load() == self; // 从 run() 中调用
+        if (!nested)
+        {
+            impl_->loopThread.store(self);
+        }
+
+        epoll_event events[64];
+        const int timeout = timeout_ms < 0
+                                ? -1
+                                : static_cast<int>(std::min<long>(timeout_ms, std::numeric_limits<int>::max()));
+        const int n = ::epoll_wait(impl_->epfd, events, 64, timeout);
+        int handled = 0;
+        if (n < 0)
+        {
+            if (errno != EINTR)
+            {
+                std::cerr << "EventLoop: epoll_wait failed: " << std::strerror(errno) << std::endl;
+                handled = -1;
+            }
+        }
+        for (int i = 0; i < n; ++i)
+        {
+            const uint64_t key = events[i].data.u64;
+            if (key == kWakeKey)
+            {
+                uint64_t value;
+                while (::read(impl_->wakeFd, &value, sizeof(value)) > 0)
+                {
+                }
+                continue;
+            }
+            if (key == kTimerKey)
+            {
+                handled += impl_->fireTimers();
+                continue;
+            }
+
+            std::shared_ptr<Callback> callback;
+            {
+                // 同一批中前面的回调可能已经注销了这个描述符
+                std::lock_guard<std::mutex> lk(impl_->mtx);
+                auto it = impl_->registrations.find(key);
+                if (it == impl_->registrations.end())
+                {
+                    continue;
+                }
+                callback = it->second.callback;
+            }
+            const uint32_t ready = fromEpoll(events[i].events);
+            invokeSafely([&] { (*callback)(ready); });
+            ++handled;
+        }
+        if (handled >= 0)
+        {
+            handled += impl_->runPosted();
+        }
+
+        if (!nested)
+        {
+            impl_->loopThread.store(std::thread::id());
+        }
+        return handled;
+    }
+
+    void EventLoop::run()
+    {
+        if (!valid())
+        {
+            return;
+        }
+        impl_->loopThread.store(std::this_thread::get_id());
+        while (!impl_->stopping.load())
+        {
+            if (runOnce(-1) < 0)
+            {
+                break;
+            }
+        }
+        impl_->loopThread.store(std::thread::id());
+        impl_->stopping.store(false); // 允许再次运行
+    }
+
+    bool EventLoop::start(int cpu)
+    {
+        if (!valid())
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lk(impl_->mtx);
+        if (impl_->thread.joinable())
+        {
+            return false;
+        }
+        impl_->stopping.store(false);
+        impl_->thread = std::thread([this, cpu]
+        {
+            if (cpu >= 0)
+            {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu % CPU_SETSIZE, &set);
+                const int ret = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+                if (ret != 0)
+                {
+                    std::cerr << "EventLoop: failed to pin to CPU " << cpu << ": " << std::strerror(ret) << std::endl;
+                }
+            }
+            run();
+        });
+        return true;
+    }
+
+    void EventLoop::stop()
+    {
+        if (!valid())
+        {
+            return;
+        }
+        impl_->stopping.store(true);
+        impl_->wake();
+        if (isInLoopThread())
+        {
+            return; // 在回调中调用：本轮结束后 run() 返回
+        }
+        std::thread thread;
+        {
+            std::lock_guard<std::mutex> lk(impl_->mtx);
+            thread.swap(impl_->thread);
+        }
+        if (thread.joinable())
+        {
+            thread.join();
+        }
+    }
+
+    bool EventLoop::isInLoopThread() const
+    {
+        return impl_->loopThread.load() == std::this_thread::get_id();
+    }
+
+    size_t EventLoop::registrationCount() const
+    {
+        std::lock_guard<std::mutex> lk(impl_->mtx);
+        return impl_->registrations.size();
+    }
+
+#else
+    // 非 Linux 平台：没有 epoll/timerfd/eventfd，所有注册失败
+
+    struct EventLoop::Impl
+    {
+    };
+
+    EventLoop::EventLoop() : impl_(new Impl())
+    {
+        std::cerr << "EventLoop is only supported on Linux." << std::endl;
+    }
+
+    EventLoop::~EventLoop() = default;
+    bool EventLoop::valid() const { return false; }
+    EventLoop::Id EventLoop::addFd(int, uint32_t, IoCallback) { return 0; }
+    bool EventLoop::modifyFd(Id, uint32_t) { return false; }
+    EventLoop::Id EventLoop::addCommunication(DataTransfer::ICommunication&, IoCallback, uint32_t) { return 0; }
+    EventLoop::Id EventLoop::addGpio(const std::string&, const std::string&, std::function<void(bool)>) { return 0; }
+    EventLoop::Id EventLoop::addUio(const std::string&, std::function<void(uint32_t)>) { return 0; }
+    EventLoop::Id EventLoop::addTimer(long, long, std::function<void()>) { return 0; }
+    bool EventLoop::remove(Id) { return false; }
+    bool EventLoop::post(std::function<void()>) { return false; }
+    int EventLoop::runOnce(long) { return -1; }
+    void EventLoop::run() {}
+    bool EventLoop::start(int) { return false; }
+    void EventLoop::stop() {}
+    bool EventLoop::isInLoopThread() const { return false; }
+    size_t EventLoop::registrationCount() const { return 0; }
+#endif
+
+    EventLoopGroup::EventLoopGroup(size_t loops, bool pinToCores)
+    {
+        const size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+        if (loops == 0)
+        {
+            loops = cores;
+        }
+        for (size_t i = 0; i < loops; ++i)
+        {
+            loops_.emplace_back(new EventLoop());
+            loops_.back()->start(pinToCores ? static_cast<int>(i % cores) : -1);
+        }
+    }
+
+    EventLoopGroup::~EventLoopGroup()
+    {
+        stop();
+    }
+
+    EventLoop& EventLoopGroup::next()
+    {
+        return *loops_[next_.fetch_add(1, std::memory_order_relaxed) % loops_.size()];
+    }
+
+    EventLoop& EventLoopGroup::at(size_t index)
+    {
+        return *loops_.at(index);
+    }
+
+    size_t EventLoopGroup::size() const
+    {
+        return loops_.size();
+    }
+
+    void EventLoopGroup::stop()
+    {
+        for (auto& loop : loops_)
+        {
+            loop->stop();
+        }
+    }
+} // namespace LSX_LIB::Thread
@@ -0,0 +1,771 @@
+#include "FiberScheduler.h"
+#include <cerrno>
+#include <cstring> // 用于 strerror
+#include <exception>
+#include <iostream> // 用于错误输出
+#include <mutex>
+#include <thread>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#endif
+
+namespace LSX_LIB::Thread
+{
+#ifdef __linux__
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // 纤程栈：[保护页][可用栈]，base 指向整个映射的起始地址
+        struct FiberStack
+        {
+            void* base = nullptr;
+            size_t mappedSize = 0;
+        };
+
+        size_t pageSize()
+        {
+            static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            return size;
+        }
+
+        bool allocateStack(size_t usable, FiberStack& stack)
+        {
+            const size_t guard = pageSize();
+            const size_t total = usable + guard;
+            void* base = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+            if (base == MAP_FAILED)
+            {
+                std::cerr << "FiberScheduler: stack mmap failed: " << std::strerror(errno) << std::endl;
+                return false;
+            }
+            // 栈向低地址增长，保护页放在最低处，溢出时触发 SIGSEGV
+            if (::mprotect(base, guard, PROT_NONE) != 0)
+            {
+                std::cerr << "FiberScheduler: stack guard mprotect failed: " << std::strerror(errno) << std::endl;
+                ::munmap(base, total);
+                return false;
+            }
+            stack.base = base;
+            stack.mappedSize = total;
+            return true;
+        }
+
+        void releaseStack(FiberStack& stack)
+        {
+            if (stack.base != nullptr)
+            {
+                ::munmap(stack.base, stack.mappedSize);
+                stack.base = nullptr;
+            }
+        }
+
+        // 计算剩余等待时间，<0 表示无限等待
+        long remainingMs(long timeout_ms, Clock::time_point deadline)
+        {
+            if (timeout_ms < 0)
+            {
+                return -1;
+            }
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+            return left > 0 ? static_cast<long>(left) : 0;
+        }
+
+        // 普通线程中的等待：直接 poll
+        bool pollFd(int fd, short events, long timeout_ms)
+        {
+            pollfd pfd{};
+            pfd.fd = fd;
+            pfd.events = events;
+            int rc;
+            do
+            {
+                rc = ::poll(&pfd, 1, timeout_ms < 0 ? -1 : static_cast<int>(timeout_ms));
+            }
+            while (rc < 0 && errno == EINTR);
+            return rc != 0;
+        }
+
+        struct Fiber
+        {
+            ucontext_t context{};
+            std::function<void()> fn;
+            FiberStack stack;
+            bool finished = false;
+            // 当前等待状态（同一时刻只等待一件事）
+            int waitFd = -1;
+            uint32_t waitEvents = 0;
+            bool timedOut = false;
+            bool hasTimer = false;
+            std::multimap<Clock::time_point, Fiber*>::iterator timer;
+        };
+    }
+
+    struct FiberScheduler::Worker
+    {
+        // 等待同一描述符的纤程列表
+        struct FdWaiters
+        {
+            std::vector<Fiber*> readers;
+            std::vector<Fiber*> writers;
+            uint32_t registered = 0; // Events currently registered with epoll (0: not registered)
+        };
+
+        FiberScheduler* owner = nullptr;
+        std::thread thread;
+        ucontext_t mainContext{};
+        Fiber* current = nullptr;
+        std::deque<Fiber*> ready; // Runnable fibers (worker thread only)
+        std::multimap<Clock::time_point, Fiber*> timers; // Sleeping / timed waits (worker thread only)
+        std::unordered_map<int, FdWaiters> fdWaiters; // Fibers blocked on descriptors (worker thread only)
+        std::vector<FiberStack> stackPool; // Reusable stacks (worker thread only)
+        size_t liveFibers = 0; // Fibers owned by this worker (worker thread only)
+        int epollFd = -1;
+        int wakeFd = -1; // eventfd: new fibers in inbox or shutdown
+        std::mutex inboxMutex;
+        std::vector<Fiber*> inbox; // Fibers spawned from other threads
+
+        void run();
+        void resume(Fiber* fiber);
+        void park();
+        void makeReady(Fiber* fiber);
+        bool waitFd(int fd, uint32_t events, long timeout_ms);
+        void removeFdWaiter(Fiber* fiber);
+        void updateRegistration(int fd, FdWaiters& waiters);
+        void dispatchFdEvent(int fd, uint32_t events);
+        void fireTimers();
+        void takeInbox();
+        void wake();
+    };
+
+    namespace
+    {
+        thread_local FiberScheduler::Worker* tls_worker = nullptr;
+
+        void fiberEntry()
+        {
+            FiberScheduler::Worker* worker = tls_worker;
+            Fiber* fiber = worker->current;
+            try
+            {
+                fiber->fn();
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Fiber execution failed: " << e.what() << std::endl;
+            } catch (...)
+            {
+                std::cerr << "Fiber execution failed with unknown error." << std::endl;
+            }
+            fiber->fn = nullptr;
+            fiber->finished = true;
+            worker->park(); // 纤程不迁移，仍回到同一工作线程；已结束的纤程不会再被恢复
+        }
+    }
+
+    void FiberScheduler::Worker::wake()
+    {
+        const uint64_t one = 1;
+        (void)::write(wakeFd, &one, sizeof(one));
+    }
+
+    void FiberScheduler::Worker::takeInbox()
+    {
+        std::vector<Fiber*> spawned;
+        {
+            std::lock_guard<std::mutex> lk(inboxMutex);
+            spawned.swap(inbox);
+        }
+        for (Fiber* fiber : spawned)
+        {
+            ++liveFibers;
+            ready.push_back(fiber);
+        }
+    }
+
+    void FiberScheduler::Worker::makeReady(Fiber* fiber)
+    {
+        ready.push_back(fiber);
+    }
+
+    void FiberScheduler::Worker::park()
+    {
+        Fiber* fiber = current;
+        ::swapcontext(&fiber->context, &mainContext);
+    }
+
+    void FiberScheduler::Worker::resume(Fiber* fiber)
+    {
+        if (fiber->stack.base == nullptr)
+        {
+            // 首次运行：分配栈（优先复用栈池）并建立上下文
+            if (!stackPool.empty())
+            {
+                fiber->stack = stackPool.back();
+                stackPool.pop_back();
+            }
+            else if (!allocateStack(owner->options_.stackSize, fiber->stack))
+            {
+                --liveFibers;
+                owner->liveFibers_.fetch_sub(1);
+                delete fiber;
+                return;
+            }
+            ::getcontext(&fiber->context);
+            fiber->context.uc_stack.ss_sp = static_cast<char*>(fiber->stack.base) + pageSize();
+            fiber->context.uc_stack.ss_size = owner->options_.stackSize;
+            fiber->context.uc_link = nullptr;
+            ::makecontext(&fiber->context, &fiberEntry, 0);
+        }
+
+        current = fiber;
+        ::swapcontext(&mainContext, &fiber->context);
+        current = nullptr;
+
+        if (fiber->finished)
+        {
+            if (stackPool.size() < owner->options_.maxPooledStacks)
+            {
+                stackPool.push_back(fiber->stack);
+            }
+            else
+            {
+                releaseStack(fiber->stack);
+            }
+            delete fiber;
+            --liveFibers;
+            owner->liveFibers_.fetch_sub(1);
+        }
+    }
+
+    void FiberScheduler::Worker::updateRegistration(int fd, FdWaiters& waiters)
+    {
+        uint32_t wanted = 0;
+        if (!waiters.readers.empty()) wanted |= EPOLLIN;
+        if (!waiters.writers.empty()) wanted |= EPOLLOUT;
+        if (wanted == waiters.registered)
+        {
+            return;
+        }
+        if (wanted == 0)
+        {
+            ::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+            fdWaiters.erase(fd);
+            return;
+        }
+        epoll_event ev{};
+        ev.events = wanted;
+        ev.data.fd = fd;
+        ::epoll_ctl(epollFd, waiters.registered == 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &ev);
+        waiters.registered = wanted;
+    }
+
+    void FiberScheduler::Worker::removeFdWaiter(Fiber* fiber)
+    {
+        auto it = fdWaiters.find(fiber->waitFd);
+        if (it != fdWaiters.end())
+        {
+            std::vector<Fiber*>& list = (fiber->waitEvents & EPOLLIN) ? it->second.readers : it->second.writers;
+            for (size_t i = 0; i < list.size(); ++i)
+            {
+                if (list[i] == fiber)
+                {
+                    list[i] = list.back();
+                    list.pop_back();
+                    break;
+                }
+            }
+            updateRegistration(fiber->waitFd, it->second);
+        }
+        fiber->waitFd = -1;
+    }
+
+    bool FiberScheduler::Worker::waitFd(int fd, uint32_t events, long timeout_ms)
+    {
+        Fiber* fiber = current;
+        FdWaiters& waiters = fdWaiters[fd];
+        if (waiters.registered == 0)
+        {
+            // 先确认描述符能加入 epoll；普通文件等不支持 epoll 的描述符视为总是就绪
+            epoll_event ev{};
+            ev.events = events;
+            ev.data.fd = fd;
+            if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev) != 0)
+            {
+                fdWaiters.erase(fd);
+                return true;
+            }
+            waiters.registered = events;
+        }
+        (events & EPOLLIN ? waiters.readers : waiters.writers).push_back(fiber);
+        updateRegistration(fd, waiters);
+
+        fiber->waitFd = fd;
+        fiber->waitEvents = events;
+        fiber->timedOut = false;
+        fiber->hasTimer = timeout_ms >= 0;
+        if (fiber->hasTimer)
+        {
+            fiber->timer = timers.emplace(Clock::now() + std::chrono::milliseconds(timeout_ms), fiber);
+        }
+        park();
+        return !fiber->timedOut;
+    }
+
+    void FiberScheduler::Worker::dispatchFdEvent(int fd, uint32_t events)
+    {
+        auto it = fdWaiters.find(fd);
+        if (it == fdWaiters.end())
+        {
+            return;
+        }
+        FdWaiters& waiters = it->second;
+        const bool failed = (events & (EPOLLERR | EPOLLHUP)) != 0;
+        auto release = [this](std::vector<Fiber*>& list)
+        {
+            for (Fiber* fiber : list)
+            {
+                fiber->waitFd = -1;
+                if (fiber->hasTimer)
+                {
+                    timers.erase(fiber->timer);
+                    fiber->hasTimer = false;
+                }
+                makeReady(fiber);
+            }
+            list.clear();
+        };
+        if (failed || (events & EPOLLIN))
+        {
+            release(waiters.readers);
+        }
+        if (failed || (events & EPOLLOUT))
+        {
+            release(waiters.writers);
+        }
+        updateRegistration(fd, waiters);
+    }
+
+    void FiberScheduler::Worker::fireTimers()
+    {
+        const auto now = Clock::now();
+        while (!timers.empty() && timers.begin()->first <= now)
+        {
+            Fiber* fiber = timers.begin()->second;
+            timers.erase(timers.begin());
+            fiber->hasTimer = false;
+            if (fiber->waitFd >= 0)
+            {
+                fiber->timedOut = true;
+                removeFdWaiter(fiber);
+            }
+            makeReady(fiber);
+        }
+    }
+
+    void FiberScheduler::Worker::run()
+    {
+        tls_worker = this;
+        epoll_event events[64];
+        while (true)
+        {
+            takeInbox();
+            // 只运行本轮开始时已就绪的纤程，新就绪的（yield 等）留到下一轮，保证 I/O 和定时器得到处理
+            for (size_t n = ready.size(); n > 0 && !ready.empty(); --n)
+            {
+                Fiber* fiber = ready.front();
+                ready.pop_front();
+                resume(fiber);
+            }
+            fireTimers();
+
+            if (liveFibers == 0 && owner->stopping_.load())
+            {
+                std::lock_guard<std::mutex> lk(inboxMutex);
+                if (inbox.empty())
+                {
+                    break;
+                }
+            }
+
+            int timeout = -1;
+            if (!ready.empty())
+            {
+                timeout = 0;
+            }
+            else if (!timers.empty())
+            {
+                const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    timers.begin()->first - Clock::now()).count();
+                timeout = wait <= 0 ? 0 : static_cast<int>(wait + 1); // Round up so the timer has expired on wake-up
+            }
+            const int count = ::epoll_wait(epollFd, events, 64, timeout);
+            for (int i = 0; i < count; ++i)
+            {
+                if (events[i].data.fd == wakeFd)
+                {
+                    uint64_t value;
+                    (void)::read(wakeFd, &value, sizeof(value));
+                    continue;
+                }
+                dispatchFdEvent(events[i].data.fd, events[i].events);
+            }
+            fireTimers();
+        }
+
+        for (FiberStack& stack : stackPool)
+        {
+            releaseStack(stack);
+        }
+        stackPool.clear();
+        tls_worker = nullptr;
+    }
+
+    FiberScheduler::FiberScheduler(const FiberOptions& options) : options_(options)
+    {
+        if (options_.workers == 0) options_.workers = 1;
+        const size_t page = pageSize();
+        options_.stackSize = (options_.stackSize + page - 1) / page * page;
+        if (options_.stackSize == 0) options_.stackSize = page;
+
+        for (size_t i = 0; i < options_.workers; ++i)
+        {
+            std::unique_ptr<Worker> worker(new Worker());
+            worker->owner = this;
+            worker->epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+            worker->wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (worker->epollFd < 0 || worker->wakeFd < 0)
+            {
+                std::cerr << "FiberScheduler: epoll/eventfd creation failed: " << std::strerror(errno) << std::endl;
+                if (worker->epollFd >= 0) ::close(worker->epollFd);
+                if (worker->wakeFd >= 0) ::close(worker->wakeFd);
+                continue;
+            }
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.fd = worker->wakeFd;
+            ::epoll_ctl(worker->epollFd, EPOLL_CTL_ADD, worker->wakeFd, &ev);
+            workers_.push_back(std::move(worker));
+        }
+        for (auto& worker : workers_)
+        {
+            Worker* raw = worker.get();
+            raw->thread = std::thread([raw] { raw->run(); });
+        }
+    }
+
+    FiberScheduler::~FiberScheduler()
+    {
+        shutdown();
+    }
+
+    bool FiberScheduler::spawn(std::function<void()> fn)
+    {
+        if (workers_.empty())
+        {
+            return false;
+        }
+        const bool from_own_fiber = inFiber() && tls_worker->owner == this;
+        if (stopping_.load() && !from_own_fiber)
+        {
+            return false;
+        }
+        Fiber* fiber = new Fiber();
+        fiber->fn = std::move(fn);
+
+        Worker* worker = workers_[nextWorker_.fetch_add(1) % workers_.size()].get();
+        if (from_own_fiber && stopping_.load())
+        {
+            worker = tls_worker; // 关闭期间其他工作线程可能已退出，子纤程留在当前工作线程
+        }
+        if (tls_worker == worker)
+        {
+            liveFibers_.fetch_add(1);
+            ++worker->liveFibers;
+            worker->makeReady(fiber); // Same worker: no lock or syscall needed
+            return true;
+        }
+        {
+            std::lock_guard<std::mutex> lk(worker->inboxMutex);
+            // 在锁内再次检查：工作线程在同一把锁下确认收件箱为空后才退出
+            if (stopping_.load())
+            {
+                delete fiber;
+                return false;
+            }
+            liveFibers_.fetch_add(1);
+            worker->inbox.push_back(fiber);
+        }
+        worker->wake();
+        return true;
+    }
+
+    void FiberScheduler::shutdown()
+    {
+        stopping_.store(true);
+        if (joined_.exchange(true))
+        {
+            return;
+        }
+        for (auto& worker : workers_)
+        {
+            worker->wake();
+        }
+        for (auto& worker : workers_)
+        {
+            if (worker->thread.joinable())
+            {
+                worker->thread.join();
+            }
+            ::close(worker->epollFd);
+            ::close(worker->wakeFd);
+        }
+    }
+
+    bool FiberScheduler::inFiber()
+    {
+        return tls_worker != nullptr && tls_worker->current != nullptr;
+    }
+
+    void FiberScheduler::yield()
+    {
+        if (!inFiber())
+        {
+            std::this_thread::yield();
+            return;
+        }
+        tls_worker->makeReady(tls_worker->current);
+        tls_worker->park();
+    }
+
+    void FiberScheduler::sleepFor(long ms)
+    {
+        if (ms <= 0)
+        {
+            yield();
+            return;
+        }
+        if (!inFiber())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+            return;
+        }
+        Worker* worker = tls_worker;
+        Fiber* fiber = worker->current;
+        fiber->waitFd = -1;
+        fiber->hasTimer = true;
+        fiber->timer = worker->timers.emplace(Clock::now() + std::chrono::milliseconds(ms), fiber);
+        worker->park();
+    }
+
+    bool FiberScheduler::waitReadable(int fd, long timeout_ms)
+    {
+        if (!inFiber() || timeout_ms == 0)
+        {
+            return pollFd(fd, POLLIN, timeout_ms);
+        }
+        return tls_worker->waitFd(fd, EPOLLIN, timeout_ms);
+    }
+
+    bool FiberScheduler::waitWritable(int fd, long timeout_ms)
+    {
+        if (!inFiber() || timeout_ms == 0)
+        {
+            return pollFd(fd, POLLOUT, timeout_ms);
+        }
+        return tls_worker->waitFd(fd, EPOLLOUT, timeout_ms);
+    }
+
+    bool FiberScheduler::isStopping() const
+    {
+        return stopping_.load();
+    }
+
+    size_t FiberScheduler::fiberCount() const
+    {
+        return liveFibers_.load();
+    }
+
+    namespace FiberIO
+    {
+        bool setNonBlocking(int fd)
+        {
+            const int flags = ::fcntl(fd, F_GETFL);
+            return flags >= 0 && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+        }
+
+        namespace
+        {
+            // 通用的 "尝试 - 等待就绪 - 重试" 循环；op 返回 -1 且 errno 为 EAGAIN 时等待
+            template <typename Op>
+            ssize_t retryIo(int fd, bool forRead, long timeout_ms, Clock::time_point deadline, Op op)
+            {
+                while (true)
+                {
+                    const ssize_t n = op();
+                    if (n >= 0)
+                    {
+                        return n;
+                    }
+                    if (errno == EINTR)
+                    {
+                        continue;
+                    }
+                    if (errno != EAGAIN && errno != EWOULDBLOCK)
+                    {
+                        return -1;
+                    }
+                    const long remaining = remainingMs(timeout_ms, deadline);
+                    if (remaining == 0 ||
+                        !(forRead ? FiberScheduler::waitReadable(fd, remaining)
+                                  : FiberScheduler::waitWritable(fd, remaining)))
+                    {
+                        errno = ETIMEDOUT;
+                        return -1;
+                    }
+                }
+            }
+
+            // 写满 size 字节
+            template <typename Op>
+            ssize_t writeAll(int fd, size_t size, long timeout_ms, Op op)
+            {
+                const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms);
+                size_t done = 0;
+                while (done < size)
+                {
+                    const ssize_t n = retryIo(fd, false, timeout_ms, deadline, [&] { return op(done); });
+                    if (n < 0)
+                    {
+                        return -1;
+                    }
+                    done += static_cast<size_t>(n);
+                }
+                return static_cast<ssize_t>(size);
+            }
+        }
+
+        ssize_t recv(int fd, void* buffer, size_t size, long timeout_ms)
+        {
+            const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms);
+            return retryIo(fd, true, timeout_ms, deadline, [&] { return ::recv(fd, buffer, size, MSG_DONTWAIT); });
+        }
+
+        ssize_t send(int fd, const void* data, size_t size, long timeout_ms)
+        {
+            const char* bytes = static_cast<const char*>(data);
+            return writeAll(fd, size, timeout_ms, [&](size_t done)
+            {
+                return ::send(fd, bytes + done, size - done, MSG_DONTWAIT | MSG_NOSIGNAL);
+            });
+        }
+
+        ssize_t read(int fd, void* buffer, size_t size, long timeout_ms)
+        {
+            const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms);
+            return retryIo(fd, true, timeout_ms, deadline, [&] { return ::read(fd, buffer, size); });
+        }
+
+        ssize_t write(int fd, const void* data, size_t size, long timeout_ms)
+        {
+            const char* bytes = static_cast<const char*>(data);
+            return writeAll(fd, size, timeout_ms, [&](size_t done)
+            {
+                return ::write(fd, bytes + done, size - done);
+            });
+        }
+
+        int connect(const std::string& ip, uint16_t port, long timeout_ms)
+        {
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(port);
+            if (::inet_pton(AF_INET, ip.c_str(), &addr.sin_addr) != 1)
+            {
+                errno = EINVAL;
+                return -1;
+            }
+            const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (fd < 0)
+            {
+                return -1;
+            }
+            if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0)
+            {
+                return fd;
+            }
+            if (errno != EINPROGRESS)
+            {
+                const int saved = errno;
+                ::close(fd);
+                errno = saved;
+                return -1;
+            }
+            if (!FiberScheduler::waitWritable(fd, timeout_ms))
+            {
+                ::close(fd);
+                errno = ETIMEDOUT;
+                return -1;
+            }
+            int error = 0;
+            socklen_t len = sizeof(error);
+            if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &len) != 0 || error != 0)
+            {
+                ::close(fd);
+                errno = error != 0 ? error : errno;
+                return -1;
+            }
+            return fd;
+        }
+
+        int accept(int listen_fd, long timeout_ms)
+        {
+            const auto deadline = Clock::now() + std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms);
+            return static_cast<int>(retryIo(listen_fd, true, timeout_ms, deadline, [&]
+            {
+                return static_cast<ssize_t>(::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC));
+            }));
+        }
+    } // namespace FiberIO
+#else
+    // 非 Linux 平台：不支持纤程，等待函数退化为普通线程中的阻塞实现
+    struct FiberScheduler::Worker
+    {
+    };
+
+    FiberScheduler::FiberScheduler(const FiberOptions& options) : options_(options)
+    {
+        std::cerr << "FiberScheduler: Not supported on this platform." << std::endl;
+    }
+
+    FiberScheduler::~FiberScheduler() = default;
+
+    bool FiberScheduler::spawn(std::function<void()>) { return false; }
+    void FiberScheduler::shutdown() { stopping_.store(true); }
+    bool FiberScheduler::isStopping() const { return stopping_.load(); }
+    size_t FiberScheduler::fiberCount() const { return 0; }
+    bool FiberScheduler::inFiber() { return false; }
+    void FiberScheduler::yield() { std::this_thread::yield(); }
+
+    void FiberScheduler::sleepFor(long ms)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms > 0 ? ms : 0));
+    }
+
+    bool FiberScheduler::waitReadable(int, long) { return true; }
+    bool FiberScheduler::waitWritable(int, long) { return true; }
+#endif
+} // namespace LSX_LIB::Thread
@@ -0,0 +1,185 @@
+#include "Pipeline.h"
+#include "ThreadPool.h"
+#include <cstdio> // 用于 std::snprintf
+
+namespace LSX_LIB::Thread
+{
+    Pipeline::Pipeline() = default;
+
+    Pipeline::~Pipeline()
+    {
+        stop();
+        wait();
+        pool_.reset(); // 所有工作线程已返回，这里只是 join
+    }
+
+    void Pipeline::ensureNotStarted()
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (started_)
+        {
+            throw std::logic_error("Pipeline: stages cannot be added after start()");
+        }
+    }
+
+    void Pipeline::addStage(std::unique_ptr<PipelineDetail::StageBase> stage)
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (started_)
+        {
+            throw std::logic_error("Pipeline: stages cannot be added after start()");
+        }
+        stages_.push_back(std::move(stage));
+    }
+
+    void Pipeline::start()
+    {
+        size_t total_workers = 0;
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            if (started_)
+            {
+                throw std::logic_error("Pipeline: already started");
+            }
+            if (stages_.empty())
+            {
+                throw std::logic_error("Pipeline: no stages");
+            }
+            for (const auto& stage : stages_)
+            {
+                if (!stage->outputConnected())
+                {
+                    throw std::logic_error("Pipeline: output of stage '" + stage->name + "' is not connected");
+                }
+                total_workers += stage->options.parallelism;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            rateBases_.assign(stages_.size(), RateBase());
+            for (RateBase& base : rateBases_)
+            {
+                base.time = now;
+            }
+            for (const auto& stage : stages_)
+            {
+                stage->activeWorkers.store(stage->options.parallelism);
+            }
+            runningWorkers_ = total_workers;
+            started_ = true;
+        }
+
+        // 每个工作线程常驻一个线程池线程，线程数恰好等于各阶段并行度之和
+        pool_.reset(new ThreadPool(total_workers));
+        for (const auto& stage : stages_)
+        {
+            PipelineDetail::StageBase* raw = stage.get();
+            for (size_t i = 0; i < raw->options.parallelism; ++i)
+            {
+                pool_->enqueue([this, raw]() { runWorker(raw); });
+            }
+        }
+    }
+
+    void Pipeline::runWorker(PipelineDetail::StageBase* stage)
+    {
+        stage->runWorker(stopping_);
+        if (stage->activeWorkers.fetch_sub(1) == 1)
+        {
+            // 本阶段最后一个工作线程结束：下游取空通道后也将结束
+            stage->closeOutput();
+        }
+        {
+            std::lock_guard<std::mutex> lk(mutex_);
+            --runningWorkers_;
+        }
+        done_cv_.notify_all();
+    }
+
+    void Pipeline::stop()
+    {
+        stopping_.store(true);
+    }
+
+    bool Pipeline::wait(long timeout_ms)
+    {
+        std::unique_lock<std::mutex> lk(mutex_);
+        auto finished = [this] { return runningWorkers_ == 0; };
+        if (timeout_ms < 0)
+        {
+            done_cv_.wait(lk, finished);
+            return true;
+        }
+        return done_cv_.wait_for(lk, std::chrono::milliseconds(timeout_ms), finished);
+    }
+
+    std::vector<StageMetrics> Pipeline::metrics()
+    {
+        std::lock_guard<std::mutex> lk(mutex_);
+        const auto now = std::chrono::steady_clock::now();
+        std::vector<StageMetrics> result;
+        result.reserve(stages_.size());
+        for (size_t i = 0; i < stages_.size(); ++i)
+        {
+            PipelineDetail::StageBase& stage = *stages_[i];
+            const PipelineDetail::StageCounters& counters = stage.counters;
+            StageMetrics m;
+            m.name = stage.name;
+            m.parallelism = stage.options.parallelism;
+            m.activeWorkers = started_ ? stage.activeWorkers.load() : 0;
+            m.itemsIn = counters.itemsIn.load(std::memory_order_relaxed);
+            m.itemsOut = counters.itemsOut.load(std::memory_order_relaxed);
+            m.errors = counters.errors.load(std::memory_order_relaxed);
+            m.queueDepth = stage.queueDepth();
+            m.queueCapacity = stage.queueCapacity();
+            m.blockedMs = static_cast<double>(counters.blockedNs.load(std::memory_order_relaxed)) / 1e6;
+            m.maxBatchUs = static_cast<double>(stage.counters.maxBatchNs.exchange(0, std::memory_order_relaxed)) / 1e3;
+
+            if (i < rateBases_.size())
+            {
+                // 数据源没有输入，按输出计算吞吐量
+                const bool is_source = stage.queueCapacity() == 0;
+                const uint64_t items = is_source ? m.itemsOut : m.itemsIn;
+                const uint64_t process_ns = counters.processNs.load(std::memory_order_relaxed);
+                RateBase& base = rateBases_[i];
+                const double elapsed_s = std::chrono::duration<double>(now - base.time).count();
+                if (elapsed_s > 0.0)
+                {
+                    m.itemsPerSecond = static_cast<double>(items - base.items) / elapsed_s;
+                }
+                if (!is_source && m.itemsIn > base.items)
+                {
+                    m.avgProcessUs = static_cast<double>(process_ns - base.processNs) / 1e3 /
+                        static_cast<double>(m.itemsIn - base.items);
+                }
+                base.items = items;
+                base.processNs = process_ns;
+                base.time = now;
+            }
+            result.push_back(std::move(m));
+        }
+        return result;
+    }
+
+    void Pipeline::dump(std::ostream& os)
+    {
+        const std::vector<StageMetrics> snapshot = metrics();
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-20s %7s %12s %12s %10s %10s %10s %15s %10s %6s\n",
+                      "stage", "workers", "in", "out", "items/s", "avg_us", "max_us", "queue", "blocked_ms", "errors");
+        os << line;
+        for (const StageMetrics& m : snapshot)
+        {
+            char workers[24];
+            std::snprintf(workers, sizeof(workers), "%zu/%zu", m.activeWorkers, m.parallelism);
+            char queue[40];
+            std::snprintf(queue, sizeof(queue), "%zu/%zu", m.queueDepth, m.queueCapacity);
+            std::snprintf(line, sizeof(line), "%-20s %7s %12llu %12llu %10.0f %10.2f %10.2f %15s %10.1f %6llu\n",
+                          m.name.c_str(), workers,
+                          static_cast<unsigned long long>(m.itemsIn),
+                          static_cast<unsigned long long>(m.itemsOut),
+                          m.itemsPerSecond, m.avgProcessUs, m.maxBatchUs, queue, m.blockedMs,
+                          static_cast<unsigned long long>(m.errors));
+            os << line;
+        }
+    }
+} // namespace LSX_LIB::Thread
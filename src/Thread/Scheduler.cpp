@@ -4,30 +4,152 @@
 #include <iostream> // 用于可能的错误/调试输出
 #include <algorithm> // 用于清理已完成的任务
 #include <vector>    // 显式包含 vector
+#include <condition_variable> // 用于可被 shutdown 打断的等待
+#include <cstdio>    // 用于 snprintf
+#include "CpuClock.h" // 用于读取任务线程的 CPU 时间
 
 namespace LSX_LIB::Thread
 {
-    void Scheduler::scheduleOnce(int delayMs, std::function<void()> func)
+    namespace
+    {
+        // 为任务线程创建 Watchdog 探针，未关联 Watchdog 时返回空
+        std::shared_ptr<Watchdog::Probe> makeProbe(Watchdog* watchdog, const std::string& name)
+        {
+            if (watchdog == nullptr)
+            {
+                return nullptr;
+            }
+            return watchdog->createProbe(name.empty() ? "scheduler" : "scheduler:" + name);
+        }
+
+        // 执行 func 并测量其 CPU 时间和墙钟时间（毫秒）。func 抛出异常时同样填入耗时再重新抛出，
+        // 失败的执行也要计入预算和超时检查
+        template <typename F>
+        void measureRun(F&& func, double& cpuMs, double& wallMs)
+        {
+            const int64_t cpu_start = CpuClock::threadNs();
+            const auto wall_start = std::chrono::steady_clock::now();
+            auto finish = [&]()
+            {
+                const int64_t cpu_end = CpuClock::threadNs();
+                wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall_start).count();
+                cpuMs = (cpu_start < 0 || cpu_end < 0) ? 0.0 : static_cast<double>(cpu_end - cpu_start) / 1e6;
+            };
+            try
+            {
+                func();
+            }
+            catch (...)
+            {
+                finish();
+                throw;
+            }
+            finish();
+        }
+    }
+
+    /**
+     * @brief 单个任务的统计与预算状态。由任务线程和 Scheduler 共享。
+     */
+    struct Scheduler::JobRecord
+    {
+        std::mutex mtx; // Protects everything below
+        std::condition_variable cv; // Wakes delay/deferral waits on shutdown
+        bool cancelled = false; // Set by shutdown()
+        JobStats stats;
+        std::chrono::steady_clock::time_point lastRefill; // Last time the budget balance was topped up
+
+        // 按经过的时间补充预算额度，余额上限为一个窗口的额度。调用者持有 mtx
+        void refill(std::chrono::steady_clock::time_point now)
+        {
+            const double elapsed_ms = std::chrono::duration<double, std::milli>(now - lastRefill).count();
+            lastRefill = now;
+            stats.budgetBalanceMs = std::min<double>(stats.budgetCpuMs,
+                stats.budgetBalanceMs + elapsed_ms * stats.budgetCpuMs / stats.budgetWindowMs);
+        }
+
+        // 记录一次执行。调用者持有 mtx
+        void record(double cpuMs, double wallMs)
+        {
+            ++stats.runs;
+            stats.totalCpuMs += cpuMs;
+            stats.totalWallMs += wallMs;
+            stats.lastCpuMs = cpuMs;
+            stats.lastWallMs = wallMs;
+            stats.maxCpuMs = std::max(stats.maxCpuMs, cpuMs);
+            stats.maxWallMs = std::max(stats.maxWallMs, wallMs);
+            if (stats.budgetCpuMs > 0)
+            {
+                stats.budgetBalanceMs -= cpuMs;
+            }
+        }
+    };
+
+    std::shared_ptr<Scheduler::JobRecord> Scheduler::addJob(const std::string& name, bool periodic, long intervalMs,
+                                                            const CpuBudget& budget)
+    {
+        // 移除已结束的一次性任务的记录，避免列表无限增长
+        jobs_.erase(std::remove_if(jobs_.begin(), jobs_.end(), [](const std::shared_ptr<JobRecord>& job)
+        {
+            std::lock_guard<std::mutex> lk(job->mtx);
+            return !job->stats.periodic && job->stats.finished;
+        }), jobs_.end());
+
+        auto job = std::make_shared<JobRecord>();
+        job->stats.name = name;
+        job->stats.periodic = periodic;
+        job->stats.intervalMs = intervalMs;
+        if (budget.cpuMs > 0)
+        {
+            job->stats.budgetCpuMs = budget.cpuMs;
+            job->stats.budgetWindowMs = budget.windowMs > 0 ? budget.windowMs : std::max(intervalMs, 1L);
+            job->stats.budgetAction = budget.action;
+            job->stats.budgetBalanceMs = static_cast<double>(budget.cpuMs);
+        }
+        job->lastRefill = std::chrono::steady_clock::now();
+        jobs_.push_back(job);
+        return job;
+    }
+
+    void Scheduler::setWatchdog(Watchdog* watchdog)
+    {
+        std::lock_guard<std::mutex> lk(tasks_mtx_);
+        watchdog_ = watchdog;
+    }
+
+    void Scheduler::scheduleOnce(int delayMs, std::function<void()> func, const std::string& name)
     {
         // 创建一个 ThreadWrapper 来执行一次性延迟任务
         auto tw = std::make_shared<ThreadWrapper>();
+        std::shared_ptr<Watchdog::Probe> probe;
+        std::shared_ptr<JobRecord> job;
+        {
+            std::lock_guard<std::mutex> lk(tasks_mtx_);
+            probe = makeProbe(watchdog_, name);
+            job = addJob(name, false, delayMs, CpuBudget());
+        }
 
         // 绑定任务：先等待指定时间，然后执行实际任务
-        // 捕获 tw 智能指针，以延长其生命周期至 lambda 执行完毕
-        tw->setTask([delayMs, func, tw]()
+        // 不捕获 tw：线程不分离，tw 由 tasks_ 持有直到线程结束后被清理或 shutdown 时 join
+        tw->setTask([delayMs, func, probe, job, name]()
         {
-            if (delayMs > 0)
+            bool cancelled;
             {
-                // 使用 sleep_for 模拟延迟
-                // 注意：如果需要更精确的延迟且能响应停止，应使用条件变量的 timed_wait
-                std::this_thread::sleep_for(std::chrono::milliseconds(delayMs));
+                // 在条件变量上等待延迟，shutdown 会立即打断等待
+                std::unique_lock<std::mutex> lk(job->mtx);
+                job->cv.wait_for(lk, std::chrono::milliseconds(std::max(delayMs, 0)), [&] { return job->cancelled; });
+                cancelled = job->cancelled;
             }
-            // 在执行实际任务前检查停止标志
-            if (tw->getState() != ThreadState::STOPPED)
+            // 在执行实际任务前检查 shutdown 请求
+            if (!cancelled)
             {
+                double cpu_ms = 0;
+                double wall_ms = 0;
                 try
                 {
-                    func(); // 执行用户任务
+                    Watchdog::Scope scope(probe.get()); // 执行期间受 Watchdog 监控
+                    if (probe && !name.empty()) probe->setTaskName(name);
+                    measureRun(func, cpu_ms, wall_ms); // 执行用户任务
                 }
                 catch (const std::exception& e)
                 {
@@ -36,83 +158,113 @@ namespace LSX_LIB::Thread
                 {
                     std::cerr << "Scheduled task execution failed with unknown error." << std::endl;
                 }
+                std::lock_guard<std::mutex> lk(job->mtx);
+                job->record(cpu_ms, wall_ms);
             }
-            // 任务执行完毕（或被停止），可以在 Scheduler 中清理
-            // 这里不直接清理，由 shutdown 或定期清理机制处理已停止的任务
+            {
+                std::lock_guard<std::mutex> lk(job->mtx);
+                job->stats.finished = true;
+            }
+            // 任务执行完毕（或被停止），线程随后退出，由下一次调度或 shutdown 清理
         });
 
-        // 启动线程 (分离，因为我们不关心等待单次任务完成，并希望其完成后自动清理资源)
-        // 如果希望能在 shutdown 时等待所有一次性任务完成，这里不应分离
-        tw->start(true); // 使用分离线程
+        // 启动线程 (不分离：延迟等待可被 shutdown 打断，shutdown 可以 join 所有一次性任务)
+        tw->start(false);
 
-        // 将线程包装器添加到列表中管理
-        // 注意：对于分离线程，tasks_ 列表中的 shared_ptr 只是一个引用
-        // 线程结束后，ThreadWrapper 对象会自动销毁（如果tw是最后一个引用）
-        // 但 tasks_ 列表中的 shared_ptr 不会自动移除，需要定期清理
+        // 将线程包装器添加到列表中管理，同时清理已经结束的任务线程，避免 tasks_ 一直增长
         std::lock_guard<std::mutex> lk(tasks_mtx_);
+        tasks_.erase(std::remove_if(tasks_.begin(), tasks_.end(),
+                                    [](const std::shared_ptr<ThreadWrapper>& t)
+                                    {
+                                        return t && t->getState() == ThreadState::STOPPED;
+                                    }), tasks_.end());
         tasks_.push_back(tw);
+    }
 
-        // 考虑定期清理 tasks_ 中已经 STOPPED 状态且已分离的 ThreadWrapper
-        // 否则 tasks_ 会一直增长
-        // 例如，可以在每次添加任务后，或者在 shutdown 中添加清理逻辑
-        // tasks_.erase(std::remove_if(tasks_.begin(), tasks_.end(),
-        //                              [](const std::shared_ptr<ThreadWrapper>& t){
-        //                                  return t && t->getState() == ThreadState::STOPPED;
-        //                              }), tasks_.end());
+    void Scheduler::schedulePeriodic(int intervalMs, std::function<void()> func, const std::string& name)
+    {
+        schedulePeriodic(intervalMs, std::move(func), name, CpuBudget());
     }
 
-    void Scheduler::schedulePeriodic(int intervalMs, std::function<void()> func)
+    void Scheduler::schedulePeriodic(int intervalMs, std::function<void()> func, const std::string& name,
+                                     const CpuBudget& budget)
     {
         // 创建一个 ThreadWrapper 来执行周期性任务
         auto tw = std::make_shared<ThreadWrapper>();
+        std::shared_ptr<Watchdog::Probe> probe;
+        std::shared_ptr<JobRecord> job;
+        {
+            std::lock_guard<std::mutex> lk(tasks_mtx_);
+            probe = makeProbe(watchdog_, name);
+            job = addJob(name, true, intervalMs, budget);
+        }
 
-        // 绑定任务：在无限循环中执行任务并等待指定间隔
-        // 注意：退出循环的条件是 ThreadWrapper 接收到停止请求
-        // 捕获 tw 智能指针，以延长其生命周期
-        tw->setTask([intervalMs, func, tw]()
+        // 绑定循环任务：ThreadWrapper 在同一个线程中按固定周期反复调用，
+        // 周期等待由 ThreadWrapper 完成，stop() 会立即打断等待
+        tw->setLoopTask([intervalMs, func, probe, job, name]()
         {
-            // 周期任务的循环是在这里实现的
-            while (tw->getState() != ThreadState::STOPPED)
             {
-                // 在执行任务前检查是否被暂停
-                // ThreadWrapper 的 threadFunc 会在 task_() 调用前处理暂停
-                // 所以这里不需要额外的暂停检查，调用 func() 即可
-
-                try
+                std::unique_lock<std::mutex> lk(job->mtx);
+                if (job->cancelled)
                 {
-                    func(); // 执行用户任务
+                    return; // shutdown 中，不再开始新的执行
                 }
-                catch (const std::exception& e)
-                {
-                    std::cerr << "Periodic task execution failed: " << e.what() << std::endl;
-                    // 周期任务失败是否停止取决于需求，这里选择继续
-                } catch (...)
+                if (job->stats.budgetCpuMs > 0)
                 {
-                    std::cerr << "Periodic task execution failed with unknown error." << std::endl;
-                    // 选择继续
+                    // 超出 CPU 预算：跳过本周期，或等待额度恢复后再执行
+                    job->refill(std::chrono::steady_clock::now());
+                    if (job->stats.budgetBalanceMs < 0)
+                    {
+                        if (job->stats.budgetAction == BudgetAction::Skip)
+                        {
+                            ++job->stats.skipped;
+                            return;
+                        }
+                        ++job->stats.deferred;
+                        const double wait_ms = -job->stats.budgetBalanceMs * job->stats.budgetWindowMs / job->stats.budgetCpuMs;
+                        if (job->cv.wait_for(lk, std::chrono::duration<double, std::milli>(wait_ms),
+                                             [&] { return job->cancelled; }))
+                        {
+                            return;
+                        }
+                        job->refill(std::chrono::steady_clock::now());
+                    }
                 }
+            }
 
-                // 执行完任务后等待指定间隔
-                // 在等待期间也需要检查停止标志
-                // std::this_thread::sleep_for 是阻塞的，如果等待期间需要响应停止，
-                // 更好的方式是使用条件变量进行 timed_wait 并检查停止标志
-                auto start_wait = std::chrono::steady_clock::now();
-                auto end_wait = start_wait + std::chrono::milliseconds(intervalMs);
-                bool stopped_during_wait = false;
-                while (std::chrono::steady_clock::now() < end_wait)
+            double cpu_ms = 0;
+            double wall_ms = 0;
+            try
+            {
+                Watchdog::Scope scope(probe.get()); // 执行期间受 Watchdog 监控
+                if (probe && !name.empty()) probe->setTaskName(name);
+                measureRun(func, cpu_ms, wall_ms); // 执行用户任务
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Periodic task execution failed: " << e.what() << std::endl;
+                // 周期任务失败是否停止取决于需求，这里选择继续
+            } catch (...)
+            {
+                std::cerr << "Periodic task execution failed with unknown error." << std::endl;
+                // 选择继续
+            }
+            {
+                std::lock_guard<std::mutex> lk(job->mtx);
+                job->record(cpu_ms, wall_ms);
+            }
+            if (probe)
+            {
+                // 单次执行超过周期：下一次执行已经被推迟
+                const long elapsed_ms = static_cast<long>(wall_ms);
+                if (elapsed_ms > intervalMs)
                 {
-                    if (tw->getState() == ThreadState::STOPPED)
-                    {
-                        stopped_during_wait = true;
-                        break;
-                    }
-                    // 短暂休眠以避免忙等
-                    std::this_thread::sleep_for(std::chrono::milliseconds(10)); // 或更短
+                    if (!name.empty()) probe->setTaskName(name);
+                    probe->reportOverrun(intervalMs, elapsed_ms);
                 }
-                if (stopped_during_wait) break; // 如果等待期间停止，退出周期循环
             }
-            // 周期任务结束（因停止请求）
         });
+        tw->setLoopInterval(intervalMs);
 
         // 启动线程 (默认不分离，shutdown 需要 join 以确保线程退出)
         tw->start(false); // 使用可join线程
@@ -121,27 +273,77 @@ namespace LSX_LIB::Thread
         std::lock_guard<std::mutex> lk(tasks_mtx_);
         tasks_.push_back(tw);
 
-        // 对于可join线程，shutdown 时会清理
-        // 对于分离线程（如 scheduleOnce 使用），需要定期清理 tasks_
+        // 可join线程在 shutdown 时清理
     }
 
     void Scheduler::shutdown()
     {
-        // 锁定 tasks_ 向量，防止在停止时有新任务被添加
-        std::lock_guard<std::mutex> lk(tasks_mtx_);
-
-        // 遍历所有任务，请求停止并join (对于可join的线程)
-        // 对于分离的线程，stop() 只是设置标志，join 会失败或无操作
-        for (auto& tw : tasks_)
+        // 在锁内取出任务列表，在锁外停止并 join：正在执行的任务可能调用 scheduleOnce/jobStats 等
+        // 需要 tasks_mtx_ 的方法，持锁 join 会互相等待。停止期间新加入的任务在下一轮处理
+        while (true)
         {
-            // 检查智能指针是否有效
-            if (tw)
+            std::vector<std::shared_ptr<ThreadWrapper>> tasks;
+            std::vector<std::shared_ptr<JobRecord>> jobs;
             {
-                tw->stop(); // 请求线程停止并等待其join完成 (如果可join)
+                std::lock_guard<std::mutex> lk(tasks_mtx_);
+                tasks.swap(tasks_);
+                jobs.swap(jobs_);
+            }
+            if (tasks.empty() && jobs.empty())
+            {
+                break;
+            }
+
+            // 先打断所有任务在延迟或预算推迟中的等待
+            for (auto& job : jobs)
+            {
+                {
+                    std::lock_guard<std::mutex> job_lk(job->mtx);
+                    job->cancelled = true;
+                }
+                job->cv.notify_all();
+            }
+
+            // 遍历所有任务，请求停止并join；正在执行的一次性任务会先执行完
+            for (auto& tw : tasks)
+            {
+                // 检查智能指针是否有效
+                if (tw)
+                {
+                    tw->stop(); // 请求线程停止并等待其join完成 (如果可join)
+                }
             }
         }
+    }
+
+    std::vector<JobStats> Scheduler::jobStats() const
+    {
+        std::lock_guard<std::mutex> lk(tasks_mtx_);
+        std::vector<JobStats> stats;
+        stats.reserve(jobs_.size());
+        for (const auto& job : jobs_)
+        {
+            std::lock_guard<std::mutex> job_lk(job->mtx);
+            stats.push_back(job->stats);
+        }
+        return stats;
+    }
 
-        // 清空任务列表
-        tasks_.clear();
+    void Scheduler::dumpStats(std::ostream& os) const
+    {
+        const std::vector<JobStats> stats = jobStats();
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-24s %8s %8s %8s %8s %12s %12s %10s %10s %12s\n", "job", "period", "runs",
+                      "deferred", "skipped", "cpu_ms", "wall_ms", "max_cpu", "max_wall", "budget_ms");
+        os << line;
+        for (const JobStats& job : stats)
+        {
+            std::snprintf(line, sizeof(line), "%-24s %8ld %8llu %8llu %8llu %12.1f %12.1f %10.1f %10.1f %12ld\n",
+                          job.name.empty() ? "<unnamed>" : job.name.c_str(), job.periodic ? job.intervalMs : 0L,
+                          static_cast<unsigned long long>(job.runs), static_cast<unsigned long long>(job.deferred),
+                          static_cast<unsigned long long>(job.skipped), job.totalCpuMs, job.totalWallMs,
+                          job.maxCpuMs, job.maxWallMs, job.budgetCpuMs);
+            os << line;
+        }
     }
 }
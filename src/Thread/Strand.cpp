@@ -0,0 +1,115 @@
+#include "Strand.h"
+#include "MpscQueue.h"
+#include <atomic>
+#include <exception>
+#include <iostream> // 用于任务异常输出
+
+namespace LSX_LIB::Thread
+{
+    struct Strand::Impl : std::enable_shared_from_this<Strand::Impl>
+    {
+        Impl(IThreadPool& p, size_t batch) : pool(p), maxBatch(batch == 0 ? 1 : batch)
+        {
+        }
+
+        // 把一次执行任务提交到线程池，调用前必须已把 scheduled 置为 true
+        void schedule()
+        {
+            std::shared_ptr<Impl> self = shared_from_this();
+            pool.enqueue([self]() { self->drain(); });
+        }
+
+        // 在工作线程上连续执行最多 maxBatch 个任务
+        void drain();
+
+        IThreadPool& pool;
+        const size_t maxBatch;
+        MpscQueue<std::function<void()>> queue; // 待执行任务，消费者为当前持有 scheduled 的执行任务
+        std::atomic<bool> scheduled{false}; // 线程池中是否已有（或正在运行）本 Strand 的执行任务
+    };
+
+    namespace
+    {
+        // 当前线程正在执行的 Strand，用于 dispatch 和 runningInThisThread
+        thread_local const void* tls_current_strand = nullptr;
+
+        // 执行单个任务并吸收异常，保证后续任务和调度状态不受影响
+        void runTask(std::function<void()>& task)
+        {
+            try
+            {
+                task();
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Strand task execution failed: " << e.what() << std::endl;
+            } catch (...)
+            {
+                std::cerr << "Strand task execution failed with unknown error." << std::endl;
+            }
+        }
+    }
+
+    void Strand::Impl::drain()
+    {
+        const void* previous = tls_current_strand;
+        tls_current_strand = this;
+
+        std::function<void()> task;
+        for (size_t executed = 0; executed < maxBatch && queue.tryPop(task); ++executed)
+        {
+            runTask(task);
+            task = nullptr; // 尽早释放任务捕获的资源
+        }
+
+        tls_current_strand = previous;
+
+        if (!queue.empty())
+        {
+            // 批次用完或有生产者正在入队：保持 scheduled，排到线程池队尾让其他任务先执行
+            schedule();
+            return;
+        }
+
+        scheduled.store(false);
+        // 生产者可能在上面的 empty() 之后入队，但在 store(false) 之前看到 scheduled == true 而未提交执行任务；
+        // 与 push 中的 seq_cst 交换配对，这里重新检查即可保证任务不会滞留
+        if (!queue.empty() && !scheduled.exchange(true))
+        {
+            schedule();
+        }
+    }
+
+    Strand::Strand(IThreadPool& pool, size_t maxBatch) : impl_(std::make_shared<Impl>(pool, maxBatch))
+    {
+    }
+
+    void Strand::post(std::function<void()> task)
+    {
+        impl_->queue.push(std::move(task));
+        if (!impl_->scheduled.exchange(true))
+        {
+            impl_->schedule();
+        }
+    }
+
+    void Strand::dispatch(std::function<void()> task)
+    {
+        if (runningInThisThread())
+        {
+            task(); // 已在本 Strand 中，串行性由当前执行任务保证
+            return;
+        }
+        post(std::move(task));
+    }
+
+    bool Strand::runningInThisThread() const
+    {
+        return tls_current_strand == impl_.get();
+    }
+
+    size_t Strand::pending() const
+    {
+        return impl_->queue.sizeApprox();
+    }
+} // namespace LSX_LIB::Thread
@@ -4,6 +4,13 @@
 #include <chrono>   // 用于 sleep 或 timed_wait
 #include <system_error> // 用于捕获 join 异常
 
+#include <cerrno> // 用于 errno
+#include <cstring> // 用于 strerror
+
+#ifndef _WIN32
+#include <poll.h> // 用于循环模式下同时等待描述符和唤醒通知
+#endif
+
 namespace LSX_LIB::Thread
 {
     ThreadWrapper::ThreadWrapper()
@@ -23,7 +30,7 @@ namespace LSX_LIB::Thread
     {
         // 确保在启动前任务已设置且当前非运行状态
         std::lock_guard<std::mutex> lk(mtx_);
-        if (!task_ || state_ == ThreadState::RUNNING)
+        if ((!task_ && !loopTask_) || state_ == ThreadState::RUNNING)
         {
             // 可以选择抛出异常或打印警告
             // std::cerr << "Warning: Cannot start thread. Task not set or already running.\n";
@@ -34,6 +41,17 @@ namespace LSX_LIB::Thread
         pauseFlag_.store(false);
         state_.store(ThreadState::RUNNING);
 
+        if (loopTask_)
+        {
+            iterations_.store(0);
+            nextRun_ = std::chrono::steady_clock::now(); // 第一次迭代立即执行
+            if (loopWaitFd_ >= 0 && !wakeNotifier_.Enable())
+            {
+                std::cerr << "ThreadWrapper: failed to create wake handle, loop wait handle ignored." << std::endl;
+            }
+            wakeNotifier_.Reset();
+        }
+
         // 创建并启动新线程
         worker_ = std::thread(&ThreadWrapper::threadFunc, this);
 
@@ -45,12 +63,15 @@ namespace LSX_LIB::Thread
 
     void ThreadWrapper::stop()
     {
-        // 设置停止标志
-        stopFlag_.store(true);
-
-        // 唤醒任何正在等待的线程 (如暂停状态或等待任务状态)
-        resume(); // 调用 resume 确保即使在 pause 状态也能被唤醒
-        cv_.notify_one(); // 额外通知一次，确保等待任务的 cv.wait_for 也能被唤醒
+        // 在锁内设置停止标志，避免线程在检查标志与进入等待之间错过通知
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            stopFlag_.store(true);
+            pauseFlag_.store(false);
+            wakeLoop();
+        }
+        // 唤醒任何正在等待的线程 (暂停状态或循环模式的定时等待)
+        cv_.notify_all();
 
         // 如果线程是可joinable的 (未分离)，等待其完成
         // 必须在设置 stopFlag_ 并通知后进行 join
@@ -67,50 +88,60 @@ namespace LSX_LIB::Thread
             }
         }
 
-        // 更新状态为停止
+        // 更新状态为停止；绑定的任务保留，供 restart() 再次启动
         state_.store(ThreadState::STOPPED);
-        // 清理任务，准备可能的 restart
-        std::lock_guard<std::mutex> lk(mtx_);
-        task_ = nullptr;
     }
 
     void ThreadWrapper::pause()
     {
         // 只有在 RUNNING 状态下才能请求暂停
+        std::lock_guard<std::mutex> lk(mtx_);
         if (state_ == ThreadState::RUNNING)
         {
             pauseFlag_.store(true);
             state_.store(ThreadState::PAUSED);
-            // 注意：实际暂停发生在 threadFunc 中的条件变量等待
+            // 注意：实际暂停发生在 threadFunc 中的条件变量等待；循环模式下打断当前的迭代等待
+            wakeLoop();
+            cv_.notify_all();
         }
     }
 
     void ThreadWrapper::resume()
     {
         // 如果当前是暂停状态，清除暂停标志并唤醒线程
+        std::lock_guard<std::mutex> lk(mtx_);
         if (pauseFlag_.load())
         {
             pauseFlag_.store(false);
-            // 唤醒 threadFunc 中等待 pauseFlag_ 的线程
-            cv_.notify_one();
             // 状态更新为 RUNNING (假设唤醒后会立即继续运行)
             state_.store(ThreadState::RUNNING);
+            // 唤醒 threadFunc 中等待 pauseFlag_ 的线程
+            cv_.notify_all();
         }
     }
 
     void ThreadWrapper::restart(bool detached)
     {
-        stop(); // 先停止当前线程
-        // task_ 在 stop() 中被清理，restart 需要重新 setTask
-        // 在实际使用中，restart 后通常需要再次调用 setTask()
-        // 为了简化，此处假设 setTask() 会在 restart 之后立即调用
-        // 如果需要在 restart 中保留原任务，需要调整 stop() 的逻辑
-        // 例如：task_ 保持不变，在 threadFunc 退出前不清理 task_
-        // 或者在 restart 中重新绑定 task_
-        // 当前实现下，调用 restart 后必须再次调用 setTask 才能再次运行任务
-        // std::cerr << "Warning: Restart requires setTask() to be called again.\n";
-        // 更好的设计是在 restart 中接收任务参数，或者保存/恢复 task_
-        start(detached); // 重新启动新线程
+        stop(); // 先停止当前线程；stop() 保留绑定的任务和循环设置
+        start(detached); // 用原来的任务重新启动新线程
+    }
+
+    void ThreadWrapper::setLoopInterval(long intervalMs)
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        loopIntervalMs_ = intervalMs;
+    }
+
+    void ThreadWrapper::setLoopWaitHandle(int fd)
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        loopWaitFd_ = fd;
+    }
+
+    void ThreadWrapper::wakeLoop()
+    {
+        // 调用者持有 mtx_；未启用时 Signal 不产生系统调用
+        wakeNotifier_.Signal();
     }
 
     void ThreadWrapper::threadFunc()
@@ -130,6 +161,13 @@ namespace LSX_LIB::Thread
             // 如果需要等待任务，可以增加一个任务就绪标志
         }
 
+        if (loopTask_)
+        {
+            runLoop();
+            state_.store(ThreadState::STOPPED);
+            return;
+        }
+
         // 检查任务是否有效且没有停止请求
         // 如果 task_ 是在 start 之前设置的，且 start 成功，这里 task_ 应该非空
         if (!task_ || stopFlag_.load())
@@ -189,4 +227,144 @@ namespace LSX_LIB::Thread
         state_.store(ThreadState::STOPPED); // 线程正常退出或被停止后状态
         // task_ = nullptr; // 不在这里清理 task_，让 stop() 或 restart() 处理
     }
+
+    void ThreadWrapper::runLoop()
+    {
+        // --- 循环模式 ---
+        // 同一个线程中反复调用 loopTask_，每次迭代之前处理暂停/停止，并按设置等待定时器或描述符
+        while (!stopFlag_.load())
+        {
+            // --- 处理暂停 ---
+            if (pauseFlag_.load())
+            {
+                std::unique_lock<std::mutex> lk(mtx_);
+                cv_.wait(lk, [&] { return !pauseFlag_.load() || stopFlag_.load(); });
+                if (stopFlag_.load())
+                {
+                    break;
+                }
+                // 暂停期间错过的周期不补跑
+                nextRun_ = std::chrono::steady_clock::now();
+                continue;
+            }
+
+            // --- 等待下一次迭代 ---
+            if (!waitForIteration())
+            {
+                continue; // 被暂停/停止请求打断，回到循环开头重新检查
+            }
+
+            // --- 执行一次迭代 ---
+            bool keepRunning = true;
+            try
+            {
+                keepRunning = loopTask_();
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "Task execution failed: " << e.what() << std::endl;
+                stopFlag_.store(true); // 与一次性模式一致，任务失败后停止线程
+            } catch (...)
+            {
+                std::cerr << "Task execution failed with unknown error." << std::endl;
+                stopFlag_.store(true);
+            }
+            iterations_.fetch_add(1);
+
+            if (!keepRunning)
+            {
+                break; // 任务要求结束循环
+            }
+
+            if (loopIntervalMs_ > 0)
+            {
+                // 固定频率：以上一次计划时间为基准，落后时从当前时间重新开始计时
+                const auto now = std::chrono::steady_clock::now();
+                nextRun_ += std::chrono::milliseconds(loopIntervalMs_);
+                if (nextRun_ < now)
+                {
+                    nextRun_ = now;
+                }
+            }
+        }
+    }
+
+    bool ThreadWrapper::waitForIteration()
+    {
+        const bool timed = loopIntervalMs_ > 0;
+        std::unique_lock<std::mutex> lk(mtx_);
+        const auto interrupted = [&] { return stopFlag_.load() || pauseFlag_.load(); };
+
+        if (loopWaitFd_ < 0 || !wakeNotifier_.IsEnabled())
+        {
+            if (!timed)
+            {
+                return !interrupted();
+            }
+            // 仅定时器：在条件变量上等待到计划时间，暂停/停止请求会立即唤醒
+            if (cv_.wait_until(lk, nextRun_, interrupted))
+            {
+                return false;
+            }
+            return true;
+        }
+
+#ifndef _WIN32
+        // 描述符 + 唤醒通知：在锁内复位通知并检查标志，之后的暂停/停止请求会使通知可读
+        if (interrupted())
+        {
+            return false;
+        }
+        wakeNotifier_.Reset();
+        const int wakeFd = wakeNotifier_.NativeHandle();
+        lk.unlock();
+
+        int timeoutMs = -1;
+        if (timed)
+        {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                nextRun_ - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0)
+            {
+                return true; // 周期已到期
+            }
+            timeoutMs = static_cast<int>(remaining) + 1; // 向上取整，避免提前 1ms 醒来
+        }
+
+        pollfd fds[2] = {};
+        fds[0].fd = loopWaitFd_;
+        fds[0].events = POLLIN;
+        fds[1].fd = wakeFd;
+        fds[1].events = POLLIN;
+        const int ret = ::poll(fds, 2, timeoutMs);
+        if (ret < 0)
+        {
+            if (errno != EINTR)
+            {
+                std::cerr << "ThreadWrapper: poll failed: " << std::strerror(errno) << std::endl;
+                stopFlag_.store(true);
+            }
+            return false;
+        }
+        if (fds[1].revents != 0)
+        {
+            return false; // 暂停/停止请求
+        }
+        // 描述符可读或周期到期
+        if (timed && ret == 0)
+        {
+            return true;
+        }
+        if (fds[0].revents & (POLLERR | POLLNVAL))
+        {
+            std::cerr << "ThreadWrapper: loop wait handle is invalid." << std::endl;
+            stopFlag_.store(true);
+            return false;
+        }
+        return ret > 0;
+#else
+        lk.unlock();
+        return true;
+#endif
+    }
 } // namespace LSX_LIB::Thread
@@ -0,0 +1,398 @@
+#include "Watchdog.h"
+#include <algorithm> // 用于 std::sort
+#include <condition_variable>
+#include <cstdio> // 用于 std::snprintf
+#include <cerrno>
+#include <exception>
+#include <iostream> // 用于默认的报告输出
+#include <thread>
+
+#ifdef __linux__
+#include <csignal>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#if defined(__linux__) && defined(__GLIBC__)
+#include <execinfo.h>
+#include <cstdlib> // 用于 free
+#define LSX_WATCHDOG_HAS_BACKTRACE 1
+#endif
+
+namespace LSX_LIB::Thread
+{
+    namespace
+    {
+#ifdef LSX_WATCHDOG_HAS_BACKTRACE
+        // 调用栈采集在被采集线程的信号处理函数中进行，同一时刻只采集一个线程
+        constexpr int kMaxFrames = 64;
+        enum CaptureState : int
+        {
+            CaptureIdle = 0,
+            CaptureRequested = 1,
+            CaptureRunning = 2,
+            CaptureDone = 3
+        };
+
+        std::mutex g_capture_mutex; // Serializes captures and handler installation
+        std::atomic<int> g_capture_state{CaptureIdle};
+        pthread_t g_capture_target;
+        int g_capture_max = 0;
+        void* g_capture_frames[kMaxFrames];
+        int g_capture_depth = 0;
+        std::vector<int> g_installed_signals; // Guarded by g_capture_mutex
+
+        void captureHandler(int)
+        {
+            const int saved_errno = errno;
+            int expected = CaptureRequested;
+            if (g_capture_state.load(std::memory_order_acquire) == CaptureRequested &&
+                pthread_equal(pthread_self(), g_capture_target) &&
+                g_capture_state.compare_exchange_strong(expected, CaptureRunning, std::memory_order_acquire))
+            {
+                g_capture_depth = backtrace(g_capture_frames, g_capture_max);
+                g_capture_state.store(CaptureDone, std::memory_order_release);
+            }
+            errno = saved_errno;
+        }
+
+        // 安装信号处理函数（调用者须持有 g_capture_mutex）
+        bool installHandler(int signo)
+        {
+            if (std::find(g_installed_signals.begin(), g_installed_signals.end(), signo) != g_installed_signals.end())
+            {
+                return true;
+            }
+            // backtrace() 首次调用会加载 libgcc，先在普通上下文中调用一次
+            void* warmup[2];
+            backtrace(warmup, 2);
+
+            struct sigaction action{};
+            action.sa_handler = &captureHandler;
+            sigemptyset(&action.sa_mask);
+            action.sa_flags = SA_RESTART;
+            if (::sigaction(signo, &action, nullptr) != 0)
+            {
+                std::cerr << "Watchdog: failed to install stack capture signal handler." << std::endl;
+                return false;
+            }
+            g_installed_signals.push_back(signo);
+            return true;
+        }
+
+        // 采集指定线程的调用栈，线程在超时时间内未响应时返回空
+        std::vector<std::string> captureStack(pthread_t thread, int signo, size_t max_frames)
+        {
+            std::vector<std::string> result;
+            std::lock_guard<std::mutex> lk(g_capture_mutex);
+            if (!installHandler(signo))
+            {
+                return result;
+            }
+            g_capture_target = thread;
+            g_capture_max = static_cast<int>(std::min<size_t>(max_frames + 1, kMaxFrames)); // +1: handler frame
+            g_capture_depth = 0;
+            g_capture_state.store(CaptureRequested, std::memory_order_release);
+            if (pthread_kill(thread, signo) != 0)
+            {
+                g_capture_state.store(CaptureIdle, std::memory_order_relaxed);
+                return result;
+            }
+            for (int i = 0; i < 200; ++i)
+            {
+                if (g_capture_state.load(std::memory_order_acquire) == CaptureDone)
+                {
+                    break;
+                }
+                if (i == 100)
+                {
+                    // 100ms 内未响应：撤销请求；处理函数已开始执行时继续等待其完成
+                    int expected = CaptureRequested;
+                    if (g_capture_state.compare_exchange_strong(expected, CaptureIdle))
+                    {
+                        return result;
+                    }
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            if (g_capture_state.load(std::memory_order_acquire) != CaptureDone)
+            {
+                return result; // Handler stuck mid-capture; leave the state busy rather than race it
+            }
+            char** symbols = g_capture_depth > 1 ? backtrace_symbols(g_capture_frames + 1, g_capture_depth - 1) : nullptr;
+            if (symbols != nullptr)
+            {
+                for (int i = 0; i < g_capture_depth - 1; ++i)
+                {
+                    result.emplace_back(symbols[i]);
+                }
+                std::free(symbols);
+            }
+            g_capture_state.store(CaptureIdle, std::memory_order_release);
+            return result;
+        }
+#endif
+
+        std::string formatReport(const StallReport& report)
+        {
+            char line[256];
+            const char* task = report.taskName.empty() ? "<unnamed>" : report.taskName.c_str();
+            if (report.kind == StallReport::Kind::StalledTask)
+            {
+                std::snprintf(line, sizeof(line),
+                              "[Watchdog] stalled task '%s' on thread '%s' (tid %ld): running %ld ms (threshold %ld ms)",
+                              task, report.threadName.c_str(), report.threadId, report.elapsedMs, report.limitMs);
+            }
+            else
+            {
+                std::snprintf(line, sizeof(line),
+                              "[Watchdog] periodic task '%s' on thread '%s' (tid %ld) overran its period: %ld ms (period %ld ms)",
+                              task, report.threadName.c_str(), report.threadId, report.elapsedMs, report.limitMs);
+            }
+            std::string text = line;
+            for (size_t i = 0; i < report.stack.size(); ++i)
+            {
+                std::snprintf(line, sizeof(line), "\n  #%-2zu ", i);
+                text += line;
+                text += report.stack[i];
+            }
+            return text;
+        }
+    }
+
+    struct Watchdog::Impl
+    {
+        WatchdogOptions options;
+        ReportHandler handler;
+        mutable std::mutex mutex; // Protects probes and stopping
+        std::condition_variable cv; // Wakes the monitor thread on stop()
+        bool stopping = false;
+        std::vector<std::weak_ptr<Probe>> probes;
+        std::atomic<uint64_t> reports{0};
+        std::thread thread;
+
+        void run();
+        void emit(const StallReport& report);
+        std::vector<std::shared_ptr<Probe>> liveProbes();
+    };
+
+    std::string StallReport::toString() const
+    {
+        return formatReport(*this);
+    }
+
+    long Watchdog::Probe::currentThreadId()
+    {
+#ifdef __linux__
+        return static_cast<long>(::syscall(SYS_gettid));
+#else
+        return 0;
+#endif
+    }
+
+    void Watchdog::Probe::setTaskName(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lk(nameMutex_);
+        taskName_ = name;
+        hasTaskName_.store(true, std::memory_order_relaxed);
+    }
+
+    void Watchdog::Probe::reportOverrun(long periodMs, long elapsedMs)
+    {
+        std::shared_ptr<Impl> owner = owner_.lock();
+        if (!owner)
+        {
+            return;
+        }
+        StallReport report;
+        report.kind = StallReport::Kind::PeriodOverrun;
+        report.threadName = threadName_;
+        {
+            std::lock_guard<std::mutex> lk(nameMutex_);
+            report.taskName = taskName_;
+        }
+        report.threadId = threadId_ != 0 ? threadId_ : currentThreadId();
+        report.elapsedMs = elapsedMs;
+        report.limitMs = periodMs;
+        owner->emit(report);
+    }
+
+    void Watchdog::Impl::emit(const StallReport& report)
+    {
+        reports.fetch_add(1, std::memory_order_relaxed);
+        if (!handler)
+        {
+            std::cerr << report.toString() << std::endl;
+            return;
+        }
+        try
+        {
+            handler(report);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Watchdog report handler failed: " << e.what() << std::endl;
+        } catch (...)
+        {
+            std::cerr << "Watchdog report handler failed with unknown error." << std::endl;
+        }
+    }
+
+    std::vector<std::shared_ptr<Watchdog::Probe>> Watchdog::Impl::liveProbes()
+    {
+        std::vector<std::shared_ptr<Probe>> result;
+        std::lock_guard<std::mutex> lk(mutex);
+        size_t kept = 0;
+        for (size_t i = 0; i < probes.size(); ++i)
+        {
+            std::shared_ptr<Probe> probe = probes[i].lock();
+            if (probe)
+            {
+                result.push_back(std::move(probe));
+                probes[kept++] = probes[i]; // Drop probes whose owners are gone
+            }
+        }
+        probes.resize(kept);
+        return result;
+    }
+
+    void Watchdog::Impl::run()
+    {
+        const auto interval = std::chrono::milliseconds(options.checkIntervalMs > 0 ? options.checkIntervalMs : 1);
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lk(mutex);
+                if (cv.wait_for(lk, interval, [this] { return stopping; }))
+                {
+                    return;
+                }
+            }
+
+            const int64_t now = Probe::nowNs();
+            const int64_t threshold_ns = static_cast<int64_t>(options.stallThresholdMs) * 1000000;
+            for (const std::shared_ptr<Probe>& probe : liveProbes())
+            {
+                const int64_t start = probe->startNs_.load(std::memory_order_acquire);
+                if (start == 0 || now - start < threshold_ns)
+                {
+                    continue;
+                }
+                const uint64_t sequence = probe->sequence_.load(std::memory_order_relaxed);
+                if (sequence == probe->reportedSequence_ || probe->startNs_.load(std::memory_order_acquire) != start)
+                {
+                    continue; // Already reported, or the task finished meanwhile
+                }
+                probe->reportedSequence_ = sequence;
+
+                StallReport report;
+                report.kind = StallReport::Kind::StalledTask;
+                report.threadName = probe->threadName_;
+                {
+                    std::lock_guard<std::mutex> lk(probe->nameMutex_);
+                    report.taskName = probe->taskName_;
+                }
+                report.threadId = probe->threadId_;
+                report.elapsedMs = static_cast<long>((now - start) / 1000000);
+                report.limitMs = options.stallThresholdMs;
+#ifdef LSX_WATCHDOG_HAS_BACKTRACE
+                if (options.captureStack)
+                {
+                    const int signo = options.stackSignal != 0 ? options.stackSignal : SIGRTMIN + 3;
+                    report.stack = captureStack(probe->thread_, signo, options.maxStackFrames);
+                }
+#endif
+                emit(report);
+            }
+        }
+    }
+
+    Watchdog::Watchdog(const WatchdogOptions& options, ReportHandler handler) : impl_(std::make_shared<Impl>())
+    {
+        impl_->options = options;
+        impl_->handler = std::move(handler);
+        Impl* impl = impl_.get();
+        impl_->thread = std::thread([impl] { impl->run(); });
+    }
+
+    Watchdog::~Watchdog()
+    {
+        stop();
+    }
+
+    std::shared_ptr<Watchdog::Probe> Watchdog::createProbe(const std::string& threadName)
+    {
+        auto probe = std::make_shared<Probe>(impl_, threadName);
+        std::lock_guard<std::mutex> lk(impl_->mutex);
+        impl_->probes.push_back(probe);
+        return probe;
+    }
+
+    void Watchdog::setCurrentTaskName(const std::string& name)
+    {
+        Probe* probe = Probe::current();
+        if (probe != nullptr)
+        {
+            probe->setTaskName(name);
+        }
+    }
+
+    void Watchdog::stop()
+    {
+        {
+            std::lock_guard<std::mutex> lk(impl_->mutex);
+            impl_->stopping = true;
+        }
+        impl_->cv.notify_all();
+        if (impl_->thread.joinable())
+        {
+            impl_->thread.join();
+        }
+    }
+
+    std::vector<ActiveTask> Watchdog::activeTasks() const
+    {
+        std::vector<ActiveTask> result;
+        const int64_t now = Probe::nowNs();
+        for (const std::shared_ptr<Probe>& probe : impl_->liveProbes())
+        {
+            const int64_t start = probe->startNs_.load(std::memory_order_acquire);
+            if (start == 0)
+            {
+                continue;
+            }
+            ActiveTask task;
+            task.threadName = probe->threadName_;
+            {
+                std::lock_guard<std::mutex> lk(probe->nameMutex_);
+                task.taskName = probe->taskName_;
+            }
+            task.threadId = probe->threadId_;
+            task.elapsedMs = static_cast<long>((now - start) / 1000000);
+            result.push_back(std::move(task));
+        }
+        std::sort(result.begin(), result.end(), [](const ActiveTask& a, const ActiveTask& b)
+        {
+            return a.elapsedMs > b.elapsedMs;
+        });
+        return result;
+    }
+
+    void Watchdog::dump(std::ostream& os) const
+    {
+        const std::vector<ActiveTask> tasks = activeTasks();
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-24s %8s %-32s %12s\n", "thread", "tid", "task", "elapsed_ms");
+        os << line;
+        for (const ActiveTask& task : tasks)
+        {
+            std::snprintf(line, sizeof(line), "%-24s %8ld %-32s %12ld\n", task.threadName.c_str(), task.threadId,
+                          task.taskName.empty() ? "<unnamed>" : task.taskName.c_str(), task.elapsedMs);
+            os << line;
+        }
+    }
+
+    uint64_t Watchdog::reportCount() const
+    {
+        return impl_->reports.load(std::memory_order_relaxed);
+    }
+} // namespace LSX_LIB::Thread